@@ -6,6 +6,7 @@
  */
 
 #include "mathematics/common.hpp"
+#include "mathematics/simd.hpp"
 #include "mathematics/vector.hpp"
 #include "objects/aabb.hpp"
 #include "objects/plane.hpp"
@@ -14,11 +15,28 @@
 #include "world/config.hpp"
 #include "world/physicsWorld.hpp"
 
+#include <array>
 #include <cmath>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 
-decimal simulation(std::string solver, decimal timestep, int maxiter)
+/// First contact of the sphere with the ground, and wall-clock time of the simulation loop.
+struct SimulationResult
+{
+    decimal contactTime = 0_d;
+    decimal seconds     = 0_d;
+};
+
+/**
+ * @brief Drop a sphere on the ground for `maxiter` steps of `timestep`.
+ *
+ * The adaptive BS32 solver takes its own steps, up to the same simulated time: `timestep` only bounds them
+ * while the sphere touches the ground. Its step ends at the contact onset, whose time is the one reported.
+ */
+SimulationResult simulation(std::string solver, decimal timestep, int maxiter, bool continuous)
 {
     Timer totalTimer;
 
@@ -28,18 +46,19 @@ decimal simulation(std::string solver, decimal timestep, int maxiter)
     config.setSolver(solver);
     config.setTimeStep(timestep);
     config.setMaxIterations(maxiter);
+    config.setContinuousCollision(continuous);
     Contact contact;
 
     // Initialize simulation
     Timer        initTimer;
     PhysicsWorld world(config);
-    auto*        ground = new Plane(Vector3D(0_d), Vector3D(50_d, 50_d, 0_d), Vector3D(0_d, 0_d, 1_d));
-    auto*        sphere = new Sphere(Vector3D(0_d, 0_d, 20_d), 0.2_d, Vector3D(0_d, 0_d, -1_d), 1_d);
+    auto*        sphere = world.getObject<Sphere>(
+        world.createObject<Sphere>(Vector3D(0_d, 0_d, 20_d), 0.2_d, Vector3D(0_d, 0_d, -1_d), 1_d));
+    auto* ground = world.getObject<Plane>(
+        world.createObject<Plane>(Vector3D(0_d), Vector3D(50_d, 50_d, 0_d), Vector3D(0_d, 0_d, 1_d)));
 
     sphere->setIsFixed(false);
 
-    world.addObject(sphere);
-    world.addObject(ground);
     world.start();
 
     decimal simulationContactTimeSphere = 0_d;
@@ -48,9 +67,11 @@ decimal simulation(std::string solver, decimal timestep, int maxiter)
     Timer         simulationTimer;
     const decimal timeStep = config.getTimeStep();
     const size_t  maxIter  = config.getMaxIterations();
+    const decimal duration = static_cast<decimal>(maxIter) * timeStep;
+    const bool    adaptive = world.getSolver() == Solver::BS32;
     size_t        counter  = 0;
 
-    while (counter < maxIter && world.getIsRunning())
+    while ((adaptive ? world.getTime() < duration : counter < maxIter) && world.getIsRunning())
     {
         Timer stepTimer;
 
@@ -58,25 +79,88 @@ decimal simulation(std::string solver, decimal timestep, int maxiter)
 
         world.integrateWithoutCollisions();
 
-        if (sphere->computeCollision(*ground, contact) && simulationContactTimeSphere == 0_d)
+        // A sphere only touching the ground may have been stopped without overlapping it
+        const bool stopped = sphere->isFixed() || sphere->computeCollision(*ground, contact);
+        if (stopped && simulationContactTimeSphere == 0_d)
         {
-            simulationContactTimeSphere = time;
+            simulationContactTimeSphere = adaptive ? world.getTime() : time;
         }
         ++counter;
     }
+    const decimal seconds = simulationTimer.elapsedSeconds();
     world.clearObjects();
 
-    return simulationContactTimeSphere;
+    return { simulationContactTimeSphere, seconds };
+}
+
+/**
+ * @brief Time `steps` steps of `count` free-falling projectiles, with the per-object integrator and with the
+ * batch integrator of the world.
+ *
+ * The per-object Verlet and RK4 integrators scan every object for each body: keep `count` small for them.
+ */
+void throughput(const std::string& solver, std::size_t count, int steps)
+{
+    Config& config = Config::get();
+    config.setSolver(solver);
+    config.setTimeStep(1e-3_d);
+
+    PhysicsWorld                         world(config);
+    std::vector<std::unique_ptr<Sphere>> spheres;
+    spheres.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Vector3D position(static_cast<decimal>(i), 0_d, 100_d);
+        spheres.push_back(std::make_unique<Sphere>(position, 0.2_d, Vector3D(1_d, 0_d, 5_d), 1_d));
+        world.addObject(spheres.back().get());
+    }
+    world.resetAcc();
+    world.applyGravityForces();
+
+    const decimal dt = config.getTimeStep();
+    Timer         perObjectTimer;
+    for (int step = 0; step < steps; ++step)
+    {
+        for (auto& sphere : spheres)
+        {
+            if (solver == "Verlet")
+                world.integrateVerlet(*sphere, dt);
+            else if (solver == "RK4")
+                world.integrateRK4(*sphere, dt);
+            else
+                world.integrateEuler(*sphere, dt);
+        }
+    }
+    const decimal perObject = perObjectTimer.elapsedSeconds();
+
+    Timer batchTimer;
+    for (int step = 0; step < steps; ++step)
+        world.integrateBodies(dt);
+    const decimal batch = batchTimer.elapsedSeconds();
+
+    const decimal updates = static_cast<decimal>(count) * static_cast<decimal>(steps);
+    std::cout << solver << ", " << count << " bodies, " << steps << " steps (" << simd::name() << ")\n"
+              << "  per-object: " << updates / perObject * 1e-6_d << " M bodies/s\n"
+              << "  batch:      " << updates / batch * 1e-6_d << " M bodies/s\n";
+    world.clearObjects();
 }
 
 int main(int argc, char** argv)
 {
+    // Throughput of the batch integrators: `Free_Fall <bodies> [Euler|Verlet|RK4]`
+    if (argc > 1)
+    {
+        throughput(argc > 2 ? argv[2] : "Euler", std::stoul(argv[1]), 100);
+        return 0;
+    }
+
     // Simulations parameters
     decimal analyticalContactTimeSphere = 1.914861584038593_d;
     decimal totalTime                   = 2_d;
 
-    // Arrays of tested parameters
-    std::array<std::string, 3>        solvers { "Euler", "Verlet", "RK4" };
+    // Arrays of tested parameters; "-CCD" variants stop the sphere at its impact within the step
+    std::array<std::string, 4>        solvers { "Euler", "Verlet", "RK4", "BS32" };
+    std::array<bool, 2>               sweeps { false, true };
     std::array<decimal, 50>           timesteps;
     std::array<int, timesteps.size()> maxIterations;
 
@@ -93,18 +177,22 @@ int main(int argc, char** argv)
         maxIterations[i] = static_cast<int>(totalTime / timesteps[i]);
     }
 
-    std::array<std::array<decimal, timesteps.size()>, solvers.size()> results;
+    std::array<std::array<std::array<SimulationResult, timesteps.size()>, solvers.size()>, sweeps.size()>
+        results;
 
     // Benchmark
-    for (std::size_t iSolver = 0; iSolver < solvers.size(); ++iSolver)
+    for (std::size_t iSweep = 0; iSweep < sweeps.size(); ++iSweep)
     {
-        for (std::size_t jIter = 0; jIter < timesteps.size(); ++jIter)
+        for (std::size_t iSolver = 0; iSolver < solvers.size(); ++iSolver)
         {
-            results[iSolver][jIter] =
-                commonMaths::absVal(simulation(solvers[iSolver], timesteps[jIter], maxIterations[jIter]) -
-                                    analyticalContactTimeSphere);
+            for (std::size_t jIter = 0; jIter < timesteps.size(); ++jIter)
+            {
+                results[iSweep][iSolver][jIter] =
+                    simulation(solvers[iSolver], timesteps[jIter], maxIterations[jIter], sweeps[iSweep]);
+            }
         }
     }
+    Config::get().setContinuousCollision(false);
 
     // Save Benchmark into CSV
     std::ofstream file("benchmarks/Free_Fall/benchmark.csv");
@@ -115,13 +203,21 @@ int main(int argc, char** argv)
         return 1;
     }
 
-    file << "solver,dt,error\n";
+    // Error on the contact time, and wall-clock time of the run: accuracy against cost for every solver
+    file << "solver,dt,error,seconds\n";
 
-    for (std::size_t iSolver = 0; iSolver < solvers.size(); ++iSolver)
+    for (std::size_t iSweep = 0; iSweep < sweeps.size(); ++iSweep)
     {
-        for (std::size_t jIter = 0; jIter < timesteps.size(); ++jIter)
+        const std::string suffix = sweeps[iSweep] ? "-CCD" : "";
+        for (std::size_t iSolver = 0; iSolver < solvers.size(); ++iSolver)
         {
-            file << solvers[iSolver] << "," << timesteps[jIter] << "," << results[iSolver][jIter] << "\n";
+            for (std::size_t jIter = 0; jIter < timesteps.size(); ++jIter)
+            {
+                const SimulationResult& result = results[iSweep][iSolver][jIter];
+                file << solvers[iSolver] << suffix << "," << timesteps[jIter] << ","
+                     << commonMaths::absVal(result.contactTime - analyticalContactTimeSphere) << ","
+                     << result.seconds << "\n";
+            }
         }
     }
 
@@ -0,0 +1,198 @@
+/**
+ * @file main.cpp
+ *
+ * @brief Throughput of the sphere–sphere and sphere–plane narrow phase.
+ *
+ * Random pairs of spheres, and of a sphere and a tilted plane, are tested through three paths:
+ *  - object: `Object::computeCollision`, the per-pair virtual dispatch;
+ *  - scalar: NarrowCollision on shape parameters gathered in arrays;
+ *  - simd: the NarrowKernels early-out tests, then NarrowCollision on the flagged pairs only.
+ * Each path reports the pairs tested per second and its speed-up over the scalar path; the number of
+ * contacts found must be the same for all of them.
+ *
+ * Usage: `Narrow_Phase [pairs] [repeats]`
+ */
+
+#include "collision/narrow_collision.hpp"
+#include "collision/narrow_kernels.hpp"
+#include "mathematics/simd.hpp"
+#include "objects/plane.hpp"
+#include "objects/sphere.hpp"
+#include "utilities/timer.hpp"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using NarrowCollision::PlaneShape;
+using NarrowCollision::SphereShape;
+
+struct PathResult
+{
+    decimal     pairsPerSecond = 0_d;
+    std::size_t contacts       = 0;
+};
+
+/// Best of `repeats` runs of `path`, which tests `pairs` pairs and returns the contacts found.
+PathResult measure(std::size_t pairs, int repeats, const std::function<std::size_t()>& path)
+{
+    PathResult result;
+    for (int run = 0; run < repeats; ++run)
+    {
+        Timer             timer;
+        const std::size_t contacts = path();
+        const decimal     seconds  = timer.elapsedSeconds();
+        result.contacts            = contacts;
+        result.pairsPerSecond      = std::max(result.pairsPerSecond, static_cast<decimal>(pairs) / seconds);
+    }
+    return result;
+}
+
+/// Component array of `count` values.
+template <typename Value>
+std::vector<decimal> column(std::size_t count, Value value)
+{
+    std::vector<decimal> values(count);
+    for (std::size_t i = 0; i < count; ++i)
+        values[i] = value(i);
+    return values;
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t pairCount = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    const int         repeats   = argc > 2 ? std::stoi(argv[2]) : 10;
+
+    std::cout << pairCount << " pairs per shape pair, best of " << repeats << ", " << simd::name() << " ("
+              << simd::width << " lanes)\n";
+
+    // Objects spread out enough that only a few percent of the pairs are in contact, as in a broad phase
+    constexpr std::size_t                      objectCount = 4096;
+    std::mt19937                               rng(11);
+    std::uniform_real_distribution<decimal>    coordinate(-6_d, 6_d);
+    std::uniform_real_distribution<decimal>    diameter(0.5_d, 2_d);
+    std::uniform_int_distribution<std::size_t> pick(0, objectCount - 1);
+    std::vector<Sphere>                        spheres;
+    std::vector<Plane>                         planes;
+    for (std::size_t i = 0; i < objectCount; ++i)
+    {
+        spheres.emplace_back(Vector3D(coordinate(rng), coordinate(rng), coordinate(rng)), diameter(rng));
+        planes.emplace_back(Vector3D(coordinate(rng), coordinate(rng), coordinate(rng)),
+                            Vector3D(8_d, 8_d, 0_d), Vector3D(coordinate(rng), coordinate(rng), 6_d));
+    }
+    std::vector<std::array<std::size_t, 3>> pairs(pairCount);
+    for (auto& pair : pairs)
+        pair = { pick(rng), pick(rng), pick(rng) }; // first sphere, second sphere, plane
+
+    // Gathered parameters of the pairs, as the narrow phase lays them out
+    std::vector<SphereShape> first(pairCount);
+    std::vector<SphereShape> second(pairCount);
+    std::vector<PlaneShape>  plane(pairCount);
+    for (std::size_t i = 0; i < pairCount; ++i)
+    {
+        first[i]  = NarrowCollision::shapeOf(spheres[pairs[i][0]]);
+        second[i] = NarrowCollision::shapeOf(spheres[pairs[i][1]]);
+        plane[i]  = NarrowCollision::shapeOf(planes[pairs[i][2]]);
+    }
+    std::array<std::vector<decimal>, 4>  a;
+    std::array<std::vector<decimal>, 4>  b;
+    std::array<std::vector<decimal>, 14> p;
+    for (std::size_t c = 0; c < 3; ++c)
+    {
+        a[c]     = column(pairCount, [&](std::size_t i) { return first[i].center[c]; });
+        b[c]     = column(pairCount, [&](std::size_t i) { return second[i].center[c]; });
+        p[c]     = column(pairCount, [&](std::size_t i) { return plane[i].center[c]; });
+        p[3 + c] = column(pairCount, [&](std::size_t i) { return plane[i].normal[c]; });
+        p[6 + c] = column(pairCount, [&](std::size_t i) { return plane[i].u[c]; });
+        p[9 + c] = column(pairCount, [&](std::size_t i) { return plane[i].v[c]; });
+    }
+    a[3]  = column(pairCount, [&](std::size_t i) { return first[i].radius; });
+    b[3]  = column(pairCount, [&](std::size_t i) { return second[i].radius; });
+    p[12] = column(pairCount, [&](std::size_t i) { return plane[i].halfWidth; });
+    p[13] = column(pairCount, [&](std::size_t i) { return plane[i].halfHeight; });
+    std::vector<std::uint8_t> candidates(pairCount);
+    std::vector<Contact>      contacts(pairCount);
+
+    const NarrowKernels::SpherePairs      spherePairs { a[0].data(), a[1].data(), a[2].data(), a[3].data(),
+                                                        b[0].data(), b[1].data(), b[2].data(), b[3].data() };
+    const NarrowKernels::SpherePlanePairs planePairs { a[0].data(),  a[1].data(),  a[2].data(),  a[3].data(),
+                                                       p[0].data(),  p[1].data(),  p[2].data(),  p[3].data(),
+                                                       p[4].data(),  p[5].data(),  p[6].data(),  p[7].data(),
+                                                       p[8].data(),  p[9].data(),  p[10].data(), p[11].data(),
+                                                       p[12].data(), p[13].data() };
+
+    // Paths
+    auto objectPath = [&](bool withPlane)
+    {
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < pairCount; ++i)
+        {
+            Object& other = withPlane ? static_cast<Object&>(planes[pairs[i][2]]) : spheres[pairs[i][1]];
+            found += spheres[pairs[i][0]].computeCollision(other, contacts[i]) ? 1 : 0;
+        }
+        return found;
+    };
+    auto scalarPath = [&](bool withPlane)
+    {
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < pairCount; ++i)
+        {
+            const bool hit = withPlane ? NarrowCollision::computeContact(first[i], plane[i], contacts[i])
+                                       : NarrowCollision::computeContact(first[i], second[i], contacts[i]);
+            found += hit ? 1 : 0;
+        }
+        return found;
+    };
+    auto simdPath = [&](bool withPlane)
+    {
+        if (withPlane)
+            NarrowKernels::spherePlane(planePairs, pairCount, candidates.data());
+        else
+            NarrowKernels::sphereSphere(spherePairs, pairCount, candidates.data());
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < pairCount; ++i)
+        {
+            if (!candidates[i])
+                continue;
+            const bool hit = withPlane ? NarrowCollision::computeContact(first[i], plane[i], contacts[i])
+                                       : NarrowCollision::computeContact(first[i], second[i], contacts[i]);
+            found += hit ? 1 : 0;
+        }
+        return found;
+    };
+
+    std::ofstream file("benchmarks/Narrow_Phase/narrow_phase.csv");
+    if (file)
+        file << "shapes,path,pairs_per_second,speedup,contacts\n";
+
+    for (const bool withPlane : { false, true })
+    {
+        const std::string shapes = withPlane ? "sphere-plane" : "sphere-sphere";
+        const std::array<std::string, 3>                  names { "object", "scalar", "simd" };
+        const std::array<std::function<std::size_t()>, 3> paths { [&] { return objectPath(withPlane); },
+                                                                  [&] { return scalarPath(withPlane); },
+                                                                  [&] { return simdPath(withPlane); } };
+        std::array<PathResult, 3> results;
+        for (std::size_t path = 0; path < paths.size(); ++path)
+            results[path] = measure(pairCount, repeats, paths[path]);
+
+        std::cout << shapes << ":\n";
+        for (std::size_t path = 0; path < paths.size(); ++path)
+        {
+            const decimal speedup = results[path].pairsPerSecond / results[1].pairsPerSecond;
+            const bool    same    = results[path].contacts == results[1].contacts;
+            std::cout << "  " << names[path] << ": " << results[path].pairsPerSecond * 1e-6_d
+                      << " M pairs/s, x" << speedup << ", " << results[path].contacts << " contacts"
+                      << (same ? "" : " (differs from scalar)") << "\n";
+            if (file)
+                file << shapes << "," << names[path] << "," << results[path].pairsPerSecond << "," << speedup
+                     << "," << results[path].contacts << "\n";
+        }
+    }
+    return 0;
+}
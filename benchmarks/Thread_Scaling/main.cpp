@@ -0,0 +1,108 @@
+/**
+ * @file main.cpp
+ *
+ * @brief Thread scaling benchmark of the step pipeline.
+ *
+ * A block of spheres falls on a ground plane, so every pass of the step (gravity, integration, broad phase,
+ * contact forces, narrow phase and response) has work. The same scene is run with 1 to 64 threads; each run
+ * reports the time per step, the speed-up over one thread and whether the final state is bit-identical to the
+ * single-thread run.
+ *
+ * Usage: `Thread_Scaling [bodies] [Euler|Verlet|RK4] [steps]`
+ */
+
+#include "mathematics/vector.hpp"
+#include "objects/plane.hpp"
+#include "objects/sphere.hpp"
+#include "utilities/thread_pool.hpp"
+#include "utilities/timer.hpp"
+#include "world/config.hpp"
+#include "world/physicsWorld.hpp"
+
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+struct ScalingResult
+{
+    decimal               msPerStep = 0_d;
+    std::vector<Vector3D> positions;
+};
+
+ScalingResult run(std::size_t threads, std::size_t count, const std::string& solver, int steps)
+{
+    Config& config = Config::get();
+    config.setSolver(solver);
+    config.setTimeStep(1e-3_d);
+    config.setBroadPhase("SweepAndPrune");
+    config.setThreadCount(threads);
+    config.setDeterministic(true);
+    config.setVerbose(false);
+
+    PhysicsWorld world(config);
+    Plane        ground(Vector3D(0_d), Vector3D(1000_d, 1000_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    world.addObject(&ground);
+
+    // Jittered lattice of touching spheres
+    std::vector<std::unique_ptr<Sphere>>    spheres;
+    std::mt19937                            rng(7);
+    std::uniform_real_distribution<decimal> jitter(-0.05_d, 0.05_d);
+    const auto side = static_cast<std::size_t>(std::ceil(std::cbrt(static_cast<decimal>(count))));
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Vector3D position(static_cast<decimal>(i % side) * 0.95_d + jitter(rng),
+                                static_cast<decimal>((i / side) % side) * 0.95_d + jitter(rng),
+                                static_cast<decimal>(i / (side * side)) * 0.95_d + 0.6_d);
+        spheres.push_back(std::make_unique<Sphere>(position, 0.5_d, Vector3D(0_d), 1_d));
+        world.addObject(spheres.back().get());
+    }
+
+    world.start();
+    world.integrate(); // builds the broad-phase structures
+    Timer timer;
+    for (int step = 1; step < steps; ++step)
+        world.integrate();
+
+    ScalingResult result;
+    result.msPerStep = timer.elapsedMilliseconds() / static_cast<decimal>(steps - 1);
+    for (const auto& sphere : spheres)
+        result.positions.push_back(sphere->getPosition());
+    world.clearObjects();
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t count  = argc > 1 ? std::stoul(argv[1]) : 20000;
+    const std::string solver = argc > 2 ? argv[2] : "Verlet";
+    const int         steps  = argc > 3 ? std::stoi(argv[3]) : 20;
+
+    std::cout << count << " bodies, " << solver << ", " << steps << " steps, "
+              << ThreadPool::getHardwareThreadCount() << " hardware threads\n";
+
+    std::ofstream file("benchmarks/Thread_Scaling/scaling.csv");
+    if (file)
+        file << "threads,ms_per_step,speedup,identical\n";
+
+    constexpr std::array<std::size_t, 7> threadCounts { 1, 2, 4, 8, 16, 32, 64 };
+    ScalingResult                        reference;
+    for (const std::size_t threads : threadCounts)
+    {
+        const ScalingResult result = run(threads, count, solver, steps);
+        if (threads == 1)
+            reference = result;
+
+        const decimal speedup   = reference.msPerStep / result.msPerStep;
+        const bool    identical = result.positions == reference.positions;
+        std::cout << "  " << threads << " threads: " << result.msPerStep << " ms/step, x" << speedup
+                  << (identical ? "" : " (results differ)") << "\n";
+        if (file)
+            file << threads << "," << result.msPerStep << "," << speedup << "," << identical << "\n";
+    }
+    return 0;
+}
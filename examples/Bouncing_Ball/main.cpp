@@ -47,15 +47,15 @@ int main(int argc, char** argv)
     // Initialize simulation
     Timer        initTimer;
     PhysicsWorld world(config);
-    auto*        ground = new Plane(Vector3D(0_d), Vector3D(40_d, 40_d, 0_d), Vector3D(0_d, 0_d, 1_d));
-    auto*        sphere = new Sphere(Vector3D(0_d, 0_d, 20), 5_d, Vector3D(0_d, 0_d, -1_d), 1_d);
+    auto*        sphere = world.getObject<Sphere>(
+        world.createObject<Sphere>(Vector3D(0_d, 0_d, 20), 5_d, Vector3D(0_d, 0_d, -1_d), 1_d));
+    auto* ground = world.getObject<Plane>(
+        world.createObject<Plane>(Vector3D(0_d), Vector3D(40_d, 40_d, 0_d), Vector3D(0_d, 0_d, 1_d)));
 
     sphere->setIsFixed(false);
     sphere->setName("Bouncing Ball");
     ground->setIsFixed(true);
     ground->setName("Ground");
-    world.addObject(sphere);
-    world.addObject(ground);
     world.start();
 
     // Initialise saving
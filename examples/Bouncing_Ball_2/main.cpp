@@ -47,17 +47,17 @@ int main(int argc, char** argv)
     // Initialize simulation
     Timer        initTimer;
     PhysicsWorld world(config);
-    auto*        ground_1 = new Plane(Vector3D(2_d, 0_d, 0_d), Vector3D(10_d), Vector3D(-1_d, 0_d, 1_d));
-    auto*        ground_2 = new Plane(Vector3D(-2_d, 0_d, 0_d), Vector3D(10_d), Vector3D(1_d, 0_d, 1_d));
-    auto*        sphere   = new Sphere(Vector3D(2_d, 0_d, 20_d), 2_d, Vector3D(0_d, 0_d, -1_d), 1_d);
+    auto*        sphere = world.getObject<Sphere>(
+        world.createObject<Sphere>(Vector3D(2_d, 0_d, 20_d), 2_d, Vector3D(0_d, 0_d, -1_d), 1_d));
+    auto* ground_1 = world.getObject<Plane>(
+        world.createObject<Plane>(Vector3D(2_d, 0_d, 0_d), Vector3D(10_d), Vector3D(-1_d, 0_d, 1_d)));
+    auto* ground_2 = world.getObject<Plane>(
+        world.createObject<Plane>(Vector3D(-2_d, 0_d, 0_d), Vector3D(10_d), Vector3D(1_d, 0_d, 1_d)));
 
     sphere->setIsFixed(false);
     sphere->setName("Bouncing Ball");
     ground_1->setName("Ground 1");
     ground_2->setName("Ground 2");
-    world.addObject(sphere);
-    world.addObject(ground_1);
-    world.addObject(ground_2);
     world.start();
 
     // Initialise saving
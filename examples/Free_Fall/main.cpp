@@ -50,11 +50,14 @@ int main(int argc, char** argv)
     // Initialise simulation
     Timer        initTimer;
     PhysicsWorld world(config);
-    auto*        ground = new Plane(Vector3D(0_d), Vector3D(25_d, 25_d, 0_d), Vector3D(0_d, 0_d, 1_d));
-    auto*        sphere = new Sphere(Vector3D(0_d, 0_d, 20_d), 0.2_d, Vector3D(0_d, 0_d, -1_d), 1_d);
-    auto*        plane  = new Plane(Vector3D(10_d, 0_d, 15_d), Vector3D(1_d, 0.4_d, 0_d), Vector3D(0_d), 1_d,
-                                    Vector3D(0_d, 1_d, 0_d));
-    auto*        cube   = new AABB(Vector3D(0_d, 10_d, 10_d), Vector3D(0.15_d), Vector3D(0_d), 1_d);
+    auto*        sphere = world.getObject<Sphere>(
+        world.createObject<Sphere>(Vector3D(0_d, 0_d, 20_d), 0.2_d, Vector3D(0_d, 0_d, -1_d), 1_d));
+    auto* plane = world.getObject<Plane>(world.createObject<Plane>(
+        Vector3D(10_d, 0_d, 15_d), Vector3D(1_d, 0.4_d, 0_d), Vector3D(0_d), 1_d, Vector3D(0_d, 1_d, 0_d)));
+    auto* cube = world.getObject<AABB>(
+        world.createObject<AABB>(Vector3D(0_d, 10_d, 10_d), Vector3D(0.15_d), Vector3D(0_d), 1_d));
+    auto* ground = world.getObject<Plane>(
+        world.createObject<Plane>(Vector3D(0_d), Vector3D(25_d, 25_d, 0_d), Vector3D(0_d, 0_d, 1_d)));
     sphere->setIsFixed(false);
     plane->setIsFixed(false);
     cube->setIsFixed(false);
@@ -63,10 +66,6 @@ int main(int argc, char** argv)
     cube->setName("Cube");
     ground->setName("ground");
 
-    world.addObject(sphere);
-    world.addObject(plane);
-    world.addObject(cube);
-    world.addObject(ground);
     world.start();
     world.initCSV(directory + "/CSV");
     world.saveObjectsCSV();
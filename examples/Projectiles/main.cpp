@@ -52,12 +52,15 @@ int main(int argc, char** argv)
     // Initialize simulation
     Timer        initTimer;
     PhysicsWorld world(config);
-    auto* ground = new Plane(Vector3D(0_d), Vector3D(100000_d, 100000_d, 0_d), Vector3D(0_d, 0_d, 1_d));
-    auto* sphereBulletMotion  = new Sphere(Vector3D(0_d, 0_d, 1.5_d), 0.2_d, Vector3D(1000_d, 0_d, 0_d), 1_d);
-    auto* planeVerticalMotion = new Plane(Vector3D(10_d, 0_d, 1_d), Vector3D(0.2_d, 0.2_d, 0_d),
-                                          Vector3D(0_d, 0_d, 100_d), 1_d, Vector3D(0_d, 1_d, 0_d));
-    auto* cubeParabolicMotion =
-        new AABB(Vector3D(0_d, 10_d, 1_d), Vector3D(0.1_d), Vector3D(0_d, 50_d, 50_d), 1_d);
+    auto*        sphereBulletMotion = world.getObject<Sphere>(
+        world.createObject<Sphere>(Vector3D(0_d, 0_d, 1.5_d), 0.2_d, Vector3D(1000_d, 0_d, 0_d), 1_d));
+    auto* planeVerticalMotion = world.getObject<Plane>(
+        world.createObject<Plane>(Vector3D(10_d, 0_d, 1_d), Vector3D(0.2_d, 0.2_d, 0_d),
+                                  Vector3D(0_d, 0_d, 100_d), 1_d, Vector3D(0_d, 1_d, 0_d)));
+    auto* cubeParabolicMotion = world.getObject<AABB>(
+        world.createObject<AABB>(Vector3D(0_d, 10_d, 1_d), Vector3D(0.1_d), Vector3D(0_d, 50_d, 50_d), 1_d));
+    auto* ground = world.getObject<Plane>(world.createObject<Plane>(
+        Vector3D(0_d), Vector3D(100000_d, 100000_d, 0_d), Vector3D(0_d, 0_d, 1_d)));
     sphereBulletMotion->setIsFixed(false);
     planeVerticalMotion->setIsFixed(false);
     cubeParabolicMotion->setIsFixed(false);
@@ -65,10 +68,6 @@ int main(int argc, char** argv)
     planeVerticalMotion->setName("Plane - Vertical Motion");
     cubeParabolicMotion->setName("Cube - Parabolic Motion");
 
-    world.addObject(sphereBulletMotion);
-    world.addObject(planeVerticalMotion);
-    world.addObject(cubeParabolicMotion);
-    world.addObject(ground);
     world.start();
     world.initCSV(directory + "/CSV");
     world.saveObjectsCSV();
@@ -47,20 +47,20 @@ int main(int argc, char** argv)
     // Initialize simulation
     Timer        initTimer;
     PhysicsWorld world(config);
-    auto*        ground = new Plane(Vector3D(10_d, 0_d, 0_d), Vector3D(50_d), Vector3D(0_d, 0_d, 1_d));
-    auto*        ramp   = new Plane(Vector3D(2_d, 0_d, 2_d), Vector3D(20_d), Vector3D(0.5_d, 0_d, 1_d));
-    auto*        wall   = new Plane(Vector3D(20_d, 0_d, 5_d), Vector3D(10_d), Vector3D(1_d, 0_d, 0_d));
-    auto*        sphere = new Sphere(Vector3D(-5_d, 0_d, 6_d), 2_d, Vector3D(0_d), 1_d);
+    auto*        sphere = world.getObject<Sphere>(
+        world.createObject<Sphere>(Vector3D(-5_d, 0_d, 6_d), 2_d, Vector3D(0_d), 1_d));
+    auto* ground = world.getObject<Plane>(
+        world.createObject<Plane>(Vector3D(10_d, 0_d, 0_d), Vector3D(50_d), Vector3D(0_d, 0_d, 1_d)));
+    auto* ramp = world.getObject<Plane>(
+        world.createObject<Plane>(Vector3D(2_d, 0_d, 2_d), Vector3D(20_d), Vector3D(0.5_d, 0_d, 1_d)));
+    auto* wall = world.getObject<Plane>(
+        world.createObject<Plane>(Vector3D(20_d, 0_d, 5_d), Vector3D(10_d), Vector3D(1_d, 0_d, 0_d)));
 
     sphere->setIsFixed(false);
     sphere->setName("Bouncing Ball");
     ground->setName("Ground");
     ramp->setName("Ramp");
     wall->setName("Wall");
-    world.addObject(sphere);
-    world.addObject(ground);
-    world.addObject(ramp);
-    world.addObject(wall);
     world.start();
 
     // Initialise saving
@@ -0,0 +1,84 @@
+/**
+ * @file bounding_box.hpp
+ * @brief World-space axis-aligned bounding volume used by the broad phase.
+ *
+ * A BoundingBox is a plain pair of corners (min, max). It is not a simulated Object: it is the conservative
+ * volume returned by `Object::getBoundingBox()` and consumed by broad-phase algorithms.
+ */
+#pragma once
+
+#include "mathematics/vector.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Axis-aligned box described by its minimum and maximum corners.
+ *
+ * All methods are inline: they are called for every body and every pair in the broad phase.
+ */
+struct BoundingBox
+{
+    Vector3D min = Vector3D(0_d);
+    Vector3D max = Vector3D(0_d);
+
+    // ============================================================================
+    /// @name Constructors
+    // ============================================================================
+    /// @{
+    BoundingBox() = default;
+    BoundingBox(const Vector3D& _min, const Vector3D& _max)
+        : min(_min)
+        , max(_max)
+    {}
+    /// @}
+
+    // ============================================================================
+    /// @name Getters
+    // ============================================================================
+    /// @{
+    Vector3D getCenter() const { return (min + max) * 0.5_d; }
+    Vector3D getExtents() const { return max - min; }
+    /// Surface area of the box, used as the insertion cost heuristic of the dynamic tree.
+    decimal getSurfaceArea() const
+    {
+        const Vector3D e = getExtents();
+        return 2_d * (e[0] * e[1] + e[1] * e[2] + e[2] * e[0]);
+    }
+    /// @}
+
+    // ============================================================================
+    /// @name Tests
+    // ============================================================================
+    /// @{
+
+    /// True if both boxes overlap (touching counts as overlapping).
+    bool overlaps(const BoundingBox& other) const
+    {
+        return min[0] <= other.max[0] && max[0] >= other.min[0] && min[1] <= other.max[1] &&
+               max[1] >= other.min[1] && min[2] <= other.max[2] && max[2] >= other.min[2];
+    }
+    /// True if `other` lies entirely inside this box.
+    bool contains(const BoundingBox& other) const
+    {
+        return min[0] <= other.min[0] && min[1] <= other.min[1] && min[2] <= other.min[2] &&
+               max[0] >= other.max[0] && max[1] >= other.max[1] && max[2] >= other.max[2];
+    }
+    /// @}
+
+    // ============================================================================
+    /// @name Utilities
+    // ============================================================================
+    /// @{
+
+    /// Return the box enlarged by `margin` on every side.
+    BoundingBox getFattened(decimal margin) const { return BoundingBox(min - margin, max + margin); }
+    /// Return the smallest box enclosing both boxes.
+    static BoundingBox merge(const BoundingBox& a, const BoundingBox& b)
+    {
+        return BoundingBox(Vector3D(std::min(a.min[0], b.min[0]), std::min(a.min[1], b.min[1]),
+                                    std::min(a.min[2], b.min[2])),
+                           Vector3D(std::max(a.max[0], b.max[0]), std::max(a.max[1], b.max[1]),
+                                    std::max(a.max[2], b.max[2])));
+    }
+    /// @}
+};
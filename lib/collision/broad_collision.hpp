@@ -39,4 +39,19 @@ inline bool isColliding(const AABB& a, const Sphere& b) { return isColliding(b,
 
 inline bool isColliding(const Plane& a, const AABB& b) { return isColliding(b, a); }
 
+// Separations: lower bound on the distance the two objects must move relative to each other before
+// `isColliding` can hold, non-positive if it may already
+decimal separation(const Sphere&, const Sphere&);
+decimal separation(const Sphere&, const Plane&);
+decimal separation(const Sphere&, const AABB&);
+decimal separation(const AABB&, const AABB&);
+decimal separation(const AABB&, const Plane&);
+decimal separation(const Plane&, const Plane&);
+
+inline decimal separation(const Plane& a, const Sphere& b) { return separation(b, a); }
+
+inline decimal separation(const AABB& a, const Sphere& b) { return separation(b, a); }
+
+inline decimal separation(const Plane& a, const AABB& b) { return separation(b, a); }
+
 } // namespace BroadCollision
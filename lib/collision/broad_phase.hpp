@@ -0,0 +1,201 @@
+/**
+ * @file broad_phase.hpp
+ * @brief Pluggable broad-phase stage producing candidate collision pairs for the narrow phase.
+ *
+ * A broad phase receives the object array of the PhysicsWorld and emits the list of index pairs that may be
+ * colliding. Each pair is then handed to the narrow phase (`Object::computeCollision`, which dispatches to
+ * `NarrowCollision::computeContact`).
+ *
+ * Pair lists are always sorted by (first, second) with `first < second`, so every algorithm feeds the
+ * collision response in the same order as the reference `i < j` loop.
+ */
+#pragma once
+
+#include "collision/pair_cache.hpp"
+#include "objects/body_storage.hpp"
+#include "objects/object.hpp"
+#include "utilities/thread_pool.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+/// @name Broad-phase algorithms
+// ============================================================================
+/// @{
+enum class BroadPhaseType : std::uint8_t
+{
+    BruteForce,
+    SweepAndPrune,
+    UniformGrid,
+    BVH,
+    Auto,
+    Unknown
+};
+
+inline std::ostream& operator<<(std::ostream& os, BroadPhaseType type) noexcept
+{
+    switch (type)
+    {
+    case BroadPhaseType::BruteForce:
+        return os << "BruteForce";
+    case BroadPhaseType::SweepAndPrune:
+        return os << "SweepAndPrune";
+    case BroadPhaseType::UniformGrid:
+        return os << "UniformGrid";
+    case BroadPhaseType::BVH:
+        return os << "BVH";
+    case BroadPhaseType::Auto:
+        return os << "Auto";
+    case BroadPhaseType::Unknown:
+        return os << "Unknown";
+    }
+    // Defensive fallback (shouldn't normally be reached)
+    return os << "BroadPhaseType(<invalid>)";
+}
+
+/// Parse a broad-phase name as written in config.yaml ("BruteForce", "SweepAndPrune", "UniformGrid", "BVH",
+/// "Auto").
+BroadPhaseType parseBroadPhase(const std::string& name);
+/// @}
+
+/**
+ * @brief Candidate pair of objects, stored as indices in the PhysicsWorld object array.
+ *
+ * `first < second` always holds.
+ */
+struct CollisionPair
+{
+    std::size_t first;
+    std::size_t second;
+
+    bool operator==(const CollisionPair& other) const = default;
+    bool operator<(const CollisionPair& other) const
+    {
+        return first < other.first || (first == other.first && second < other.second);
+    }
+};
+
+/**
+ * @brief Interface of a broad-phase algorithm.
+ *
+ * Implementations may keep state between two calls to `computePairs` (sorted lists, trees, ...) and rely on
+ * frame-to-frame coherence. `reset()` must be called whenever objects are added or removed, since it
+ * invalidates the object indices.
+ */
+struct BroadPhase
+{
+protected:
+    ThreadPool*                             pool      = nullptr;
+    const std::vector<std::uint8_t>*        bodyFlags = nullptr; // BodyStorage flags of the objects
+    std::vector<std::uint8_t>               colliding;  // result of checkCollision per candidate
+    std::vector<std::vector<CollisionPair>> chunkPairs; // pairs found by each chunk of a parallel search
+
+    bool isSleeping(std::size_t i) const
+    {
+        return bodyFlags && ((*bodyFlags)[i] & BodyStorage::flagSleeping) != 0;
+    }
+    /// Neither object can move: one sleeps, the other sleeps or is fixed. Such pairs are not reported.
+    bool isSleepingPair(std::size_t i, std::size_t j) const
+    {
+        if (!bodyFlags)
+            return false;
+        constexpr std::uint8_t still = BodyStorage::flagSleeping | BodyStorage::flagFixed;
+        const std::uint8_t     a     = (*bodyFlags)[i];
+        const std::uint8_t     b     = (*bodyFlags)[j];
+        return ((a | b) & BodyStorage::flagSleeping) != 0 && (a & still) != 0 && (b & still) != 0;
+    }
+
+    /// Append to `pairs`, in order, the candidates passing `Object::checkCollision`, tested on the pool.
+    void appendColliding(const std::vector<Object*>& objects, const std::vector<CollisionPair>& candidates,
+                         std::vector<CollisionPair>& pairs);
+    /**
+     * @brief Run `search(first, last, out)` over chunks of `[0, count)` and append the outputs in chunk
+     * order, so the pair list does not depend on the number of threads.
+     */
+    template <typename Search>
+    void collectPairs(std::size_t count, std::size_t minGrain, std::vector<CollisionPair>& pairs,
+                      Search&& search)
+    {
+        if (!pool || pool->getThreadCount() == 1)
+        {
+            search(std::size_t { 0 }, count, pairs);
+            return;
+        }
+        const std::size_t grain = pool->grainFor(count, minGrain);
+        chunkPairs.resize(ThreadPool::chunkCount(0, count, grain));
+        pool->parallelFor(0, count, grain,
+                          [&](std::size_t first, std::size_t last)
+                          {
+                              std::vector<CollisionPair>& out = chunkPairs[first / grain];
+                              out.clear();
+                              search(first, last, out);
+                          });
+        for (const std::vector<CollisionPair>& out : chunkPairs)
+            pairs.insert(pairs.end(), out.begin(), out.end());
+    }
+
+public:
+    virtual ~BroadPhase() = default;
+
+    virtual BroadPhaseType getType() const = 0;
+    /// Drop all internal state; the next `computePairs` call rebuilds from scratch.
+    virtual void reset() = 0;
+    /**
+     * @brief Update internal structures and write the candidate pairs.
+     *
+     * @param objects Object array of the world (null entries are ignored).
+     * @param pairs Output list, cleared then filled with sorted candidate pairs.
+     */
+    virtual void computePairs(const std::vector<Object*>& objects, std::vector<CollisionPair>& pairs) = 0;
+    /// Search the pairs on `threadPool` (null: calling thread only). The pair list is the same either way.
+    virtual void setThreadPool(ThreadPool* threadPool) { pool = threadPool; }
+    /**
+     * @brief Read the sleep state of the objects from `flags`, indexed like the object array (null: every
+     * object is awake).
+     *
+     * Sleeping objects do not move: their boxes are not updated, and pairs in which neither object can move
+     * are left out.
+     */
+    virtual void setBodyFlags(const std::vector<std::uint8_t>* flags) { bodyFlags = flags; }
+    /// Print algorithm-specific statistics (indented, one item per line). Nothing by default.
+    virtual void printStats(std::ostream& os) const { static_cast<void>(os); }
+};
+
+/**
+ * @brief Reference broad phase: the historical `i < j` loop over all pairs.
+ *
+ * Every pair is tested with the virtual `Object::checkCollision`. O(N²), kept for validation. With caching,
+ * pairs found apart are kept in a PairCache and not tested again until their objects moved enough to meet;
+ * without, every pair is tested at each call.
+ */
+struct BruteForceBroadPhase : public BroadPhase
+{
+private:
+    PairCache pairCache;
+    bool      caching = true;
+
+public:
+    BruteForceBroadPhase() = default;
+    /// @param _caching Skip the pairs known apart (false: plain `i < j` loop).
+    explicit BruteForceBroadPhase(bool _caching)
+        : caching(_caching)
+    {}
+
+    BroadPhaseType   getType() const override { return BroadPhaseType::BruteForce; }
+    const PairCache& getPairCache() const { return pairCache; }
+    void             reset() override { pairCache.clear(); }
+    void             computePairs(const std::vector<Object*>& objects,
+                                  std::vector<CollisionPair>& pairs) override;
+    void             printStats(std::ostream& os) const override;
+};
+
+/**
+ * @brief Build a broad phase of the given type. `Unknown` falls back to the brute-force reference.
+ *
+ * Algorithm parameters (grid cell size, pair caching, ...) are read from the Config singleton.
+ */
+std::unique_ptr<BroadPhase> makeBroadPhase(BroadPhaseType type);
@@ -0,0 +1,114 @@
+/**
+ * @file broad_phase_manager.hpp
+ * @brief Broad phase choosing at runtime between the other broad-phase algorithms.
+ *
+ * Every K steps the manager samples the scene (object count, spread of the object sizes, fraction of fixed
+ * bodies, cost of one pair test) and the measured time of the algorithms already used, then picks the most
+ * suitable algorithm:
+ *  - BruteForce for tiny scenes, or when testing every pair is cheaper than the best measured spatial phase;
+ *  - BVH for very uneven sizes or mostly fixed scenes;
+ *  - UniformGrid for many objects of similar size;
+ *  - SweepAndPrune otherwise.
+ *
+ * A switch is cancelled when the new algorithm was already measured slower than the active one. Every
+ * algorithm instance is kept alive, so switching back reuses its sorted lists or tree.
+ */
+#pragma once
+
+#include "collision/broad_phase.hpp"
+
+#include <array>
+#include <memory>
+#include <string>
+
+/// Scene statistics sampled by the BroadPhaseManager.
+struct BroadPhaseStats
+{
+    std::size_t objectCount     = 0;
+    decimal     sizeVariation   = 0_d; // coefficient of variation of the bounding box sizes (planes excluded)
+    decimal     fixedFraction   = 0_d;
+    decimal     pairTestCost    = 0_d; // ns per box + checkCollision test
+    decimal     spatialStepCost = 0_d; // ns per step of the fastest measured spatial phase, 0 if none
+};
+
+/**
+ * @class BroadPhaseManager
+ * @brief Auto-selecting broad phase.
+ */
+struct BroadPhaseManager : public BroadPhase
+{
+private:
+    static constexpr std::size_t algorithmCount = 4; // BruteForce, SweepAndPrune, UniformGrid, BVH
+
+    std::array<std::unique_ptr<BroadPhase>, algorithmCount> algorithms;
+    std::array<decimal, algorithmCount>                     timings {}; // averaged ns per step, 0 if unused
+    BroadPhaseType                                          active         = BroadPhaseType::SweepAndPrune;
+    BroadPhaseStats                                         stats;
+    std::string                                             decision       = "not sampled yet";
+    std::size_t                                             sampleInterval = 60;
+    std::size_t                                             stepCount      = 0;
+    std::size_t                                             switchCount    = 0;
+    bool                                                    warmingUp      = true; // next step rebuilds
+
+    BroadPhase& getAlgorithm(BroadPhaseType type);
+    void        sample(const std::vector<Object*>& objects);
+
+public:
+    /// Below this count every pair is tested.
+    static constexpr std::size_t bruteForceMaxCount = 32;
+    /// From this count, scenes of similar sizes use the uniform grid.
+    static constexpr std::size_t gridMinCount = 512;
+    /// Size coefficient of variation above which the BVH is used.
+    static constexpr decimal unevenSizeVariation = 1_d;
+    /// Fraction of fixed bodies above which the BVH is used.
+    static constexpr decimal mostlyFixedFraction = 0.5_d;
+    /// A switch is cancelled if the target was measured this much slower than the active algorithm.
+    static constexpr decimal switchTolerance = 1.1_d;
+
+    // ============================================================================
+    /// @name Constructors
+    // ============================================================================
+    /// @{
+    BroadPhaseManager() = default;
+    /// @param _sampleInterval Number of steps between two samplings (K).
+    explicit BroadPhaseManager(std::size_t _sampleInterval)
+        : sampleInterval(_sampleInterval > 0 ? _sampleInterval : 1)
+    {}
+    /// @}
+
+    // ============================================================================
+    /// @name Getters / Setters
+    // ============================================================================
+    /// @{
+    BroadPhaseType         getType() const override { return BroadPhaseType::Auto; }
+    BroadPhaseType         getActiveType() const { return active; }
+    const BroadPhaseStats& getStats() const { return stats; }
+    /// Human-readable reason of the last decision.
+    const std::string& getDecision() const { return decision; }
+    std::size_t        getSwitchCount() const { return switchCount; }
+    std::size_t        getSampleInterval() const { return sampleInterval; }
+    /// Averaged time of one step of an algorithm, in ns (0 if never used since the last reset).
+    decimal getTiming(BroadPhaseType type) const;
+    void    setSampleInterval(std::size_t interval) { sampleInterval = interval > 0 ? interval : 1; }
+    /// @}
+
+    // ============================================================================
+    /// @name Broad phase
+    // ============================================================================
+    /// @{
+    void reset() override;
+    void computePairs(const std::vector<Object*>& objects, std::vector<CollisionPair>& pairs) override;
+    /// Shared by every algorithm, including the ones built later.
+    void setThreadPool(ThreadPool* threadPool) override;
+    void setBodyFlags(const std::vector<std::uint8_t>* flags) override;
+    void printStats(std::ostream& os) const override;
+    /// @}
+
+    /**
+     * @brief Decision rule applied at each sampling.
+     *
+     * @param stats Sampled statistics.
+     * @param reason If not null, receives a short explanation of the choice.
+     */
+    static BroadPhaseType choose(const BroadPhaseStats& stats, std::string* reason = nullptr);
+};
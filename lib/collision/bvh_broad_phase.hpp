@@ -0,0 +1,67 @@
+/**
+ * @file bvh_broad_phase.hpp
+ * @brief Broad phase backed by a dynamic AABB tree, robust to very uneven object sizes.
+ *
+ * Every object owns a leaf with a fattened box. Slow objects stay inside their fat box for many steps and
+ * cost nothing to maintain; the others are reinserted. Candidate pairs are found with one tree query per
+ * object, O(N log N) overall.
+ */
+#pragma once
+
+#include "collision/broad_phase.hpp"
+#include "collision/dynamic_aabb_tree.hpp"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class BVHBroadPhase
+ * @brief Broad phase querying a DynamicAABBTree holding one leaf per object.
+ */
+struct BVHBroadPhase : public BroadPhase
+{
+private:
+    DynamicAABBTree           tree;
+    std::vector<std::int32_t> proxies; // leaf of each object, nullNode for null entries
+    std::vector<BoundingBox>  boxes;   // tight boxes of the current step
+    std::size_t               proxyCount    = 0;
+    std::size_t               reinsertCount = 0;
+    bool                      built         = false;
+
+    void rebuild(const std::vector<Object*>& objects);
+
+public:
+    // ============================================================================
+    /// @name Getters / Setters
+    // ============================================================================
+    /// @{
+    BroadPhaseType         getType() const override { return BroadPhaseType::BVH; }
+    const DynamicAABBTree& getTree() const { return tree; }
+    /// Number of leaves reinserted during the last step (objects that left their fat box).
+    std::size_t getReinsertCount() const { return reinsertCount; }
+    /// Fattening distance of the leaves; takes effect at the next rebuild.
+    void setMargin(decimal margin)
+    {
+        tree.setMargin(margin);
+        built = false;
+    }
+    /// @}
+
+    // ============================================================================
+    /// @name Broad phase
+    // ============================================================================
+    /// @{
+    void reset() override { built = false; }
+    void computePairs(const std::vector<Object*>& objects, std::vector<CollisionPair>& pairs) override;
+    /// @}
+
+    // ============================================================================
+    /// @name Queries
+    // ============================================================================
+    /// @{
+    /// Box enclosing every object, as of the last `computePairs` call.
+    BoundingBox getWorldBounds() const { return tree.getWorldBounds(); }
+    /// Indices of the objects whose box overlaps `region`, as of the last `computePairs` call.
+    void queryRegion(const BoundingBox& region, std::vector<std::size_t>& result) const;
+    /// @}
+};
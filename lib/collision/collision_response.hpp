@@ -41,6 +41,8 @@ void positionCorrection(Object& A, Object& B, Contact& contact, decimal percent
  * @param B Second object involved in the collision.
  * @param contact Contact information including normal and penetration depth.
  * @param restitution Coefficient of restitution [0, 1], where 0 = perfectly inelastic,
- *                    1 = perfectly elastic (default 0.5).
+ *                    1 = perfectly elastic.
  */
+void reboundCollision(Object& A, Object& B, Contact& contact, decimal restitution);
+/// Rebound with the smaller restitution of the materials of the two objects.
 void reboundCollision(Object& A, Object& B, Contact& contact);
@@ -0,0 +1,73 @@
+/**
+ * @file contact_islands.hpp
+ * @brief Split the contact graph of a step into independent islands.
+ *
+ * Bodies are the nodes of the graph and contact pairs its edges. Fixed bodies (ground planes, walls, ...)
+ * are never moved by a collision response, so they do not connect the bodies touching them: two piles
+ * resting on the same plane form two islands. Islands share no dynamic body, so they can be solved in any
+ * order, or concurrently, with the same result.
+ */
+#pragma once
+
+#include "collision/broad_phase.hpp"
+#include "objects/body_storage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @class ContactIslands
+ * @brief Union-find over the dynamic bodies, rebuilt every step from the contact pairs.
+ */
+struct ContactIslands
+{
+private:
+    std::vector<std::uint32_t> parent;      // union-find forest over the body slots
+    std::vector<std::uint32_t> treeSize;    // size of each tree, used to attach the smaller one
+    std::vector<std::uint32_t> islandIndex; // island of each root slot, `none` if not numbered yet
+    std::vector<std::uint32_t> pairIsland;  // island of each pair, `none` if it is not a contact
+    std::vector<std::size_t>   islandStart; // offsets of each island in `islandPairs`
+    std::vector<std::size_t>   islandPairs; // pair indices grouped by island, in pair order
+    std::vector<std::size_t>   cursor;      // next free offset of each island during the bucketing
+    std::vector<std::uint32_t> bodyIsland;  // island of each slot, `none` for bodies in no contact
+
+    std::uint32_t find(std::uint32_t slot);
+    void          unite(std::uint32_t a, std::uint32_t b);
+
+public:
+    static constexpr std::uint32_t none = static_cast<std::uint32_t>(-1);
+
+    // ============================================================================
+    /// @name Getters
+    // ============================================================================
+    /// @{
+    std::size_t size() const { return islandStart.empty() ? 0 : islandStart.size() - 1; }
+    /// Pair indices of an island, in increasing order.
+    std::span<const std::size_t> getPairs(std::size_t island) const
+    {
+        return { islandPairs.data() + islandStart[island], islandStart[island + 1] - islandStart[island] };
+    }
+    /// Island of a dynamic body, `none` if it is in no contact (or not dynamic).
+    std::uint32_t getBodyIsland(std::size_t slot) const { return bodyIsland[slot]; }
+    /// @}
+
+    // ============================================================================
+    /// @name Construction
+    // ============================================================================
+    /// @{
+    /**
+     * @brief Build the islands of a step.
+     *
+     * @param bodies Body storage of the world (pair indices are its slots).
+     * @param pairs Candidate pairs of the broad phase.
+     * @param isEdge If not null, only pairs `k` with `isEdge[k] != 0` are contacts; otherwise every pair is.
+     *
+     * Islands are numbered in the order of their first pair. Pairs between two non-dynamic bodies belong
+     * to no island.
+     */
+    void build(const BodyStorage& bodies, const std::vector<CollisionPair>& pairs,
+               const std::uint8_t* isEdge = nullptr);
+    /// @}
+};
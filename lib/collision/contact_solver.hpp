@@ -0,0 +1,163 @@
+/**
+ * @file contact_solver.hpp
+ * @brief Iterative sequential-impulse solver for the contacts of a step.
+ *
+ * Instead of a single rebound impulse per contact, every contact of an island is visited several times, and
+ * the impulse it has applied so far is accumulated and clamped (non-negative along the normal, inside the
+ * friction cone along the tangent). Neighbouring contacts of a stack thus converge towards impulses that
+ * satisfy all of them at once.
+ *
+ * Accumulated impulses are cached per persistent contact, keyed by the ids of the two objects, and applied
+ * again at the start of the next step (warm starting): a resting stack starts from last step's solution and
+ * a few iterations are enough. The cache is a sorted array, double-buffered between steps, and the
+ * constraints of a step live in the frame arena: a steady-state solve does not allocate.
+ */
+#pragma once
+
+#include "collision/broad_phase.hpp"
+#include "collision/contact.hpp"
+#include "collision/contact_islands.hpp"
+#include "objects/body_storage.hpp"
+#include "utilities/frame_arena.hpp"
+#include "utilities/thread_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+// ============================================================================
+/// @name Contact solvers
+// ============================================================================
+/// @{
+enum class ContactSolverType : std::uint8_t
+{
+    Rebound,
+    SequentialImpulse,
+    Unknown
+};
+
+inline std::ostream& operator<<(std::ostream& os, ContactSolverType type) noexcept
+{
+    switch (type)
+    {
+    case ContactSolverType::Rebound:
+        return os << "Rebound";
+    case ContactSolverType::SequentialImpulse:
+        return os << "SequentialImpulse";
+    case ContactSolverType::Unknown:
+        return os << "Unknown";
+    }
+    return os << "ContactSolverType(<invalid>)";
+}
+
+/// Parse a contact solver name as written in config.yaml ("Rebound", "SequentialImpulse").
+ContactSolverType parseContactSolver(const std::string& name);
+/// @}
+
+/**
+ * @class ContactSolver
+ * @brief Sequential impulses with accumulated, warm-started impulses, solved island by island.
+ */
+struct ContactSolver
+{
+private:
+    /// Contact between the bodies of slots `a` and `b`, with `normal` pointing from `b` to `a`.
+    struct Constraint
+    {
+        std::uint32_t a;
+        std::uint32_t b;
+        Vector3D      normal;
+        Vector3D      tangentImpulse; // accumulated friction impulse
+        decimal       normalImpulse;  // accumulated normal impulse, >= 0
+        decimal       invMassA;
+        decimal       invMassB;
+        decimal       normalMass;   // 1 / (invMassA + invMassB)
+        decimal       friction;     // friction coefficient of the pair
+        decimal       bounce;       // normal velocity required by restitution
+        decimal       penetration;  // penetration at the start of the step
+        decimal       separation;   // (posA - posB) . normal at the start of the step
+        std::uint64_t key;          // ids of the objects
+        bool          flipped;      // the object of slot `a` has the larger id
+    };
+    /// Impulses kept between two steps, oriented from the object of smaller id to the other one.
+    struct CachedImpulse
+    {
+        std::uint64_t key;
+        decimal       normal;
+        Vector3D      tangent;
+    };
+
+    std::size_t velocityIterations = 10;
+    std::size_t positionIterations = 3;
+    decimal     correctionRate     = 0.8_d;  // fraction of the penetration removed per position iteration
+    decimal     slop               = 0.01_d; // penetration left uncorrected, keeps resting contacts touching
+
+    // Frame memory of the step being solved
+    std::span<Constraint>    constraints;
+    std::span<std::uint32_t> pairConstraint; // constraint of each pair, or `none`
+    std::span<std::uint8_t>  isConstraint;   // island edges
+    std::span<std::uint8_t>  inContact;      // bodies with a constraint
+
+    std::vector<CachedImpulse> cache; // sorted by key
+    std::vector<CachedImpulse> nextCache;
+
+    static constexpr std::uint32_t none = static_cast<std::uint32_t>(-1);
+
+    void buildConstraints(const BodyStorage& bodies, const std::vector<CollisionPair>& pairs,
+                          std::span<const Contact> contacts, std::span<const std::uint8_t> found,
+                          decimal restingSpeed, FrameArena& frame);
+    void warmStart(BodyStorage& bodies, const Constraint& c) const;
+    void solveVelocity(BodyStorage& bodies, Constraint& c) const;
+    void solvePosition(BodyStorage& bodies, const Constraint& c) const;
+    void kick(BodyStorage& bodies, const Vector3D& velocityStep) const;
+    void storeImpulses();
+
+public:
+    // ============================================================================
+    /// @name Getters / Setters
+    // ============================================================================
+    /// @{
+    std::size_t getVelocityIterations() const { return velocityIterations; }
+    std::size_t getPositionIterations() const { return positionIterations; }
+    /// Number of contacts whose impulses are kept for the next step.
+    std::size_t getCachedContactCount() const { return cache.size(); }
+    /// Iterations over the contacts of an island: more is more accurate, fewer is faster.
+    void setIterations(std::size_t velocity, std::size_t position)
+    {
+        velocityIterations = velocity;
+        positionIterations = position;
+    }
+    /// Forget the cached impulses, e.g. after the bodies changed.
+    void clearCache() { cache.clear(); }
+    /// @}
+
+    // ============================================================================
+    /// @name Solving
+    // ============================================================================
+    /// @{
+    /**
+     * @brief Solve the contacts of a step.
+     *
+     * @param bodies Body storage of the world; velocities and positions of the dynamic bodies are updated.
+     * @param pairs Candidate pairs of the broad phase.
+     * @param contacts Narrow-phase contact of each pair.
+     * @param found Non-zero for the pairs actually in contact.
+     * @param islands Rebuilt over the contacts; islands are solved concurrently on `pool`.
+     * @param pool Threads of the world.
+     * @param frame Frame arena of the step, holding the constraints.
+     * @param gravityStep Velocity gravity adds over the next step.
+     * @param restingSpeed Approach speed below which contacts do not bounce.
+     *
+     * The constraints are solved on the velocities the bodies will have after the gravity kick of the next
+     * step, so that resting contacts do not sink by g * dt² every step. Each island is solved in pair order
+     * whatever the number of threads, so results do not depend on it.
+     */
+    void solve(BodyStorage& bodies, const std::vector<CollisionPair>& pairs,
+               std::span<const Contact> contacts, std::span<const std::uint8_t> found,
+               ContactIslands& islands, ThreadPool& pool, FrameArena& frame, const Vector3D& gravityStep,
+               decimal restingSpeed);
+    /// @}
+};
@@ -0,0 +1,57 @@
+/**
+ * @file continuous_collision.hpp
+ * @brief Time of impact of a sphere swept along a straight motion, against the other shapes.
+ *
+ * The discrete narrow phase only sees the end positions of a step: a sphere moving farther than its radius
+ * in one step can pass through a plane, a thin box or another sphere without any contact being found. The
+ * functions below sweep a sphere along its relative motion over the step and return the fraction of the
+ * motion at which it first touches the other shape, so that the step can stop it there (see
+ * PhysicsWorld::advanceToImpacts).
+ *
+ * The other shape is taken at its start position and the motion is relative to it: for two moving bodies,
+ * pass the difference of their displacements. Shapes touching at the start are left to the narrow phase.
+ *
+ * `approachTime` bounds from below the time before two shapes in ballistic flight can touch, so that free
+ * flights can be skipped in one jump (see PhysicsWorld::fastForward).
+ */
+
+#pragma once
+
+#include "collision/narrow_collision.hpp"
+
+namespace ContinuousCollision {
+
+// ============================================================================
+/// @name Times of impact
+// ============================================================================
+/// @{
+/**
+ * @brief First contact of `sphere` moved by `motion` with the other shape.
+ *
+ * @param fraction Set to the fraction of `motion`, in [0, 1], at which the shapes first touch.
+ * @return true if the shapes are apart at the start and touch before the end of the motion.
+ */
+bool timeOfImpact(const NarrowCollision::SphereShape& sphere, const Vector3D& motion,
+                  const NarrowCollision::SphereShape& other, decimal& fraction);
+bool timeOfImpact(const NarrowCollision::SphereShape& sphere, const Vector3D& motion,
+                  const NarrowCollision::PlaneShape& plane, decimal& fraction);
+bool timeOfImpact(const NarrowCollision::SphereShape& sphere, const Vector3D& motion,
+                  const NarrowCollision::BoxShape& aabb, decimal& fraction);
+/// @}
+
+// ============================================================================
+/// @name Ballistic approach
+// ============================================================================
+/// @{
+/**
+ * @brief First time at which `speed·t + acceleration·t²/2` reaches `gap`.
+ *
+ * With `gap` a separation of two shapes (see NarrowCollision::separation), and `speed` and `acceleration`
+ * bounds on the rates at which they close it, the shapes cannot touch before that time.
+ *
+ * @return The smallest positive root, 0 if `gap` is not positive, infinity if the gap is never closed.
+ */
+decimal approachTime(decimal gap, decimal speed, decimal acceleration);
+/// @}
+
+} // namespace ContinuousCollision
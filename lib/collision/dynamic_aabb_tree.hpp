@@ -0,0 +1,140 @@
+/**
+ * @file dynamic_aabb_tree.hpp
+ * @brief Dynamic bounding volume hierarchy of axis-aligned boxes.
+ *
+ * Each leaf stores a fattened box around a user item. Moving an item only touches the tree when its box
+ * leaves the fat box: the leaf is then removed and reinserted, choosing the sibling with the surface area
+ * heuristic. The tree is kept balanced with AVL-like rotations, so its height stays in O(log N).
+ *
+ * The tree does not know about Objects: it can be reused for any spatial query on boxes (broad phase,
+ * picking, region queries, ...).
+ */
+#pragma once
+
+#include "collision/bounding_box.hpp"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class DynamicAABBTree
+ * @brief Balanced binary tree of fattened boxes supporting insertion, removal, update and box queries.
+ */
+struct DynamicAABBTree
+{
+private:
+    struct Node
+    {
+        BoundingBox   box;
+        std::int32_t  parent   = nullNode; // next free node when the node is unused
+        std::int32_t  child1   = nullNode;
+        std::int32_t  child2   = nullNode;
+        std::int32_t  height   = -1; // 0 for leaves, -1 for free nodes
+        std::uint32_t userData = 0;
+
+        bool isLeaf() const { return child1 == nullNode; }
+    };
+
+    std::vector<Node> nodes;
+    std::int32_t      root      = nullNode;
+    std::int32_t      freeList  = nullNode;
+    std::size_t       leafCount = 0;
+    decimal           margin    = 0.05_d;
+
+    Node&        node(std::int32_t index) { return nodes[static_cast<std::size_t>(index)]; }
+    const Node&  node(std::int32_t index) const { return nodes[static_cast<std::size_t>(index)]; }
+    std::int32_t allocateNode();
+    void         freeNode(std::int32_t node);
+    void         insertLeaf(std::int32_t leaf);
+    void         removeLeaf(std::int32_t leaf);
+    void         refitAncestors(std::int32_t node);
+    std::int32_t balance(std::int32_t node);
+
+public:
+    static constexpr std::int32_t nullNode = -1;
+
+    // ============================================================================
+    /// @name Getters / Setters
+    // ============================================================================
+    /// @{
+    /// Box enclosing every item of the tree (empty box if the tree is empty).
+    BoundingBox getWorldBounds() const { return root == nullNode ? BoundingBox() : node(root).box; }
+    /// Fat box stored in the leaf of a proxy.
+    const BoundingBox& getFatBox(std::int32_t proxy) const { return node(proxy).box; }
+    std::uint32_t      getUserData(std::int32_t proxy) const { return node(proxy).userData; }
+    /// Height of the tree (0 for a single leaf, -1 when empty).
+    std::int32_t getHeight() const { return root == nullNode ? -1 : node(root).height; }
+    std::size_t  getProxyCount() const { return leafCount; }
+    decimal      getMargin() const { return margin; }
+    /// Distance added on every side of the boxes of new or reinserted leaves.
+    void setMargin(decimal m) { margin = m; }
+    /// @}
+
+    // ============================================================================
+    /// @name Proxies
+    // ============================================================================
+    /// @{
+    /// Insert an item with its tight box and return its proxy id.
+    std::int32_t createProxy(const BoundingBox& box, std::uint32_t userData);
+    void         destroyProxy(std::int32_t proxy);
+    /**
+     * @brief Update the box of a proxy.
+     *
+     * @return true if the box left the fat box and the leaf was reinserted, false if the tree is unchanged.
+     */
+    bool moveProxy(std::int32_t proxy, const BoundingBox& box);
+    /// Remove every proxy, keeping the allocated memory.
+    void clear();
+    /// @}
+
+    // ============================================================================
+    /// @name Queries
+    // ============================================================================
+    /// @{
+    /**
+     * @brief Call `callback(userData)` for every leaf whose fat box overlaps `box`.
+     *
+     * The traversal stops early if the callback returns false. Concurrent queries are safe: the traversal
+     * stack belongs to the calling thread (kept between calls to avoid allocations).
+     */
+    template <typename Callback>
+    void query(const BoundingBox& box, Callback&& callback) const
+    {
+        if (root == nullNode)
+            return;
+
+        thread_local std::vector<std::int32_t> stack;
+        stack.clear();
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            const Node& current = node(stack.back());
+            stack.pop_back();
+
+            if (!current.box.overlaps(box))
+                continue;
+
+            if (current.isLeaf())
+            {
+                if (!callback(current.userData))
+                    return;
+            }
+            else
+            {
+                stack.push_back(current.child1);
+                stack.push_back(current.child2);
+            }
+        }
+    }
+    /// Append the user data of every leaf overlapping `box` to `result`.
+    void query(const BoundingBox& box, std::vector<std::uint32_t>& result) const
+    {
+        query(box,
+              [&result](std::uint32_t userData)
+              {
+                  result.push_back(userData);
+                  return true;
+              });
+    }
+    /// @}
+};
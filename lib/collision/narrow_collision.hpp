@@ -5,6 +5,9 @@
  * Provides accurate and expensive computations to test collision between objects, and if so, to compute
  * collision properties : contact point position, penetration lenght and normal vector.
  *
+ * The computations work on shape parameters (SphereShape, BoxShape, PlaneShape), so that the batch narrow
+ * phase can run them over parameters gathered in contiguous arrays (see NarrowPhase). The overloads taking
+ * objects gather the parameters of the two objects and also fill `contact.A` and `contact.B`.
  */
 
 #pragma once
@@ -16,6 +19,69 @@
 
 namespace NarrowCollision {
 
+// ============================================================================
+/// @name Shape parameters
+// ============================================================================
+/// @{
+struct SphereShape
+{
+    Vector3D center;
+    decimal  radius;
+};
+struct BoxShape
+{
+    Vector3D center;
+    Vector3D halfExtents;
+};
+struct PlaneShape
+{
+    Vector3D center;
+    Vector3D normal;
+    Vector3D u;
+    Vector3D v;
+    decimal  halfWidth;
+    decimal  halfHeight;
+};
+
+inline SphereShape shapeOf(const Sphere& s) { return { s.getCenter(), s.getRadius() }; }
+inline BoxShape    shapeOf(const AABB& a) { return { a.getPosition(), a.getHalfExtents() }; }
+inline PlaneShape  shapeOf(const Plane& p)
+{
+    return { p.getPosition(), p.getNormal(), p.getU(), p.getV(), p.getHalfWidth(), p.getHalfHeight() };
+}
+/// @}
+
+// ============================================================================
+/// @name Shape contacts
+// ============================================================================
+/// @{
+/// Fill the geometry of `contact` (position, normal, penetration) if the shapes intersect.
+bool computeContact(const SphereShape&, const SphereShape&, Contact& contact);
+bool computeContact(const SphereShape&, const PlaneShape&, Contact& contact);
+bool computeContact(const SphereShape&, const BoxShape&, Contact& contact);
+bool computeContact(const BoxShape&, const BoxShape&, Contact& contact);
+bool computeContact(const BoxShape&, const PlaneShape&, Contact& contact);
+bool computeContact(const PlaneShape&, const PlaneShape&, Contact& contact);
+/// @}
+
+// ============================================================================
+/// @name Shape separations
+// ============================================================================
+/// @{
+/// Lower bound on the distance the shapes must move relative to each other before `computeContact` can find
+/// a contact, non-positive if it may already. Two planes are never known apart.
+decimal separation(const SphereShape&, const SphereShape&);
+decimal separation(const SphereShape&, const PlaneShape&);
+decimal separation(const SphereShape&, const BoxShape&);
+decimal separation(const BoxShape&, const BoxShape&);
+decimal separation(const BoxShape&, const PlaneShape&);
+inline decimal separation(const PlaneShape&, const PlaneShape&) { return 0_d; }
+
+inline decimal separation(const PlaneShape& a, const SphereShape& b) { return separation(b, a); }
+inline decimal separation(const BoxShape& a, const SphereShape& b) { return separation(b, a); }
+inline decimal separation(const PlaneShape& a, const BoxShape& b) { return separation(b, a); }
+/// @}
+
 // Sphere vs Sphere
 bool computeContact(const Sphere&, const Sphere&, Contact& contact);
 
@@ -0,0 +1,63 @@
+/**
+ * @file narrow_kernels.hpp
+ * @brief Vectorised early-out tests of the sphere narrow phase.
+ *
+ * Most candidate pairs of a sphere-heavy scene are not in contact, and NarrowCollision rejects them with a
+ * few cheap tests before computing anything else. These kernels run those tests on `simd::width` pairs at
+ * a time (see simd.hpp), over shape parameters stored as component arrays, and flag the pairs they cannot
+ * reject: only flagged pairs then go through the full contact computation.
+ *
+ * The flags are exact: the kernels perform the same operations as NarrowCollision, so a pair is flagged if
+ * and only if it passes the early-out tests of its scalar computation.
+ */
+#pragma once
+
+#include "precision.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace NarrowKernels {
+
+/// Component arrays of sphere pairs: centers and radii of the first and of the second spheres.
+struct SpherePairs
+{
+    const decimal* ax;
+    const decimal* ay;
+    const decimal* az;
+    const decimal* ar;
+    const decimal* bx;
+    const decimal* by;
+    const decimal* bz;
+    const decimal* br;
+};
+
+/// Component arrays of sphere-plane pairs: sphere center and radius, plane center, axes and half extents.
+struct SpherePlanePairs
+{
+    const decimal* cx;
+    const decimal* cy;
+    const decimal* cz;
+    const decimal* r;
+    const decimal* px;
+    const decimal* py;
+    const decimal* pz;
+    const decimal* nx;
+    const decimal* ny;
+    const decimal* nz;
+    const decimal* ux;
+    const decimal* uy;
+    const decimal* uz;
+    const decimal* vx;
+    const decimal* vy;
+    const decimal* vz;
+    const decimal* halfWidth;
+    const decimal* halfHeight;
+};
+
+/// `candidates[i]` = 1 if the spheres of pair `i` are not farther apart than their radii, 0 otherwise.
+void sphereSphere(const SpherePairs& pairs, std::size_t count, std::uint8_t* candidates);
+/// `candidates[i]` = 1 if the sphere of pair `i` reaches the plane and its rectangle padded by the radius.
+void spherePlane(const SpherePlanePairs& pairs, std::size_t count, std::uint8_t* candidates);
+
+} // namespace NarrowKernels
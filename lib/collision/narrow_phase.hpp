@@ -0,0 +1,104 @@
+/**
+ * @file narrow_phase.hpp
+ * @brief Narrow phase of a step, run over the candidate pairs grouped by shape types.
+ *
+ * Going through `Object::computeCollision` costs a virtual call and a switch on the other type for every
+ * pair. Instead, the pairs are sorted into one bucket per pair of ObjectTypes, and each bucket is run by a
+ * kernel specialised for its two shapes: the kernel gathers the shape parameters of a chunk of pairs into
+ * contiguous arrays of the frame arena, then computes the contacts of the whole chunk. The sphere–sphere
+ * and sphere–plane kernels first reject the separated pairs with the SIMD tests of NarrowKernels.
+ *
+ * Contacts are the ones `computeCollision` gives: the computations are the same, and the object of the
+ * first shape of the bucket name is `contact.A`. Pairs with other types still go through `computeCollision`.
+ *
+ * Candidate pairs that stay apart, such as objects resting above a large plane, are kept in a PairCache:
+ * they are not tested again until their objects moved enough to touch. Without caching, the kernels run on
+ * every pair.
+ */
+#pragma once
+
+#include "collision/broad_phase.hpp"
+#include "collision/contact.hpp"
+#include "collision/pair_cache.hpp"
+#include "objects/body_storage.hpp"
+#include "utilities/frame_arena.hpp"
+#include "utilities/thread_pool.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// ============================================================================
+/// @name Pair buckets
+// ============================================================================
+/// @{
+enum class PairBucket : std::uint8_t
+{
+    SphereSphere,
+    SpherePlane,
+    SphereAABB,
+    AABBAABB,
+    AABBPlane,
+    PlanePlane,
+    Other // pairs with a Generic object
+};
+
+inline constexpr std::size_t pairBucketCount = 7;
+/// @}
+
+/**
+ * @class NarrowPhase
+ * @brief Contacts of the candidate pairs, computed bucket by bucket.
+ */
+struct NarrowPhase
+{
+private:
+    std::array<std::size_t, pairBucketCount + 1> bucketStart {}; // offsets of each bucket in `order`
+    std::span<std::uint32_t>                     order;          // frame memory: pairs sorted by bucket
+    PairCache                                    pairCache;      // candidate pairs known apart
+    bool                                         caching = true;
+
+    void markSeparated(const std::vector<Object*>& objects, const std::vector<CollisionPair>& pairs,
+                       std::span<std::uint8_t> separated, ThreadPool& pool, std::size_t grain);
+
+public:
+    // ============================================================================
+    /// @name Getters / Setters
+    // ============================================================================
+    /// @{
+    /// Bucket of a pair of objects, whatever their order.
+    static PairBucket getBucket(ObjectType a, ObjectType b);
+    /// Number of pairs of `bucket` in the last `compute`.
+    std::size_t getBucketSize(PairBucket bucket) const
+    {
+        const auto b = static_cast<std::size_t>(bucket);
+        return bucketStart[b + 1] - bucketStart[b];
+    }
+    const PairCache& getPairCache() const { return pairCache; }
+    bool             getCaching() const { return caching; }
+    /// Skip the candidate pairs known apart (false: every pair goes through its kernel).
+    void setCaching(bool enabled);
+    /// @}
+
+    // ============================================================================
+    /// @name Computation
+    // ============================================================================
+    /// @{
+    /**
+     * @brief Narrow phase of every candidate pair.
+     *
+     * @param bodies Body storage of the world.
+     * @param pairs Candidate pairs of the broad phase, sorted as the broad phase emits them.
+     * @param contacts Receives the contact of each pair.
+     * @param found Receives 1 for the pairs in contact, 0 for the others.
+     * @param pool Threads of the world; chunks of the sorted pairs run concurrently.
+     * @param frame Frame arena of the step, holding the sorted pairs and the gathered shapes.
+     * @param grain Minimum number of pairs per chunk.
+     */
+    void compute(const BodyStorage& bodies, const std::vector<CollisionPair>& pairs,
+                 std::span<Contact> contacts, std::span<std::uint8_t> found, ThreadPool& pool,
+                 FrameArena& frame, std::size_t grain);
+    /// @}
+};
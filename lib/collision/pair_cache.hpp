@@ -0,0 +1,165 @@
+/**
+ * @file pair_cache.hpp
+ * @brief Separation bounds of object pairs kept between passes, to skip the tests of pairs far apart.
+ *
+ * A pair tested and found apart is cached with a lower bound on its separation: the distance its objects
+ * must move relative to each other before the test can succeed. Each pass charges every object with the
+ * distance it moved since the previous pass, and a cached pair is not tested again while the distance moved
+ * by its two objects since it was cached stays below its bound. Slowly moving scenes test each distant pair
+ * once every many steps instead of every step.
+ *
+ * Distances moved are measured on the positions, not predicted from the velocities: integrators, position
+ * corrections and teleports are all accounted for. Bounds are shrunk by a margin covering the rounding of
+ * the tests, so a skipped test is one that would have failed: results do not change. A change of the shape
+ * of an object (type, size, plane normal or extents) clears the cache.
+ *
+ * Entries are stored per row (first object of the pair), sorted by second object. A pass visits the pairs of
+ * a row in increasing order, reading the row with a merge walk and rewriting it; rows are independent, so
+ * each one can be handled by a different thread.
+ */
+#pragma once
+
+#include "objects/object.hpp"
+#include "utilities/thread_pool.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @class PairCache
+ * @brief Per-pair separation bounds, decreased by the measured motion of the objects.
+ */
+struct PairCache
+{
+private:
+    /// Pair (row, second) known apart while the travel of its two objects stays below `limit`.
+    struct Entry
+    {
+        std::uint32_t second;
+        double        limit;
+    };
+    /// Shape of an object as last seen, compared exactly.
+    struct Footprint
+    {
+        std::array<decimal, 8> shape {}; // size, then the normal and half extents of planes
+        ObjectType             type     = ObjectType::Generic;
+        bool                   occupied = false;
+
+        bool operator==(const Footprint& other) const = default;
+    };
+
+    /// Rounding of the tests, relative to the magnitude of the coordinates of the two objects.
+    static constexpr double roundingMargin = 64.0 * std::numeric_limits<decimal>::epsilon();
+    /// Rounding of the accumulated travel, relative to it.
+    static constexpr double travelMargin = 1e-9;
+
+    std::vector<std::vector<Entry>> rows;       // entries of each first object, sorted by second
+    std::vector<std::vector<Entry>> lanes;      // per thread: row being rewritten
+    std::vector<std::size_t>        skipCounts; // per thread: tests skipped during the last pass
+    std::vector<double>             travel;     // per object: distance moved since the cache was cleared
+    std::vector<double>             scale;      // per object: magnitude of its coordinates
+    std::vector<Vector3D>           positions;  // per object: position at the last update
+    std::vector<Footprint>          footprints; // per object: shape at the last update
+    const ThreadPool*               pool = nullptr;
+
+    static Footprint footprintOf(const Object& obj);
+
+public:
+    /**
+     * @class Row
+     * @brief Pass over the pairs of one first object, in increasing order of the second one.
+     *
+     * Pairs not visited are dropped from the cache; `finish` must be called once the row is done.
+     */
+    class Row
+    {
+    private:
+        PairCache&                cache;
+        std::size_t               first;
+        const std::vector<Entry>& entries;
+        std::vector<Entry>&       next;
+        std::size_t&              skipCount;
+        std::size_t               cursor = 0;
+
+    public:
+        Row(PairCache& pairCache, std::size_t firstObject, std::size_t thread)
+            : cache(pairCache)
+            , first(firstObject)
+            , entries(pairCache.rows[firstObject])
+            , next(pairCache.lanes[thread])
+            , skipCount(pairCache.skipCounts[thread])
+        {
+            next.clear();
+        }
+
+        /// True if (first, second) is still known apart: it is kept and its test can be skipped.
+        bool isSeparated(std::size_t second)
+        {
+            while (cursor < entries.size() && entries[cursor].second < second)
+                ++cursor;
+            if (cursor == entries.size() || entries[cursor].second != second)
+                return false;
+            const Entry& entry = entries[cursor++];
+            if (!(cache.travel[first] + cache.travel[second] < entry.limit))
+                return false;
+            next.push_back(entry);
+            ++skipCount;
+            return true;
+        }
+        /**
+         * @brief Cache (first, second) if `gap`, a separation of the pair computed now, is positive once
+         * shrunk by the rounding margins.
+         *
+         * @return true if the pair was cached: it is apart and its test can be skipped.
+         */
+        bool store(std::size_t second, decimal gap)
+        {
+            const double moved  = cache.travel[first] + cache.travel[second];
+            const double margin = roundingMargin * (1.0 + cache.scale[first] + cache.scale[second]) +
+                                  travelMargin * moved;
+            const double bound  = static_cast<double>(gap) - margin;
+            if (!(bound > 0.0))
+                return false;
+            next.push_back({ static_cast<std::uint32_t>(second), moved + bound });
+            return true;
+        }
+        /// Replace the entries of the row with the ones kept or stored during the pass. They are copied
+        /// rather than swapped, so that each row and each lane keeps its own capacity.
+        void finish() { cache.rows[first].assign(next.begin(), next.end()); }
+    };
+
+    // ============================================================================
+    /// @name Getters
+    // ============================================================================
+    /// @{
+    /// Number of pairs currently known apart.
+    std::size_t getEntryCount() const;
+    /// Number of tests skipped during the last pass.
+    std::size_t getSkippedCount() const;
+    /// Lower bound on the distance `a` and `b` must move before `a.checkCollision(b)` can hold.
+    static decimal getBroadSeparation(const Object& a, const Object& b);
+    /// Lower bound on the distance `a` and `b` must move before `a.computeCollision(b, ...)` can hold.
+    static decimal getNarrowSeparation(const Object& a, const Object& b);
+    /// @}
+
+    // ============================================================================
+    /// @name Passes
+    // ============================================================================
+    /// @{
+    /// Forget every pair and the distances moved.
+    void clear();
+    /**
+     * @brief Start a pass: charge every object with the distance it moved since the last one.
+     *
+     * @param objects Object array of the world (null entries are ignored); a new size or a new shape clears
+     * the cache.
+     * @param threadPool Threads that will rewrite the rows (null: calling thread only).
+     */
+    void update(const std::vector<Object*>& objects, const ThreadPool* threadPool);
+    /// Rewrite the row of `first` from the calling thread.
+    Row row(std::size_t first) { return Row(*this, first, pool ? pool->getCurrentThread() : 0); }
+    /// @}
+};
@@ -0,0 +1,66 @@
+/**
+ * @file sweep_and_prune.hpp
+ * @brief Incremental Sweep-and-Prune (sort and sweep) broad phase.
+ *
+ * The bounding boxes of all objects are projected on the three world axes as sorted lists of interval
+ * endpoints. Between two steps objects move little, so the lists are nearly sorted and are updated with an
+ * insertion sort in close to linear time. Candidate pairs are then found by sweeping the axis with the
+ * largest spread.
+ */
+#pragma once
+
+#include "collision/broad_phase.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class SweepAndPrune
+ * @brief Broad phase keeping persistent sorted interval lists along X, Y and Z.
+ */
+struct SweepAndPrune : public BroadPhase
+{
+private:
+    /// Interval bound of one object on one axis.
+    struct Endpoint
+    {
+        decimal       value;
+        std::uint32_t proxy; // index of the object in the world array
+        bool          isMin;
+    };
+
+    std::array<std::vector<Endpoint>, 3> axes;
+    std::vector<BoundingBox>             boxes;
+    std::vector<std::uint32_t>           active;     // objects whose interval is open during the sweep
+    std::vector<std::uint32_t>           activeSlot; // position of each object in `active`
+    std::vector<CollisionPair>           candidates; // overlapping boxes found by the sweep
+    std::size_t                          proxyCount = 0;
+    std::size_t                          sweepAxis  = 0;
+    decimal                              margin     = PRECISION_MACHINE;
+    bool                                 built      = false;
+
+    void        rebuild(const std::vector<Object*>& objects);
+    void        updateBoxes(const std::vector<Object*>& objects, bool skipSleeping);
+    static void insertionSort(std::vector<Endpoint>& axis);
+
+public:
+    // ============================================================================
+    /// @name Getters / Setters
+    // ============================================================================
+    /// @{
+    BroadPhaseType getType() const override { return BroadPhaseType::SweepAndPrune; }
+    std::size_t    getSweepAxis() const { return sweepAxis; }
+    decimal        getMargin() const { return margin; }
+    /// Enlarge every box by `m` so that touching contacts are never missed.
+    void setMargin(decimal m) { margin = m; }
+    /// @}
+
+    // ============================================================================
+    /// @name Broad phase
+    // ============================================================================
+    /// @{
+    void reset() override { built = false; }
+    void computePairs(const std::vector<Object*>& objects, std::vector<CollisionPair>& pairs) override;
+    /// @}
+};
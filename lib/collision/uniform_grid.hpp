@@ -0,0 +1,91 @@
+/**
+ * @file uniform_grid.hpp
+ * @brief Hashed uniform grid broad phase, suited to many objects of similar size.
+ *
+ * Space is cut into cubic cells of a fixed size. Each object is binned in the cells covered by its bounding
+ * box, and the cells are stored in a hash table rebuilt every step with a counting sort, so the cost is
+ * linear in the number of objects. Candidate pairs only come from objects sharing a cell.
+ *
+ * Planes and objects much larger than a cell would fill a huge number of cells: they are kept in a separate
+ * list and tested against every other object.
+ */
+#pragma once
+
+#include "collision/broad_phase.hpp"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class UniformGrid
+ * @brief Broad phase binning objects in a spatial hash of uniform cells.
+ */
+struct UniformGrid : public BroadPhase
+{
+private:
+    /// Integer coordinates of the cells covered by a bounding box.
+    struct CellRange
+    {
+        std::int64_t min[3];
+        std::int64_t max[3];
+    };
+
+    decimal                    configuredCellSize = 0_d; // 0: inferred from the objects
+    decimal                    cellSize           = 1_d;
+    decimal                    margin             = PRECISION_MACHINE;
+    bool                       cellSizeValid      = false;
+    std::vector<BoundingBox>   boxes;
+    std::vector<CellRange>     ranges;
+    std::vector<std::uint32_t> gridded;       // objects binned in the cells
+    std::vector<std::uint32_t> large;         // planes and oversized objects
+    std::vector<std::uint32_t> bucketStart;   // offsets of each hash bucket in `bucketEntries`
+    std::vector<std::uint32_t> bucketEntries; // object indices sorted by hash bucket
+    std::vector<std::uint32_t> bucketCursor;
+    std::vector<CollisionPair> candidates; // overlapping boxes, before the shape checks
+    std::size_t                bucketMask = 0;
+
+    decimal       inferCellSize(const std::vector<Object*>& objects) const;
+    CellRange     computeCellRange(const BoundingBox& box) const;
+    std::uint32_t hashCell(std::int64_t x, std::int64_t y, std::int64_t z) const;
+    void          buildTable();
+
+public:
+    /// Objects spanning more cells than this along one axis are moved to the large-object list.
+    static constexpr std::int64_t maxCellsPerAxis = 4;
+
+    // ============================================================================
+    /// @name Constructors
+    // ============================================================================
+    /// @{
+    UniformGrid() = default;
+    /// @param _cellSize Edge length of the cells, or 0 to infer it from the objects.
+    explicit UniformGrid(decimal _cellSize)
+        : configuredCellSize(_cellSize)
+    {}
+    /// @}
+
+    // ============================================================================
+    /// @name Getters / Setters
+    // ============================================================================
+    /// @{
+    BroadPhaseType getType() const override { return BroadPhaseType::UniformGrid; }
+    /// Cell size in use (valid once `computePairs` has been called).
+    decimal getCellSize() const { return cellSize; }
+    /// Number of objects kept out of the grid during the last step.
+    std::size_t getLargeObjectCount() const { return large.size(); }
+    /// Set the cell size; 0 infers it from the median Sphere radius at the next step.
+    void setCellSize(decimal size)
+    {
+        configuredCellSize = size;
+        cellSizeValid      = false;
+    }
+    /// @}
+
+    // ============================================================================
+    /// @name Broad phase
+    // ============================================================================
+    /// @{
+    void reset() override { cellSizeValid = false; }
+    void computePairs(const std::vector<Object*>& objects, std::vector<CollisionPair>& pairs) override;
+    /// @}
+};
@@ -0,0 +1,149 @@
+/**
+ * @file simd.hpp
+ * @brief Thin wrapper over the SIMD instruction sets available at compile time.
+ *
+ * `simd::Pack` holds `simd::width` consecutive `decimal` values:
+ *  - AVX-512: 16 floats or 8 doubles;
+ *  - AVX: 8 floats or 4 doubles;
+ *  - SSE2: 4 floats or 2 doubles;
+ *  - otherwise a single scalar, so that code written against this header always compiles.
+ *
+ * AVX and AVX-512 are only used when the compiler targets them (e.g. `-march=native`, see
+ * `3DPE_USE_NATIVE_ARCH`). Loads and stores are unaligned: the arrays come from `std::vector`.
+ *
+ * Comparisons return a `simd::Mask`, bit `i` being the result for element `i`. They are ordered: any
+ * comparison with a NaN is false, as with the scalar operators.
+ */
+#pragma once
+
+#include "precision.hpp"
+
+#include <cstddef>
+
+#if defined(__AVX512F__) || defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace simd {
+
+/// One bit per element of a Pack.
+using Mask = unsigned;
+
+#if defined(__AVX512F__) && defined(IS_DOUBLE_PRECISION)
+using Pack                         = __m512d;
+inline constexpr std::size_t width = 8;
+inline Pack load(const decimal* p) { return _mm512_loadu_pd(p); }
+inline void store(decimal* p, Pack a) { _mm512_storeu_pd(p, a); }
+inline Pack set1(decimal a) { return _mm512_set1_pd(a); }
+inline Pack add(Pack a, Pack b) { return _mm512_add_pd(a, b); }
+inline Pack mul(Pack a, Pack b) { return _mm512_mul_pd(a, b); }
+inline Pack sub(Pack a, Pack b) { return _mm512_sub_pd(a, b); }
+inline Pack abs(Pack a) { return _mm512_abs_pd(a); }
+inline Mask less(Pack a, Pack b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+inline Mask greater(Pack a, Pack b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+#elif defined(__AVX512F__)
+using Pack                         = __m512;
+inline constexpr std::size_t width = 16;
+inline Pack load(const decimal* p) { return _mm512_loadu_ps(p); }
+inline void store(decimal* p, Pack a) { _mm512_storeu_ps(p, a); }
+inline Pack set1(decimal a) { return _mm512_set1_ps(a); }
+inline Pack add(Pack a, Pack b) { return _mm512_add_ps(a, b); }
+inline Pack mul(Pack a, Pack b) { return _mm512_mul_ps(a, b); }
+inline Pack sub(Pack a, Pack b) { return _mm512_sub_ps(a, b); }
+inline Pack abs(Pack a) { return _mm512_abs_ps(a); }
+inline Mask less(Pack a, Pack b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+inline Mask greater(Pack a, Pack b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+#elif defined(__AVX__) && defined(IS_DOUBLE_PRECISION)
+using Pack                         = __m256d;
+inline constexpr std::size_t width = 4;
+inline Pack load(const decimal* p) { return _mm256_loadu_pd(p); }
+inline void store(decimal* p, Pack a) { _mm256_storeu_pd(p, a); }
+inline Pack set1(decimal a) { return _mm256_set1_pd(a); }
+inline Pack add(Pack a, Pack b) { return _mm256_add_pd(a, b); }
+inline Pack mul(Pack a, Pack b) { return _mm256_mul_pd(a, b); }
+inline Pack sub(Pack a, Pack b) { return _mm256_sub_pd(a, b); }
+inline Pack abs(Pack a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+inline Mask less(Pack a, Pack b)
+{
+    return static_cast<Mask>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ)));
+}
+inline Mask greater(Pack a, Pack b)
+{
+    return static_cast<Mask>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ)));
+}
+#elif defined(__AVX__)
+using Pack                         = __m256;
+inline constexpr std::size_t width = 8;
+inline Pack load(const decimal* p) { return _mm256_loadu_ps(p); }
+inline void store(decimal* p, Pack a) { _mm256_storeu_ps(p, a); }
+inline Pack set1(decimal a) { return _mm256_set1_ps(a); }
+inline Pack add(Pack a, Pack b) { return _mm256_add_ps(a, b); }
+inline Pack mul(Pack a, Pack b) { return _mm256_mul_ps(a, b); }
+inline Pack sub(Pack a, Pack b) { return _mm256_sub_ps(a, b); }
+inline Pack abs(Pack a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+inline Mask less(Pack a, Pack b)
+{
+    return static_cast<Mask>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)));
+}
+inline Mask greater(Pack a, Pack b)
+{
+    return static_cast<Mask>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)));
+}
+#elif defined(__SSE2__) && defined(IS_DOUBLE_PRECISION)
+using Pack                         = __m128d;
+inline constexpr std::size_t width = 2;
+inline Pack load(const decimal* p) { return _mm_loadu_pd(p); }
+inline void store(decimal* p, Pack a) { _mm_storeu_pd(p, a); }
+inline Pack set1(decimal a) { return _mm_set1_pd(a); }
+inline Pack add(Pack a, Pack b) { return _mm_add_pd(a, b); }
+inline Pack mul(Pack a, Pack b) { return _mm_mul_pd(a, b); }
+inline Pack sub(Pack a, Pack b) { return _mm_sub_pd(a, b); }
+inline Pack abs(Pack a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+inline Mask less(Pack a, Pack b) { return static_cast<Mask>(_mm_movemask_pd(_mm_cmplt_pd(a, b))); }
+inline Mask greater(Pack a, Pack b) { return static_cast<Mask>(_mm_movemask_pd(_mm_cmpgt_pd(a, b))); }
+#elif defined(__SSE2__)
+using Pack                         = __m128;
+inline constexpr std::size_t width = 4;
+inline Pack load(const decimal* p) { return _mm_loadu_ps(p); }
+inline void store(decimal* p, Pack a) { _mm_storeu_ps(p, a); }
+inline Pack set1(decimal a) { return _mm_set1_ps(a); }
+inline Pack add(Pack a, Pack b) { return _mm_add_ps(a, b); }
+inline Pack mul(Pack a, Pack b) { return _mm_mul_ps(a, b); }
+inline Pack sub(Pack a, Pack b) { return _mm_sub_ps(a, b); }
+inline Pack abs(Pack a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+inline Mask less(Pack a, Pack b) { return static_cast<Mask>(_mm_movemask_ps(_mm_cmplt_ps(a, b))); }
+inline Mask greater(Pack a, Pack b) { return static_cast<Mask>(_mm_movemask_ps(_mm_cmpgt_ps(a, b))); }
+#else
+using Pack                         = decimal;
+inline constexpr std::size_t width = 1;
+inline Pack load(const decimal* p) { return *p; }
+inline void store(decimal* p, Pack a) { *p = a; }
+inline Pack set1(decimal a) { return a; }
+inline Pack add(Pack a, Pack b) { return a + b; }
+inline Pack mul(Pack a, Pack b) { return a * b; }
+inline Pack sub(Pack a, Pack b) { return a - b; }
+inline Pack abs(Pack a) { return a < 0 ? -a : a; }
+inline Mask less(Pack a, Pack b) { return a < b ? 1u : 0u; }
+inline Mask greater(Pack a, Pack b) { return a > b ? 1u : 0u; }
+#endif
+
+/// a * b + c.
+inline Pack madd(Pack a, Pack b, Pack c) { return add(mul(a, b), c); }
+/// Mask of every element of a Pack.
+inline constexpr Mask allElements = (1u << width) - 1u;
+
+/// Name of the instruction set in use, for logs and benchmarks.
+inline const char* name()
+{
+#if defined(__AVX512F__)
+    return "AVX-512";
+#elif defined(__AVX__)
+    return "AVX";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace simd
@@ -58,6 +58,9 @@ public:
     // ============================================================================
     /// @{
 
+    /// World-space bounding box used by the broad phase.
+    BoundingBox getBoundingBox() const override;
+
     /// Check broad collision between two AABBs.
     bool checkAABBCollision(const AABB& aabb);
     /// Check broad collision between a AABB and an Sphere.
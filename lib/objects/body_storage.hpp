@@ -0,0 +1,207 @@
+/**
+ * @file body_storage.hpp
+ * @brief Structure-of-arrays storage of the bodies of a PhysicsWorld.
+ *
+ * The state read by the integrators every step (position, velocity, acceleration, inverse mass and flags) is
+ * kept in contiguous arrays, one per component, so that the integration loops stream through memory without
+ * following a pointer per body. Everything else (names, materials, sizes, ...) goes to a separate cold store.
+ *
+ * The contact properties of each body are interned in a MaterialRegistry: the contact code looks the
+ * coefficients of a pair up by the material ids of its two slots.
+ *
+ * Objects added to the storage become views on their slot: their getters and setters forward to the arrays.
+ * Removing an Object copies its state back into it, so it stays usable on its own.
+ */
+#pragma once
+
+#include "objects/material_registry.hpp"
+#include "objects/object.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Array of 3D vectors stored as one array per component.
+struct Vector3DArray
+{
+    std::vector<decimal> x;
+    std::vector<decimal> y;
+    std::vector<decimal> z;
+
+    std::size_t size() const { return x.size(); }
+    Vector3D    get(std::size_t i) const { return Vector3D(x[i], y[i], z[i]); }
+    void        set(std::size_t i, const Vector3D& v)
+    {
+        x[i] = v[0];
+        y[i] = v[1];
+        z[i] = v[2];
+    }
+    void push_back(const Vector3D& v)
+    {
+        x.push_back(v[0]);
+        y.push_back(v[1]);
+        z.push_back(v[2]);
+    }
+    void pop_back()
+    {
+        x.pop_back();
+        y.pop_back();
+        z.pop_back();
+    }
+    void clear()
+    {
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+    /// Resize to `n` vectors of value (v, v, v), reusing the current capacity.
+    void assign(std::size_t n, decimal v)
+    {
+        x.assign(n, v);
+        y.assign(n, v);
+        z.assign(n, v);
+    }
+};
+
+/**
+ * @class BodyStorage
+ * @brief Owner of the body state of a PhysicsWorld, indexed by slot.
+ *
+ * The slot of a body is its index in the world. Removing a body moves the last one into its slot (swap and
+ * pop), so removal costs the same whatever the number of bodies. Destroying an attached Object leaves an
+ * empty slot (null object, no flag set) that the loops skip.
+ */
+struct BodyStorage
+{
+public:
+    /// The slot holds a live Object.
+    static constexpr std::uint8_t flagActive = 1 << 0;
+    /// The body is not moved by the integrators.
+    static constexpr std::uint8_t flagFixed = 1 << 1;
+    /// The body rests: it is skipped like a fixed one until something wakes it up.
+    static constexpr std::uint8_t flagSleeping = 1 << 2;
+
+private:
+    // Hot data
+    Vector3DArray             positions;
+    Vector3DArray             velocities;
+    Vector3DArray             accelerations;
+    std::vector<decimal>      inverseMasses; // 0 for fixed bodies
+    std::vector<decimal>      motionMasks;   // 1 for dynamic bodies, 0 otherwise
+    std::vector<std::uint8_t> flags;
+    // Sleeping
+    std::vector<decimal>       sleepEnergies; // kinetic energy below which the body may sleep, < 0: world's
+    std::vector<decimal>       stillTimes;    // time spent below the sleep energy
+    std::vector<std::uint32_t> sleepGroups;   // slot standing for the island the body fell asleep with
+    // Contact materials
+    std::vector<std::uint32_t> materialIds;
+    MaterialRegistry           materials;
+    // Cold data
+    std::vector<ObjectColdData> cold;
+    std::vector<ObjectType>     types;
+    std::vector<Object*>        objects;
+
+    std::size_t version       = 0;
+    std::size_t sleepingCount = 0;
+
+    void detach(std::size_t slot);
+    void moveSlot(std::size_t from, std::size_t to);
+    void removeSlot(std::size_t slot);
+    void wakeSleeping(std::size_t slot);
+
+public:
+    // ============================================================================
+    /// @name Constructors / Destructors
+    // ============================================================================
+    /// @{
+    BodyStorage()                              = default;
+    BodyStorage(const BodyStorage&)            = delete;
+    BodyStorage& operator=(const BodyStorage&) = delete;
+    ~BodyStorage() { clear(); }
+    /// @}
+
+    // ============================================================================
+    /// @name Getters
+    // ============================================================================
+    /// @{
+    std::size_t                 size() const { return objects.size(); }
+    const std::vector<Object*>& getObjects() const { return objects; }
+    Object*                     getObject(std::size_t slot) const { return objects[slot]; }
+    /// Incremented each time slots are added, removed or emptied, so that per-slot caches can be invalidated.
+    std::size_t getVersion() const { return version; }
+    /// True if the slot holds a live, non fixed, awake body.
+    bool isDynamic(std::size_t slot) const { return flags[slot] == flagActive; }
+    bool isSleeping(std::size_t slot) const { return (flags[slot] & flagSleeping) != 0; }
+    /// Number of sleeping bodies.
+    std::size_t getSleepingCount() const { return sleepingCount; }
+    bool contains(const Object& obj) const { return obj.storage == this; }
+
+    Vector3DArray&                   getPositions() { return positions; }
+    const Vector3DArray&             getPositions() const { return positions; }
+    Vector3DArray&                   getVelocities() { return velocities; }
+    const Vector3DArray&             getVelocities() const { return velocities; }
+    Vector3DArray&                   getAccelerations() { return accelerations; }
+    const Vector3DArray&             getAccelerations() const { return accelerations; }
+    const std::vector<decimal>&      getInverseMasses() const { return inverseMasses; }
+    /// Per-slot factor of the batch integrators, so that fixed and empty slots are updated without branches.
+    const std::vector<decimal>&      getMotionMasks() const { return motionMasks; }
+    const std::vector<std::uint8_t>& getFlags() const { return flags; }
+    const std::vector<decimal>&      getSleepEnergies() const { return sleepEnergies; }
+    std::vector<decimal>&            getStillTimes() { return stillTimes; }
+    const std::vector<decimal>&      getStillTimes() const { return stillTimes; }
+    std::uint32_t                    getSleepGroup(std::size_t slot) const { return sleepGroups[slot]; }
+    ObjectColdData&                  getColdData(std::size_t slot) { return cold[slot]; }
+    const ObjectColdData&            getColdData(std::size_t slot) const { return cold[slot]; }
+    ObjectType                       getType(std::size_t slot) const { return types[slot]; }
+    std::uint32_t                    getMaterialId(std::size_t slot) const { return materialIds[slot]; }
+    const MaterialRegistry&          getMaterials() const { return materials; }
+    /// Premixed contact coefficients of the bodies of two slots.
+    const MaterialPair& getMaterialPair(std::size_t a, std::size_t b) const
+    {
+        return materials.getPair(materialIds[a], materialIds[b]);
+    }
+    /// @}
+
+    // ============================================================================
+    /// @name Body management
+    // ============================================================================
+    /// @{
+
+    /**
+     * @brief Move the state of an Object into a new slot and turn the Object into a view on it.
+     * @return The slot of the Object.
+     */
+    std::size_t add(Object& obj);
+    /// Detach an Object and remove its slot, the last slot moving into it; returns the removed slot (`size()`
+    /// if the Object is not stored here).
+    std::size_t remove(Object& obj);
+    /// Empty the slot of an Object being destroyed.
+    void release(std::size_t slot);
+    /// Detach every Object and remove all slots.
+    void clear();
+    /// Update the mass-dependent data of a slot.
+    void setMass(std::size_t slot, decimal mass, bool fixed);
+    void setSleepEnergy(std::size_t slot, decimal energy) { sleepEnergies[slot] = energy; }
+    /// Register again the contact properties of a slot, after its material or contact constants changed.
+    void updateMaterial(std::size_t slot)
+    {
+        const std::uint32_t previous = materialIds[slot];
+        materialIds[slot]            = materials.intern(cold[slot]);
+        materials.release(previous);
+    }
+    /// @}
+
+    // ============================================================================
+    /// @name Sleeping
+    // ============================================================================
+    /// @{
+    /// Put a dynamic body to sleep with the bodies of `group`: it stops and the integrators skip it.
+    void sleep(std::size_t slot, std::uint32_t group);
+    /// Wake a sleeping body up; does nothing on an awake one.
+    void wake(std::size_t slot)
+    {
+        if (isSleeping(slot))
+            wakeSleeping(slot);
+    }
+    /// @}
+};
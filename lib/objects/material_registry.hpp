@@ -0,0 +1,92 @@
+/**
+ * @file material_registry.hpp
+ * @brief Small integer ids for the materials of the bodies, and premixed coefficients of every pair of them.
+ *
+ * The contact code needs, for each pair of bodies in contact, coefficients mixed from the constants of the
+ * two bodies: effective stiffness, damping ratio (a log and a square root), friction (a square root) and
+ * restitution. Scenes use a handful of distinct materials, so these are computed once per pair of materials
+ * into a symmetric table, and looked up by the ids of the two bodies.
+ */
+#pragma once
+
+#include "objects/object.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// Contact properties of a body: the restitution of its Material and its contact-model constants.
+struct MaterialProperties
+{
+    decimal restitution    = 0_d;
+    decimal stiffnessCst   = 0_d;
+    decimal restitutionCst = 0_d;
+    decimal frictionCst    = 0_d;
+
+    bool operator==(const MaterialProperties&) const = default;
+};
+
+/// Coefficients of the contact between two materials, premixed.
+struct MaterialPair
+{
+    decimal stiffness    = 0_d; // effective stiffness of the spring model, 0 if negligible
+    decimal dampingRatio = 0_d; // from the combined restitution constant sqrt(e1 * e2)
+    decimal friction     = 0_d; // combined friction sqrt(mu1 * mu2), 0 if negligible
+    decimal restitution  = 0_d; // impulse restitution: smaller Material restitution, within [0, 1]
+};
+
+/**
+ * @class MaterialRegistry
+ * @brief Interns the contact properties of the bodies and keeps the pair table of the registered ones.
+ *
+ * Each id counts the slots using it. An id released by its last slot is reused by the next new material, so
+ * the table holds at most as many materials as were ever in use at once.
+ */
+struct MaterialRegistry
+{
+private:
+    struct PropertiesHash
+    {
+        std::size_t operator()(const MaterialProperties& p) const;
+    };
+
+    std::vector<MaterialProperties> materials;
+    std::vector<std::size_t>        useCounts; // slots using each id, 0 for a released id
+    std::vector<std::uint32_t>      freeIds;
+    std::vector<MaterialPair>       pairTable; // stride² entries, symmetric
+    std::size_t                     stride = 0;
+
+    std::unordered_map<MaterialProperties, std::uint32_t, PropertiesHash> ids;
+
+    void fillPairs(std::uint32_t id);
+
+public:
+    // ============================================================================
+    /// @name Getters
+    // ============================================================================
+    /// @{
+    /// Number of ids, released ones included.
+    std::size_t               size() const { return materials.size(); }
+    std::size_t               getUseCount(std::uint32_t id) const { return useCounts[id]; }
+    const MaterialProperties& getProperties(std::uint32_t id) const { return materials[id]; }
+    const MaterialPair&       getPair(std::uint32_t a, std::uint32_t b) const
+    {
+        return pairTable[a * stride + b];
+    }
+    /// @}
+
+    // ============================================================================
+    /// @name Registration
+    // ============================================================================
+    /// @{
+    /// Id of the material of `cold`, counted as used once more; a new material fills one row of the table.
+    std::uint32_t intern(const ObjectColdData& cold);
+    /// Count one use of `id` less; an unused id is reused by the next new material.
+    void release(std::uint32_t id);
+    /// Forget every material.
+    void clear();
+    /// Coefficients of the contact between two materials.
+    static MaterialPair mix(const MaterialProperties& a, const MaterialProperties& b);
+    /// @}
+};
@@ -7,14 +7,17 @@
  * It serves as a base class for specific object types like Sphere, AABB, and Plane.
  */
 #pragma once
+#include "collision/bounding_box.hpp"
 #include "collision/contact.hpp"
 #include "cstdint"
 #include "material.hpp"
 #include "mathematics/vector.hpp"
 #include "ostream"
 
+#include <cstddef>
 #include <fstream>
 #include <iostream>
+#include <string>
 
 enum class ObjectType : std::uint8_t
 {
@@ -41,6 +44,30 @@ inline std::string toString(ObjectType type)
     }
 }
 
+struct BodyStorage;
+
+/**
+ * @brief Object properties not touched by the integrators.
+ *
+ * Stored inside the Object while it is detached, and in the cold store of a BodyStorage once it is added to a
+ * PhysicsWorld.
+ */
+struct ObjectColdData
+{
+    Vector3D     rotation = Vector3D();
+    Vector3D     size     = Vector3D(1_d, 1_d, 1_d);
+    Vector3D     force    = Vector3D();
+    Vector3D     torque   = Vector3D();
+    decimal      mass     = 0_d; // static by default
+    Material     material;
+    decimal      stiffnessCst   = 0_d;
+    decimal      restitutionCst = 0_d;
+    decimal      frictionCst    = 0_d;
+    unsigned int id             = 0;
+    std::string  name;
+    bool         continuous = false; // swept against the other bodies (see PhysicsWorld::advanceToImpacts)
+};
+
 /**
  * @brief Object class representing a physical entity in the simulation.
  *
@@ -48,26 +75,30 @@ inline std::string toString(ObjectType type)
  * properties: position, rotation, velocity, acceleration, forces, and torques (`Vector3D`).
  * Can be extended for specific object types (e.g., Sphere, AABB, Plane).
  *
+ * Once added to a PhysicsWorld, the state lives in the world's BodyStorage and the Object only acts as a view
+ * on its slot: getters and setters read and write the storage arrays. Copies of an Object are always
+ * detached.
  */
 struct Object
 {
 private:
-    Vector3D position     = Vector3D();
-    Vector3D rotation     = Vector3D();
-    Vector3D size         = Vector3D(1_d, 1_d, 1_d);
-    Vector3D velocity     = Vector3D();
-    Vector3D acceleration = Vector3D();
-    Vector3D force        = Vector3D();
-    Vector3D torque       = Vector3D();
-    decimal  mass         = 0_d; // static by default
-    Material material;
-    decimal  stiffnessCst   = 0_d;
-    decimal  restitutionCst = 0_d;
-    decimal  frictionCst    = 0_d;
-
-    bool         fixed = true;
-    unsigned int id;
-    std::string  name;
+    friend struct BodyStorage;
+
+    // Detached state, only used while `storage` is null
+    Vector3D       position     = Vector3D();
+    Vector3D       velocity     = Vector3D();
+    Vector3D       acceleration = Vector3D();
+    bool           fixed        = true;
+    decimal        sleepEnergy  = -1_d; // < 0: sleep energy of the world
+    ObjectColdData cold;
+
+    BodyStorage* storage = nullptr;
+    std::size_t  slot    = 0;
+
+    ObjectColdData&       getColdData();
+    const ObjectColdData& getColdData() const;
+    /// Let the storage register the new contact properties of the body.
+    void updateMaterial();
 
 public:
     /// @brief Constructions can be done with various levels of details.
@@ -85,7 +116,11 @@ public:
     Object(const Vector3D& position, const Vector3D& size, const Vector3D& velocity, decimal mass);
     Object(const Vector3D& position, const Vector3D& rotation, const Vector3D& size, const Vector3D& velocity,
            const Vector3D& acceleration, const Vector3D& force, const Vector3D& torque, decimal mass);
-    virtual ~Object() = default;
+    /// Copy the state of `other` into a detached Object.
+    Object(const Object& other);
+    /// Copy the state of `other`, keeping the storage slot of this Object if it has one.
+    Object& operator=(const Object& other);
+    virtual ~Object();
     /// @}
 
     /// @name Getters
@@ -101,11 +136,19 @@ public:
     decimal            getStiffnessCst() const;
     decimal            getRestitutionCst() const;
     decimal            getFrictionCst() const;
-    Material           getMaterial() const;
+    const Material&    getMaterial() const;
     virtual ObjectType getType() const;
     bool               getIsFixed() const;
-    unsigned int       getId() const { return id; }
-    std::string        getName() const { return name; }
+    unsigned int       getId() const { return getColdData().id; }
+    std::string        getName() const { return getColdData().name; }
+    /// True if the body stops at its first impact within a step instead of passing through thin objects.
+    bool getIsContinuous() const { return getColdData().continuous; }
+    /// Kinetic energy below which the body may fall asleep; negative values use the world setting.
+    decimal getSleepEnergy() const;
+    /// True if the body rests in a PhysicsWorld and is skipped until woken up.
+    bool isSleeping() const;
+    /// True while the Object is a view on a BodyStorage slot.
+    bool isAttached() const { return storage != nullptr; }
     /// @}
 
     /// @name Setters
@@ -123,15 +166,18 @@ public:
     void setFrictionCst(decimal mu);
     void setMaterial(const Material& mat);
     void setIsFixed(bool b);
-    void setId(unsigned int _id) { id = _id; }
-    void setName(const std::string& _name) { name = _name; }
+    void setSleepEnergy(decimal energy);
+    void setId(unsigned int _id) { getColdData().id = _id; }
+    void setName(const std::string& _name) { getColdData().name = _name; }
+    /// Sweep the body against the other bodies at each step; only spheres are swept.
+    void setIsContinuous(bool b) { getColdData().continuous = b; }
 
     /// @}
 
     /// @name Transformations
     /// @{
-    void addAcceleration(const Vector3D& acc) { acceleration += acc; }
-    void applyTranslation(const Vector3D& v_translation) { position += v_translation; }
+    void addAcceleration(const Vector3D& acc) { setAcceleration(getAcceleration() + acc); }
+    void applyTranslation(const Vector3D& v_translation) { setPosition(getPosition() + v_translation); }
     void applyRotation(const Vector3D& v_rotation);
     /**
      * @brief Applies scaling to the object.
@@ -142,20 +188,22 @@ public:
      *
      * @param v_scaling The scaling vector to apply.
      */
-    void applyScaling(const Vector3D& v_scaling) { size *= v_scaling; }
+    void applyScaling(const Vector3D& v_scaling) { getColdData().size *= v_scaling; }
     /// @}
 
     /// @name Physics
     /// @{
     void checkFixed();
-    bool isFixed() const { return fixed; }
+    bool isFixed() const { return getIsFixed(); }
+    /// Wake the body up if it sleeps; changing its position or velocity does it too.
+    void wakeUp();
     void resetForces()
     {
-        force.setToNull();
-        torque.setToNull();
+        getColdData().force.setToNull();
+        getColdData().torque.setToNull();
     }
-    void applyForce(const Vector3D& _force) { force += _force; }
-    void applyTorque(const Vector3D& _torque) { torque += _torque; }
+    void applyForce(const Vector3D& _force) { getColdData().force += _force; }
+    void applyTorque(const Vector3D& _torque) { getColdData().torque += _torque; }
     /// Integrate motion equations over a time step `dt` to update physical properties.
     virtual void integrate(decimal dt);
     /// @}
@@ -163,6 +211,11 @@ public:
     /// @name Collision
     /// @{
 
+    /**
+     * @brief World-space bounding box used by the broad phase.
+     *  Default implementation encloses `size` around `position`; derived classes return tighter bounds.
+     */
+    virtual BoundingBox getBoundingBox() const;
     /**
      * @brief Quick check for collision with another object (Broad Phase).
      *  This is a pure virtual functions that must be implemented by derived classes.
@@ -0,0 +1,155 @@
+/**
+ * @file object_pool.hpp
+ * @brief Arena of Objects of one type, addressed by generational handles.
+ *
+ * Objects are constructed in fixed-size chunks that are never moved nor freed before the pool itself: the
+ * address of an Object stays valid for its whole life, which the views of a BodyStorage rely on. Destroyed
+ * entries go to a free list and are reused by the next `create`, so a scene rebuilt after `clear` allocates
+ * nothing once the pool has grown to its size.
+ *
+ * Each entry carries a generation, incremented when its Object is destroyed: a handle kept after that no
+ * longer resolves, even once the entry holds a new Object.
+ */
+#pragma once
+
+#include "objects/object.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/// Handle on an Object owned by a PhysicsWorld: type of its pool, entry, and generation of the entry.
+struct ObjectHandle
+{
+    static constexpr std::uint32_t invalidIndex = static_cast<std::uint32_t>(-1);
+
+    ObjectType    type       = ObjectType::Generic;
+    std::uint32_t index      = invalidIndex;
+    std::uint32_t generation = 0;
+
+    bool isNull() const { return index == invalidIndex; }
+    bool operator==(const ObjectHandle&) const = default;
+};
+
+/**
+ * @class ObjectPool
+ * @brief Chunked arena of `T` with a free list and per-entry generations.
+ */
+template <typename T>
+struct ObjectPool
+{
+private:
+    static constexpr std::size_t chunkSize = 256;
+
+    struct Chunk
+    {
+        alignas(T) std::byte storage[chunkSize * sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::vector<std::uint32_t>          generations; // generation of each entry, odd while it holds an Object
+    std::vector<std::uint32_t>          freeEntries; // popped from the back
+    std::size_t                         liveCount = 0;
+
+    T* entry(std::size_t index) const
+    {
+        return std::launder(reinterpret_cast<T*>(chunks[index / chunkSize]->storage) + index % chunkSize);
+    }
+    bool isLive(std::size_t index) const { return (generations[index] & 1u) != 0; }
+
+public:
+    // ============================================================================
+    /// @name Constructors / Destructors
+    // ============================================================================
+    /// @{
+    ObjectPool()                             = default;
+    ObjectPool(const ObjectPool&)            = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    ~ObjectPool() { clear(); }
+    /// @}
+
+    // ============================================================================
+    /// @name Getters
+    // ============================================================================
+    /// @{
+    /// Number of live Objects.
+    std::size_t size() const { return liveCount; }
+    /// Number of entries allocated so far, live or free.
+    std::size_t capacity() const { return chunks.size() * chunkSize; }
+    /// Object of `index` if `generation` is still the current one, null otherwise.
+    T* get(std::uint32_t index, std::uint32_t generation) const
+    {
+        if (index >= generations.size() || generations[index] != generation || !isLive(index))
+            return nullptr;
+        return entry(index);
+    }
+    /// Entry holding `obj`, or `ObjectHandle::invalidIndex` if it does not come from this pool.
+    std::uint32_t indexOf(const Object* obj) const
+    {
+        const auto* address = reinterpret_cast<const std::byte*>(obj);
+        for (std::size_t c = 0; c < chunks.size(); ++c)
+        {
+            const std::byte* first = chunks[c]->storage;
+            if (address < first || address >= first + sizeof(Chunk::storage))
+                continue;
+            const std::size_t index = c * chunkSize + static_cast<std::size_t>(address - first) / sizeof(T);
+            return isLive(index) ? static_cast<std::uint32_t>(index) : ObjectHandle::invalidIndex;
+        }
+        return ObjectHandle::invalidIndex;
+    }
+    std::uint32_t getGeneration(std::uint32_t index) const { return generations[index]; }
+    /// @}
+
+    // ============================================================================
+    /// @name Allocation
+    // ============================================================================
+    /// @{
+    /// Construct a `T` from `args` in a free entry; returns its index.
+    template <typename... Args>
+    std::uint32_t create(Args&&... args)
+    {
+        if (freeEntries.empty())
+        {
+            const std::size_t first = capacity();
+            chunks.push_back(std::make_unique<Chunk>());
+            generations.resize(capacity(), 0);
+            for (std::size_t index = capacity(); index-- > first;)
+                freeEntries.push_back(static_cast<std::uint32_t>(index));
+        }
+        const std::uint32_t index = freeEntries.back();
+        ::new (static_cast<void*>(entry(index))) T(std::forward<Args>(args)...);
+        freeEntries.pop_back();
+        ++generations[index];
+        ++liveCount;
+        return index;
+    }
+    /// Destroy the Object of `index`; the entry is reused by a later `create`.
+    void destroy(std::uint32_t index)
+    {
+        if (index >= generations.size() || !isLive(index))
+            return;
+        entry(index)->~T();
+        ++generations[index];
+        freeEntries.push_back(index);
+        --liveCount;
+    }
+    /// Destroy every Object and keep the chunks; entries are then reused from the first one.
+    void clear()
+    {
+        for (std::size_t index = 0; index < generations.size(); ++index)
+        {
+            if (!isLive(index))
+                continue;
+            entry(index)->~T();
+            ++generations[index];
+        }
+        liveCount = 0;
+        freeEntries.clear();
+        for (std::size_t index = generations.size(); index-- > 0;)
+            freeEntries.push_back(static_cast<std::uint32_t>(index));
+    }
+    /// @}
+};
@@ -148,6 +148,9 @@ public:
     // ============================================================================
     /// @{
 
+    /// World-space bounding box used by the broad phase.
+    BoundingBox getBoundingBox() const override;
+
     /// Check broad collision between two Planes.
     bool checkPlaneCollision(const Plane& Plane);
     /// Check broad collision between a Plane and an AABB.
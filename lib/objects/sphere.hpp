@@ -74,6 +74,9 @@ public:
     // ============================================================================
     /// @{
 
+    /// World-space bounding box used by the broad phase.
+    BoundingBox getBoundingBox() const override;
+
     /// Check broad collision between two Spheres.
     bool checkSphereCollision(const Sphere& sphere);
     /// Check broad collision between a Sphere and an AABB.
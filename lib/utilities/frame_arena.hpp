@@ -0,0 +1,111 @@
+/**
+ * @file frame_arena.hpp
+ * @brief Linear allocator for the transient data of one physics step.
+ *
+ * Contacts, per-pair forces and solver scratch only live for one step. Instead of sizing containers for
+ * them, the step takes them from a frame arena: an allocation moves a cursor forward in a slab, and the
+ * whole frame is released at once by `reset` at the start of the next step. A frame larger than the slabs
+ * reserved so far gets a new slab; on the next reset the slabs are merged into a single one of their total
+ * size, so a steady-state step allocates nothing.
+ *
+ * Each thread of the world ThreadPool has its own lane of slabs: allocations made inside a parallel pass
+ * never contend, and a lane is only ever touched by its thread.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+struct ThreadPool;
+
+/**
+ * @class FrameArena
+ * @brief Per-thread bump allocator, released in bulk once per step.
+ */
+struct FrameArena
+{
+private:
+    struct Slab
+    {
+        std::unique_ptr<std::byte[]> memory;
+        std::size_t                  size = 0;
+    };
+    struct Lane
+    {
+        std::vector<Slab> slabs;
+        std::size_t       slab   = 0; // slab being filled
+        std::size_t       offset = 0; // first free byte of that slab
+    };
+
+    std::vector<Lane> lanes = std::vector<Lane>(1);
+    const ThreadPool* pool  = nullptr;
+    std::size_t       slabSize;
+
+    Lane& lane();
+    void* allocateBytes(std::size_t bytes, std::size_t alignment);
+
+public:
+    /// Position of the calling thread's lane, to release what was allocated after it.
+    struct Marker
+    {
+        std::size_t slab   = 0;
+        std::size_t offset = 0;
+    };
+
+    // ============================================================================
+    /// @name Constructors / Destructors
+    // ============================================================================
+    /// @{
+    /// `slabSize` is the size in bytes of the first slab of each lane.
+    explicit FrameArena(std::size_t slabSize = 64 * 1024)
+        : slabSize(slabSize)
+    {}
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    /// @}
+
+    // ============================================================================
+    /// @name Getters / Setters
+    // ============================================================================
+    /// @{
+    /// Bytes reserved by every lane.
+    std::size_t getCapacity() const;
+    /// Slabs of every lane; one per lane once the frame size is stable.
+    std::size_t getSlabCount() const;
+    /// One lane per thread of `threadPool`; null uses a single lane. Not to be called during a frame.
+    void setThreadPool(const ThreadPool* threadPool);
+    /// @}
+
+    // ============================================================================
+    /// @name Allocation
+    // ============================================================================
+    /// @{
+    /// `count` default-initialised `T` in the lane of the calling thread, valid until `reset` or `rewind`.
+    template <typename T>
+    std::span<T> allocate(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Frame memory is released without destructors");
+        T* data = static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T)));
+        std::uninitialized_default_construct_n(data, count);
+        return { data, count };
+    }
+    /// `count` copies of `value` in the lane of the calling thread, valid until `reset` or `rewind`.
+    template <typename T>
+    std::span<T> allocate(std::size_t count, const T& value)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Frame memory is released without destructors");
+        T* data = static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T)));
+        std::uninitialized_fill_n(data, count, value);
+        return { data, count };
+    }
+    /// Current position of the calling thread's lane.
+    Marker mark();
+    /// Release what the calling thread allocated since `marker`.
+    void rewind(const Marker& marker);
+    /// Release the whole frame of every lane; lanes that needed several slabs get a single larger one.
+    void reset();
+    /// @}
+};
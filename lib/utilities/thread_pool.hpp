@@ -0,0 +1,138 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Small work-stealing thread pool used to split the passes of a physics step.
+ *
+ * Every thread owns a task deque: it pops its own tasks from the back and, once empty, steals from the
+ * front of the other deques. Deques are ring buffers that keep their storage, so that a batch of no more
+ * tasks than an earlier one is submitted without allocating. The thread calling `run` or `parallelFor` takes
+ * part in the work and returns once every task of its batch is done, so a pool of one thread runs
+ * everything inline.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ThreadPool
+{
+private:
+    /// Calls `task(index)` on the callable of a `run`, without copying it.
+    using TaskCall = void (*)(const void* task, std::size_t index);
+
+    /// Tasks submitted by one call to `run`.
+    struct Batch
+    {
+        const void*              task = nullptr;
+        TaskCall                 call = nullptr;
+        std::atomic<std::size_t> remaining { 0 };
+        std::mutex               errorMutex;
+        std::exception_ptr       error;
+    };
+    struct Task
+    {
+        Batch*      batch = nullptr;
+        std::size_t index = 0;
+    };
+    /// Task deque of one thread, as a ring buffer whose capacity is a power of two.
+    struct Queue
+    {
+        std::mutex        mutex;
+        std::vector<Task> ring;
+        std::size_t       head  = 0; // index of the front task
+        std::size_t       count = 0;
+
+        void pushBack(const Task& task);
+        Task popBack();
+        Task popFront();
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues; // queue 0 is shared by the threads outside the pool
+    std::vector<std::thread>            workers;
+    std::mutex                          sleepMutex;
+    std::condition_variable             wakeUp;
+    std::atomic<std::size_t>            queued { 0 };
+    std::atomic<bool>                   stopping { false };
+
+    std::size_t ownQueue() const;
+    bool        tryRunOne(std::size_t self);
+    static void execute(const Task& task);
+    void        workerLoop(std::size_t self);
+    void        runTasks(std::size_t count, const void* task, TaskCall call);
+
+public:
+    // ============================================================================
+    /// @name Constructors / Destructors
+    // ============================================================================
+    /// @{
+    /// `threadCount` counts the calling thread; 0 uses every hardware thread.
+    explicit ThreadPool(std::size_t threadCount = 1);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    /// @}
+
+    // ============================================================================
+    /// @name Getters
+    // ============================================================================
+    /// @{
+    /// Threads taking part in the work, the calling one included.
+    std::size_t getThreadCount() const { return workers.size() + 1; }
+    /// Number of hardware threads, at least 1.
+    static std::size_t getHardwareThreadCount();
+    /// Index of the calling thread in `[0, getThreadCount())`; 0 for the threads outside the pool.
+    std::size_t getCurrentThread() const { return ownQueue(); }
+    /// @}
+
+    // ============================================================================
+    /// @name Execution
+    // ============================================================================
+    /// @{
+    /// Run `task(0)` ... `task(count - 1)` on the pool and wait for all of them; rethrows the first
+    /// exception thrown by a task. `task` is called by reference: submitting a batch does not allocate it.
+    template <typename Function>
+    void run(std::size_t count, const Function& task)
+    {
+        runTasks(count, &task,
+                 [](const void* function, std::size_t index)
+                 { (*static_cast<const Function*>(function))(index); });
+    }
+    /// Number of chunks `parallelFor` splits `[begin, end)` into.
+    static std::size_t chunkCount(std::size_t begin, std::size_t end, std::size_t grain)
+    {
+        return end > begin ? (end - begin + grain - 1) / grain : 0;
+    }
+    /// Grain splitting `count` items into a few chunks per thread, but no chunk smaller than `minGrain`.
+    std::size_t grainFor(std::size_t count, std::size_t minGrain) const;
+    /**
+     * @brief Call `function(first, last)` on consecutive chunks of `[begin, end)`.
+     *
+     * Chunk `k` is `[begin + k * grain, min(end, begin + (k + 1) * grain))`, so per-chunk results can be
+     * stored at `(first - begin) / grain` and merged in order, whatever thread ran the chunk.
+     */
+    template <typename Function>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Function&& function)
+    {
+        grain                   = grain > 0 ? grain : 1;
+        const std::size_t count = chunkCount(begin, end, grain);
+        if (count <= 1 || workers.empty())
+        {
+            for (std::size_t first = begin; first < end; first += grain)
+                function(first, std::min(end, first + grain));
+            return;
+        }
+        run(count,
+            [&](std::size_t chunk)
+            {
+                const std::size_t first = begin + chunk * grain;
+                function(first, std::min(end, first + grain));
+            });
+    }
+    /// @}
+};
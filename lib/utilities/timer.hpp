@@ -4,14 +4,17 @@
  *
  * This module provides a simple, RAII-style timer class for measuring time intervals with microsecond
  * precision. It is used to profile simulation steps, configuration load times, and command execution
- * durations.
+ * durations. `LatencyHistogram` accumulates the durations measured over many steps, to follow their
+ * distribution (see RealTimeDriver).
  *
  * @see <chrono> (for underlying timing mechanism)
  */
 #pragma once
 #include "precision.hpp"
 
+#include <array>
 #include <chrono>
+#include <cstddef>
 
 /**
  * @brief High-resolution timer for measuring elapsed time.
@@ -30,6 +33,8 @@ public:
     /// @brief Reset the timer to the current time.
     void reset();
 
+    /// @brief Query elapsed time in nanoseconds.
+    [[nodiscard]] long long elapsedNanoseconds() const;
     /// @brief Query elapsed time in microseconds.
     [[nodiscard]] long long elapsedMicroseconds() const;
     /// @brief Query elapsed time in milliseconds.
@@ -37,3 +42,40 @@ public:
     /// @brief Query elapsed time in seconds.
     [[nodiscard]] decimal elapsedSeconds() const;
 };
+
+/**
+ * @brief Distribution of durations in nanoseconds, in power-of-two buckets.
+ *
+ * Bucket `i` counts the durations in [2^i, 2^(i+1)) ns, the first one also holding 0: a percentile is known
+ * within a factor of 2, with a fixed size and no allocation. The exact minimum, maximum and mean are kept
+ * aside.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr std::size_t bucketCount = 48; // up to 2^48 ns, about 78 hours
+
+private:
+    std::array<std::size_t, bucketCount> buckets {};
+    std::size_t                          count = 0;
+    long long                            min   = 0;
+    long long                            max   = 0;
+    long double                          total = 0;
+
+public:
+    /// @brief Add a duration, in nanoseconds; negative ones count as 0.
+    void record(long long nanoseconds);
+    /// @brief Forget every duration recorded.
+    void reset();
+
+    [[nodiscard]] std::size_t getCount() const { return count; }
+    [[nodiscard]] long long   getMin() const { return min; }
+    [[nodiscard]] long long   getMax() const { return max; }
+    /// @brief Mean duration in nanoseconds, 0 if none was recorded.
+    [[nodiscard]] decimal getMean() const;
+    /// @brief Upper bound of the bucket of the `fraction` quantile (0.99: 99th percentile), capped by the
+    /// maximum.
+    [[nodiscard]] long long getPercentile(decimal fraction) const;
+    /// @brief Durations of bucket `index`, in [2^index, 2^(index + 1)) ns.
+    [[nodiscard]] std::size_t getBucket(std::size_t index) const { return buckets[index]; }
+};
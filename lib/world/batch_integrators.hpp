@@ -0,0 +1,47 @@
+/**
+ * @file batch_integrators.hpp
+ * @brief Vectorised integration kernels over the body arrays of a BodyStorage.
+ *
+ * Each kernel updates every slot in a single pass over the component arrays, `simd::width` bodies at a time
+ * (see simd.hpp). Updates are multiplied by the motion mask of the slot, so fixed and empty slots keep
+ * their state without any branch in the loop. With a mask of 1, the operations are the same as in the
+ * per-object integrators of PhysicsWorld, so the results are identical.
+ *
+ * The optional `[first, last)` slot range restricts a kernel to a chunk of the arrays; slots are
+ * independent, so chunks can run on different threads and give the same result as a single pass.
+ */
+#pragma once
+
+#include "objects/body_storage.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace BatchIntegrators {
+
+/// Default end of the slot range: up to the last slot.
+inline constexpr std::size_t allSlots = static_cast<std::size_t>(-1);
+
+/// Semi-implicit Euler: v += a * dt, then x += v * dt.
+void euler(Vector3DArray& pos, Vector3DArray& vel, const Vector3DArray& acc, const std::vector<decimal>& mask,
+           decimal dt, std::size_t first = 0, std::size_t last = allSlots);
+/// Kick then drift: v += a * h, then x += v * dt.
+void kickDrift(Vector3DArray& pos, Vector3DArray& vel, const Vector3DArray& acc,
+               const std::vector<decimal>& mask, decimal h, decimal dt, std::size_t first = 0,
+               std::size_t last = allSlots);
+/// Kick: v += a * h.
+void kick(Vector3DArray& vel, const Vector3DArray& acc, const std::vector<decimal>& mask, decimal h,
+          std::size_t first = 0, std::size_t last = allSlots);
+/// Unmasked accumulation: y += a * x.
+void axpy(Vector3DArray& y, const Vector3DArray& x, decimal a, std::size_t first = 0,
+          std::size_t last = allSlots);
+/**
+ * @brief Runge-Kutta state update: pos = pos0 + dx * h, vel = vel0 + dv * h.
+ *
+ * `dx` and `dv` may alias `vel` and the accelerations: each slot is read before being written.
+ */
+void offset(Vector3DArray& pos, Vector3DArray& vel, const Vector3DArray& pos0, const Vector3DArray& vel0,
+            const Vector3DArray& dx, const Vector3DArray& dv, const std::vector<decimal>& mask, decimal h,
+            std::size_t first = 0, std::size_t last = allSlots);
+
+} // namespace BatchIntegrators
@@ -21,12 +21,30 @@ private:
     decimal gravity = 9.81_d; // m/s^2
 
     // Simulation parameters
-    decimal     timeStep           = 0.01_d; // seconds
-    decimal     simulationDuration = 10_d;   // simulation duration in seconds
-    std::size_t maxIterations      = static_cast<std::size_t>(std::round(simulationDuration / timeStep));
-    std::string solver             = "Euler";
-    bool        verbose            = true;
-    bool        save               = false;
+    decimal     timeStep            = 0.01_d; // seconds
+    decimal     simulationDuration  = 10_d;   // simulation duration in seconds
+    std::size_t maxIterations       = static_cast<std::size_t>(std::round(simulationDuration / timeStep));
+    std::string solver              = "Euler";
+    decimal     absTolerance        = 1e-5_d; // local error tolerances of the adaptive solver
+    decimal     relTolerance        = 1e-5_d;
+    std::size_t maxTimeLevel        = 0;     // multi-rate: up to 2^level sub-steps per step, 0 = single rate
+    std::string broadPhase          = "SweepAndPrune";
+    decimal     gridCellSize        = 0_d;   // uniform grid cell size, 0 = inferred from the objects
+    std::size_t broadPhaseSampling  = 60;    // steps between two samplings of the Auto broad phase
+    bool        pairCaching         = true;  // skip the pairs known apart in the broad and narrow phases
+    std::size_t threadCount         = 1;     // threads of the step pipeline, 0 = all hardware threads
+    bool        deterministic       = true;  // results bit-identical to the single-thread path
+    decimal     sleepEnergy         = 0_d;   // kinetic energy (J) below which bodies may sleep, 0 = never
+    decimal     sleepTime           = 0.5_d; // seconds an island must stay below it before sleeping
+    std::string contactSolver       = "Rebound";
+    std::size_t velocityIterations  = 10;    // sequential-impulse passes over the contacts of an island
+    std::size_t positionIterations  = 3;     // penetration correction passes
+    bool        continuousCollision = false; // stop every fast sphere at its first impact within a step
+    bool        eventDriven         = false; // `run` skips free flights up to the next possible contact
+    decimal     realTimeFactor      = 0_d;   // simulated seconds per wall-clock second, 0 = no pacing
+    decimal     outputRate          = 0_d;   // states recorded per simulated second, 0 = one per step
+    bool        verbose             = true;
+    bool        save                = false;
 
     /// Singleton constructor
     Config() = default;
@@ -46,6 +64,24 @@ public:
     decimal        getSimulationDuration() const;
     std::size_t    getMaxIterations() const;
     std::string    getSolver() const;
+    decimal        getAbsTolerance() const;
+    decimal        getRelTolerance() const;
+    std::size_t    getMaxTimeLevel() const;
+    std::string    getBroadPhase() const;
+    decimal        getGridCellSize() const;
+    std::size_t    getBroadPhaseSampling() const;
+    bool           getPairCaching() const;
+    std::size_t    getThreadCount() const;
+    bool           getDeterministic() const;
+    decimal        getSleepEnergy() const;
+    decimal        getSleepTime() const;
+    std::string    getContactSolver() const;
+    std::size_t    getVelocityIterations() const;
+    std::size_t    getPositionIterations() const;
+    bool           getContinuousCollision() const;
+    bool           getEventDriven() const;
+    decimal        getRealTimeFactor() const;
+    decimal        getOutputRate() const;
     bool           getVerbose() const;
     bool           getSave() const;
     /// @}
@@ -91,6 +127,70 @@ public:
         simulationDuration = decimal(maxIterations) / timeStep;
     }
     void setSolver(const std::string& sol) { solver = sol; }
+    void setAbsTolerance(decimal tol)
+    {
+        if (tol <= 0)
+            throw std::invalid_argument("Absolute tolerance must be positive");
+        absTolerance = tol;
+    }
+    void setRelTolerance(decimal tol)
+    {
+        if (tol < 0)
+            throw std::invalid_argument("Relative tolerance cannot be negative");
+        relTolerance = tol;
+    }
+    void setMaxTimeLevel(std::size_t level)
+    {
+        if (level > 16)
+            throw std::invalid_argument("Time level cannot exceed 16");
+        maxTimeLevel = level;
+    }
+    void setBroadPhase(const std::string& bp) { broadPhase = bp; }
+    void setGridCellSize(decimal size)
+    {
+        if (size < 0)
+            throw std::invalid_argument("Grid cell size cannot be negative");
+        gridCellSize = size;
+    }
+    void setBroadPhaseSampling(std::size_t steps)
+    {
+        if (steps == 0)
+            throw std::invalid_argument("Broad phase sampling interval must be positive");
+        broadPhaseSampling = steps;
+    }
+    void setPairCaching(bool caching) { pairCaching = caching; }
+    /// Number of threads running the step, the calling one included; 0 uses every hardware thread.
+    void setThreadCount(std::size_t count) { threadCount = count; }
+    void setDeterministic(bool det) { deterministic = det; }
+    void setSleepEnergy(decimal energy)
+    {
+        if (energy < 0)
+            throw std::invalid_argument("Sleep energy cannot be negative");
+        sleepEnergy = energy;
+    }
+    void setSleepTime(decimal time)
+    {
+        if (time < 0)
+            throw std::invalid_argument("Sleep time cannot be negative");
+        sleepTime = time;
+    }
+    void setContactSolver(const std::string& cs) { contactSolver = cs; }
+    void setVelocityIterations(std::size_t count) { velocityIterations = count; }
+    void setPositionIterations(std::size_t count) { positionIterations = count; }
+    void setContinuousCollision(bool ccd) { continuousCollision = ccd; }
+    void setEventDriven(bool events) { eventDriven = events; }
+    void setRealTimeFactor(decimal factor)
+    {
+        if (factor < 0)
+            throw std::invalid_argument("Real-time factor cannot be negative");
+        realTimeFactor = factor;
+    }
+    void setOutputRate(decimal rate)
+    {
+        if (rate < 0)
+            throw std::invalid_argument("Output rate cannot be negative");
+        outputRate = rate;
+    }
     void setVerbose(bool verb) { verbose = verb; }
     void setSave(bool sav) { save = sav; }
     /// @}
@@ -1,4 +1,6 @@
+#pragma once
 #include "mathematics/vector.hpp"
+#include "objects/material_registry.hpp"
 #include "objects/object.hpp"
 
 namespace Physics {
@@ -47,4 +49,23 @@ Vector3D computeContactForce(const Object& obj1, const Object& obj2);
 /// restitution = e and effective stiffness = k.
 Vector3D computeContactForce(const Object& obj1, const Object& obj2, decimal mu, decimal e, decimal k);
 /// @}
+
+// ============================================================================
+/// @name Fused contact force
+// ============================================================================
+/// @{
+/// Constants of the spring-damper-friction model for a pair of objects; all zero without stiffness.
+struct ContactModel
+{
+    decimal stiffness = 0_d; // effective stiffness k
+    decimal damping   = 0_d; // damping coefficient c = 2 zeta sqrt(k mu)
+    decimal friction  = 0_d; // friction coefficient
+};
+/// Compute the contact model of two objects.
+ContactModel computeContactModel(const Object& obj1, const Object& obj2);
+/// Compute the contact model of two bodies of masses m1 and m2, from the pair table of their materials.
+ContactModel computeContactModel(const MaterialPair& pair, decimal m1, decimal m2);
+/// Compute spring + damping + friction on obj1 from r = x2 - x1 and v = v2 - v1, each term once.
+Vector3D computeContactForce(const ContactModel& model, const Vector3D& r, const Vector3D& v);
+/// @}
 } // namespace Physics
@@ -4,14 +4,32 @@
  *
  */
 #pragma once
+#include "collision/broad_phase.hpp"
+#include "collision/contact_islands.hpp"
+#include "collision/contact_solver.hpp"
+#include "collision/dynamic_aabb_tree.hpp"
+#include "collision/narrow_phase.hpp"
+#include "objects/aabb.hpp"
+#include "objects/body_storage.hpp"
 #include "objects/object.hpp"
+#include "objects/object_pool.hpp"
+#include "objects/plane.hpp"
+#include "objects/sphere.hpp"
+#include "utilities/frame_arena.hpp"
+#include "utilities/thread_pool.hpp"
 #include "world/config.hpp"
 #include "world/integrateRK4.hpp"
 #include "world/physics.hpp"
 #include "world/solver.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <fstream>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 /**
@@ -25,10 +43,14 @@
 struct PhysicsWorld
 {
 private:
-    Config&                                        config = Config::get();
-    std::vector<Object*>                           objects;
-    std::ofstream                                  objectFile;
-    std::vector<std::pair<Object*, std::ofstream>> motionFiles;
+    Config&     config = Config::get();
+    BodyStorage bodies;
+    // Objects owned by the world, one arena per type; freed in bulk by `clearObjects`
+    ObjectPool<Sphere>         spheres;
+    ObjectPool<AABB>           boxes;
+    ObjectPool<Plane>          planes;
+    std::ofstream              objectFile;
+    std::vector<std::ofstream> motionFiles; // indexed by slot
 
     bool     isRunning = false;
     Solver   solver;
@@ -36,17 +58,187 @@ private:
     decimal  gravityCst = config.getGravity();
     Vector3D gravityAcc = Physics::computeGravityAcc(gravityCst);
 
-    unsigned int nextObjectId = 0;
+    // Step pipeline threads; with `deterministic`, results are bit-identical to a single thread
+    std::unique_ptr<ThreadPool> threadPool    = std::make_unique<ThreadPool>(config.getThreadCount());
+    bool                        deterministic = config.getDeterministic();
+    // Transient data of the current step (contacts, per-pair forces, solver scratch), released by `integrate`
+    FrameArena frame;
+
+    BroadPhaseType              broadPhaseType = parseBroadPhase(config.getBroadPhase());
+    std::unique_ptr<BroadPhase> broadPhase     = makeBroadPhase(broadPhaseType);
+    std::vector<CollisionPair>  pairs;
+    std::size_t                 broadPhaseVersion = 0; // bodies version seen by the broad phase
+    // Narrow phase of the current step, in frame memory
+    NarrowPhase             narrowPhase;
+    std::span<Contact>      contacts;
+    std::span<std::uint8_t> contactFound;
+    std::span<std::uint8_t> touched; // bodies moved by a collision response during the current pass
+    ContactIslands          islands;
+    ContactSolverType       contactSolverType = parseContactSolver(config.getContactSolver());
+    ContactSolver           contactSolver;
+
+    // Sleeping: islands whose bodies stayed below their sleep energy for `sleepTime` are put to sleep
+    decimal sleepEnergy = config.getSleepEnergy();
+    decimal sleepTime   = config.getSleepTime();
+
+    // Continuous collision: positions of the bodies at the start of the step, empty when no body is swept
+    bool                continuousCollision = config.getContinuousCollision();
+    std::span<Vector3D> sweepStart;
+    /// Advance of a swept sphere past its time of impact, relative to its radius, so that the narrow phase
+    /// finds the contact.
+    static constexpr decimal impactSkin = 0.01_d;
+    // Event-driven stepping: `run` jumps over the free flights (see `fastForward`)
+    bool        eventDriven  = config.getEventDriven();
+    std::size_t fastForwards = 0;
+    decimal     lastHorizon  = 0_d; // last span searched by `fastForward`, where the next search starts
+    // Contact horizon: boxes swept by the bodies over the searched span, and the planes checked apart
+    DynamicAABBTree          horizonTree;
+    std::vector<BoundingBox> horizonBoxes; // by slot
+    std::vector<std::size_t> horizonPlanes;
+
+    // Velocity Verlet: accelerations at the end of the last step, valid while the bodies are unchanged
+    Vector3DArray verletAcc;
+    std::size_t   verletVersion  = 0;
+    bool          verletAccValid = false;
+    // Runge-Kutta buffers of RK4 and BS32, reused between steps: start state, weighted sums of the stage
+    // derivatives, and the stage derivatives of BS32 (kept for the dense output of the last step)
+    Vector3DArray                rkPos0;
+    Vector3DArray                rkVel0;
+    Vector3DArray                rkSumX;
+    Vector3DArray                rkSumV;
+    std::array<Vector3DArray, 4> rkStageX;
+    std::array<Vector3DArray, 4> rkStageV;
+
+    // Adaptive stepping (BS32): error tolerances, size of the next step, and the steps taken
+    decimal absTolerance   = config.getAbsTolerance();
+    decimal relTolerance   = config.getRelTolerance();
+    decimal adaptiveStep   = timeStep;
+    decimal lastStep       = timeStep; // length of the last step of `integrate`
+    decimal denseStep      = 0_d;      // length of the last BS32 step, 0 once its dense output is stale
+    double  simulationTime = 0.0;      // in double, so that many small steps add up without drift
+
+    // Multi-rate stepping: each body moves with a step of `timeStep / 2^level` (see integrateMultiRate)
+    std::size_t               maxTimeLevel = config.getMaxTimeLevel();
+    std::vector<std::uint8_t> timeLevels;          // by slot, levels of the last step
+    std::vector<decimal>      levelMasks;          // by slot, sub-steps covered by the move of the body, or 0
+    bool                      subStepping = false; // integrators read `levelMasks`, not the motion masks
+    std::size_t               bodyUpdates = 0;
+    /// Sub-steps of a body over a period of its stiffest contact, at least.
+    static constexpr decimal stepsPerContactPeriod = 16_d;
+    /// Islands of the implicit solver up to this many bodies are solved exactly, larger ones block by block.
+    static constexpr std::size_t maxDirectIsland = 64;
+
+    unsigned int nextObjectId     = 0;
+    std::size_t  forceEvaluations = 0;
+
+    /// Smallest chunks handed to a thread: slots of the array kernels, pairs of the contact passes.
+    static constexpr std::size_t slotGrain = 4096;
+    static constexpr std::size_t pairGrain = 64;
+
+    /// Call `function(first, last)` on chunks of the body slots, over the pool.
+    template <typename Function>
+    void forEachSlotChunk(Function&& function)
+    {
+        const std::size_t n = bodies.size();
+        threadPool->parallelFor(0, n, threadPool->grainFor(n, slotGrain), function);
+    }
+    /// Narrow phase of every candidate pair on the pool, into `contacts` and `contactFound`.
+    void computeContacts();
+    /// Collision response of pair `k`, inside the island being solved.
+    void solveContact(std::size_t k);
+    /// Wake the sleep groups of the sleeping bodies paired with an awake one; true if any woke up.
+    bool wakeContacts();
+    /// True if the body of `slot` is a dynamic sphere swept by the continuous collision.
+    bool isSwept(std::size_t slot) const;
+    /// Keep the start positions in `sweepStart` if a body is swept, before the bodies are integrated.
+    void saveSweepStarts();
+    /// Stop every swept sphere at its first impact along its motion since `saveSweepStarts`.
+    void advanceToImpacts();
+    /// Move the bodies over the next step of `integrate`, of `timeStep` or adaptive; returns its length.
+    decimal advanceBodies();
+    /// Lower bound on the time before the body of `slot`, in ballistic flight, can touch the body of `other`.
+    decimal pairFlightTime(std::size_t slot, std::size_t other) const;
+    /// Box covering the body of `slot` over a ballistic flight of `span`; its current box if it cannot move.
+    BoundingBox sweptBox(std::size_t slot, decimal span) const;
+    /// Time before which no contact can start, searched up to `span`: `span` if none can start sooner. Only
+    /// known to be below `threshold` when it is.
+    decimal contactHorizon(decimal span, decimal threshold);
+    /// Time before the body of `slot`, at its current velocity and acceleration, moves by half its smallest
+    /// size: a step no longer cannot carry it through another body.
+    decimal motionTime(std::size_t slot) const;
+    /// Smallest `motionTime` of the dynamic bodies.
+    decimal motionLimit();
+    /// Motion masks of the integrators: the level masks during a multi-rate sub-step.
+    const std::vector<decimal>& motionMasks() const
+    {
+        return subStepping ? levelMasks : bodies.getMotionMasks();
+    }
+    /// True if the body of `slot` moves at the current (sub-)step.
+    bool isStepped(std::size_t slot) const
+    {
+        return bodies.isDynamic(slot) && (!subStepping || levelMasks[slot] > 0_d);
+    }
+    /// Choose the time level of every body into `timeLevels`; returns the finest one.
+    std::size_t assignTimeLevels();
+    /// Move every body over `timeStep` in sub-steps of its time level.
+    void integrateMultiRate();
+    /// Collision response of the candidate pairs with a body moved at the current sub-step.
+    void solveSubStepCollisions();
+    /// Evaluate the Velocity Verlet accelerations again if bodies or forces changed since the last step.
+    void updateVerletAcc();
+    /// Velocity change over the step `h` of the bodies of an island of the implicit solver, into their
+    /// accelerations as `Δv / h`. `local` gives the index of each body in `members`, or `none`.
+    void solveImplicitIsland(std::span<const std::uint32_t> members, std::span<const std::size_t> islandPairs,
+                             std::span<const Physics::ContactModel> models,
+                             std::span<const std::uint32_t> local, decimal h);
+    /// Write a row of the motion file of `slot`.
+    void writeMotionRow(std::size_t slot, decimal time, const Vector3D& position, const Vector3D& velocity,
+                        const Vector3D& acceleration);
+    /// Destroy `obj` if one of the pools owns it.
+    void destroyOwned(Object* obj);
+
+    /// Arena of the objects of type `T` in `world`, and the ObjectType of its handles.
+    template <typename T, typename World>
+    static auto& poolOf(World& world)
+    {
+        if constexpr (std::is_same_v<T, Sphere>)
+            return world.spheres;
+        else if constexpr (std::is_same_v<T, AABB>)
+            return world.boxes;
+        else
+        {
+            static_assert(std::is_same_v<T, Plane>, "The world owns Spheres, AABBs and Planes only");
+            return world.planes;
+        }
+    }
+    template <typename T>
+    static constexpr ObjectType poolType()
+    {
+        if constexpr (std::is_same_v<T, Sphere>)
+            return ObjectType::Sphere;
+        else if constexpr (std::is_same_v<T, AABB>)
+            return ObjectType::AABB;
+        else
+            return ObjectType::Plane;
+    }
 
 public:
     // ============================================================================
     /// @name Constructors / Destructors
     // ============================================================================
     /// @{
-    PhysicsWorld() = default;
+    PhysicsWorld()
+    {
+        frame.setThreadPool(threadPool.get());
+        broadPhase->setThreadPool(threadPool.get());
+        broadPhase->setBodyFlags(&bodies.getFlags());
+        narrowPhase.setCaching(config.getPairCaching());
+        contactSolver.setIterations(config.getVelocityIterations(), config.getPositionIterations());
+    }
     explicit PhysicsWorld(Config& _config)
         : config(_config)
     {
+        frame.setThreadPool(threadPool.get());
         (*this).initialise();
     }
     ~PhysicsWorld() { clearObjects(); };
@@ -56,23 +248,86 @@ public:
     /// @name Getters
     // ============================================================================
     /// @{
-    Config&      getConfig() const;
-    bool         getIsRunning() const;
-    decimal      getTimeStep() const;
-    decimal      getGravityCst() const;
-    Vector3D     getGravityAcc() const;
-    Solver       getSolver() const;
-    unsigned int getNextObjectId() const { return nextObjectId; }
+    Config&        getConfig() const;
+    bool           getIsRunning() const;
+    decimal        getTimeStep() const;
+    decimal        getGravityCst() const;
+    Vector3D       getGravityAcc() const;
+    Solver         getSolver() const;
+    BroadPhaseType getBroadPhaseType() const;
+    std::size_t    getThreadCount() const;
+    bool           getDeterministic() const;
+    decimal        getSleepEnergy() const;
+    decimal        getSleepTime() const;
+    bool           getContinuousCollision() const;
+    bool           getEventDriven() const;
+    bool           getPairCaching() const;
+    decimal        getAbsTolerance() const;
+    decimal        getRelTolerance() const;
+    std::size_t    getMaxTimeLevel() const;
+    /// Time levels of the bodies at the last step, by slot: the body moved in steps of `timeStep / 2^level`.
+    const std::vector<std::uint8_t>& getTimeLevels() const { return timeLevels; }
+    /// Bodies moved by the multi-rate steps, summed over their sub-steps.
+    std::size_t getBodyUpdateCount() const { return bodyUpdates; }
+    /// Simulated time: sum of the steps of `integrate` and of the jumps of `fastForward`.
+    decimal getTime() const { return static_cast<decimal>(simulationTime); }
+    /// Length of the last step of `integrate`: `timeStep`, or the accepted step of the adaptive solver.
+    decimal getLastStep() const { return lastStep; }
+    unsigned int   getNextObjectId() const { return nextObjectId; }
+    /// Contact response of `solveCollisions`.
+    ContactSolverType    getContactSolverType() const { return contactSolverType; }
+    const ContactSolver& getContactSolver() const { return contactSolver; }
+    /// Number of jumps made by `fastForward` since construction.
+    std::size_t getFastForwardCount() const { return fastForwards; }
+    /// Number of whole-system force evaluations (`applyForces`) since construction.
+    std::size_t getForceEvaluationCount() const { return forceEvaluations; }
+    /// Candidate pairs produced by the last broad-phase update.
+    const std::vector<CollisionPair>& getCandidatePairs() const { return pairs; }
+    /// Contact islands of the last multithreaded collision pass or sleep update.
+    const ContactIslands& getIslands() const { return islands; }
+    /// Pair buckets of the last narrow phase run over all the candidate pairs.
+    const NarrowPhase& getNarrowPhase() const { return narrowPhase; }
+    /// Arena of the transient data of a step.
+    const FrameArena& getFrameArena() const { return frame; }
+    /// Number of bodies currently asleep.
+    std::size_t getSleepingCount() const;
+    /// Number of awake, non fixed bodies.
+    std::size_t getAwakeCount() const;
     /// @}
 
     // ============================================================================
     /// @name Setters
     // ============================================================================
     /// @{
+    /// Select the integrator ("Euler", "Verlet", "RK4", "BS32", "Implicit").
     void setSolver(const std::string& _solver);
+    /// Local error tolerances of the adaptive solver: absolute, and relative to the state.
+    void setTolerances(decimal absolute, decimal relative);
+    /// Finest time level of the multi-rate stepping, 0 to step every body with `timeStep`.
+    void setMaxTimeLevel(std::size_t level);
+    /// Select the broad-phase algorithm ("BruteForce", "SweepAndPrune", "UniformGrid", "BVH", "Auto").
+    void setBroadPhase(const std::string& _broadPhase);
+    /// Skip the pairs known apart in the brute-force broad phase and the narrow phase (false: test them all).
+    void setPairCaching(bool caching);
     void setTimeStep(decimal step);
     void setGravityCst(decimal g);
     void setGravityAcc(const Vector3D& acc);
+    /// Run the step passes on `count` threads, the calling one included (0: all hardware threads).
+    void setThreadCount(std::size_t count);
+    /// Keep results bit-identical to the single-thread path (see `solveCollisions`).
+    void setDeterministic(bool det);
+    /// Kinetic energy (J) below which bodies may fall asleep, for bodies without their own; 0 disables it.
+    void setSleepEnergy(decimal energy);
+    /// Time an island must stay below the sleep energy before falling asleep.
+    void setSleepTime(decimal time);
+    /// Sweep every dynamic sphere at each step, not only the ones set continuous (`Object::setIsContinuous`).
+    void setContinuousCollision(bool ccd);
+    /// Let `run` skip the free flights in closed form, stepping only while bodies may be in contact.
+    void setEventDriven(bool events);
+    /// Select the contact response ("Rebound", "SequentialImpulse").
+    void setContactSolver(const std::string& name);
+    /// Passes of the sequential-impulse solver over each island: velocity, then penetration ones.
+    void setSolverIterations(std::size_t velocity, std::size_t position);
     /// @}
 
     // ============================================================================
@@ -85,13 +340,7 @@ public:
     void start() { isRunning = true; }
     void stop() { isRunning = false; }
     /// Re-initialise PhysicsWorld
-    void resetAcc()
-    {
-        for (auto* obj : objects)
-        {
-            obj->setAcceleration(Vector3D(0_d));
-        }
-    }
+    void resetAcc();
     /// @}
 
     // ============================================================================
@@ -113,10 +362,14 @@ public:
     void applyContactForces(Object& obj, Object& other);
     /// Compute and apply all forces for the curent physics step on one Object.
     void computeAcceleration(Object& obj);
+    /// Run the broad phase and refresh the candidate pair list.
+    void updateBroadPhase();
     /// Compute and apply all forces for the current physics step.
     void applyForces();
     /// Solve collisions between objects.
     void solveCollisions();
+    /// Advance the sleep timers of the bodies over `dt` and put the resting islands to sleep.
+    void updateSleeping(decimal dt);
     /// @}
 
     // ============================================================================
@@ -131,13 +384,34 @@ public:
     /// Runge-Kutta 4 integrator for one object.
     Derivative evaluateRK4(const Object& obj, const Derivative& d, decimal dt);
     void       integrateRK4(Object& obj, decimal dt);
+    /// @brief Velocity Verlet step of the whole system, with a single force evaluation.
+    void integrateVerletBodies(decimal dt);
+    /// @brief Runge-Kutta 4 step of the whole system: each stage evaluates the forces of every body at once.
+    void integrateRK4Bodies(decimal dt);
+    /// @brief Bogacki-Shampine 3(2) step of the whole system, of at most `maxStep`, sized by the error
+    /// tolerances. Returns the length of the accepted step.
+    decimal integrateBS32Bodies(decimal maxStep);
+    /// @brief Linearly implicit Euler step of the whole system, implicit in the contact springs and dampers
+    /// of each island.
+    void integrateImplicitBodies(decimal dt);
+    /// @brief Integrate all dynamic bodies over `dt` with the world solver, in vectorised passes over the
+    /// body arrays. Accelerations must be up to date.
+    void integrateBodies(decimal dt);
     /// @brief Integrate all objects over one time step without collision resolution.
     /// Only for testing purposes.
     void integrateWithoutCollisions();
     /// @brief Integrate all objects over one time step.
     /// Resets accelerations, applies forces, and moves objects using semi-implicit Euler.
     void integrate();
-    /// Run simulation over all iterations.
+    /**
+     * @brief Jump over whole time steps while every awake body is in free flight.
+     *
+     * @param maxSteps Largest number of steps to skip.
+     * @return The number of steps skipped; 0 if a body may touch another one within the next step.
+     */
+    std::size_t fastForward(std::size_t maxSteps);
+    /// Run simulation over all iterations; paced and recorded by a RealTimeDriver if the configuration sets a
+    /// real-time factor or an output rate.
     void run();
     /// @}
 
@@ -146,25 +420,50 @@ public:
     // ============================================================================
     /// @{
 
-    /// Add Object in the PhysicaWorld.
+    /// Add Object in the PhysicaWorld: its state moves to the body storage and `obj` becomes a view on it.
     void addObject(Object* obj)
     {
         if (obj)
         {
             obj->setId(nextObjectId++);
-            objects.push_back(obj);
+            bodies.add(*obj);
         }
     }
-    void removeObject(Object* obj)
+    /// Construct a Sphere, AABB or Plane from `args` in the arena of its type and add it; the world owns it.
+    template <typename T, typename... Args>
+    ObjectHandle createObject(Args&&... args)
+    {
+        ObjectPool<T>&      pool       = poolOf<T>(*this);
+        const std::uint32_t index      = pool.create(std::forward<Args>(args)...);
+        const std::uint32_t generation = pool.getGeneration(index);
+        addObject(pool.get(index, generation));
+        return { poolType<T>(), index, generation };
+    }
+    /// Object of a handle, or null once it was destroyed.
+    Object* getObject(ObjectHandle handle) const;
+    template <typename T>
+    T* getObject(ObjectHandle handle) const
+    {
+        if (handle.type != poolType<T>())
+            return nullptr;
+        return poolOf<T>(*this).get(handle.index, handle.generation);
+    }
+    /// Remove Object from the PhysicsWorld in constant time; the last body moves to its index. An Object
+    /// owned by the world is destroyed, any other one gets its state back and stays usable.
+    void removeObject(Object* obj);
+    /// Remove and destroy the Object of a handle; does nothing if it is already gone.
+    void destroyObject(ObjectHandle handle) { removeObject(getObject(handle)); }
+    /// Remove every Object and destroy the ones owned by the world; their arenas are kept for reuse.
+    void clearObjects();
+    size_t  getObjectCount() const { return bodies.size(); }
+    Object* getObject(size_t index) const
     {
-        objects.erase(std::remove(objects.begin(), objects.end(), obj), objects.end());
+        return (index < bodies.size()) ? bodies.getObject(index) : nullptr;
     }
-    /// Clear Object array
-    void    clearObjects() { objects.clear(); }
-    size_t  getObjectCount() const { return objects.size(); }
-    Object* getObject(size_t index) const { return (index < objects.size()) ? objects[index] : nullptr; }
-    Object* getObject(size_t index) { return (index < objects.size()) ? objects[index] : nullptr; }
-    std::vector<Object*> getObject() { return objects; }
+    Object* getObject(size_t index) { return (index < bodies.size()) ? bodies.getObject(index) : nullptr; }
+    /// Objects by index; destroyed user Objects leave null entries.
+    const std::vector<Object*>& getObject() const { return bodies.getObjects(); }
+    const BodyStorage&          getBodies() const { return bodies; }
     /// @}
 
     // ============================================================================
@@ -176,6 +475,9 @@ public:
     void printState() const;
     void initCSV(const std::string& directory);
     void saveObjectsCSV();
+    /// Write the state of the bodies at `time`; within the last BS32 step, it is interpolated.
     void saveMotionCSV(decimal time);
+    /// Write the given positions and velocities of the bodies at `time`, interpolated by the caller.
+    void saveMotionCSV(decimal time, const Vector3DArray& positions, const Vector3DArray& velocities);
     /// @}
 };
@@ -0,0 +1,143 @@
+/**
+ * @file realtime_driver.hpp
+ * @brief Fixed-step loop of a PhysicsWorld, paced on the wall clock and recorded at its own rate.
+ *
+ * The world always moves by whole steps of its solver. The driver decides when they are taken:
+ *  - `run` steps over a simulated duration, each step starting when the wall clock reaches its simulated
+ *    start divided by the real-time factor (1: real time, 10: ten times faster, 0: as fast as possible);
+ *  - `advance` is the accumulator of an interactive loop: it takes the steps covered by the wall time of a
+ *    frame, and leaves the remainder as the interpolation factor of the rendered state (`interpolate`).
+ *
+ * The state is recorded at `outputRate` times per simulated second, independently of the step: a record
+ * falling between two step ends is interpolated between them (the dense output for BS32). The driver
+ * measures the latency of each step, the lateness of its start on the schedule and the steps ending after
+ * the start of the next one, for rigs needing a steady step rate.
+ */
+#pragma once
+
+#include "objects/body_storage.hpp"
+#include "utilities/timer.hpp"
+#include "world/physicsWorld.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+
+/**
+ * @class RealTimeDriver
+ * @brief Steps a PhysicsWorld on a wall-clock schedule, recording it at a fixed output rate.
+ */
+struct RealTimeDriver
+{
+private:
+    using Clock = std::chrono::steady_clock;
+
+    PhysicsWorld& world;
+    decimal       realTimeFactor;
+    decimal       outputRate;
+
+    // Accumulator of `advance`: simulated time owed to the world, and the time given up to catch up
+    double accumulator = 0.0;
+    double droppedTime = 0.0;
+
+    // State at the start and at the end of the last step, for the interpolation
+    Vector3DArray previousPos;
+    Vector3DArray previousVel;
+    double        previousTime = 0.0;
+    double        currentTime  = 0.0;
+    // Records: index of the next one (at `nextRecord / outputRate`), and the count written
+    long long   nextRecord  = 0;
+    std::size_t recordCount = 0;
+    double      lastRecord  = 0.0;
+    // Interpolated state of a record
+    Vector3DArray recordPos;
+    Vector3DArray recordVel;
+
+    // Last part of a wait spent spinning rather than sleeping, as a sleep may overrun its deadline
+    Clock::duration spinMargin = std::chrono::microseconds(200);
+
+    LatencyHistogram stepLatency;
+    LatencyHistogram startJitter;
+    std::size_t      stepCount      = 0;
+    std::size_t      deadlineMisses = 0;
+
+    /// Lag on the schedule, in steps, beyond which the schedule is shifted rather than caught up.
+    static constexpr std::size_t maxCatchUpSteps = 8;
+
+    /// Take one step of the world, measure it and write the records it passes.
+    void step();
+    /// Write the records due in (`previousTime`, `currentTime`].
+    void recordDue();
+    /// Wait until `deadline`: sleep, then spin over the last `spinMargin`.
+    void waitUntil(Clock::time_point deadline) const;
+
+public:
+    // ============================================================================
+    /// @name Constructors
+    // ============================================================================
+    /// @{
+    /// Driver of `world`, with the real-time factor and the output rate of its configuration.
+    explicit RealTimeDriver(PhysicsWorld& world);
+    /// @}
+
+    // ============================================================================
+    /// @name Getters / Setters
+    // ============================================================================
+    /// @{
+    decimal getRealTimeFactor() const { return realTimeFactor; }
+    decimal getOutputRate() const { return outputRate; }
+    /// Simulated seconds per wall-clock second, 0 to step as fast as possible.
+    void setRealTimeFactor(decimal factor);
+    /// Records per simulated second, 0 to record every step.
+    void setOutputRate(decimal rate);
+    /// Part of each wait spent spinning; a margin longer than a step keeps a core busy for the steadiest
+    /// starts.
+    void setSpinMargin(std::chrono::nanoseconds margin) { spinMargin = margin; }
+
+    /// Steps taken by the driver.
+    std::size_t getStepCount() const { return stepCount; }
+    /// States recorded by the driver (written only if the configuration saves them).
+    std::size_t getRecordCount() const { return recordCount; }
+    /// Simulated time of the last record.
+    decimal getLastRecordTime() const { return static_cast<decimal>(lastRecord); }
+    /// Simulated time given up when the world could not keep up with the schedule.
+    decimal getDroppedTime() const { return static_cast<decimal>(droppedTime); }
+    /// Steps ending after the scheduled start of the next one.
+    std::size_t getDeadlineMisses() const { return deadlineMisses; }
+    /// Wall time of each step, in nanoseconds.
+    const LatencyHistogram& getStepLatency() const { return stepLatency; }
+    /// Delay of the start of each paced step on its schedule, in nanoseconds.
+    const LatencyHistogram& getStartJitter() const { return startJitter; }
+    /// Fraction of a step left in the accumulator of `advance`, in [0, 1).
+    decimal getAlpha() const;
+    /// @}
+
+    // ============================================================================
+    /// @name Stepping
+    // ============================================================================
+    /// @{
+    /**
+     * @brief Step the world over `duration` simulated seconds, paced by the real-time factor.
+     *
+     * A step falling behind its schedule by more than `maxCatchUpSteps` steps shifts the schedule, the
+     * time lost being counted in `getDroppedTime`. Stops early if the world is stopped.
+     */
+    void run(decimal duration);
+    /**
+     * @brief Take the steps covered by `frameTime` wall-clock seconds, times the real-time factor.
+     *
+     * Without a real-time factor, a call takes one step. The remainder is kept for the next call, up to
+     * `maxCatchUpSteps` steps. Returns the number of steps taken.
+     */
+    std::size_t advance(double frameTime);
+    /**
+     * @brief State of the bodies at `alpha` of the last step, linear between its two ends.
+     *
+     * With `getAlpha`, the state to render after `advance`: one step behind the world, never extrapolated.
+     */
+    void interpolate(decimal alpha, Vector3DArray& positions, Vector3DArray& velocities) const;
+    /// @}
+
+    /// Print the step latency, the start jitter and the misses.
+    void printReport(std::ostream& out) const;
+};
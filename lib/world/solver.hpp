@@ -8,6 +8,8 @@ enum class Solver : std::uint8_t
     Euler,
     Verlet,
     RK4,
+    BS32,     // Bogacki-Shampine 3(2), adaptive step
+    Implicit, // linearly implicit Euler, implicit in the contact springs and dampers
     Unknown
 };
 
@@ -21,6 +23,10 @@ inline std::ostream& operator<<(std::ostream& os, Solver s) noexcept
         return os << "Verlet";
     case Solver::RK4:
         return os << "RK4";
+    case Solver::BS32:
+        return os << "BS32";
+    case Solver::Implicit:
+        return os << "Implicit";
     case Solver::Unknown:
         return os << "Unknown";
     }
@@ -2,6 +2,9 @@
 
 #include "mathematics/common.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 //  Sphere vs Sphere
 
 /**
@@ -135,3 +138,68 @@ bool BroadCollision::isColliding(const Plane& plane1, const Plane& plane2)
     return commonMaths::approxSmallerOrEqualThan(
         commonMaths::absVal(dist), (0.5 * plane1.getSize()).getMax() + (0.5 * plane2.getSize()).getMax());
 }
+
+// ============================================================================
+//  Separations
+// ============================================================================
+// Each one is the distance by which the quantity compared in `isColliding` exceeds its threshold (tolerance
+// included), divided by how fast a relative translation can change that quantity.
+
+/**
+ * @brief Separation of two Spheres: distance between centers minus the largest colliding distance.
+ */
+decimal BroadCollision::separation(const Sphere& sphere1, const Sphere& sphere2)
+{
+    const decimal r = sphere1.getRadius() + sphere2.getRadius();
+    return (sphere2.getCenter() - sphere1.getCenter()).getNorm() - std::sqrt(r * r + PRECISION_MACHINE);
+}
+
+/**
+ * @brief Separation of a Sphere and an AABB, as bounding spheres.
+ */
+decimal BroadCollision::separation(const Sphere& sphere, const AABB& aabb)
+{
+    const decimal dist = (sphere.getCenter() - aabb.getPosition()).getNorm();
+    return dist - (aabb.getHalfExtents().getNorm() + sphere.getRadius() + PRECISION_MACHINE);
+}
+
+/**
+ * @brief Separation of a Sphere and a Plane along the plane normal.
+ */
+decimal BroadCollision::separation(const Sphere& sphere, const Plane& plane)
+{
+    const Vector3D n    = plane.getNormal().getNormalised();
+    const decimal  dist = (sphere.getCenter() - plane.getPosition()).dotProduct(n);
+    return commonMaths::absVal(dist) -
+           (sphere.getRadius() + (0.5 * plane.getSize()).getMax() + PRECISION_MACHINE);
+}
+
+/**
+ * @brief Separation of two AABBs: the largest gap between their projections on the world axes.
+ */
+decimal BroadCollision::separation(const AABB& aabb1, const AABB& aabb2)
+{
+    const Vector3D gap1 = aabb2.getMin() - aabb1.getMax();
+    const Vector3D gap2 = aabb1.getMin() - aabb2.getMax();
+    return std::max({ gap1.getX(), gap1.getY(), gap1.getZ(), gap2.getX(), gap2.getY(), gap2.getZ() });
+}
+
+/**
+ * @brief Separation of an AABB and a Plane along the plane normal.
+ */
+decimal BroadCollision::separation(const AABB& aabb, const Plane& plane)
+{
+    const Vector3D n    = plane.getNormal().getNormalised();
+    const decimal  proj = aabb.getHalfExtents().dotProduct(n.getAbsolute());
+    const decimal  dist = (aabb.getPosition() - plane.getPosition()).dotProduct(n);
+    return commonMaths::absVal(dist) - (proj + PRECISION_MACHINE);
+}
+
+/**
+ * @brief Separation of two Planes, as bounding spheres.
+ */
+decimal BroadCollision::separation(const Plane& plane1, const Plane& plane2)
+{
+    const decimal dist = (plane1.getPosition() - plane2.getPosition()).getNorm();
+    return dist - ((0.5 * plane1.getSize()).getMax() + (0.5 * plane2.getSize()).getMax() + PRECISION_MACHINE);
+}
@@ -0,0 +1,163 @@
+#include "collision/broad_phase.hpp"
+
+#include "collision/broad_phase_manager.hpp"
+#include "collision/bvh_broad_phase.hpp"
+#include "collision/sweep_and_prune.hpp"
+#include "collision/uniform_grid.hpp"
+#include "world/config.hpp"
+
+// ============================================================================
+//  Factory
+// ============================================================================
+BroadPhaseType parseBroadPhase(const std::string& name)
+{
+    if (name == "BruteForce")
+        return BroadPhaseType::BruteForce;
+    if (name == "SweepAndPrune")
+        return BroadPhaseType::SweepAndPrune;
+    if (name == "UniformGrid")
+        return BroadPhaseType::UniformGrid;
+    if (name == "BVH")
+        return BroadPhaseType::BVH;
+    if (name == "Auto")
+        return BroadPhaseType::Auto;
+    return BroadPhaseType::Unknown;
+}
+
+std::unique_ptr<BroadPhase> makeBroadPhase(BroadPhaseType type)
+{
+    switch (type)
+    {
+    case BroadPhaseType::SweepAndPrune:
+        return std::make_unique<SweepAndPrune>();
+    case BroadPhaseType::UniformGrid:
+        return std::make_unique<UniformGrid>(Config::get().getGridCellSize());
+    case BroadPhaseType::BVH:
+        return std::make_unique<BVHBroadPhase>();
+    case BroadPhaseType::Auto:
+        return std::make_unique<BroadPhaseManager>(Config::get().getBroadPhaseSampling());
+    case BroadPhaseType::BruteForce:
+    case BroadPhaseType::Unknown:
+        return std::make_unique<BruteForceBroadPhase>(Config::get().getPairCaching());
+    }
+    return std::make_unique<BruteForceBroadPhase>(Config::get().getPairCaching());
+}
+
+// ============================================================================
+//  Parallel search
+// ============================================================================
+/**
+ * @brief Filter candidate pairs with the polymorphic broad check.
+ *
+ * On a pool, every candidate is tested into its own flag, then the flags are read in order: the output is
+ * the one of the sequential loop. Pairs of sleeping objects are dropped without testing.
+ */
+void BroadPhase::appendColliding(const std::vector<Object*>&       objects,
+                                 const std::vector<CollisionPair>& candidates,
+                                 std::vector<CollisionPair>&       pairs)
+{
+    const std::size_t n = candidates.size();
+    if (!pool || pool->getThreadCount() == 1)
+    {
+        for (const CollisionPair& c : candidates)
+        {
+            if (!isSleepingPair(c.first, c.second) && objects[c.first]->checkCollision(*objects[c.second]))
+                pairs.push_back(c);
+        }
+        return;
+    }
+
+    colliding.resize(n);
+    pool->parallelFor(0, n, pool->grainFor(n, 256),
+                      [&](std::size_t first, std::size_t last)
+                      {
+                          for (std::size_t k = first; k < last; ++k)
+                          {
+                              const CollisionPair& c   = candidates[k];
+                              const bool           hit = !isSleepingPair(c.first, c.second) &&
+                                                         objects[c.first]->checkCollision(*objects[c.second]);
+                              colliding[k]             = hit ? 1 : 0;
+                          }
+                      });
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        if (colliding[k])
+            pairs.push_back(candidates[k]);
+    }
+}
+
+// ============================================================================
+//  Brute force
+// ============================================================================
+/**
+ * @brief Test every pair (i, j), i < j, with the polymorphic broad check of the objects.
+ *
+ * Pairs are generated in lexicographic order, so no sorting is needed. With caching, a pair still known
+ * apart by the pair cache is skipped; otherwise its separation is computed first, and only the pairs it
+ * cannot prove apart are checked.
+ */
+void BruteForceBroadPhase::computePairs(const std::vector<Object*>& objects,
+                                        std::vector<CollisionPair>& pairs)
+{
+    pairs.clear();
+
+    // Rows are split over the pool; small chunks let idle threads steal the long first rows
+    const std::size_t n = objects.size();
+    if (!caching)
+    {
+        collectPairs(n, 16, pairs,
+                     [&](std::size_t first, std::size_t last, std::vector<CollisionPair>& out)
+                     {
+                         for (std::size_t i = first; i < last; ++i)
+                         {
+                             Object* A = objects[i];
+                             if (!A)
+                                 continue;
+
+                             for (std::size_t j = i + 1; j < n; ++j)
+                             {
+                                 Object* B = objects[j];
+                                 if (B && !isSleepingPair(i, j) && A->checkCollision(*B))
+                                     out.push_back({ i, j });
+                             }
+                         }
+                     });
+        return;
+    }
+
+    pairCache.update(objects, pool);
+    collectPairs(n, 16, pairs,
+                 [&](std::size_t first, std::size_t last, std::vector<CollisionPair>& out)
+                 {
+                     for (std::size_t i = first; i < last; ++i)
+                     {
+                         Object* A = objects[i];
+                         if (!A)
+                             continue;
+
+                         PairCache::Row row = pairCache.row(i);
+                         for (std::size_t j = i + 1; j < n; ++j)
+                         {
+                             Object* B = objects[j];
+                             if (!B || isSleepingPair(i, j))
+                                 continue;
+                             if (row.isSeparated(j) || row.store(j, PairCache::getBroadSeparation(*A, *B)))
+                                 continue;
+
+                             if (A->checkCollision(*B))
+                                 out.push_back({ i, j });
+                         }
+                         row.finish();
+                     }
+                 });
+}
+void BruteForceBroadPhase::printStats(std::ostream& os) const
+{
+    if (!caching)
+    {
+        os << "    Pair cache: off\n";
+        return;
+    }
+    os << "    Pair cache: " << pairCache.getEntryCount() << " pairs apart, " << pairCache.getSkippedCount()
+       << " tests skipped\n";
+}
@@ -0,0 +1,232 @@
+#include "collision/broad_phase_manager.hpp"
+
+#include "utilities/timer.hpp"
+
+#include <cmath>
+#include <ostream>
+#include <sstream>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+static std::size_t algorithmIndex(BroadPhaseType type) { return static_cast<std::size_t>(type); }
+
+BroadPhase& BroadPhaseManager::getAlgorithm(BroadPhaseType type)
+{
+    std::unique_ptr<BroadPhase>& algorithm = algorithms[algorithmIndex(type)];
+    if (!algorithm)
+    {
+        algorithm = makeBroadPhase(type);
+        algorithm->setThreadPool(pool);
+        algorithm->setBodyFlags(bodyFlags);
+    }
+    return *algorithm;
+}
+
+decimal BroadPhaseManager::getTiming(BroadPhaseType type) const
+{
+    const std::size_t index = algorithmIndex(type);
+    return index < algorithmCount ? timings[index] : 0_d;
+}
+
+/**
+ * @brief Measure the scene statistics and switch algorithm if needed.
+ *
+ * The pair-test cost is timed on a bounded sample of pairs so that sampling stays cheap on large scenes.
+ */
+void BroadPhaseManager::sample(const std::vector<Object*>& objects)
+{
+    // Count, sizes & fixed bodies
+    std::size_t count      = 0;
+    std::size_t fixedCount = 0;
+    std::size_t sizeCount  = 0;
+    decimal     sum        = 0_d;
+    decimal     sumSquare  = 0_d;
+    for (const Object* obj : objects)
+    {
+        if (!obj)
+            continue;
+        ++count;
+        if (obj->getIsFixed())
+            ++fixedCount;
+        if (obj->getType() == ObjectType::Plane)
+            continue;
+        const decimal size = obj->getBoundingBox().getExtents().getMax();
+        sum += size;
+        sumSquare += size * size;
+        ++sizeCount;
+    }
+    stats.objectCount   = count;
+    stats.fixedFraction = count > 0 ? static_cast<decimal>(fixedCount) / static_cast<decimal>(count) : 0_d;
+    stats.sizeVariation = 0_d;
+    if (sizeCount > 0 && sum > 0_d)
+    {
+        const decimal mean     = sum / static_cast<decimal>(sizeCount);
+        const decimal variance = std::max(sumSquare / static_cast<decimal>(sizeCount) - mean * mean, 0_d);
+        stats.sizeVariation    = std::sqrt(variance) / mean;
+    }
+
+    // Pair-test cost, on up to 256 pairs of consecutive objects
+    const std::size_t n         = objects.size();
+    std::size_t       testCount = 0;
+    Timer             timer;
+    for (std::size_t i = 0; i + 1 < n && testCount < 256; ++i)
+    {
+        Object* A = objects[i];
+        Object* B = objects[i + 1];
+        if (!A || !B)
+            continue;
+        // Only the cost matters
+        static_cast<void>(A->getBoundingBox().overlaps(B->getBoundingBox()) && A->checkCollision(*B));
+        ++testCount;
+    }
+    const long long elapsed = timer.elapsedNanoseconds();
+    if (testCount > 0)
+        stats.pairTestCost = static_cast<decimal>(elapsed) / static_cast<decimal>(testCount);
+
+    // Best measured spatial phase
+    stats.spatialStepCost = 0_d;
+    for (std::size_t index = 1; index < algorithmCount; ++index)
+    {
+        if (timings[index] > 0_d && (stats.spatialStepCost == 0_d || timings[index] < stats.spatialStepCost))
+            stats.spatialStepCost = timings[index];
+    }
+
+    // Decision
+    std::string          reason;
+    const BroadPhaseType preferred = choose(stats, &reason);
+    if (preferred == active)
+    {
+        decision = "kept " + reason;
+        return;
+    }
+
+    const decimal preferredTiming = timings[algorithmIndex(preferred)];
+    const decimal activeTiming    = timings[algorithmIndex(active)];
+    if (preferredTiming > 0_d && activeTiming > 0_d && preferredTiming > switchTolerance * activeTiming)
+    {
+        std::ostringstream os;
+        os << "kept " << active << ": " << preferred << " measured slower (" << reason << ")";
+        decision = os.str();
+        return;
+    }
+
+    std::ostringstream os;
+    os << "switched from " << active << " to " << reason;
+    decision = os.str();
+    active    = preferred;
+    warmingUp = true;
+    ++switchCount;
+}
+
+// ============================================================================
+//  Decision
+// ============================================================================
+BroadPhaseType BroadPhaseManager::choose(const BroadPhaseStats& s, std::string* reason)
+{
+    auto result = [reason](BroadPhaseType type, const std::string& why)
+    {
+        if (reason)
+        {
+            std::ostringstream os;
+            os << type << ": " << why;
+            *reason = os.str();
+        }
+        return type;
+    };
+
+    const decimal n = static_cast<decimal>(s.objectCount);
+    if (s.objectCount <= bruteForceMaxCount)
+        return result(BroadPhaseType::BruteForce, "few objects");
+    const decimal bruteForceCost = 0.5_d * n * (n - 1_d) * s.pairTestCost;
+    if (s.spatialStepCost > 0_d && bruteForceCost > 0_d && bruteForceCost < s.spatialStepCost)
+        return result(BroadPhaseType::BruteForce, "all pairs cheaper than the measured spatial phases");
+    if (s.sizeVariation > unevenSizeVariation)
+        return result(BroadPhaseType::BVH, "uneven object sizes");
+    if (s.fixedFraction > mostlyFixedFraction)
+        return result(BroadPhaseType::BVH, "mostly fixed objects");
+    if (s.objectCount >= gridMinCount)
+        return result(BroadPhaseType::UniformGrid, "many objects of similar size");
+    return result(BroadPhaseType::SweepAndPrune, "medium object count");
+}
+
+// ============================================================================
+//  Broad phase
+// ============================================================================
+void BroadPhaseManager::reset()
+{
+    for (std::unique_ptr<BroadPhase>& algorithm : algorithms)
+    {
+        if (algorithm)
+            algorithm->reset();
+    }
+    timings.fill(0_d);
+    stepCount = 0;
+    warmingUp = true;
+}
+
+void BroadPhaseManager::setThreadPool(ThreadPool* threadPool)
+{
+    pool = threadPool;
+    for (std::unique_ptr<BroadPhase>& algorithm : algorithms)
+    {
+        if (algorithm)
+            algorithm->setThreadPool(pool);
+    }
+}
+void BroadPhaseManager::setBodyFlags(const std::vector<std::uint8_t>* flags)
+{
+    bodyFlags = flags;
+    for (std::unique_ptr<BroadPhase>& algorithm : algorithms)
+    {
+        if (algorithm)
+            algorithm->setBodyFlags(bodyFlags);
+    }
+}
+
+/**
+ * @brief Sample every `sampleInterval` steps, then run the active algorithm and time it.
+ *
+ * The first step after a switch or a reset rebuilds the algorithm from scratch and is not timed.
+ *
+ * The pair list is always produced by exactly one algorithm in the same sorted format, so a switch is
+ * invisible to the narrow phase.
+ */
+void BroadPhaseManager::computePairs(const std::vector<Object*>& objects, std::vector<CollisionPair>& pairs)
+{
+    if (stepCount % sampleInterval == 0)
+        sample(objects);
+    ++stepCount;
+
+    Timer timer;
+    getAlgorithm(active).computePairs(objects, pairs);
+    const decimal elapsed = static_cast<decimal>(timer.elapsedNanoseconds());
+    if (warmingUp)
+    {
+        warmingUp = false;
+        return;
+    }
+
+    // Exponential moving average
+    decimal& timing = timings[algorithmIndex(active)];
+    timing          = timing > 0_d ? 0.8_d * timing + 0.2_d * elapsed : elapsed;
+}
+
+void BroadPhaseManager::printStats(std::ostream& os) const
+{
+    os << "    Active: " << active << " (" << switchCount << " switches, sampled every " << sampleInterval
+       << " steps)\n";
+    os << "    Decision: " << decision << "\n";
+    os << "    Stats: " << stats.objectCount << " objects, size variation " << stats.sizeVariation << ", "
+       << stats.fixedFraction * 100_d << "% fixed, " << stats.pairTestCost << " ns per pair test\n";
+    os << "    Timings:";
+    for (std::size_t index = 0; index < algorithmCount; ++index)
+    {
+        os << " " << static_cast<BroadPhaseType>(index) << "=";
+        if (timings[index] > 0_d)
+            os << timings[index] * 1e-3_d << " us";
+        else
+            os << "-";
+    }
+    os << "\n";
+}
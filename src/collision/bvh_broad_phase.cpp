@@ -0,0 +1,96 @@
+#include "collision/bvh_broad_phase.hpp"
+
+#include <algorithm>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+/// Recreate one leaf per object from scratch. Called on the first step and whenever the object array changed.
+void BVHBroadPhase::rebuild(const std::vector<Object*>& objects)
+{
+    tree.clear();
+    proxyCount = objects.size();
+    proxies.assign(proxyCount, DynamicAABBTree::nullNode);
+    boxes.assign(proxyCount, BoundingBox());
+
+    for (std::size_t i = 0; i < proxyCount; ++i)
+    {
+        if (!objects[i])
+            continue;
+        boxes[i]   = objects[i]->getBoundingBox().getFattened(PRECISION_MACHINE);
+        proxies[i] = tree.createProxy(boxes[i], static_cast<std::uint32_t>(i));
+    }
+    built = true;
+}
+
+// ============================================================================
+//  Broad phase
+// ============================================================================
+/**
+ * @brief Refit the leaves that left their fat box, then query the tree with every object.
+ *
+ * The tree reports overlaps of fat boxes; candidates are then filtered on the tight boxes and with
+ * `Object::checkCollision`, like the brute-force reference.
+ *
+ * Sleeping objects are neither refitted nor queried: their pairs with the awake objects are found by the
+ * queries of the latter.
+ */
+void BVHBroadPhase::computePairs(const std::vector<Object*>& objects, std::vector<CollisionPair>& pairs)
+{
+    pairs.clear();
+    reinsertCount = 0;
+
+    if (!built || objects.size() != proxyCount)
+    {
+        rebuild(objects);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < proxyCount; ++i)
+        {
+            if (!objects[i] || isSleeping(i))
+                continue;
+            boxes[i] = objects[i]->getBoundingBox().getFattened(PRECISION_MACHINE);
+            if (tree.moveProxy(proxies[i], boxes[i]))
+                ++reinsertCount;
+        }
+    }
+
+    // The tree is only read from here: one query per object, split over the pool
+    collectPairs(proxyCount, 64, pairs,
+                 [&](std::size_t first, std::size_t last, std::vector<CollisionPair>& out)
+                 {
+                     for (std::size_t i = first; i < last; ++i)
+                     {
+                         if (!objects[i] || isSleeping(i))
+                             continue;
+
+                         tree.query(boxes[i],
+                                    [&](std::uint32_t j)
+                                    {
+                                        if ((j > i || isSleeping(j)) && !isSleepingPair(i, j) &&
+                                            boxes[i].overlaps(boxes[j]) &&
+                                            objects[i]->checkCollision(*objects[j]))
+                                            out.push_back({ std::min<std::size_t>(i, j),
+                                                            std::max<std::size_t>(i, j) });
+                                        return true;
+                                    });
+                     }
+                 });
+
+    std::sort(pairs.begin(), pairs.end());
+}
+
+// ============================================================================
+//  Queries
+// ============================================================================
+void BVHBroadPhase::queryRegion(const BoundingBox& region, std::vector<std::size_t>& result) const
+{
+    tree.query(region,
+               [&](std::uint32_t i)
+               {
+                   if (boxes[i].overlaps(region))
+                       result.push_back(i);
+                   return true;
+               });
+}
@@ -25,6 +25,13 @@ void positionCorrection(Object& A, Object& B, Contact& contact, decimal percent,
 }
 
 void reboundCollision(Object& A, Object& B, Contact& contact)
+{
+    const decimal e =
+        std::clamp(std::min(A.getMaterial().getRestitution(), B.getMaterial().getRestitution()), 0_d, 1_d);
+    reboundCollision(A, B, contact, e);
+}
+
+void reboundCollision(Object& A, Object& B, Contact& contact, decimal restitution)
 {
     decimal invMassA   = A.getMass() > 0_d ? 1_d / A.getMass() : 0_d;
     decimal invMassB   = B.getMass() > 0_d ? 1_d / B.getMass() : 0_d;
@@ -47,9 +54,7 @@ void reboundCollision(Object& A, Object& B, Contact& contact)
     if (velAlongNormal >= 0_d)
         return;
 
-    decimal e =
-        std::clamp(std::min(A.getMaterial().getRestitution(), B.getMaterial().getRestitution()), 0_d, 1_d);
-    decimal j = -(1_d + e) * velAlongNormal / invMassSum;
+    decimal j = -(1_d + restitution) * velAlongNormal / invMassSum;
 
     Vector3D impulse = n * j;
 
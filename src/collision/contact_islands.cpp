@@ -0,0 +1,95 @@
+#include "collision/contact_islands.hpp"
+
+#include <numeric>
+#include <utility>
+
+// ============================================================================
+//  Union-find
+// ============================================================================
+/// Root of the tree of `slot`, halving the path on the way.
+std::uint32_t ContactIslands::find(std::uint32_t slot)
+{
+    while (parent[slot] != slot)
+    {
+        parent[slot] = parent[parent[slot]];
+        slot         = parent[slot];
+    }
+    return slot;
+}
+void ContactIslands::unite(std::uint32_t a, std::uint32_t b)
+{
+    a = find(a);
+    b = find(b);
+    if (a == b)
+        return;
+    if (treeSize[a] < treeSize[b])
+        std::swap(a, b);
+    parent[b] = a;
+    treeSize[a] += treeSize[b];
+}
+
+// ============================================================================
+//  Construction
+// ============================================================================
+/**
+ * @brief Merge the dynamic ends of every contact, then bucket the pairs by root.
+ *
+ * A contact with a fixed body only attaches the pair to the island of its dynamic end. The bucketing is a
+ * counting sort, so pairs keep their order inside an island.
+ */
+void ContactIslands::build(const BodyStorage& bodies, const std::vector<CollisionPair>& pairs,
+                           const std::uint8_t* isEdge)
+{
+    const std::size_t n = bodies.size();
+    parent.resize(n);
+    std::iota(parent.begin(), parent.end(), 0u);
+    treeSize.assign(n, 1);
+    islandIndex.assign(n, none);
+    islandStart.assign(1, 0);
+    islandPairs.clear();
+
+    auto isContact = [&](std::size_t k) { return !isEdge || isEdge[k] != 0; };
+    for (std::size_t k = 0; k < pairs.size(); ++k)
+    {
+        const CollisionPair& pair = pairs[k];
+        if (isContact(k) && bodies.isDynamic(pair.first) && bodies.isDynamic(pair.second))
+            unite(static_cast<std::uint32_t>(pair.first), static_cast<std::uint32_t>(pair.second));
+    }
+
+    // Island of each pair, numbered by first appearance; counts are accumulated in islandStart[island + 1]
+    pairIsland.assign(pairs.size(), none);
+    for (std::size_t k = 0; k < pairs.size(); ++k)
+    {
+        const CollisionPair& pair = pairs[k];
+        if (!isContact(k))
+            continue;
+        const std::size_t body = bodies.isDynamic(pair.first) ? pair.first : pair.second;
+        if (!bodies.isDynamic(body))
+            continue;
+
+        const std::uint32_t root = find(static_cast<std::uint32_t>(body));
+        if (islandIndex[root] == none)
+        {
+            islandIndex[root] = static_cast<std::uint32_t>(islandStart.size() - 1);
+            islandStart.push_back(0);
+        }
+        pairIsland[k] = islandIndex[root];
+        ++islandStart[pairIsland[k] + 1];
+    }
+    bodyIsland.assign(n, none);
+    for (std::size_t slot = 0; slot < n; ++slot)
+    {
+        if (bodies.isDynamic(slot))
+            bodyIsland[slot] = islandIndex[find(static_cast<std::uint32_t>(slot))];
+    }
+
+    // Counting sort of the pairs by island
+    std::partial_sum(islandStart.begin(), islandStart.end(), islandStart.begin());
+    islandPairs.resize(islandStart.back());
+    cursor.assign(islandStart.begin(), islandStart.end() - 1);
+    for (std::size_t k = 0; k < pairs.size(); ++k)
+    {
+        if (pairIsland[k] != none)
+            islandPairs[cursor[pairIsland[k]]++] = k;
+    }
+}
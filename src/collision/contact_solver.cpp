@@ -0,0 +1,234 @@
+/**
+ * @file contact_solver.cpp
+ * @brief Implementation of the sequential-impulse contact solver.
+ *
+ * @see contact_solver.hpp
+ */
+#include "collision/contact_solver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+ContactSolverType parseContactSolver(const std::string& name)
+{
+    if (name == "Rebound")
+        return ContactSolverType::Rebound;
+    if (name == "SequentialImpulse")
+        return ContactSolverType::SequentialImpulse;
+    return ContactSolverType::Unknown;
+}
+
+/// Add `impulse` to body `a` and subtract it from body `b`, weighted by their inverse masses.
+static void applyImpulse(Vector3DArray& vel, std::uint32_t a, std::uint32_t b, decimal invMassA,
+                         decimal invMassB, const Vector3D& impulse)
+{
+    // Fixed bodies may be shared by several islands: they are never written
+    if (invMassA > 0_d)
+        vel.set(a, vel.get(a) + impulse * invMassA);
+    if (invMassB > 0_d)
+        vel.set(b, vel.get(b) - impulse * invMassB);
+}
+
+// ============================================================================
+//  Constraints
+// ============================================================================
+/**
+ * @brief One constraint per contact with a dynamic body, warm-started from the cache.
+ *
+ * The normal is oriented from `b` to `a`, as in `reboundCollision`. Contacts approaching faster than
+ * `restingSpeed` bounce with the smaller restitution of the two materials; slower ones are resting contacts
+ * and only stop.
+ */
+void ContactSolver::buildConstraints(const BodyStorage& bodies, const std::vector<CollisionPair>& pairs,
+                                     std::span<const Contact> contacts, std::span<const std::uint8_t> found,
+                                     decimal restingSpeed, FrameArena& frame)
+{
+    const Vector3DArray&        pos     = bodies.getPositions();
+    const Vector3DArray&        vel     = bodies.getVelocities();
+    const std::vector<decimal>& invMass = bodies.getInverseMasses();
+
+    // At most one constraint per pair; the unused tail is left to the frame
+    const std::span<Constraint> slots = frame.allocate<Constraint>(pairs.size());
+    std::size_t                 count = 0;
+    pairConstraint                    = frame.allocate<std::uint32_t>(pairs.size(), none);
+    isConstraint                      = frame.allocate<std::uint8_t>(pairs.size(), 0);
+    inContact                         = frame.allocate<std::uint8_t>(bodies.size(), 0);
+    for (std::size_t k = 0; k < pairs.size(); ++k)
+    {
+        const std::size_t a = pairs[k].first;
+        const std::size_t b = pairs[k].second;
+        if (!found[k] || (!bodies.isDynamic(a) && !bodies.isDynamic(b)))
+            continue;
+
+        Constraint c;
+        c.a        = static_cast<std::uint32_t>(a);
+        c.b        = static_cast<std::uint32_t>(b);
+        c.invMassA = bodies.isDynamic(a) ? invMass[a] : 0_d;
+        c.invMassB = bodies.isDynamic(b) ? invMass[b] : 0_d;
+        if (c.invMassA + c.invMassB <= 0_d)
+            continue;
+        c.normalMass = 1_d / (c.invMassA + c.invMassB);
+
+        c.normal = contacts[k].normal;
+        if ((pos.get(a) - pos.get(b)).dotProduct(c.normal) < 0_d)
+            c.normal = -c.normal;
+        c.penetration = contacts[k].penetration;
+        c.separation  = (pos.get(a) - pos.get(b)).dotProduct(c.normal);
+
+        const MaterialPair& material = bodies.getMaterialPair(a, b);
+        const decimal       approach = (vel.get(a) - vel.get(b)).dotProduct(c.normal);
+        c.friction                   = material.friction;
+        c.bounce                     = approach < -restingSpeed ? -material.restitution * approach : 0_d;
+
+        const ObjectColdData& coldA = bodies.getColdData(a);
+        const ObjectColdData& coldB = bodies.getColdData(b);
+
+        // Cached impulses of the same pair of objects, last step
+        const std::uint64_t low  = std::min(coldA.id, coldB.id);
+        const std::uint64_t high = std::max(coldA.id, coldB.id);
+        c.key                    = (low << 32) | high;
+        c.flipped                = coldA.id > coldB.id;
+        c.normalImpulse          = 0_d;
+        c.tangentImpulse         = Vector3D(0_d);
+        const auto it = std::lower_bound(cache.begin(), cache.end(), c.key,
+                                         [](const CachedImpulse& cached, std::uint64_t key)
+                                         { return cached.key < key; });
+        if (it != cache.end() && it->key == c.key)
+        {
+            // Only the part of the friction impulse in the new tangent plane is kept
+            const Vector3D tangent = c.flipped ? -it->tangent : it->tangent;
+            c.normalImpulse        = it->normal;
+            c.tangentImpulse       = tangent - c.normal * tangent.dotProduct(c.normal);
+        }
+
+        pairConstraint[k] = static_cast<std::uint32_t>(count);
+        isConstraint[k]   = 1;
+        inContact[a]      = inContact[a] || c.invMassA > 0_d;
+        inContact[b]      = inContact[b] || c.invMassB > 0_d;
+        slots[count++]    = c;
+    }
+    constraints = slots.first(count);
+}
+void ContactSolver::warmStart(BodyStorage& bodies, const Constraint& c) const
+{
+    applyImpulse(bodies.getVelocities(), c.a, c.b, c.invMassA, c.invMassB,
+                 c.normal * c.normalImpulse + c.tangentImpulse);
+}
+/**
+ * @brief One visit of a contact: normal impulse, then friction inside the cone of the updated normal one.
+ *
+ * Both are accumulated: the increment may be negative, as long as the total stays admissible.
+ */
+void ContactSolver::solveVelocity(BodyStorage& bodies, Constraint& c) const
+{
+    Vector3DArray& vel = bodies.getVelocities();
+
+    // Normal: relative velocity along the normal brought to `bounce`, pushing only
+    const decimal approach   = (vel.get(c.a) - vel.get(c.b)).dotProduct(c.normal);
+    const decimal previous   = c.normalImpulse;
+    c.normalImpulse          = std::max(previous + c.normalMass * (c.bounce - approach), 0_d);
+    const decimal normalStep = c.normalImpulse - previous;
+    applyImpulse(vel, c.a, c.b, c.invMassA, c.invMassB, c.normal * normalStep);
+
+    if (c.friction <= 0_d)
+        return;
+
+    // Friction: tangential relative velocity cancelled, within |impulse| <= friction * normal impulse
+    const Vector3D relative = vel.get(c.a) - vel.get(c.b);
+    const Vector3D sliding  = relative - c.normal * relative.dotProduct(c.normal);
+    const Vector3D start    = c.tangentImpulse;
+    Vector3D       tangent  = start - sliding * c.normalMass;
+    const decimal  limit    = c.friction * c.normalImpulse;
+    const decimal  norm2    = tangent.getNormSquare();
+    if (norm2 > limit * limit)
+        tangent *= limit / std::sqrt(norm2);
+    c.tangentImpulse = tangent;
+    applyImpulse(vel, c.a, c.b, c.invMassA, c.invMassB, tangent - start);
+}
+/**
+ * @brief Push the bodies apart along the normal, from the penetration left after the moves so far.
+ *
+ * The penetration is updated from the displacement of the two bodies along the normal since the start of
+ * the step, so later iterations see the corrections of the neighbouring contacts.
+ */
+void ContactSolver::solvePosition(BodyStorage& bodies, const Constraint& c) const
+{
+    Vector3DArray& pos         = bodies.getPositions();
+    const decimal  moved       = (pos.get(c.a) - pos.get(c.b)).dotProduct(c.normal) - c.separation;
+    const decimal  penetration = c.penetration - moved;
+    if (penetration <= slop)
+        return;
+
+    const Vector3D correction = c.normal * ((penetration - slop) * correctionRate * c.normalMass);
+    if (c.invMassA > 0_d)
+        pos.set(c.a, pos.get(c.a) + correction * c.invMassA);
+    if (c.invMassB > 0_d)
+        pos.set(c.b, pos.get(c.b) - correction * c.invMassB);
+}
+/// Add `velocityStep` to the velocity of the dynamic bodies in contact.
+void ContactSolver::kick(BodyStorage& bodies, const Vector3D& velocityStep) const
+{
+    Vector3DArray& vel = bodies.getVelocities();
+    for (std::size_t slot = 0; slot < inContact.size(); ++slot)
+    {
+        if (inContact[slot])
+            vel.set(slot, vel.get(slot) + velocityStep);
+    }
+}
+/// Keep the impulses of this step's contacts only, so that contacts which ended are forgotten.
+void ContactSolver::storeImpulses()
+{
+    nextCache.clear();
+    for (const Constraint& c : constraints)
+        nextCache.push_back({ c.key, c.normalImpulse, c.flipped ? -c.tangentImpulse : c.tangentImpulse });
+    std::sort(nextCache.begin(), nextCache.end(),
+              [](const CachedImpulse& a, const CachedImpulse& b) { return a.key < b.key; });
+    std::swap(cache, nextCache);
+}
+
+// ============================================================================
+//  Solving
+// ============================================================================
+void ContactSolver::solve(BodyStorage& bodies, const std::vector<CollisionPair>& pairs,
+                          std::span<const Contact> contacts, std::span<const std::uint8_t> found,
+                          ContactIslands& islands, ThreadPool& pool, FrameArena& frame,
+                          const Vector3D& gravityStep, decimal restingSpeed)
+{
+    buildConstraints(bodies, pairs, contacts, found, restingSpeed, frame);
+    if (constraints.empty())
+    {
+        storeImpulses();
+        return;
+    }
+    islands.build(bodies, pairs, isConstraint.data());
+    kick(bodies, gravityStep);
+
+    const std::size_t islandCount = islands.size();
+    pool.parallelFor(0, islandCount, pool.grainFor(islandCount, 1),
+                     [&](std::size_t first, std::size_t last)
+                     {
+                         for (std::size_t island = first; island < last; ++island)
+                         {
+                             const auto islandPairs = islands.getPairs(island);
+                             for (const std::size_t k : islandPairs)
+                                 warmStart(bodies, constraints[pairConstraint[k]]);
+                             for (std::size_t it = 0; it < velocityIterations; ++it)
+                             {
+                                 for (const std::size_t k : islandPairs)
+                                     solveVelocity(bodies, constraints[pairConstraint[k]]);
+                             }
+                             for (std::size_t it = 0; it < positionIterations; ++it)
+                             {
+                                 for (const std::size_t k : islandPairs)
+                                     solvePosition(bodies, constraints[pairConstraint[k]]);
+                             }
+                         }
+                     });
+
+    kick(bodies, -gravityStep);
+    storeImpulses();
+}
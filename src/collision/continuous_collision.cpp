@@ -0,0 +1,159 @@
+#include "collision/continuous_collision.hpp"
+
+#include "mathematics/common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+using NarrowCollision::BoxShape;
+using NarrowCollision::PlaneShape;
+using NarrowCollision::SphereShape;
+
+// ============================================================================
+//  Sphere vs Sphere
+// ============================================================================
+/**
+ * @brief Time of impact of two spheres: first root of |s + t·motion| = r1 + r2, s being the start offset.
+ */
+bool ContinuousCollision::timeOfImpact(const SphereShape& sphere, const Vector3D& motion,
+                                       const SphereShape& other, decimal& fraction)
+{
+    const Vector3D offset = sphere.center - other.center;
+    const decimal  rSum   = sphere.radius + other.radius;
+    const decimal  a      = motion.getNormSquare();
+    const decimal  b      = offset.dotProduct(motion);
+    const decimal  c      = offset.getNormSquare() - rSum * rSum;
+
+    // Touching at the start, or not closing in
+    if (c <= 0_d || b >= 0_d || a <= 0_d)
+        return false;
+
+    const decimal discriminant = b * b - a * c;
+    if (discriminant < 0_d)
+        return false;
+
+    const decimal t = (-b - std::sqrt(discriminant)) / a;
+    if (t > 1_d)
+        return false;
+
+    fraction = std::max(t, 0_d);
+    return true;
+}
+
+// ============================================================================
+//  Sphere vs Plane
+// ============================================================================
+/**
+ * @brief Time of impact of a sphere and a finite plane.
+ *
+ * The sphere reaches the plane when its signed distance crosses the radius on its side; the impact counts if
+ * the center is then within the rectangle padded by the radius, the bounds of the discrete test. A sphere
+ * only grazing the rim of the rectangle during the motion is left to the narrow phase.
+ */
+bool ContinuousCollision::timeOfImpact(const SphereShape& sphere, const Vector3D& motion,
+                                       const PlaneShape& plane, decimal& fraction)
+{
+    const decimal signedDist = (sphere.center - plane.center).dotProduct(plane.normal);
+    const decimal approach   = motion.dotProduct(plane.normal);
+    const decimal radius     = sphere.radius;
+
+    decimal t = 0_d;
+    if (signedDist > radius && approach < 0_d && signedDist + approach <= radius)
+        t = (signedDist - radius) / -approach;
+    else if (signedDist < -radius && approach > 0_d && signedDist + approach >= -radius)
+        t = (-radius - signedDist) / approach;
+    else
+        return false;
+
+    // Position of the center on the plane at the impact
+    const Vector3D local = sphere.center + t * motion - plane.center;
+    const decimal  s     = local.dotProduct(plane.u);
+    const decimal  v     = local.dotProduct(plane.v);
+    if (commonMaths::approxGreaterThan(commonMaths::absVal(s), plane.halfWidth + radius) ||
+        commonMaths::approxGreaterThan(commonMaths::absVal(v), plane.halfHeight + radius))
+        return false;
+
+    fraction = std::clamp(t, 0_d, 1_d);
+    return true;
+}
+
+// ============================================================================
+//  Sphere vs AABB
+// ============================================================================
+/**
+ * @brief Time of impact of a sphere and an AABB: entry of the center in the box expanded by the radius.
+ *
+ * The expanded box contains the rounded box swept by the sphere, so the impact found at an edge or a corner
+ * may come slightly early, never late: the sphere then stops short of the box and goes on at the next step.
+ */
+bool ContinuousCollision::timeOfImpact(const SphereShape& sphere, const Vector3D& motion,
+                                       const BoxShape& aabb, decimal& fraction)
+{
+    const Vector3D min = aabb.center - aabb.halfExtents - Vector3D(sphere.radius);
+    const Vector3D max = aabb.center + aabb.halfExtents + Vector3D(sphere.radius);
+
+    // Already within reach of the box: left to the narrow phase
+    bool inside = true;
+    for (std::size_t i = 0; i < 3; ++i)
+        inside = inside && sphere.center[i] >= min[i] && sphere.center[i] <= max[i];
+    if (inside)
+        return false;
+
+    // Slab test of the segment against the expanded box
+    decimal enter = 0_d;
+    decimal exit  = 1_d;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        if (motion[i] == 0_d)
+        {
+            if (sphere.center[i] < min[i] || sphere.center[i] > max[i])
+                return false;
+            continue;
+        }
+        decimal near = (min[i] - sphere.center[i]) / motion[i];
+        decimal far  = (max[i] - sphere.center[i]) / motion[i];
+        if (near > far)
+            std::swap(near, far);
+        enter = std::max(enter, near);
+        exit  = std::min(exit, far);
+        if (enter > exit)
+            return false;
+    }
+
+    fraction = enter;
+    return true;
+}
+
+// ============================================================================
+//  Ballistic approach
+// ============================================================================
+/**
+ * @brief Smallest positive root of `acceleration·t²/2 + speed·t - gap`, with the numerically stable form of
+ * the quadratic roots.
+ */
+decimal ContinuousCollision::approachTime(decimal gap, decimal speed, decimal acceleration)
+{
+    constexpr decimal never = std::numeric_limits<decimal>::infinity();
+    if (!(gap > 0_d))
+        return 0_d;
+
+    const decimal a = 0.5_d * acceleration;
+    if (a == 0_d)
+        return speed > 0_d ? gap / speed : never;
+
+    const decimal discriminant = speed * speed + 4_d * a * gap;
+    if (discriminant < 0_d)
+        return never; // decelerating before the gap is closed
+
+    // Roots of a·t² + speed·t - gap: q / a and -gap / q
+    const decimal q     = -0.5_d * (speed + std::copysign(std::sqrt(discriminant), speed));
+    decimal       first = never;
+    for (const decimal root : { q / a, q != 0_d ? -gap / q : never })
+    {
+        if (root > 0_d)
+            first = std::min(first, root);
+    }
+    return first;
+}
@@ -0,0 +1,259 @@
+#include "collision/dynamic_aabb_tree.hpp"
+
+#include <algorithm>
+
+// ============================================================================
+//  Node pool
+// ============================================================================
+std::int32_t DynamicAABBTree::allocateNode()
+{
+    if (freeList == nullNode)
+    {
+        nodes.emplace_back();
+        freeList = static_cast<std::int32_t>(nodes.size() - 1);
+    }
+
+    const std::int32_t index = freeList;
+    Node&              n     = node(index);
+    freeList                 = n.parent;
+    n                        = Node();
+    n.height                 = 0;
+    return index;
+}
+
+void DynamicAABBTree::freeNode(std::int32_t index)
+{
+    Node& n  = node(index);
+    n.parent = freeList;
+    n.height = -1;
+    freeList = index;
+}
+
+void DynamicAABBTree::clear()
+{
+    nodes.clear();
+    root      = nullNode;
+    freeList  = nullNode;
+    leafCount = 0;
+}
+
+// ============================================================================
+//  Proxies
+// ============================================================================
+std::int32_t DynamicAABBTree::createProxy(const BoundingBox& box, std::uint32_t userData)
+{
+    const std::int32_t proxy = allocateNode();
+    node(proxy).box          = box.getFattened(margin);
+    node(proxy).userData     = userData;
+    insertLeaf(proxy);
+    ++leafCount;
+    return proxy;
+}
+
+void DynamicAABBTree::destroyProxy(std::int32_t proxy)
+{
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --leafCount;
+}
+
+bool DynamicAABBTree::moveProxy(std::int32_t proxy, const BoundingBox& box)
+{
+    if (node(proxy).box.contains(box))
+        return false;
+
+    removeLeaf(proxy);
+    node(proxy).box = box.getFattened(margin);
+    insertLeaf(proxy);
+    return true;
+}
+
+// ============================================================================
+//  Tree maintenance
+// ============================================================================
+/**
+ * @brief Insert a leaf next to the sibling minimising the surface area heuristic.
+ *
+ * Descending from the root, the cost of creating a new parent at the current node is compared with the cost
+ * of pushing the leaf down into each child (including the growth of the ancestors' boxes).
+ */
+void DynamicAABBTree::insertLeaf(std::int32_t leaf)
+{
+    if (root == nullNode)
+    {
+        root              = leaf;
+        node(root).parent = nullNode;
+        return;
+    }
+
+    // 1. Find the best sibling
+    const BoundingBox leafBox = node(leaf).box;
+    std::int32_t      index   = root;
+    while (!node(index).isLeaf())
+    {
+        const Node&   current      = node(index);
+        const decimal area         = current.box.getSurfaceArea();
+        const decimal combinedArea = BoundingBox::merge(current.box, leafBox).getSurfaceArea();
+
+        // Cost of creating a new parent for this node and the new leaf
+        const decimal cost = 2_d * combinedArea;
+        // Minimum cost of pushing the leaf further down the tree
+        const decimal inheritanceCost = 2_d * (combinedArea - area);
+
+        auto descentCost = [&](std::int32_t child)
+        {
+            const Node&   c       = node(child);
+            const decimal newArea = BoundingBox::merge(c.box, leafBox).getSurfaceArea();
+            return (c.isLeaf() ? newArea : newArea - c.box.getSurfaceArea()) + inheritanceCost;
+        };
+        const decimal cost1 = descentCost(current.child1);
+        const decimal cost2 = descentCost(current.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+        index = cost1 < cost2 ? current.child1 : current.child2;
+    }
+    const std::int32_t sibling = index;
+
+    // 2. Create a new parent
+    const std::int32_t oldParent = node(sibling).parent;
+    const std::int32_t newParent = allocateNode();
+    Node&              parent    = node(newParent);
+    parent.parent                = oldParent;
+    parent.box                   = BoundingBox::merge(leafBox, node(sibling).box);
+    parent.height                = node(sibling).height + 1;
+    parent.child1                = sibling;
+    parent.child2                = leaf;
+    node(sibling).parent         = newParent;
+    node(leaf).parent            = newParent;
+
+    if (oldParent == nullNode)
+        root = newParent;
+    else if (node(oldParent).child1 == sibling)
+        node(oldParent).child1 = newParent;
+    else
+        node(oldParent).child2 = newParent;
+
+    // 3. Walk back up the tree fixing heights and boxes
+    refitAncestors(node(leaf).parent);
+}
+
+void DynamicAABBTree::removeLeaf(std::int32_t leaf)
+{
+    if (leaf == root)
+    {
+        root = nullNode;
+        return;
+    }
+
+    const std::int32_t parent      = node(leaf).parent;
+    const std::int32_t grandParent = node(parent).parent;
+    const std::int32_t sibling     = node(parent).child1 == leaf ? node(parent).child2 : node(parent).child1;
+
+    if (grandParent == nullNode)
+    {
+        root                 = sibling;
+        node(sibling).parent = nullNode;
+        freeNode(parent);
+        return;
+    }
+
+    // Replace the parent by the sibling
+    if (node(grandParent).child1 == parent)
+        node(grandParent).child1 = sibling;
+    else
+        node(grandParent).child2 = sibling;
+    node(sibling).parent = grandParent;
+    freeNode(parent);
+
+    refitAncestors(grandParent);
+}
+
+/// Rebalance and recompute the boxes and heights from `index` up to the root.
+void DynamicAABBTree::refitAncestors(std::int32_t index)
+{
+    while (index != nullNode)
+    {
+        index = balance(index);
+
+        Node&       current = node(index);
+        const Node& child1  = node(current.child1);
+        const Node& child2  = node(current.child2);
+        current.height      = 1 + std::max(child1.height, child2.height);
+        current.box         = BoundingBox::merge(child1.box, child2.box);
+
+        index = current.parent;
+    }
+}
+
+/**
+ * @brief Perform a left or right rotation if the subtree rooted at `indexA` is unbalanced.
+ *
+ * The taller grandchild is lifted in place of `indexA`, as in an AVL tree.
+ *
+ * @return Index of the new root of the subtree.
+ */
+std::int32_t DynamicAABBTree::balance(std::int32_t indexA)
+{
+    Node& A = node(indexA);
+    if (A.isLeaf() || A.height < 2)
+        return indexA;
+
+    const std::int32_t indexB = A.child1;
+    const std::int32_t indexC = A.child2;
+    Node&              B      = node(indexB);
+    Node&              C      = node(indexC);
+
+    const std::int32_t imbalance = C.height - B.height;
+
+    // Lift C, or B, above A
+    auto rotate = [&](std::int32_t indexUp, Node& up, Node& other, bool upIsChild2)
+    {
+        const std::int32_t indexF = up.child1;
+        const std::int32_t indexG = up.child2;
+        Node&              F      = node(indexF);
+        Node&              G      = node(indexG);
+
+        up.child1 = indexA;
+        up.parent = A.parent;
+        A.parent  = indexUp;
+
+        if (up.parent == nullNode)
+            root = indexUp;
+        else if (node(up.parent).child1 == indexA)
+            node(up.parent).child1 = indexUp;
+        else
+            node(up.parent).child2 = indexUp;
+
+        // The taller grandchild stays under `up`, the other one replaces `up` under A
+        const bool         keepF    = F.height > G.height;
+        const std::int32_t indexIn  = keepF ? indexF : indexG;
+        const std::int32_t indexOut = keepF ? indexG : indexF;
+        Node&              in       = node(indexIn);
+        Node&              out      = node(indexOut);
+
+        up.child2 = indexIn;
+        if (upIsChild2)
+            A.child2 = indexOut;
+        else
+            A.child1 = indexOut;
+        out.parent = indexA;
+
+        A.box     = BoundingBox::merge(other.box, out.box);
+        up.box    = BoundingBox::merge(A.box, in.box);
+        A.height  = 1 + std::max(other.height, out.height);
+        up.height = 1 + std::max(A.height, in.height);
+    };
+
+    if (imbalance > 1)
+    {
+        rotate(indexC, C, B, true);
+        return indexC;
+    }
+    if (imbalance < -1)
+    {
+        rotate(indexB, B, C, false);
+        return indexB;
+    }
+    return indexA;
+}
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 // ============================================================================
 //  Sphere vs Sphere
@@ -14,15 +15,15 @@
  * Collision occurs if the distance between centers is less than or equal
  * to the sum of their radii.
  *
- * @param s1 Sphere instance.
- * @param s2 Sphere instance.
+ * @param s1 Sphere parameters.
+ * @param s2 Sphere parameters.
  * @return true if the spheres intersect, false otherwise.
  */
-bool NarrowCollision::computeContact(const Sphere& s1, const Sphere& s2, Contact& contact)
+bool NarrowCollision::computeContact(const SphereShape& s1, const SphereShape& s2, Contact& contact)
 {
-    const Vector3D diff  = s2.getCenter() - s1.getCenter();
+    const Vector3D diff  = s2.center - s1.center;
     const decimal  dist2 = diff.getNormSquare();
-    const decimal  rSum  = s1.getRadius() + s2.getRadius();
+    const decimal  rSum  = s1.radius + s2.radius;
 
     if (commonMaths::approxGreaterThan(dist2, rSum * rSum))
     {
@@ -37,10 +38,7 @@ bool NarrowCollision::computeContact(const Sphere& s1, const Sphere& s2, Contact
     contact.penetration = rSum - dist;
 
     // Compute contact point
-    contact.position = s1.getCenter() + normal * s1.getRadius();
-
-    contact.A = &s1;
-    contact.B = &s2;
+    contact.position = s1.center + normal * s1.radius;
 
     return true;
 }
@@ -56,16 +54,16 @@ bool NarrowCollision::computeContact(const Sphere& s1, const Sphere& s2, Contact
  * Test for the two different cases : sphere inside AABB and sphere's center inside AABB. The second needs a
  * special treatment
  *
- * @param sphere Sphere instance.
- * @param aabb AABB instance.
+ * @param sphere Sphere parameters.
+ * @param aabb AABB parameters.
  * @return true if the sphere and AABB intersect, false otherwise.
  */
-bool NarrowCollision::computeContact(const Sphere& sphere, const AABB& aabb, Contact& contact)
+bool NarrowCollision::computeContact(const SphereShape& sphere, const BoxShape& aabb, Contact& contact)
 {
-    const Vector3D center = sphere.getCenter();
-    const Vector3D min    = aabb.getMin();
-    const Vector3D max    = aabb.getMax();
-    const decimal  radius = sphere.getRadius();
+    const Vector3D center = sphere.center;
+    const Vector3D min    = aabb.center - aabb.halfExtents;
+    const Vector3D max    = aabb.center + aabb.halfExtents;
+    const decimal  radius = sphere.radius;
 
     // Find the closest point on AABB to sphere center
     Vector3D closestPoint;
@@ -139,9 +137,6 @@ bool NarrowCollision::computeContact(const Sphere& sphere, const AABB& aabb, Con
         contact.position    = center + normal * minDist;
     }
 
-    contact.A = &sphere;
-    contact.B = &aabb;
-
     return true;
 }
 
@@ -154,18 +149,18 @@ bool NarrowCollision::computeContact(const Sphere& sphere, const AABB& aabb, Con
  * Collision occurs if the sphere's center-to-plane distance is smaller than the sphere radius, and if the
  * projection of the sphere center onto the plane lies within its rectangle bounds.
  *
- * @param sphere Sphere instance.
- * @param plane Plane instance.
+ * @param sphere Sphere parameters.
+ * @param plane Plane parameters.
  * @return true if the sphere and plane intersect, false otherwise.
  */
-bool NarrowCollision::computeContact(const Sphere& sphere, const Plane& plane, Contact& contact)
+bool NarrowCollision::computeContact(const SphereShape& sphere, const PlaneShape& plane, Contact& contact)
 {
-    Vector3D       planeNormal  = plane.getNormal();
-    const Vector3D sphereCenter = sphere.getCenter();
-    const decimal  sphereRadius = sphere.getRadius();
+    Vector3D       planeNormal  = plane.normal;
+    const Vector3D sphereCenter = sphere.center;
+    const decimal  sphereRadius = sphere.radius;
 
     // 1) Check distance using plane equation
-    const Vector3D planeToSphere = sphereCenter - plane.getPosition();
+    const Vector3D planeToSphere = sphereCenter - plane.center;
     const decimal  signedDist    = planeToSphere.dotProduct(planeNormal);
 
     // Early exit: sphere completely behind or too far in front
@@ -176,15 +171,15 @@ bool NarrowCollision::computeContact(const Sphere& sphere, const Plane& plane, C
     }
 
     // 2) Project onto plane and check bounds with radius padding
-    const Vector3D proj  = sphereCenter - signedDist * plane.getNormal();
-    const Vector3D local = proj - plane.getPosition();
+    const Vector3D proj  = sphereCenter - signedDist * plane.normal;
+    const Vector3D local = proj - plane.center;
 
-    const decimal s = local.dotProduct(plane.getU());
-    const decimal t = local.dotProduct(plane.getV());
+    const decimal s = local.dotProduct(plane.u);
+    const decimal t = local.dotProduct(plane.v);
 
     // Check bounds with radius consideration
-    const decimal effectiveHalfWidth  = plane.getHalfWidth() + sphereRadius;
-    const decimal effectiveHalfHeight = plane.getHalfHeight() + sphereRadius;
+    const decimal effectiveHalfWidth  = plane.halfWidth + sphereRadius;
+    const decimal effectiveHalfHeight = plane.halfHeight + sphereRadius;
 
     if (commonMaths::approxGreaterThan(commonMaths::absVal(s), effectiveHalfWidth) ||
         commonMaths::approxGreaterThan(commonMaths::absVal(t), effectiveHalfHeight))
@@ -193,21 +188,21 @@ bool NarrowCollision::computeContact(const Sphere& sphere, const Plane& plane, C
     }
 
     // 3) Exact distance to clamped point
-    const decimal clampedS = std::clamp(s, -plane.getHalfWidth(), plane.getHalfWidth());
-    const decimal clampedT = std::clamp(t, -plane.getHalfHeight(), plane.getHalfHeight());
+    const decimal clampedS = std::clamp(s, -plane.halfWidth, plane.halfWidth);
+    const decimal clampedT = std::clamp(t, -plane.halfHeight, plane.halfHeight);
 
-    const Vector3D closestPoint = plane.getPosition() + clampedS * plane.getU() + clampedT * plane.getV();
+    const Vector3D closestPoint = plane.center + clampedS * plane.u + clampedT * plane.v;
     const Vector3D delta        = closestPoint - sphereCenter;
     const decimal  dist2        = delta.dotProduct(delta);
 
     // Collision if within radius
-    if (commonMaths::approxGreaterThan(dist2, sphere.getRadius() * sphere.getRadius()))
+    if (commonMaths::approxGreaterThan(dist2, sphere.radius * sphere.radius))
         return false;
 
     decimal    dist = delta.getNorm();
     const bool insideFace =
-        commonMaths::approxSmallerOrEqualThan(commonMaths::absVal(s), plane.getHalfWidth()) &&
-        commonMaths::approxSmallerOrEqualThan(commonMaths::absVal(t), plane.getHalfHeight());
+        commonMaths::approxSmallerOrEqualThan(commonMaths::absVal(s), plane.halfWidth) &&
+        commonMaths::approxSmallerOrEqualThan(commonMaths::absVal(t), plane.halfHeight);
 
     if (insideFace)
     {
@@ -220,9 +215,7 @@ bool NarrowCollision::computeContact(const Sphere& sphere, const Plane& plane, C
 
     contact.penetration = sphereRadius - dist;
     contact.position    = closestPoint;
-    contact.penetration = sphere.getRadius() - dist;
-    contact.A           = &sphere;
-    contact.B           = &plane;
+    contact.penetration = sphere.radius - dist;
     return true;
 }
 
@@ -234,16 +227,16 @@ bool NarrowCollision::computeContact(const Sphere& sphere, const Plane& plane, C
  *
  * Collision occurs if they overlap on each axis simultaneously and compute contact properties.
  *
- * @param a1 AABB instance.
- * @param a2 AABB instance.
+ * @param a1 AABB parameters.
+ * @param a2 AABB parameters.
  * @return true if the AABBs intersect, false otherwise.
  */
-bool NarrowCollision::computeContact(const AABB& a1, const AABB& a2, Contact& contact)
+bool NarrowCollision::computeContact(const BoxShape& a1, const BoxShape& a2, Contact& contact)
 {
-    const Vector3D a1Min = a1.getMin();
-    const Vector3D a1Max = a1.getMax();
-    const Vector3D a2Min = a2.getMin();
-    const Vector3D a2Max = a2.getMax();
+    const Vector3D a1Min = a1.center - a1.halfExtents;
+    const Vector3D a1Max = a1.center + a1.halfExtents;
+    const Vector3D a2Min = a2.center - a2.halfExtents;
+    const Vector3D a2Max = a2.center + a2.halfExtents;
 
     // Check overlap on each axis
     const decimal overlapX = std::min(a1Max[0], a2Max[0]) - std::max(a1Min[0], a2Min[0]);
@@ -262,7 +255,7 @@ bool NarrowCollision::computeContact(const AABB& a1, const AABB& a2, Contact& co
     decimal  penetration = overlapX;
     Vector3D normal(1, 0, 0);
 
-    const Vector3D centerDelta = a2.getPosition() - a1.getPosition();
+    const Vector3D centerDelta = a2.center - a1.center;
 
     if (overlapY < penetration)
     {
@@ -290,9 +283,6 @@ bool NarrowCollision::computeContact(const AABB& a1, const AABB& a2, Contact& co
     contact.normal      = normal;
     contact.penetration = penetration;
 
-    contact.A = &a1;
-    contact.B = &a2;
-
     return true;
 }
 
@@ -305,29 +295,29 @@ bool NarrowCollision::computeContact(const AABB& a1, const AABB& a2, Contact& co
  * Collision occurs if the signed distance from the AABB to the plane is less than or equal to the projection
  * radius of the AABB onto the plane normal.
  *
- * @param aabb AABB instance.
- * @param plane Plane instance.
+ * @param aabb AABB parameters.
+ * @param plane Plane parameters.
  * @return true if the AABB and the Plane intersect, false otherwise.
  */
-bool NarrowCollision::computeContact(const AABB& aabb, const Plane& plane, Contact& contact)
+bool NarrowCollision::computeContact(const BoxShape& aabb, const PlaneShape& plane, Contact& contact)
 {
-    const Vector3D aabbPosition = aabb.getPosition();
-    const Vector3D aabbExtents  = aabb.getHalfExtents();
+    const Vector3D aabbPosition = aabb.center;
+    const Vector3D aabbExtents  = aabb.halfExtents;
 
-    const Vector3D planeNormal = plane.getNormal().getNormalised();
-    const Vector3D planeAxisU  = plane.getU().getNormalised();
-    const Vector3D planeAxisV  = plane.getV().getNormalised();
+    const Vector3D planeNormal = plane.normal.getNormalised();
+    const Vector3D planeAxisU  = plane.u.getNormalised();
+    const Vector3D planeAxisV  = plane.v.getNormalised();
 
     // AABB vs infinite plane
     const decimal r = aabbExtents.dotProduct(planeNormal.getAbsolute());
 
-    const decimal dist = (aabbPosition - plane.getPosition()).dotProduct(planeNormal);
+    const decimal dist = (aabbPosition - plane.center).dotProduct(planeNormal);
 
     if (commonMaths::approxGreaterThan(commonMaths::absVal(dist), r))
         return false;
 
     // Project AABB onto plane local axes
-    const Vector3D d = aabbPosition - plane.getPosition();
+    const Vector3D d = aabbPosition - plane.center;
 
     const decimal s0 = d.dotProduct(planeAxisU);
     const decimal t0 = d.dotProduct(planeAxisV);
@@ -340,16 +330,14 @@ bool NarrowCollision::computeContact(const AABB& aabb, const Plane& plane, Conta
                        aabbExtents[1] * commonMaths::absVal(planeAxisV[1]) +
                        aabbExtents[2] * commonMaths::absVal(planeAxisV[2]);
 
-    if (commonMaths::approxGreaterThan(commonMaths::absVal(s0), plane.getHalfWidth() + rs) ||
-        commonMaths::approxGreaterThan(commonMaths::absVal(t0), plane.getHalfHeight() + rt))
+    if (commonMaths::approxGreaterThan(commonMaths::absVal(s0), plane.halfWidth + rs) ||
+        commonMaths::approxGreaterThan(commonMaths::absVal(t0), plane.halfHeight + rt))
         return false;
 
     // Contact
     contact.normal      = (dist < 0_d) ? planeNormal : -planeNormal;
     contact.penetration = r - commonMaths::absVal(dist);
     contact.position    = aabbPosition - dist * planeNormal;
-    contact.A           = &aabb;
-    contact.B           = &plane;
 
     return true;
 }
@@ -363,14 +351,14 @@ bool NarrowCollision::computeContact(const AABB& aabb, const Plane& plane, Conta
  * Collision occurs if the associated infinite planes intersects (they are not parallel), and if the
  * intersection line passes through both rectangles' bounds.
  *
- * @param p1 Plane instance.
- * @param p2 Plane instance.
+ * @param p1 Plane parameters.
+ * @param p2 Plane parameters.
  * @return true if the planes intersect, false otherwise.
  */
-bool NarrowCollision::computeContact(const Plane& p1, const Plane& p2, Contact& contact)
+bool NarrowCollision::computeContact(const PlaneShape& p1, const PlaneShape& p2, Contact& contact)
 {
-    const Vector3D planeNormal1 = p1.getNormal().getNormalised();
-    const Vector3D planeNormal2 = p2.getNormal().getNormalised();
+    const Vector3D planeNormal1 = p1.normal.getNormalised();
+    const Vector3D planeNormal2 = p2.normal.getNormalised();
 
     const Vector3D dir  = planeNormal1.crossProduct(planeNormal2);
     const decimal  dir2 = dir.getNormSquare();
@@ -378,15 +366,13 @@ bool NarrowCollision::computeContact(const Plane& p1, const Plane& p2, Contact&
     // Parallel / coplanar
     if (commonMaths::approxEqual(dir2, 0_d))
     {
-        const decimal d = planeNormal1.dotProduct(p2.getPosition() - p1.getPosition());
+        const decimal d = planeNormal1.dotProduct(p2.center - p1.center);
         if (!commonMaths::approxEqual(d, 0_d))
             return false;
 
         // Coplanar rectangles
-        auto corner = [](const Plane& P, decimal su, decimal sv)
-        {
-            return P.getPosition() + P.getU() * (su * P.getHalfWidth()) + P.getV() * (sv * P.getHalfHeight());
-        };
+        auto corner = [](const PlaneShape& P, decimal su, decimal sv)
+        { return P.center + P.u * (su * P.halfWidth) + P.v * (sv * P.halfHeight); };
 
         std::array<Vector3D, 4> A = { corner(p1, -1_d, -1_d), corner(p1, 1_d, -1_d), corner(p1, 1_d, 1_d),
                                       corner(p1, -1_d, 1_d) };
@@ -394,8 +380,8 @@ bool NarrowCollision::computeContact(const Plane& p1, const Plane& p2, Contact&
         std::array<Vector3D, 4> B = { corner(p2, -1_d, -1_d), corner(p2, 1_d, -1_d), corner(p2, 1_d, 1_d),
                                       corner(p2, -1_d, 1_d) };
 
-        std::array<Vector3D, 4> axes = { p1.getU().getNormalised(), p1.getV().getNormalised(),
-                                         p2.getU().getNormalised(), p2.getV().getNormalised() };
+        std::array<Vector3D, 4> axes = { p1.u.getNormalised(), p1.v.getNormalised(), p2.u.getNormalised(),
+                                         p2.v.getNormalised() };
 
         auto project = [](const Vector3D& axis, const auto& verts)
         {
@@ -421,25 +407,23 @@ bool NarrowCollision::computeContact(const Plane& p1, const Plane& p2, Contact&
         }
 
         // overlap confirmed
-        contact.position    = (p1.getPosition() + p2.getPosition()) * 0.5_d;
-        contact.normal      = p1.getNormal().getNormalised();
+        contact.position    = (p1.center + p2.center) * 0.5_d;
+        contact.normal      = p1.normal.getNormalised();
         contact.penetration = 0_d;
-        contact.A           = &p1;
-        contact.B           = &p2;
         return true;
     }
 
     // Intersection line
-    const decimal d1 = planeNormal1.dotProduct(p1.getPosition());
-    const decimal d2 = planeNormal2.dotProduct(p2.getPosition());
+    const decimal d1 = planeNormal1.dotProduct(p1.center);
+    const decimal d2 = planeNormal2.dotProduct(p2.center);
 
     const Vector3D P0 = ((planeNormal2 * d1 - planeNormal1 * d2).crossProduct(dir)) / dir2;
 
-    auto interval = [&](const Plane& P) -> std::optional<std::pair<decimal, decimal>>
+    auto interval = [&](const PlaneShape& P) -> std::optional<std::pair<decimal, decimal>>
     {
-        const Vector3D C = P.getPosition();
-        const Vector3D u = P.getU().getNormalised();
-        const Vector3D v = P.getV().getNormalised();
+        const Vector3D C = P.center;
+        const Vector3D u = P.u.getNormalised();
+        const Vector3D v = P.v.getNormalised();
 
         auto axis = [&](decimal s0, decimal s1, decimal h) -> std::optional<std::pair<decimal, decimal>>
         {
@@ -454,8 +438,8 @@ bool NarrowCollision::computeContact(const Plane& p1, const Plane& p2, Contact&
             return std::make_pair(a, b);
         };
 
-        auto Iu = axis((P0 - C).dotProduct(u), dir.dotProduct(u), P.getHalfWidth());
-        auto Iv = axis((P0 - C).dotProduct(v), dir.dotProduct(v), P.getHalfHeight());
+        auto Iu = axis((P0 - C).dotProduct(u), dir.dotProduct(u), P.halfWidth);
+        auto Iv = axis((P0 - C).dotProduct(v), dir.dotProduct(v), P.halfHeight);
         if (!Iu || !Iv)
             return std::nullopt;
 
@@ -475,7 +459,113 @@ bool NarrowCollision::computeContact(const Plane& p1, const Plane& p2, Contact&
     contact.position    = P0 + dir * ((t0 + t1) * 0.5_d);
     contact.normal      = planeNormal2;
     contact.penetration = 0_d;
-    contact.A           = &p1;
-    contact.B           = &p2;
     return true;
 }
+
+// ============================================================================
+//  Separations
+// ============================================================================
+// Each one is the distance by which the quantity of the first rejection test of `computeContact` exceeds its
+// threshold (tolerance included): a relative translation changes that quantity by at most its length.
+
+/**
+ * @brief Separation of two spheres: distance between centers minus the largest contact distance.
+ */
+decimal NarrowCollision::separation(const SphereShape& s1, const SphereShape& s2)
+{
+    const decimal rSum = s1.radius + s2.radius;
+    return (s2.center - s1.center).getNorm() - std::sqrt(rSum * rSum + PRECISION_MACHINE);
+}
+
+/**
+ * @brief Separation of a sphere and a plane: distance from the center to the infinite plane, minus the
+ * radius.
+ */
+decimal NarrowCollision::separation(const SphereShape& sphere, const PlaneShape& plane)
+{
+    const decimal signedDist = (sphere.center - plane.center).dotProduct(plane.normal);
+    return commonMaths::absVal(signedDist) - (sphere.radius + PRECISION_MACHINE);
+}
+
+/**
+ * @brief Separation of a sphere and an AABB: distance from the center to the box, minus the radius.
+ */
+decimal NarrowCollision::separation(const SphereShape& sphere, const BoxShape& aabb)
+{
+    const Vector3D min = aabb.center - aabb.halfExtents;
+    const Vector3D max = aabb.center + aabb.halfExtents;
+    Vector3D       closestPoint;
+    for (std::size_t i = 0; i < 3; ++i)
+        closestPoint[i] = std::max(min[i], std::min(sphere.center[i], max[i]));
+    const decimal radius = std::sqrt(sphere.radius * sphere.radius + PRECISION_MACHINE);
+    return (sphere.center - closestPoint).getNorm() - radius;
+}
+
+/**
+ * @brief Separation of two AABBs: the largest gap between their projections on the world axes.
+ */
+decimal NarrowCollision::separation(const BoxShape& a1, const BoxShape& a2)
+{
+    const Vector3D a1Min = a1.center - a1.halfExtents;
+    const Vector3D a1Max = a1.center + a1.halfExtents;
+    const Vector3D a2Min = a2.center - a2.halfExtents;
+    const Vector3D a2Max = a2.center + a2.halfExtents;
+    decimal        gap   = -std::numeric_limits<decimal>::infinity();
+    for (std::size_t i = 0; i < 3; ++i)
+        gap = std::max(gap, std::max(a1Min[i], a2Min[i]) - std::min(a1Max[i], a2Max[i]));
+    return gap - PRECISION_MACHINE;
+}
+
+/**
+ * @brief Separation of an AABB and a plane: distance from the center to the infinite plane, minus the
+ * projected half extents.
+ */
+decimal NarrowCollision::separation(const BoxShape& aabb, const PlaneShape& plane)
+{
+    const Vector3D planeNormal = plane.normal.getNormalised();
+    const decimal  r           = aabb.halfExtents.dotProduct(planeNormal.getAbsolute());
+    const decimal  dist        = (aabb.center - plane.center).dotProduct(planeNormal);
+    return commonMaths::absVal(dist) - (r + PRECISION_MACHINE);
+}
+
+// ============================================================================
+//  Objects
+// ============================================================================
+/**
+ * @brief Contact of the shapes of two objects, with `contact.A` and `contact.B` set to the objects.
+ */
+template <typename First, typename Second>
+static bool objectContact(const First& first, const Second& second, Contact& contact)
+{
+    if (!NarrowCollision::computeContact(NarrowCollision::shapeOf(first), NarrowCollision::shapeOf(second),
+                                         contact))
+        return false;
+    contact.A = &first;
+    contact.B = &second;
+    return true;
+}
+
+bool NarrowCollision::computeContact(const Sphere& s1, const Sphere& s2, Contact& contact)
+{
+    return objectContact(s1, s2, contact);
+}
+bool NarrowCollision::computeContact(const Sphere& sphere, const Plane& plane, Contact& contact)
+{
+    return objectContact(sphere, plane, contact);
+}
+bool NarrowCollision::computeContact(const Sphere& sphere, const AABB& aabb, Contact& contact)
+{
+    return objectContact(sphere, aabb, contact);
+}
+bool NarrowCollision::computeContact(const AABB& a1, const AABB& a2, Contact& contact)
+{
+    return objectContact(a1, a2, contact);
+}
+bool NarrowCollision::computeContact(const AABB& aabb, const Plane& plane, Contact& contact)
+{
+    return objectContact(aabb, plane, contact);
+}
+bool NarrowCollision::computeContact(const Plane& p1, const Plane& p2, Contact& contact)
+{
+    return objectContact(p1, p2, contact);
+}
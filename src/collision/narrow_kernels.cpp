@@ -0,0 +1,146 @@
+/**
+ * @file narrow_kernels.cpp
+ * @brief Implementation of the vectorised narrow-phase tests.
+ *
+ * Every kernel runs a SIMD loop over full packs, then a scalar loop for the remaining pairs performing the
+ * same operations. `commonMaths::approx*` comparisons are spelled out on packs: `isFinite(x)` is
+ * `x < +inf`, which is false for NaN and +inf only, as the scalar test.
+ *
+ * @see narrow_kernels.hpp
+ */
+#include "collision/narrow_kernels.hpp"
+
+#include "mathematics/common.hpp"
+#include "mathematics/simd.hpp"
+
+#include <limits>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+/// Bits of `commonMaths::approxGreaterThan(lhs, rhs)`.
+static simd::Mask approxGreaterThan(simd::Pack lhs, simd::Pack rhs, simd::Pack precision, simd::Pack inf)
+{
+    return simd::less(lhs, inf) & simd::less(rhs, inf) & simd::greater(lhs, simd::add(rhs, precision));
+}
+/// Bits of `commonMaths::approxSmallerThan(lhs, rhs)`.
+static simd::Mask approxSmallerThan(simd::Pack lhs, simd::Pack rhs, simd::Pack precision, simd::Pack inf)
+{
+    return simd::less(lhs, inf) & simd::less(rhs, inf) & simd::less(lhs, simd::sub(rhs, precision));
+}
+static void storeCandidates(std::uint8_t* candidates, simd::Mask mask)
+{
+    for (std::size_t lane = 0; lane < simd::width; ++lane)
+        candidates[lane] = static_cast<std::uint8_t>((mask >> lane) & 1u);
+}
+
+// ============================================================================
+//  Kernels
+// ============================================================================
+namespace NarrowKernels {
+
+/**
+ * @brief Separation test of NarrowCollision::computeContact(sphere, sphere).
+ *
+ * A pair is rejected when the squared distance of the centers is greater than the squared sum of the radii.
+ */
+void sphereSphere(const SpherePairs& pairs, std::size_t count, std::uint8_t* candidates)
+{
+    const simd::Pack precision = simd::set1(PRECISION_MACHINE);
+    const simd::Pack inf       = simd::set1(std::numeric_limits<decimal>::infinity());
+
+    std::size_t i = 0;
+    for (; i + simd::width <= count; i += simd::width)
+    {
+        const simd::Pack dx        = simd::sub(simd::load(pairs.bx + i), simd::load(pairs.ax + i));
+        const simd::Pack dy        = simd::sub(simd::load(pairs.by + i), simd::load(pairs.ay + i));
+        const simd::Pack dz        = simd::sub(simd::load(pairs.bz + i), simd::load(pairs.az + i));
+        const simd::Pack dist2     = simd::madd(dz, dz, simd::madd(dy, dy, simd::mul(dx, dx)));
+        const simd::Pack rSum      = simd::add(simd::load(pairs.ar + i), simd::load(pairs.br + i));
+        const simd::Mask separated = approxGreaterThan(dist2, simd::mul(rSum, rSum), precision, inf);
+        storeCandidates(candidates + i, ~separated & simd::allElements);
+    }
+    for (; i < count; ++i)
+    {
+        const decimal dx    = pairs.bx[i] - pairs.ax[i];
+        const decimal dy    = pairs.by[i] - pairs.ay[i];
+        const decimal dz    = pairs.bz[i] - pairs.az[i];
+        const decimal dist2 = dx * dx + dy * dy + dz * dz;
+        const decimal rSum  = pairs.ar[i] + pairs.br[i];
+        candidates[i]       = commonMaths::approxGreaterThan(dist2, rSum * rSum) ? 0 : 1;
+    }
+}
+
+/**
+ * @brief Early exits of NarrowCollision::computeContact(sphere, plane).
+ *
+ * A pair is rejected when the signed distance of the center to the plane exceeds the radius, or when the
+ * projection of the center on the plane falls outside the rectangle padded by the radius.
+ */
+void spherePlane(const SpherePlanePairs& pairs, std::size_t count, std::uint8_t* candidates)
+{
+    const simd::Pack precision = simd::set1(PRECISION_MACHINE);
+    const simd::Pack inf       = simd::set1(std::numeric_limits<decimal>::infinity());
+    const simd::Pack zero      = simd::set1(0_d);
+
+    std::size_t i = 0;
+    for (; i + simd::width <= count; i += simd::width)
+    {
+        const simd::Pack cx = simd::load(pairs.cx + i);
+        const simd::Pack cy = simd::load(pairs.cy + i);
+        const simd::Pack cz = simd::load(pairs.cz + i);
+        const simd::Pack r  = simd::load(pairs.r + i);
+        const simd::Pack px = simd::load(pairs.px + i);
+        const simd::Pack py = simd::load(pairs.py + i);
+        const simd::Pack pz = simd::load(pairs.pz + i);
+        const simd::Pack nx = simd::load(pairs.nx + i);
+        const simd::Pack ny = simd::load(pairs.ny + i);
+        const simd::Pack nz = simd::load(pairs.nz + i);
+
+        // Distance to the plane
+        const simd::Pack signedDist =
+            simd::add(simd::add(simd::mul(simd::sub(cx, px), nx), simd::mul(simd::sub(cy, py), ny)),
+                      simd::mul(simd::sub(cz, pz), nz));
+        simd::Mask rejected = approxSmallerThan(signedDist, simd::sub(zero, r), precision, inf) |
+                              approxGreaterThan(signedDist, r, precision, inf);
+
+        // Bounds of the rectangle, padded by the radius
+        const simd::Pack lx = simd::sub(simd::sub(cx, simd::mul(signedDist, nx)), px);
+        const simd::Pack ly = simd::sub(simd::sub(cy, simd::mul(signedDist, ny)), py);
+        const simd::Pack lz = simd::sub(simd::sub(cz, simd::mul(signedDist, nz)), pz);
+        const simd::Pack s  = simd::add(simd::add(simd::mul(lx, simd::load(pairs.ux + i)),
+                                                  simd::mul(ly, simd::load(pairs.uy + i))),
+                                        simd::mul(lz, simd::load(pairs.uz + i)));
+        const simd::Pack t  = simd::add(simd::add(simd::mul(lx, simd::load(pairs.vx + i)),
+                                                  simd::mul(ly, simd::load(pairs.vy + i))),
+                                        simd::mul(lz, simd::load(pairs.vz + i)));
+        rejected |= approxGreaterThan(simd::abs(s), simd::add(simd::load(pairs.halfWidth + i), r), precision,
+                                      inf) |
+                    approxGreaterThan(simd::abs(t), simd::add(simd::load(pairs.halfHeight + i), r), precision,
+                                      inf);
+        storeCandidates(candidates + i, ~rejected & simd::allElements);
+    }
+    for (; i < count; ++i)
+    {
+        const decimal signedDist = (pairs.cx[i] - pairs.px[i]) * pairs.nx[i] +
+                                   (pairs.cy[i] - pairs.py[i]) * pairs.ny[i] +
+                                   (pairs.cz[i] - pairs.pz[i]) * pairs.nz[i];
+        if (commonMaths::approxSmallerThan(signedDist, -pairs.r[i]) ||
+            commonMaths::approxGreaterThan(signedDist, pairs.r[i]))
+        {
+            candidates[i] = 0;
+            continue;
+        }
+        const decimal lx = pairs.cx[i] - signedDist * pairs.nx[i] - pairs.px[i];
+        const decimal ly = pairs.cy[i] - signedDist * pairs.ny[i] - pairs.py[i];
+        const decimal lz = pairs.cz[i] - signedDist * pairs.nz[i] - pairs.pz[i];
+        const decimal s  = lx * pairs.ux[i] + ly * pairs.uy[i] + lz * pairs.uz[i];
+        const decimal t  = lx * pairs.vx[i] + ly * pairs.vy[i] + lz * pairs.vz[i];
+        const bool    outside =
+            commonMaths::approxGreaterThan(commonMaths::absVal(s), pairs.halfWidth[i] + pairs.r[i]) ||
+            commonMaths::approxGreaterThan(commonMaths::absVal(t), pairs.halfHeight[i] + pairs.r[i]);
+        candidates[i] = outside ? 0 : 1;
+    }
+}
+
+} // namespace NarrowKernels
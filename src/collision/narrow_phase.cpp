@@ -0,0 +1,383 @@
+#include "collision/narrow_phase.hpp"
+
+#include "collision/narrow_collision.hpp"
+#include "collision/narrow_kernels.hpp"
+
+#include <algorithm>
+
+using NarrowCollision::BoxShape;
+using NarrowCollision::PlaneShape;
+using NarrowCollision::SphereShape;
+
+// ============================================================================
+//  Getters / Setters
+// ============================================================================
+PairBucket NarrowPhase::getBucket(ObjectType a, ObjectType b)
+{
+    // Sphere < AABB < Plane: the first type of a bucket name is the smaller one
+    if (b < a)
+        std::swap(a, b);
+    switch (a)
+    {
+    case ObjectType::Sphere:
+        if (b == ObjectType::Sphere)
+            return PairBucket::SphereSphere;
+        return b == ObjectType::AABB ? PairBucket::SphereAABB : PairBucket::SpherePlane;
+    case ObjectType::AABB:
+        return b == ObjectType::AABB ? PairBucket::AABBAABB : PairBucket::AABBPlane;
+    case ObjectType::Plane:
+        return PairBucket::PlanePlane;
+    case ObjectType::Generic:
+        break;
+    }
+    return PairBucket::Other;
+}
+void NarrowPhase::setCaching(bool enabled)
+{
+    caching = enabled;
+    if (!caching)
+        pairCache.clear();
+}
+
+// ============================================================================
+//  Kernels
+// ============================================================================
+namespace {
+
+/// Data shared by the kernels of one `compute`.
+struct Batch
+{
+    const BodyStorage&                bodies;
+    const std::vector<CollisionPair>& pairs;
+    std::span<const std::uint32_t>    order;
+    std::span<Contact>                contacts;
+    std::span<std::uint8_t>           found;
+    FrameArena&                       frame;
+};
+
+void gather(const BodyStorage& bodies, std::size_t slot, SphereShape& shape)
+{
+    shape.center = bodies.getPositions().get(slot);
+    shape.radius = bodies.getColdData(slot).size.getX() * 0.5_d;
+}
+void gather(const BodyStorage& bodies, std::size_t slot, BoxShape& shape)
+{
+    shape.center      = bodies.getPositions().get(slot);
+    shape.halfExtents = bodies.getColdData(slot).size * 0.5_d;
+}
+void gather(const BodyStorage& bodies, std::size_t slot, PlaneShape& shape)
+{
+    // Axes and extents of a plane are not in the storage arrays
+    shape = NarrowCollision::shapeOf(static_cast<const Plane&>(*bodies.getObject(slot)));
+}
+
+/// Slots of the pair of `order[i]`, the one of type `firstType` first.
+std::pair<std::size_t, std::size_t> orientedSlots(const Batch& batch, std::size_t i, ObjectType firstType)
+{
+    const CollisionPair& pair = batch.pairs[batch.order[i]];
+    if (batch.bodies.getType(pair.first) == firstType)
+        return { pair.first, pair.second };
+    return { pair.second, pair.first };
+}
+
+/// Write the result of pair `k`: `contact.A` is the object of `a`.
+void store(const Batch& batch, std::size_t k, bool hit, std::size_t a, std::size_t b)
+{
+    batch.found[k] = hit ? 1 : 0;
+    if (!hit)
+        return;
+    batch.contacts[k].A = batch.bodies.getObject(a);
+    batch.contacts[k].B = batch.bodies.getObject(b);
+}
+
+/**
+ * @brief Pairs `[first, last)` of `order` made of a `First` and a `Second` shape.
+ *
+ * The shapes of the whole range are gathered into two arrays, then the contacts are computed in one pass.
+ */
+template <typename First, typename Second>
+void shapeKernel(const Batch& batch, std::size_t first, std::size_t last, ObjectType firstType)
+{
+    const std::size_t        count   = last - first;
+    std::span<First>         shapesA = batch.frame.allocate<First>(count);
+    std::span<Second>        shapesB = batch.frame.allocate<Second>(count);
+    std::span<std::uint32_t> slots   = batch.frame.allocate<std::uint32_t>(2 * count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto [a, b] = orientedSlots(batch, first + i, firstType);
+        gather(batch.bodies, a, shapesA[i]);
+        gather(batch.bodies, b, shapesB[i]);
+        slots[2 * i]     = static_cast<std::uint32_t>(a);
+        slots[2 * i + 1] = static_cast<std::uint32_t>(b);
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::size_t k = batch.order[first + i];
+        batch.contacts[k]   = Contact();
+        const bool hit      = NarrowCollision::computeContact(shapesA[i], shapesB[i], batch.contacts[k]);
+        store(batch, k, hit, slots[2 * i], slots[2 * i + 1]);
+    }
+}
+
+/**
+ * @brief Sphere–sphere pairs `[first, last)` of `order`.
+ *
+ * Centers and radii are gathered into component arrays, NarrowKernels flags the pairs that are not
+ * separated, and only those go through the full contact.
+ */
+void sphereSphereKernel(const Batch& batch, std::size_t first, std::size_t last)
+{
+    const Vector3DArray&    positions  = batch.bodies.getPositions();
+    const std::size_t       count      = last - first;
+    std::span<decimal>      data       = batch.frame.allocate<decimal>(8 * count);
+    std::span<std::uint8_t> candidates = batch.frame.allocate<std::uint8_t>(count);
+    decimal*                ax         = data.data();
+    decimal*                ay         = ax + count;
+    decimal*                az         = ay + count;
+    decimal*                ar         = az + count;
+    decimal*                bx         = ar + count;
+    decimal*                by         = bx + count;
+    decimal*                bz         = by + count;
+    decimal*                br         = bz + count;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const CollisionPair& pair = batch.pairs[batch.order[first + i]];
+        ax[i]                     = positions.x[pair.first];
+        ay[i]                     = positions.y[pair.first];
+        az[i]                     = positions.z[pair.first];
+        ar[i]                     = batch.bodies.getColdData(pair.first).size.getX() * 0.5_d;
+        bx[i]                     = positions.x[pair.second];
+        by[i]                     = positions.y[pair.second];
+        bz[i]                     = positions.z[pair.second];
+        br[i]                     = batch.bodies.getColdData(pair.second).size.getX() * 0.5_d;
+    }
+    NarrowKernels::sphereSphere({ ax, ay, az, ar, bx, by, bz, br }, count, candidates.data());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::size_t    k    = batch.order[first + i];
+        const CollisionPair& pair = batch.pairs[k];
+        batch.contacts[k]         = Contact();
+        bool touching             = false;
+        if (candidates[i])
+        {
+            const SphereShape a { Vector3D(ax[i], ay[i], az[i]), ar[i] };
+            const SphereShape b { Vector3D(bx[i], by[i], bz[i]), br[i] };
+            touching = NarrowCollision::computeContact(a, b, batch.contacts[k]);
+        }
+        store(batch, k, touching, pair.first, pair.second);
+    }
+}
+
+/**
+ * @brief Sphere–plane pairs `[first, last)` of `order`.
+ *
+ * Sphere and plane parameters are gathered into component arrays, NarrowKernels flags the pairs passing
+ * the distance and bound tests, and only those go through the full contact.
+ */
+void spherePlaneKernel(const Batch& batch, std::size_t first, std::size_t last)
+{
+    const std::size_t        count      = last - first;
+    std::span<decimal>       data       = batch.frame.allocate<decimal>(18 * count);
+    std::span<std::uint8_t>  candidates = batch.frame.allocate<std::uint8_t>(count);
+    std::span<std::uint32_t> slots      = batch.frame.allocate<std::uint32_t>(2 * count);
+    std::array<decimal*, 18> arrays;
+    for (std::size_t a = 0; a < arrays.size(); ++a)
+        arrays[a] = data.data() + a * count;
+    auto [cx, cy, cz, r, px, py, pz, nx, ny, nz, ux, uy, uz, vx, vy, vz, halfWidth, halfHeight] = arrays;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto [sphere, plane] = orientedSlots(batch, first + i, ObjectType::Sphere);
+        SphereShape s;
+        PlaneShape  p;
+        gather(batch.bodies, sphere, s);
+        gather(batch.bodies, plane, p);
+        cx[i]            = s.center[0];
+        cy[i]            = s.center[1];
+        cz[i]            = s.center[2];
+        r[i]             = s.radius;
+        px[i]            = p.center[0];
+        py[i]            = p.center[1];
+        pz[i]            = p.center[2];
+        nx[i]            = p.normal[0];
+        ny[i]            = p.normal[1];
+        nz[i]            = p.normal[2];
+        ux[i]            = p.u[0];
+        uy[i]            = p.u[1];
+        uz[i]            = p.u[2];
+        vx[i]            = p.v[0];
+        vy[i]            = p.v[1];
+        vz[i]            = p.v[2];
+        halfWidth[i]     = p.halfWidth;
+        halfHeight[i]    = p.halfHeight;
+        slots[2 * i]     = static_cast<std::uint32_t>(sphere);
+        slots[2 * i + 1] = static_cast<std::uint32_t>(plane);
+    }
+    NarrowKernels::spherePlane({ cx, cy, cz, r, px, py, pz, nx, ny, nz, ux, uy, uz, vx, vy, vz, halfWidth,
+                                 halfHeight },
+                               count, candidates.data());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::size_t k = batch.order[first + i];
+        batch.contacts[k]   = Contact();
+        bool touching       = false;
+        if (candidates[i])
+        {
+            const SphereShape s { Vector3D(cx[i], cy[i], cz[i]), r[i] };
+            const PlaneShape  p { Vector3D(px[i], py[i], pz[i]), Vector3D(nx[i], ny[i], nz[i]),
+                                 Vector3D(ux[i], uy[i], uz[i]), Vector3D(vx[i], vy[i], vz[i]), halfWidth[i],
+                                 halfHeight[i] };
+            touching = NarrowCollision::computeContact(s, p, batch.contacts[k]);
+        }
+        store(batch, k, touching, slots[2 * i], slots[2 * i + 1]);
+    }
+}
+
+/// Pairs `[first, last)` of `order` with a Generic object, through the virtual dispatch of the objects.
+void objectKernel(const Batch& batch, std::size_t first, std::size_t last)
+{
+    for (std::size_t i = first; i < last; ++i)
+    {
+        const std::size_t k = batch.order[i];
+        Object*           A = batch.bodies.getObject(batch.pairs[k].first);
+        Object*           B = batch.bodies.getObject(batch.pairs[k].second);
+        batch.contacts[k]   = Contact();
+        batch.found[k]      = A->computeCollision(*B, batch.contacts[k]) ? 1 : 0;
+    }
+}
+
+void runBucket(const Batch& batch, PairBucket bucket, std::size_t first, std::size_t last)
+{
+    switch (bucket)
+    {
+    case PairBucket::SphereSphere:
+        return sphereSphereKernel(batch, first, last);
+    case PairBucket::SpherePlane:
+        return spherePlaneKernel(batch, first, last);
+    case PairBucket::SphereAABB:
+        return shapeKernel<SphereShape, BoxShape>(batch, first, last, ObjectType::Sphere);
+    case PairBucket::AABBAABB:
+        return shapeKernel<BoxShape, BoxShape>(batch, first, last, ObjectType::AABB);
+    case PairBucket::AABBPlane:
+        return shapeKernel<BoxShape, PlaneShape>(batch, first, last, ObjectType::AABB);
+    case PairBucket::PlanePlane:
+        return shapeKernel<PlaneShape, PlaneShape>(batch, first, last, ObjectType::Plane);
+    case PairBucket::Other:
+        return objectKernel(batch, first, last);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+//  Computation
+// ============================================================================
+/**
+ * @brief Mark the pairs known apart by the pair cache, or whose separation proves them apart now.
+ *
+ * The rows of the cache are rewritten in parallel over chunks of the pairs moved to the start of a row, so
+ * that each row has a single writer.
+ */
+void NarrowPhase::markSeparated(const std::vector<Object*>& objects, const std::vector<CollisionPair>& pairs,
+                                std::span<std::uint8_t> separated, ThreadPool& pool, std::size_t grain)
+{
+    const std::size_t pairCount = pairs.size();
+    const auto        rowStart  = [&](std::size_t k)
+    {
+        while (k > 0 && k < pairCount && pairs[k].first == pairs[k - 1].first)
+            ++k;
+        return k;
+    };
+    pairCache.update(objects, &pool);
+    pool.parallelFor(0, pairCount, pool.grainFor(pairCount, grain),
+                     [&](std::size_t first, std::size_t last)
+                     {
+                         const std::size_t end = rowStart(last);
+                         for (std::size_t k = rowStart(first); k < end;)
+                         {
+                             const std::size_t a   = pairs[k].first;
+                             PairCache::Row    row = pairCache.row(a);
+                             for (; k < end && pairs[k].first == a; ++k)
+                             {
+                                 const std::size_t b     = pairs[k].second;
+                                 const bool        apart = row.isSeparated(b) ||
+                                                    row.store(b, PairCache::getNarrowSeparation(*objects[a],
+                                                                                               *objects[b]));
+                                 separated[k] = apart ? 1 : 0;
+                             }
+                             row.finish();
+                         }
+                     });
+}
+/**
+ * @brief Pair cache, counting sort of the pairs by bucket, then the kernels over chunks of the sorted pairs.
+ *
+ * With caching, pairs known apart (see markSeparated) are not in contact and go to the end of their bucket,
+ * where no kernel runs.
+ *
+ * Inside a bucket, pairs keep their order. A chunk may span several buckets: each part runs through the
+ * kernel of its bucket, with its shapes gathered in the frame lane of the running thread and released
+ * right after.
+ */
+void NarrowPhase::compute(const BodyStorage& bodies, const std::vector<CollisionPair>& pairs,
+                          std::span<Contact> contacts, std::span<std::uint8_t> found, ThreadPool& pool,
+                          FrameArena& frame, std::size_t grain)
+{
+    const std::size_t           pairCount = pairs.size();
+    const std::vector<Object*>& objects   = bodies.getObjects();
+    std::span<std::uint8_t>     separated = frame.allocate<std::uint8_t>(pairCount);
+    if (caching)
+        markSeparated(objects, pairs, separated, pool, grain);
+    else
+        std::fill(separated.begin(), separated.end(), std::uint8_t { 0 });
+
+    std::span<std::uint8_t>                  buckets = frame.allocate<std::uint8_t>(pairCount);
+    std::array<std::size_t, pairBucketCount> tested  = {};
+    bucketStart.fill(0);
+    for (std::size_t k = 0; k < pairCount; ++k)
+    {
+        const PairBucket bucket = getBucket(bodies.getType(pairs[k].first), bodies.getType(pairs[k].second));
+        buckets[k]              = static_cast<std::uint8_t>(bucket);
+        ++bucketStart[buckets[k] + 1];
+        if (separated[k])
+            found[k] = 0;
+        else
+            ++tested[buckets[k]];
+    }
+    for (std::size_t b = 0; b < pairBucketCount; ++b)
+        bucketStart[b + 1] += bucketStart[b];
+
+    // Tested pairs first in each bucket, then the separated ones
+    order = frame.allocate<std::uint32_t>(pairCount);
+    std::array<std::size_t, pairBucketCount> testedCursor    = {};
+    std::array<std::size_t, pairBucketCount> separatedCursor = {};
+    for (std::size_t b = 0; b < pairBucketCount; ++b)
+    {
+        testedCursor[b]    = bucketStart[b];
+        separatedCursor[b] = bucketStart[b] + tested[b];
+    }
+    for (std::size_t k = 0; k < pairCount; ++k)
+    {
+        std::size_t& cursor = separated[k] ? separatedCursor[buckets[k]] : testedCursor[buckets[k]];
+        order[cursor++]     = static_cast<std::uint32_t>(k);
+    }
+
+    const Batch batch { bodies, pairs, order, contacts, found, frame };
+    pool.parallelFor(0, pairCount, pool.grainFor(pairCount, grain),
+                     [&](std::size_t first, std::size_t last)
+                     {
+                         for (std::size_t b = 0; b < pairBucketCount; ++b)
+                         {
+                             const std::size_t begin = std::max(first, bucketStart[b]);
+                             const std::size_t end   = std::min(last, bucketStart[b] + tested[b]);
+                             if (begin >= end)
+                                 continue;
+                             const FrameArena::Marker mark = frame.mark();
+                             runBucket(batch, static_cast<PairBucket>(b), begin, end);
+                             frame.rewind(mark);
+                         }
+                     });
+}
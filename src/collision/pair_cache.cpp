@@ -0,0 +1,152 @@
+#include "collision/pair_cache.hpp"
+
+#include "collision/broad_collision.hpp"
+#include "collision/narrow_collision.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// Call `next` with `obj` cast to its type; 0 (may collide) for the types without a known separation.
+template <typename Next>
+decimal withType(const Object& obj, Next&& next)
+{
+    switch (obj.getType())
+    {
+    case ObjectType::Sphere:
+        return next(static_cast<const Sphere&>(obj));
+    case ObjectType::AABB:
+        return next(static_cast<const AABB&>(obj));
+    case ObjectType::Plane:
+        return next(static_cast<const Plane&>(obj));
+    case ObjectType::Generic:
+        break;
+    }
+    return 0_d;
+}
+
+/// Call `separation` with both objects cast to their types.
+template <typename Separation>
+decimal separationOf(const Object& a, const Object& b, Separation&& separation)
+{
+    return withType(a, [&](const auto& first)
+                    { return withType(b, [&](const auto& second) { return separation(first, second); }); });
+}
+
+} // namespace
+
+// ============================================================================
+//  Getters
+// ============================================================================
+std::size_t PairCache::getEntryCount() const
+{
+    std::size_t count = 0;
+    for (const std::vector<Entry>& row : rows)
+        count += row.size();
+    return count;
+}
+std::size_t PairCache::getSkippedCount() const
+{
+    std::size_t count = 0;
+    for (const std::size_t skipped : skipCounts)
+        count += skipped;
+    return count;
+}
+decimal PairCache::getBroadSeparation(const Object& a, const Object& b)
+{
+    return separationOf(a, b, [](const auto& first, const auto& second)
+                        { return BroadCollision::separation(first, second); });
+}
+decimal PairCache::getNarrowSeparation(const Object& a, const Object& b)
+{
+    return separationOf(a, b,
+                        [](const auto& first, const auto& second)
+                        {
+                            return NarrowCollision::separation(NarrowCollision::shapeOf(first),
+                                                               NarrowCollision::shapeOf(second));
+                        });
+}
+
+// ============================================================================
+//  Passes
+// ============================================================================
+PairCache::Footprint PairCache::footprintOf(const Object& obj)
+{
+    Footprint      footprint;
+    const Vector3D size = obj.getSize();
+    footprint.type      = obj.getType();
+    footprint.occupied  = true;
+    footprint.shape     = { size[0], size[1], size[2] };
+    if (footprint.type == ObjectType::Plane)
+    {
+        const Plane&    plane  = static_cast<const Plane&>(obj);
+        const Vector3D& normal = plane.getNormal();
+        footprint.shape[3]     = normal[0];
+        footprint.shape[4]     = normal[1];
+        footprint.shape[5]     = normal[2];
+        footprint.shape[6]     = plane.getHalfWidth();
+        footprint.shape[7]     = plane.getHalfHeight();
+    }
+    return footprint;
+}
+
+void PairCache::clear()
+{
+    for (std::vector<Entry>& row : rows)
+        row.clear();
+    std::fill(travel.begin(), travel.end(), 0.0);
+}
+
+/**
+ * @brief Add to the travel of every object the length of its displacement since the last update.
+ *
+ * The displacement is computed in double precision from the positions, so the travel is an upper bound on
+ * the distance between the current position and any position since the cache was cleared, up to the
+ * relative rounding covered by `travelMargin`.
+ */
+void PairCache::update(const std::vector<Object*>& objects, const ThreadPool* threadPool)
+{
+    // A row has fewer entries than there are objects: lanes never grow during a pass, whatever rows their
+    // thread rewrites
+    const std::size_t n     = objects.size();
+    pool                    = threadPool;
+    const std::size_t count = pool ? pool->getThreadCount() : 1;
+    lanes.resize(count);
+    for (std::vector<Entry>& lane : lanes)
+        lane.reserve(n);
+    skipCounts.assign(count, 0);
+
+    bool changed = n != rows.size();
+    rows.resize(n);
+    travel.resize(n, 0.0);
+    scale.resize(n, 0.0);
+    positions.resize(n, Vector3D(0_d));
+    footprints.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (!objects[i])
+            continue;
+        const Footprint footprint = footprintOf(*objects[i]);
+        const Vector3D  position  = objects[i]->getPosition();
+        if (!(footprint == footprints[i]))
+        {
+            footprints[i] = footprint;
+            changed       = true;
+        }
+        double moved = 0.0;
+        double size  = 0.0;
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            const double delta = static_cast<double>(position[c]) - static_cast<double>(positions[i][c]);
+            moved += delta * delta;
+        }
+        for (const decimal value : footprint.shape)
+            size = std::max(size, std::abs(static_cast<double>(value)));
+        travel[i]    += std::sqrt(moved);
+        scale[i]      = static_cast<double>(position.getAbsolute().getMax()) + size;
+        positions[i]  = position;
+    }
+    if (changed)
+        clear();
+}
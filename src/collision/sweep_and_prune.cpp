@@ -0,0 +1,164 @@
+#include "collision/sweep_and_prune.hpp"
+
+#include <algorithm>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+/**
+ * @brief Strict ordering of endpoints.
+ *
+ * At equal values, a minimum endpoint comes before a maximum one so that touching intervals are reported as
+ * overlapping.
+ */
+static bool endpointLess(decimal valueA, bool isMinA, decimal valueB, bool isMinB)
+{
+    return valueA < valueB || (valueA == valueB && isMinA && !isMinB);
+}
+
+/// Recompute the boxes of the objects; sleeping ones have not moved and may keep theirs.
+void SweepAndPrune::updateBoxes(const std::vector<Object*>& objects, bool skipSleeping)
+{
+    for (std::size_t i = 0; i < proxyCount; ++i)
+    {
+        if (objects[i] && !(skipSleeping && isSleeping(i)))
+            boxes[i] = objects[i]->getBoundingBox().getFattened(margin);
+    }
+}
+
+/**
+ * @brief Rebuild the three endpoint lists from scratch with a full sort.
+ *
+ * Called on the first step and whenever the object array changed.
+ */
+void SweepAndPrune::rebuild(const std::vector<Object*>& objects)
+{
+    proxyCount = objects.size();
+    boxes.assign(proxyCount, BoundingBox());
+    activeSlot.assign(proxyCount, 0);
+    updateBoxes(objects, false);
+
+    for (std::size_t a = 0; a < 3; ++a)
+    {
+        std::vector<Endpoint>& axis = axes[a];
+        axis.clear();
+        for (std::size_t i = 0; i < proxyCount; ++i)
+        {
+            if (!objects[i])
+                continue;
+            const auto proxy = static_cast<std::uint32_t>(i);
+            axis.push_back({ boxes[i].min[a], proxy, true });
+            axis.push_back({ boxes[i].max[a], proxy, false });
+        }
+        std::sort(axis.begin(), axis.end(), [](const Endpoint& lhs, const Endpoint& rhs)
+                  { return endpointLess(lhs.value, lhs.isMin, rhs.value, rhs.isMin); });
+    }
+    built = true;
+}
+
+/**
+ * @brief Insertion sort of a nearly sorted endpoint list.
+ *
+ * With small displacements between steps each endpoint only moves past a few neighbours, so the cost is
+ * close to linear in the number of objects.
+ */
+void SweepAndPrune::insertionSort(std::vector<Endpoint>& axis)
+{
+    for (std::size_t i = 1; i < axis.size(); ++i)
+    {
+        const Endpoint key = axis[i];
+        std::size_t    j   = i;
+        while (j > 0 && endpointLess(key.value, key.isMin, axis[j - 1].value, axis[j - 1].isMin))
+        {
+            axis[j] = axis[j - 1];
+            --j;
+        }
+        axis[j] = key;
+    }
+}
+
+// ============================================================================
+//  Broad phase
+// ============================================================================
+/**
+ * @brief Update the sorted lists and sweep the axis of largest spread.
+ *
+ * During the sweep, a minimum endpoint opens the interval of its object, which is tested against every
+ * currently open interval; a maximum endpoint closes it. Candidate pairs overlap on all three axes and pass
+ * the polymorphic `Object::checkCollision`, so the list is the one of the brute-force reference restricted
+ * to overlapping boxes (which bound every shape handled by the narrow phase).
+ */
+void SweepAndPrune::computePairs(const std::vector<Object*>& objects, std::vector<CollisionPair>& pairs)
+{
+    pairs.clear();
+
+    if (!built || objects.size() != proxyCount)
+    {
+        rebuild(objects);
+    }
+    else
+    {
+        updateBoxes(objects, true);
+        for (std::size_t a = 0; a < 3; ++a)
+        {
+            for (Endpoint& e : axes[a])
+                e.value = e.isMin ? boxes[e.proxy].min[a] : boxes[e.proxy].max[a];
+            insertionSort(axes[a]);
+        }
+    }
+
+    // Choose the sweep axis with the largest variance of box centres
+    Vector3D    sum(0_d);
+    Vector3D    sumSquare(0_d);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < proxyCount; ++i)
+    {
+        if (!objects[i])
+            continue;
+        const Vector3D c = boxes[i].getCenter();
+        sum += c;
+        sumSquare += c * c;
+        ++count;
+    }
+    if (count == 0)
+        return;
+    const decimal  invCount = 1_d / static_cast<decimal>(count);
+    const Vector3D mean     = sum * invCount;
+    const Vector3D variance = sumSquare * invCount - mean * mean;
+    sweepAxis               = 0;
+    if (variance[1] > variance[sweepAxis])
+        sweepAxis = 1;
+    if (variance[2] > variance[sweepAxis])
+        sweepAxis = 2;
+
+    // Sweep: box overlaps are collected, then the shape checks run on the pool
+    active.clear();
+    candidates.clear();
+    for (const Endpoint& e : axes[sweepAxis])
+    {
+        if (e.isMin)
+        {
+            for (const std::uint32_t other : active)
+            {
+                if (!boxes[other].overlaps(boxes[e.proxy]))
+                    continue;
+                const std::size_t first  = std::min<std::size_t>(other, e.proxy);
+                const std::size_t second = std::max<std::size_t>(other, e.proxy);
+                candidates.push_back({ first, second });
+            }
+            activeSlot[e.proxy] = static_cast<std::uint32_t>(active.size());
+            active.push_back(e.proxy);
+        }
+        else
+        {
+            const std::uint32_t slot = activeSlot[e.proxy];
+            const std::uint32_t last = active.back();
+            active[slot]             = last;
+            activeSlot[last]         = slot;
+            active.pop_back();
+        }
+    }
+    appendColliding(objects, candidates, pairs);
+
+    std::sort(pairs.begin(), pairs.end());
+}
@@ -0,0 +1,199 @@
+#include "collision/uniform_grid.hpp"
+
+#include "objects/sphere.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+/**
+ * @brief Choose a cell size when none is configured.
+ *
+ * The cell edge is the median Sphere diameter, so a typical sphere covers at most two cells per axis. Without
+ * spheres, the median largest extent of the non-plane bounding boxes is used instead.
+ */
+decimal UniformGrid::inferCellSize(const std::vector<Object*>& objects) const
+{
+    std::vector<decimal> sizes;
+    for (const Object* obj : objects)
+    {
+        if (obj && obj->getType() == ObjectType::Sphere)
+            sizes.push_back(2_d * static_cast<const Sphere*>(obj)->getRadius());
+    }
+    if (sizes.empty())
+    {
+        for (const Object* obj : objects)
+        {
+            if (obj && obj->getType() != ObjectType::Plane)
+                sizes.push_back(obj->getBoundingBox().getExtents().getMax());
+        }
+    }
+    if (sizes.empty())
+        return 1_d;
+
+    auto median = sizes.begin() + static_cast<std::ptrdiff_t>(sizes.size() / 2);
+    std::nth_element(sizes.begin(), median, sizes.end());
+    return *median > PRECISION_MACHINE ? *median : 1_d;
+}
+
+UniformGrid::CellRange UniformGrid::computeCellRange(const BoundingBox& box) const
+{
+    CellRange range;
+    for (std::size_t a = 0; a < 3; ++a)
+    {
+        range.min[a] = static_cast<std::int64_t>(std::floor(box.min[a] / cellSize));
+        range.max[a] = static_cast<std::int64_t>(std::floor(box.max[a] / cellSize));
+    }
+    return range;
+}
+
+std::uint32_t UniformGrid::hashCell(std::int64_t x, std::int64_t y, std::int64_t z) const
+{
+    const std::uint64_t h = (static_cast<std::uint64_t>(x) * 73856093ULL) ^
+                            (static_cast<std::uint64_t>(y) * 19349663ULL) ^
+                            (static_cast<std::uint64_t>(z) * 83492791ULL);
+    return static_cast<std::uint32_t>(h & bucketMask);
+}
+
+/**
+ * @brief Fill the hash table with a counting sort of the (cell, object) entries.
+ *
+ * Two passes over the gridded objects: the first counts the entries of each bucket, the second writes the
+ * object indices at their final place. No per-cell allocation is made.
+ */
+void UniformGrid::buildTable()
+{
+    std::size_t entryCount = 0;
+    for (const std::uint32_t i : gridded)
+    {
+        const CellRange& r = ranges[i];
+        entryCount += static_cast<std::size_t>((r.max[0] - r.min[0] + 1) * (r.max[1] - r.min[1] + 1) *
+                                               (r.max[2] - r.min[2] + 1));
+    }
+
+    const std::size_t bucketCount = std::bit_ceil(std::max<std::size_t>(2 * entryCount, 64));
+    bucketMask                    = bucketCount - 1;
+    bucketStart.assign(bucketCount + 1, 0);
+    bucketEntries.resize(entryCount);
+
+    for (const std::uint32_t i : gridded)
+    {
+        const CellRange& r = ranges[i];
+        for (std::int64_t x = r.min[0]; x <= r.max[0]; ++x)
+            for (std::int64_t y = r.min[1]; y <= r.max[1]; ++y)
+                for (std::int64_t z = r.min[2]; z <= r.max[2]; ++z)
+                    ++bucketStart[hashCell(x, y, z) + 1];
+    }
+    for (std::size_t b = 0; b < bucketCount; ++b)
+        bucketStart[b + 1] += bucketStart[b];
+
+    bucketCursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+    for (const std::uint32_t i : gridded)
+    {
+        const CellRange& r = ranges[i];
+        for (std::int64_t x = r.min[0]; x <= r.max[0]; ++x)
+            for (std::int64_t y = r.min[1]; y <= r.max[1]; ++y)
+                for (std::int64_t z = r.min[2]; z <= r.max[2]; ++z)
+                    bucketEntries[bucketCursor[hashCell(x, y, z)]++] = i;
+    }
+}
+
+// ============================================================================
+//  Broad phase
+// ============================================================================
+/**
+ * @brief Bin the objects and collect the pairs sharing a cell.
+ *
+ * A pair of overlapping boxes shares several cells; it is only reported from the bucket of its owner cell,
+ * the cell holding the minimum corner of the boxes' intersection. Hash collisions can still produce a few
+ * duplicates, removed by the final sort. Candidates must also pass `Object::checkCollision`, like the
+ * brute-force reference.
+ */
+void UniformGrid::computePairs(const std::vector<Object*>& objects, std::vector<CollisionPair>& pairs)
+{
+    pairs.clear();
+
+    if (!cellSizeValid)
+    {
+        cellSize      = configuredCellSize > 0_d ? configuredCellSize : inferCellSize(objects);
+        cellSizeValid = true;
+    }
+
+    // Bounding boxes & split between gridded and large objects
+    const std::size_t n = objects.size();
+    boxes.resize(n);
+    ranges.resize(n);
+    gridded.clear();
+    large.clear();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const Object* obj = objects[i];
+        if (!obj)
+            continue;
+
+        boxes[i]  = obj->getBoundingBox().getFattened(margin);
+        ranges[i] = computeCellRange(boxes[i]);
+
+        const CellRange&   r    = ranges[i];
+        const std::int64_t span = std::max({ r.max[0] - r.min[0], r.max[1] - r.min[1], r.max[2] - r.min[2] });
+        if (obj->getType() == ObjectType::Plane || span >= maxCellsPerAxis)
+            large.push_back(static_cast<std::uint32_t>(i));
+        else
+            gridded.push_back(static_cast<std::uint32_t>(i));
+    }
+
+    candidates.clear();
+    auto addPair = [&](std::size_t a, std::size_t b)
+    {
+        candidates.push_back({ std::min(a, b), std::max(a, b) });
+    };
+
+    // Pairs inside each bucket
+    buildTable();
+    for (std::size_t bucket = 0; bucket <= bucketMask; ++bucket)
+    {
+        const std::uint32_t begin = bucketStart[bucket];
+        const std::uint32_t end   = bucketStart[bucket + 1];
+        for (std::uint32_t i = begin; i < end; ++i)
+        {
+            const std::uint32_t a = bucketEntries[i];
+            for (std::uint32_t j = i + 1; j < end; ++j)
+            {
+                const std::uint32_t b = bucketEntries[j];
+                if (a == b || !boxes[a].overlaps(boxes[b]))
+                    continue;
+
+                const CellRange& ra = ranges[a];
+                const CellRange& rb = ranges[b];
+                if (hashCell(std::max(ra.min[0], rb.min[0]), std::max(ra.min[1], rb.min[1]),
+                             std::max(ra.min[2], rb.min[2])) != bucket)
+                    continue;
+
+                addPair(a, b);
+            }
+        }
+    }
+
+    // Large objects against everything
+    for (std::size_t i = 0; i < large.size(); ++i)
+    {
+        const std::uint32_t a = large[i];
+        for (const std::uint32_t b : gridded)
+        {
+            if (boxes[a].overlaps(boxes[b]))
+                addPair(a, b);
+        }
+        for (std::size_t j = i + 1; j < large.size(); ++j)
+        {
+            if (boxes[a].overlaps(boxes[large[j]]))
+                addPair(a, large[j]);
+        }
+    }
+    appendColliding(objects, candidates, pairs);
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+}
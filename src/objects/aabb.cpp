@@ -50,6 +50,8 @@ Vector3D   AABB::getMax() const { return getPosition() + getHalfExtents(); }
 // ============================================================================
 //  Collision
 // ============================================================================
+BoundingBox AABB::getBoundingBox() const { return BoundingBox(getMin(), getMax()); }
+
 /**
  * @brief Checks broad collision between two aabb.
  */
@@ -0,0 +1,212 @@
+/**
+ * @file body_storage.cpp
+ * @brief Implementation of the structure-of-arrays body storage.
+ *
+ * @see body_storage.hpp
+ */
+#include "objects/body_storage.hpp"
+
+#include <utility>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+static decimal inverseMass(decimal mass, bool fixed) { return (fixed || mass <= 0_d) ? 0_d : 1_d / mass; }
+
+/// Copy the state of a slot back into its Object, which then stops being a view.
+void BodyStorage::detach(std::size_t slot)
+{
+    Object* obj = objects[slot];
+    if (!obj)
+        return;
+
+    obj->position     = positions.get(slot);
+    obj->velocity     = velocities.get(slot);
+    obj->acceleration = accelerations.get(slot);
+    obj->fixed        = (flags[slot] & flagFixed) != 0;
+    obj->sleepEnergy  = sleepEnergies[slot];
+    obj->cold         = std::move(cold[slot]);
+    obj->storage      = nullptr;
+    obj->slot         = 0;
+    objects[slot]     = nullptr;
+}
+
+/// Copy every array entry of slot `from` into slot `to`, and point the Object of `from` to its new slot.
+void BodyStorage::moveSlot(std::size_t from, std::size_t to)
+{
+    positions.set(to, positions.get(from));
+    velocities.set(to, velocities.get(from));
+    accelerations.set(to, accelerations.get(from));
+    inverseMasses[to] = inverseMasses[from];
+    motionMasks[to]   = motionMasks[from];
+    flags[to]         = flags[from];
+    sleepEnergies[to] = sleepEnergies[from];
+    stillTimes[to]    = stillTimes[from];
+    sleepGroups[to]   = sleepGroups[from];
+    materialIds[to]   = materialIds[from];
+    cold[to]          = std::move(cold[from]);
+    types[to]         = types[from];
+    objects[to]       = objects[from];
+    if (objects[to])
+        objects[to]->slot = to;
+}
+
+/**
+ * @brief Remove a slot by moving the last one into it.
+ *
+ * Sleep groups name slots: the bodies asleep with the removed one are woken up, as it may have held them, and
+ * the group named after the moved slot follows it.
+ */
+void BodyStorage::removeSlot(std::size_t slot)
+{
+    const std::size_t last = objects.size() - 1;
+    if (sleepingCount > 0)
+    {
+        const bool          asleep = isSleeping(slot);
+        const std::uint32_t group  = sleepGroups[slot];
+        for (std::size_t i = 0; i < objects.size(); ++i)
+        {
+            if (!isSleeping(i))
+                continue;
+            if (asleep && sleepGroups[i] == group)
+                wakeSleeping(i);
+            else if (sleepGroups[i] == last)
+                sleepGroups[i] = static_cast<std::uint32_t>(slot);
+        }
+    }
+    materials.release(materialIds[slot]);
+    if (slot != last)
+        moveSlot(last, slot);
+
+    positions.pop_back();
+    velocities.pop_back();
+    accelerations.pop_back();
+    inverseMasses.pop_back();
+    motionMasks.pop_back();
+    flags.pop_back();
+    sleepEnergies.pop_back();
+    stillTimes.pop_back();
+    sleepGroups.pop_back();
+    materialIds.pop_back();
+    cold.pop_back();
+    types.pop_back();
+    objects.pop_back();
+    ++version;
+}
+void BodyStorage::wakeSleeping(std::size_t slot)
+{
+    flags[slot] &= static_cast<std::uint8_t>(~flagSleeping);
+    --sleepingCount;
+    motionMasks[slot] = (flags[slot] & flagFixed) ? 0_d : 1_d;
+    stillTimes[slot]  = 0_d;
+}
+
+// ============================================================================
+//  Body management
+// ============================================================================
+/**
+ * @brief Append a slot holding the current state of `obj`.
+ *
+ * An Object already stored elsewhere is first detached from its previous storage. Adding an Object twice to
+ * the same storage returns its existing slot.
+ */
+std::size_t BodyStorage::add(Object& obj)
+{
+    if (obj.storage == this)
+        return obj.slot;
+    if (obj.storage)
+        obj.storage->remove(obj);
+
+    const decimal mass = obj.cold.mass;
+    positions.push_back(obj.position);
+    velocities.push_back(obj.velocity);
+    accelerations.push_back(obj.acceleration);
+    inverseMasses.push_back(inverseMass(mass, obj.fixed));
+    motionMasks.push_back(obj.fixed ? 0_d : 1_d);
+    flags.push_back(static_cast<std::uint8_t>(flagActive | (obj.fixed ? flagFixed : 0)));
+    sleepEnergies.push_back(obj.sleepEnergy);
+    stillTimes.push_back(0_d);
+    sleepGroups.push_back(0);
+    cold.push_back(std::move(obj.cold));
+    materialIds.push_back(materials.intern(cold.back()));
+    types.push_back(obj.getType());
+    objects.push_back(&obj);
+
+    obj.storage = this;
+    obj.slot    = objects.size() - 1;
+    ++version;
+    return obj.slot;
+}
+std::size_t BodyStorage::remove(Object& obj)
+{
+    if (obj.storage != this)
+        return size();
+
+    const std::size_t slot = obj.slot;
+    detach(slot);
+    removeSlot(slot);
+    return slot;
+}
+/**
+ * @brief Forget the Object of a slot without touching the Object itself.
+ *
+ * Called from the Object destructor: the slot stays in place (so other slots keep their index) but is no
+ * longer active.
+ */
+void BodyStorage::release(std::size_t slot)
+{
+    if (isSleeping(slot))
+        --sleepingCount;
+    objects[slot]     = nullptr;
+    flags[slot]       = 0;
+    motionMasks[slot] = 0_d;
+    ++version;
+}
+void BodyStorage::clear()
+{
+    for (std::size_t slot = 0; slot < objects.size(); ++slot)
+        detach(slot);
+
+    positions.clear();
+    velocities.clear();
+    accelerations.clear();
+    inverseMasses.clear();
+    motionMasks.clear();
+    flags.clear();
+    sleepEnergies.clear();
+    stillTimes.clear();
+    sleepGroups.clear();
+    materialIds.clear();
+    materials.clear();
+    cold.clear();
+    types.clear();
+    objects.clear();
+    sleepingCount = 0;
+    ++version;
+}
+void BodyStorage::setMass(std::size_t slot, decimal mass, bool fixed)
+{
+    wake(slot);
+    cold[slot].mass     = mass;
+    inverseMasses[slot] = inverseMass(mass, fixed);
+    motionMasks[slot]   = fixed ? 0_d : 1_d;
+    if (fixed)
+        flags[slot] |= flagFixed;
+    else
+        flags[slot] &= static_cast<std::uint8_t>(~flagFixed);
+}
+
+// ============================================================================
+//  Sleeping
+// ============================================================================
+void BodyStorage::sleep(std::size_t slot, std::uint32_t group)
+{
+    if (!isDynamic(slot))
+        return;
+    flags[slot] |= flagSleeping;
+    ++sleepingCount;
+    motionMasks[slot] = 0_d;
+    sleepGroups[slot] = group;
+    velocities.set(slot, Vector3D(0_d));
+    accelerations.set(slot, Vector3D(0_d));
+}
@@ -0,0 +1,117 @@
+/**
+ * @file material_registry.cpp
+ * @brief Implementation of the material registry and its pair table.
+ *
+ * @see material_registry.hpp
+ */
+#include "objects/material_registry.hpp"
+
+#include "mathematics/common.hpp"
+#include "world/physics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <initializer_list>
+
+// ============================================================================
+//  Registration
+// ============================================================================
+/**
+ * @brief Mix the constants of two materials as the contact models do.
+ *
+ * Same values as `Physics::computeContactModel` (stiffness, damping ratio and friction) and
+ * `reboundCollision` (restitution).
+ */
+MaterialPair MaterialRegistry::mix(const MaterialProperties& a, const MaterialProperties& b)
+{
+    MaterialPair pair;
+    const decimal k = Physics::effectiveStiffness(a.stiffnessCst, b.stiffnessCst);
+    if (!commonMaths::approxEqual(k, 0_d))
+    {
+        const decimal e   = std::sqrt(a.restitutionCst * b.restitutionCst);
+        pair.stiffness    = k;
+        pair.dampingRatio = Physics::dampingRatioFromRestitution(e);
+    }
+    const decimal friction = std::sqrt(a.frictionCst * b.frictionCst);
+    if (!commonMaths::approxEqual(friction, 0_d))
+        pair.friction = friction;
+    pair.restitution = std::clamp(std::min(a.restitution, b.restitution), 0_d, 1_d);
+    return pair;
+}
+std::size_t MaterialRegistry::PropertiesHash::operator()(const MaterialProperties& p) const
+{
+    const std::hash<decimal> hash;
+    std::size_t              seed = hash(p.restitution);
+    for (const decimal value : { p.stiffnessCst, p.restitutionCst, p.frictionCst })
+        seed ^= hash(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+    return seed;
+}
+/**
+ * @brief Mix a new material with every id into its row and column of the table.
+ *
+ * The table grows by doubling its stride, so n new materials cost O(n²) mixes and copies in all.
+ */
+void MaterialRegistry::fillPairs(std::uint32_t id)
+{
+    const std::size_t n = materials.size();
+    if (n > stride)
+    {
+        const std::size_t         grown = std::max<std::size_t>(2 * stride, 8);
+        std::vector<MaterialPair> table(grown * grown);
+        for (std::size_t a = 0; a < stride; ++a)
+            std::copy_n(pairTable.data() + a * stride, stride, table.data() + a * grown);
+        pairTable = std::move(table);
+        stride    = grown;
+    }
+    for (std::size_t other = 0; other < n; ++other)
+    {
+        pairTable[id * stride + other] = mix(materials[id], materials[other]);
+        pairTable[other * stride + id] = pairTable[id * stride + other];
+    }
+}
+std::uint32_t MaterialRegistry::intern(const ObjectColdData& cold)
+{
+    const MaterialProperties properties { cold.material.getRestitution(), cold.stiffnessCst,
+                                          cold.restitutionCst, cold.frictionCst };
+    const auto [it, inserted] = ids.try_emplace(properties, 0);
+    if (!inserted)
+    {
+        ++useCounts[it->second];
+        return it->second;
+    }
+
+    std::uint32_t id;
+    if (!freeIds.empty())
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+        materials[id] = properties;
+        useCounts[id] = 1;
+    }
+    else
+    {
+        id = static_cast<std::uint32_t>(materials.size());
+        materials.push_back(properties);
+        useCounts.push_back(1);
+    }
+    it->second = id;
+    fillPairs(id);
+    return id;
+}
+void MaterialRegistry::release(std::uint32_t id)
+{
+    if (--useCounts[id] > 0)
+        return;
+    ids.erase(materials[id]);
+    freeIds.push_back(id);
+}
+void MaterialRegistry::clear()
+{
+    materials.clear();
+    useCounts.clear();
+    freeIds.clear();
+    ids.clear();
+    pairTable.clear();
+    stride = 0;
+}
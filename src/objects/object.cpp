@@ -5,6 +5,7 @@
  * Implements all member functions of the Object class declared in object.hpp,.
  *
  * This file includes:
+ *  - Accessors forwarding to the BodyStorage slot of attached objects.
  *  - Integration of motion equations.
  *
  * @see object.hpp
@@ -13,97 +14,198 @@
 
 #include "mathematics/matrix.hpp"
 #include "mathematics/vector.hpp"
+#include "objects/body_storage.hpp"
 
 #include <fstream>
 #include <iomanip>
 
 //  Constructors / Destructors
-Object::Object(decimal mass)
-    : mass { mass } {};
+Object::Object(decimal mass) { cold.mass = mass; };
 Object::Object(const Vector3D& position)
     : position { position }
 {}
 Object::Object(const Vector3D& position, const Vector3D& size)
     : position { position }
-    , size { size }
-{}
+{
+    cold.size = size;
+}
 Object::Object(const Vector3D& position, const Vector3D& size, decimal mass)
     : position { position }
-    , size { size }
-    , mass { mass }
 {
+    cold.size = size;
+    cold.mass = mass;
     checkFixed();
 }
 Object::Object(const Vector3D& position, const Vector3D& size, const Vector3D& velocity, decimal mass)
     : position { position }
-    , size { size }
     , velocity { velocity }
-    , mass { mass }
 {
+    cold.size = size;
+    cold.mass = mass;
     checkFixed();
 }
 Object::Object(const Vector3D& position, const Vector3D& rotation, const Vector3D& size,
                const Vector3D& velocity, const Vector3D& acceleration, const Vector3D& force,
                const Vector3D& torque, decimal mass)
     : position { position }
-    , rotation { rotation }
-    , size { size }
     , velocity { velocity }
     , acceleration { acceleration }
-    , force { force }
-    , torque { torque }
-    , mass { mass }
 {
+    cold.rotation = rotation;
+    cold.size     = size;
+    cold.force    = force;
+    cold.torque   = torque;
+    cold.mass     = mass;
     checkFixed();
 }
+Object::Object(const Object& other)
+    : position { other.getPosition() }
+    , velocity { other.getVelocity() }
+    , acceleration { other.getAcceleration() }
+    , fixed { other.getIsFixed() }
+    , sleepEnergy { other.getSleepEnergy() }
+    , cold { other.getColdData() }
+{}
+Object& Object::operator=(const Object& other)
+{
+    if (this == &other)
+        return *this;
+
+    setPosition(other.getPosition());
+    setVelocity(other.getVelocity());
+    setAcceleration(other.getAcceleration());
+    getColdData() = other.getColdData();
+    updateMaterial();
+    setIsFixed(other.getIsFixed());
+    setSleepEnergy(other.getSleepEnergy());
+    return *this;
+}
+Object::~Object()
+{
+    if (storage)
+        storage->release(slot);
+}
+
+ObjectColdData&       Object::getColdData() { return storage ? storage->getColdData(slot) : cold; }
+const ObjectColdData& Object::getColdData() const { return storage ? storage->getColdData(slot) : cold; }
 
 //  Getters
-Vector3D   Object::getPosition() const { return position; }
-Vector3D   Object::getRotation() const { return rotation; }
-Vector3D   Object::getSize() const { return size; }
-Vector3D   Object::getVelocity() const { return velocity; }
-Vector3D   Object::getAcceleration() const { return acceleration; }
-Vector3D   Object::getForce() const { return force; }
-Vector3D   Object::getTorque() const { return torque; }
-decimal    Object::getMass() const { return mass; }
-decimal    Object::getStiffnessCst() const { return stiffnessCst; }
-decimal    Object::getRestitutionCst() const { return restitutionCst; }
-decimal    Object::getFrictionCst() const { return frictionCst; }
-Material   Object::getMaterial() const { return material; }
+Vector3D Object::getPosition() const { return storage ? storage->getPositions().get(slot) : position; }
+Vector3D Object::getRotation() const { return getColdData().rotation; }
+Vector3D Object::getSize() const { return getColdData().size; }
+Vector3D Object::getVelocity() const { return storage ? storage->getVelocities().get(slot) : velocity; }
+Vector3D Object::getAcceleration() const
+{
+    return storage ? storage->getAccelerations().get(slot) : acceleration;
+}
+Vector3D   Object::getForce() const { return getColdData().force; }
+Vector3D   Object::getTorque() const { return getColdData().torque; }
+decimal    Object::getMass() const { return getColdData().mass; }
+decimal    Object::getStiffnessCst() const { return getColdData().stiffnessCst; }
+decimal    Object::getRestitutionCst() const { return getColdData().restitutionCst; }
+decimal    Object::getFrictionCst() const { return getColdData().frictionCst; }
 ObjectType Object::getType() const { return ObjectType::Generic; }
-bool       Object::getIsFixed() const { return fixed; }
+bool       Object::getIsFixed() const
+{
+    return storage ? (storage->getFlags()[slot] & BodyStorage::flagFixed) != 0 : fixed;
+}
+const Material& Object::getMaterial() const { return getColdData().material; }
+
+decimal Object::getSleepEnergy() const { return storage ? storage->getSleepEnergies()[slot] : sleepEnergy; }
+bool    Object::isSleeping() const { return storage && storage->isSleeping(slot); }
 
 //  Setters
-void Object::setPosition(const Vector3D& _position) { position = _position; }
-void Object::setRotation(const Vector3D& _rotation) { rotation = _rotation; }
-void Object::setSize(const Vector3D& _size) { size = _size; }
-void Object::setVelocity(const Vector3D& _velocity) { velocity = _velocity; }
-void Object::setAcceleration(const Vector3D& _acceleration) { acceleration = _acceleration; }
-void Object::setForce(const Vector3D& _force) { force = _force; }
-void Object::setTorque(const Vector3D& _torque) { torque = _torque; }
+void Object::setPosition(const Vector3D& _position)
+{
+    if (storage)
+    {
+        storage->getPositions().set(slot, _position);
+        storage->wake(slot);
+    }
+    else
+        position = _position;
+}
+void Object::setRotation(const Vector3D& _rotation) { getColdData().rotation = _rotation; }
+void Object::setSize(const Vector3D& _size) { getColdData().size = _size; }
+void Object::setVelocity(const Vector3D& _velocity)
+{
+    if (storage)
+    {
+        storage->getVelocities().set(slot, _velocity);
+        storage->wake(slot);
+    }
+    else
+        velocity = _velocity;
+}
+void Object::setAcceleration(const Vector3D& _acceleration)
+{
+    if (storage)
+        storage->getAccelerations().set(slot, _acceleration);
+    else
+        acceleration = _acceleration;
+}
+void Object::setForce(const Vector3D& _force) { getColdData().force = _force; }
+void Object::setTorque(const Vector3D& _torque) { getColdData().torque = _torque; }
 void Object::setMass(const decimal _mass)
 {
-    mass = _mass;
+    getColdData().mass = _mass;
     checkFixed();
 }
-void Object::setStiffnessCst(decimal k) { stiffnessCst = k; }
-void Object::setRestitutionCst(decimal e) { restitutionCst = e; }
-void Object::setFrictionCst(decimal mu) { frictionCst = mu; }
-void Object::setMaterial(const Material& mat) { material = mat; }
+void Object::setStiffnessCst(decimal k)
+{
+    getColdData().stiffnessCst = k;
+    updateMaterial();
+}
+void Object::setRestitutionCst(decimal e)
+{
+    getColdData().restitutionCst = e;
+    updateMaterial();
+}
+void Object::setFrictionCst(decimal mu)
+{
+    getColdData().frictionCst = mu;
+    updateMaterial();
+}
+void Object::setMaterial(const Material& mat)
+{
+    getColdData().material = mat;
+    updateMaterial();
+}
 void Object::setIsFixed(bool b)
 {
-    fixed = b;
-    if (fixed)
-        mass = 0_d;
+    if (b)
+        getColdData().mass = 0_d;
+    if (storage)
+        storage->setMass(slot, getColdData().mass, b);
+    else
+        fixed = b;
+}
+void Object::setSleepEnergy(decimal energy)
+{
+    if (storage)
+        storage->setSleepEnergy(slot, energy);
+    else
+        sleepEnergy = energy;
 }
 
 //  Physics
+void Object::wakeUp()
+{
+    if (storage)
+        storage->wake(slot);
+}
+void Object::updateMaterial()
+{
+    if (storage)
+        storage->updateMaterial(slot);
+}
 void Object::checkFixed()
 {
-    if (mass <= 0_d)
-        fixed = true;
+    const decimal mass = getColdData().mass;
+    if (storage)
+        storage->setMass(slot, mass, mass <= 0_d);
     else
-        fixed = false;
+        fixed = mass <= 0_d;
 }
 /**
  * Default implementation uses simple Euler integration.
@@ -112,8 +214,16 @@ void Object::checkFixed()
  */
 void Object::integrate(decimal dt)
 {
-    velocity += acceleration * dt;
-    position += velocity * dt;
+    setVelocity(getVelocity() + getAcceleration() * dt);
+    setPosition(getPosition() + getVelocity() * dt);
+}
+
+//  Collision
+BoundingBox Object::getBoundingBox() const
+{
+    const Vector3D center   = getPosition();
+    const Vector3D halfSize = getSize() * 0.5_d;
+    return BoundingBox(center - halfSize, center + halfSize);
 }
 
 //  Utilities
@@ -67,6 +67,15 @@ bool Plane::containsPoint(const Vector3D& point) const
 // ============================================================================
 //  Collision
 // ============================================================================
+/**
+ * @brief Bounding box of the finite rectangle: projection of both half-extents on each world axis.
+ */
+BoundingBox Plane::getBoundingBox() const
+{
+    const Vector3D halfExtents = u.getAbsolute() * halfWidth + v.getAbsolute() * halfHeight;
+    return BoundingBox(getPosition() - halfExtents, getPosition() + halfExtents);
+}
+
 /**
  * @brief Checks broad collision between two Planes.
  */
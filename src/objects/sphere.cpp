@@ -27,6 +27,12 @@ decimal    Sphere::getRadius() const { return getDiameter() * 0.5_d; }
 // ============================================================================
 //  Collision
 // ============================================================================
+BoundingBox Sphere::getBoundingBox() const
+{
+    const decimal radius = getRadius();
+    return BoundingBox(getCenter() - radius, getCenter() + radius);
+}
+
 /**
  * @brief Checks broad collision between two Sphere.s
  */
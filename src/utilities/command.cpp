@@ -7,7 +7,6 @@
 
 #include <functional>
 #include <iostream>
-#include <memory>
 #include <sstream>
 
 // ============================================================================
@@ -32,6 +31,14 @@ void printUsage()
         << "-------------------------------------------------------------------------------------\n"
         << "World:\n"
         << "  set <dt|g> <value>                   Set timestep/grav acceleration to <value>.\n"
+        << "  set broadphase <name>                Select broad phase (BruteForce, SweepAndPrune, "
+           "UniformGrid, BVH, Auto).\n"
+        << "  set threads <n>                      Run the step on <n> threads (0: all hardware threads).\n"
+        << "  set deterministic <0|1>              Keep results bit-identical to a single thread.\n"
+        << "  set sleep <energy> [time]            Let bodies below <energy> J for [time] s fall asleep "
+           "(0: never).\n"
+        << "  set contactsolver <name> [v] [p]     Select contact response (Rebound, SequentialImpulse), "
+           "with [v] velocity and [p] position iterations.\n"
         << "  set obj <id> <property> [...values]  Set property for a given object, identified by its ID "
            "(see 'list'). Properties can be: pos, size, vel, acc, rot, mass, fixed. values can "
            "be either one value (ex: mass) or three values separated by spaces (ex: position).\n"
@@ -138,6 +145,49 @@ bool handleSetCommand(PhysicsWorld& world, std::deque<std::string>& words)
         std::cout << "Gravity set to " << value << " m/s².\n";
         return true;
     }
+    if (what == "broadphase" && !words.empty())
+    {
+        const std::string name = popNext(words);
+        world.setBroadPhase(name);
+        std::cout << "Broad phase set to " << world.getBroadPhaseType() << ".\n";
+        return true;
+    }
+    if (what == "threads" && !words.empty())
+    {
+        world.setThreadCount(std::stoul(popNext(words)));
+        std::cout << "Step running on " << world.getThreadCount() << " thread(s).\n";
+        return true;
+    }
+    if (what == "deterministic" && !words.empty())
+    {
+        const std::string val = popNext(words);
+        world.setDeterministic(val == "1" || val == "true" || val == "yes");
+        std::cout << "Deterministic mode " << (world.getDeterministic() ? "on" : "off") << ".\n";
+        return true;
+    }
+    if (what == "sleep" && !words.empty())
+    {
+        world.setSleepEnergy(stringToDecimal(popNext(words)));
+        if (!words.empty())
+            world.setSleepTime(stringToDecimal(popNext(words)));
+        std::cout << "Sleep energy set to " << world.getSleepEnergy() << " J after " << world.getSleepTime()
+                  << " s.\n";
+        return true;
+    }
+    if (what == "contactsolver" && !words.empty())
+    {
+        world.setContactSolver(popNext(words));
+        if (words.size() >= 2)
+        {
+            const std::size_t velocity = std::stoul(popNext(words));
+            world.setSolverIterations(velocity, std::stoul(popNext(words)));
+        }
+        const ContactSolver& solver = world.getContactSolver();
+        std::cout << "Contact solver set to " << world.getContactSolverType() << " ("
+                  << solver.getVelocityIterations() << " velocity, " << solver.getPositionIterations()
+                  << " position iterations).\n";
+        return true;
+    }
     if (what == "obj" && words.size() >= 2)
     {
         size_t      id   = std::stoul(popNext(words));
@@ -179,19 +229,19 @@ bool handleAddCommand(PhysicsWorld& world, std::deque<std::string>& words)
         name            = "Object_" + std::to_string(id);
     }
 
-    std::unique_ptr<Object> obj;
+    ObjectHandle handle;
 
     if (type == "sphere")
     {
-        obj = std::make_unique<Sphere>(Vector3D(0, 0, 10), 0.2_d, Vector3D(0, 0, 0), 1.0_d);
+        handle = world.createObject<Sphere>(Vector3D(0, 0, 10), 0.2_d, Vector3D(0, 0, 0), 1.0_d);
     }
     else if (type == "plane")
     {
-        obj = std::make_unique<Plane>(Vector3D(0, 0, 0), Vector3D(1, 1, 1), 1.0_d, Vector3D(0, 0, 1));
+        handle = world.createObject<Plane>(Vector3D(0, 0, 0), Vector3D(1, 1, 1), 1.0_d, Vector3D(0, 0, 1));
     }
     else if (type == "aabb")
     {
-        obj = std::make_unique<AABB>(Vector3D(0, 0, 5), Vector3D(1, 1, 1), Vector3D(0, 0, 0), 1.0_d);
+        handle = world.createObject<AABB>(Vector3D(0, 0, 5), Vector3D(1, 1, 1), Vector3D(0, 0, 0), 1.0_d);
     }
     else
     {
@@ -199,9 +249,7 @@ bool handleAddCommand(PhysicsWorld& world, std::deque<std::string>& words)
         return false;
     }
 
-    obj->setName(name);
-
-    world.addObject(obj.release());
+    world.getObject(handle)->setName(name);
 
     std::cout << "Added " << type << " (" << name << ")\n";
     return true;
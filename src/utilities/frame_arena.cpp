@@ -0,0 +1,94 @@
+#include "utilities/frame_arena.hpp"
+
+#include "utilities/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+// ============================================================================
+//  Getters / Setters
+// ============================================================================
+std::size_t FrameArena::getCapacity() const
+{
+    std::size_t capacity = 0;
+    for (const Lane& l : lanes)
+    {
+        for (const Slab& slab : l.slabs)
+            capacity += slab.size;
+    }
+    return capacity;
+}
+std::size_t FrameArena::getSlabCount() const
+{
+    std::size_t count = 0;
+    for (const Lane& l : lanes)
+        count += l.slabs.size();
+    return count;
+}
+void FrameArena::setThreadPool(const ThreadPool* threadPool)
+{
+    pool = threadPool;
+    lanes.resize(pool ? pool->getThreadCount() : 1);
+}
+
+// ============================================================================
+//  Allocation
+// ============================================================================
+FrameArena::Lane& FrameArena::lane() { return lanes[pool ? pool->getCurrentThread() : 0]; }
+
+/**
+ * @brief Bump the cursor of the calling thread's lane, moving to the next slab when the current one is full.
+ *
+ * A new slab is at least twice the size of the last one, so a growing frame needs few of them.
+ */
+void* FrameArena::allocateBytes(std::size_t bytes, std::size_t alignment)
+{
+    Lane& l = lane();
+    while (true)
+    {
+        if (l.slab == l.slabs.size())
+        {
+            const std::size_t last = l.slabs.empty() ? 0 : l.slabs.back().size;
+            const std::size_t size = std::max({ slabSize, bytes + alignment, 2 * last });
+            l.slabs.push_back({ std::make_unique_for_overwrite<std::byte[]>(size), size });
+        }
+
+        const Slab&          slab  = l.slabs[l.slab];
+        const std::uintptr_t base  = reinterpret_cast<std::uintptr_t>(slab.memory.get());
+        const std::size_t    start = ((base + l.offset + alignment - 1) & ~(alignment - 1)) - base;
+        if (start + bytes <= slab.size)
+        {
+            l.offset = start + bytes;
+            return slab.memory.get() + start;
+        }
+        ++l.slab;
+        l.offset = 0;
+    }
+}
+FrameArena::Marker FrameArena::mark()
+{
+    const Lane& l = lane();
+    return { l.slab, l.offset };
+}
+void FrameArena::rewind(const Marker& marker)
+{
+    Lane& l  = lane();
+    l.slab   = marker.slab;
+    l.offset = marker.offset;
+}
+void FrameArena::reset()
+{
+    for (Lane& l : lanes)
+    {
+        if (l.slabs.size() > 1)
+        {
+            std::size_t size = 0;
+            for (const Slab& slab : l.slabs)
+                size += slab.size;
+            l.slabs.clear();
+            l.slabs.push_back({ std::make_unique_for_overwrite<std::byte[]>(size), size });
+        }
+        l.slab   = 0;
+        l.offset = 0;
+    }
+}
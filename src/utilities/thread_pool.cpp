@@ -0,0 +1,191 @@
+#include "utilities/thread_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+// Pool and queue of the current thread; threads outside any pool use queue 0.
+static thread_local const ThreadPool* currentPool  = nullptr;
+static thread_local std::size_t       currentQueue = 0;
+
+// ============================================================================
+//  Constructors / Destructors
+// ============================================================================
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    if (threadCount == 0)
+        threadCount = getHardwareThreadCount();
+
+    for (std::size_t i = 0; i < threadCount; ++i)
+        queues.push_back(std::make_unique<Queue>());
+    for (std::size_t i = 1; i < threadCount; ++i)
+        workers.emplace_back([this, i] { workerLoop(i); });
+}
+ThreadPool::~ThreadPool()
+{
+    stopping = true;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeUp.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+// ============================================================================
+//  Getters
+// ============================================================================
+std::size_t ThreadPool::getHardwareThreadCount()
+{
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+std::size_t ThreadPool::grainFor(std::size_t count, std::size_t minGrain) const
+{
+    const std::size_t chunks = 4 * getThreadCount();
+    return std::max<std::size_t>({ 1, minGrain, (count + chunks - 1) / chunks });
+}
+
+// ============================================================================
+//  Task deques
+// ============================================================================
+void ThreadPool::Queue::pushBack(const Task& task)
+{
+    if (count == ring.size())
+    {
+        // Unrolled in order into twice the capacity
+        std::vector<Task> grown(std::max<std::size_t>(16, 2 * ring.size()));
+        for (std::size_t i = 0; i < count; ++i)
+            grown[i] = ring[(head + i) & (ring.size() - 1)];
+        ring = std::move(grown);
+        head = 0;
+    }
+    ring[(head + count) & (ring.size() - 1)] = task;
+    ++count;
+}
+ThreadPool::Task ThreadPool::Queue::popBack()
+{
+    --count;
+    return ring[(head + count) & (ring.size() - 1)];
+}
+ThreadPool::Task ThreadPool::Queue::popFront()
+{
+    const Task task = ring[head];
+    head            = (head + 1) & (ring.size() - 1);
+    --count;
+    return task;
+}
+
+// ============================================================================
+//  Scheduling
+// ============================================================================
+std::size_t ThreadPool::ownQueue() const { return currentPool == this ? currentQueue : 0; }
+
+/**
+ * @brief Run one task: the newest of the own deque, otherwise the oldest of another deque.
+ *
+ * @return False when every deque was empty.
+ */
+bool ThreadPool::tryRunOne(std::size_t self)
+{
+    const std::size_t queueCount = queues.size();
+    for (std::size_t offset = 0; offset < queueCount; ++offset)
+    {
+        Queue& queue = *queues[(self + offset) % queueCount];
+        Task   task;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.count == 0)
+                continue;
+            task = offset == 0 ? queue.popBack() : queue.popFront();
+        }
+        --queued;
+        execute(task);
+        return true;
+    }
+    return false;
+}
+/**
+ * @brief Run a task and report its completion to its batch.
+ *
+ * The batch belongs to the thread waiting in `run` and may be destroyed as soon as `remaining` reaches 0, so
+ * it is not touched after the decrement.
+ */
+void ThreadPool::execute(const Task& task)
+{
+    Batch& batch = *task.batch;
+    try
+    {
+        batch.call(batch.task, task.index);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(batch.errorMutex);
+        if (!batch.error)
+            batch.error = std::current_exception();
+    }
+    batch.remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+void ThreadPool::workerLoop(std::size_t self)
+{
+    currentPool  = this;
+    currentQueue = self;
+    while (true)
+    {
+        if (tryRunOne(self))
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0)
+            return;
+    }
+}
+
+// ============================================================================
+//  Execution
+// ============================================================================
+/**
+ * @brief Deal the tasks over every deque, then work until the batch is done.
+ *
+ * The calling thread keeps running tasks, its own then stolen ones, instead of sleeping: a nested call from
+ * a worker therefore cannot deadlock the pool.
+ */
+void ThreadPool::runTasks(std::size_t count, const void* task, TaskCall call)
+{
+    if (count == 0)
+        return;
+    if (workers.empty())
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            call(task, i);
+        return;
+    }
+
+    Batch batch;
+    batch.task      = task;
+    batch.call      = call;
+    batch.remaining = count;
+
+    // Counted before the push: a worker popping a task first would wrap the counter below zero
+    queued += count;
+    const std::size_t self       = ownQueue();
+    const std::size_t queueCount = queues.size();
+    for (std::size_t q = 0; q < queueCount; ++q)
+    {
+        Queue&                      queue = *queues[(self + q) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (std::size_t i = q; i < count; i += queueCount)
+            queue.pushBack({ &batch, i });
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeUp.notify_all();
+
+    while (batch.remaining.load(std::memory_order_acquire) > 0)
+    {
+        if (!tryRunOne(self))
+            std::this_thread::yield();
+    }
+    if (batch.error)
+        std::rethrow_exception(batch.error);
+}
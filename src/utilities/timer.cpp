@@ -1,7 +1,18 @@
 #include "utilities/timer.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
 void Timer::reset() { start_time = std::chrono::high_resolution_clock::now(); }
 
+[[nodiscard]] long long Timer::elapsedNanoseconds() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() -
+                                                                start_time)
+        .count();
+}
+
 [[nodiscard]] long long Timer::elapsedMicroseconds() const
 {
     return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() -
@@ -18,3 +29,43 @@ void Timer::reset() { start_time = std::chrono::high_resolution_clock::now(); }
 {
     return static_cast<decimal>(elapsedMicroseconds()) / 1e6_d;
 }
+
+// ============================================================================
+//  Latency histogram
+// ============================================================================
+void LatencyHistogram::record(long long nanoseconds)
+{
+    // Bit width of the duration: i + 1 in [2^i, 2^(i+1)), 0 for 0
+    const long long   duration = std::max(nanoseconds, 0LL);
+    const auto        bits     = std::bit_width(static_cast<unsigned long long>(duration));
+    const std::size_t width    = static_cast<std::size_t>(bits);
+    ++buckets[std::clamp<std::size_t>(width, 1, bucketCount) - 1];
+
+    min    = count == 0 ? duration : std::min(min, duration);
+    max    = count == 0 ? duration : std::max(max, duration);
+    total += static_cast<long double>(duration);
+    ++count;
+}
+void LatencyHistogram::reset() { *this = LatencyHistogram(); }
+decimal LatencyHistogram::getMean() const
+{
+    return count == 0 ? 0_d : static_cast<decimal>(total / static_cast<long double>(count));
+}
+/**
+ * @brief The bucket is the first one whose cumulated count reaches `fraction` of the durations.
+ */
+long long LatencyHistogram::getPercentile(decimal fraction) const
+{
+    if (count == 0)
+        return 0;
+    const decimal     share     = std::clamp(fraction, 0_d, 1_d) * static_cast<decimal>(count);
+    const std::size_t rank      = std::max<std::size_t>(static_cast<std::size_t>(std::ceil(share)), 1);
+    std::size_t       cumulated = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i)
+    {
+        cumulated += buckets[i];
+        if (cumulated >= rank)
+            return std::min(max, (1LL << (i + 1)) - 1);
+    }
+    return max;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file batch_integrators.cpp
+ * @brief Implementation of the vectorised integration kernels.
+ *
+ * Every kernel processes one component array at a time: a SIMD loop over full packs, then a scalar loop for
+ * the remaining slots performing the same operations.
+ *
+ * @see batch_integrators.hpp
+ */
+#include "world/batch_integrators.hpp"
+
+#include "mathematics/simd.hpp"
+
+// ============================================================================
+//  Component kernels
+// ============================================================================
+static void kickDriftComponent(decimal* x, decimal* v, const decimal* a, const decimal* m, std::size_t n,
+                               decimal h, decimal dt)
+{
+    const simd::Pack hPack  = simd::set1(h);
+    const simd::Pack dtPack = simd::set1(dt);
+
+    std::size_t i = 0;
+    for (; i + simd::width <= n; i += simd::width)
+    {
+        const simd::Pack mask = simd::load(m + i);
+        const simd::Pack newV = simd::madd(simd::load(a + i), simd::mul(hPack, mask), simd::load(v + i));
+        simd::store(v + i, newV);
+        simd::store(x + i, simd::madd(newV, simd::mul(dtPack, mask), simd::load(x + i)));
+    }
+    for (; i < n; ++i)
+    {
+        v[i] += a[i] * (h * m[i]);
+        x[i] += v[i] * (dt * m[i]);
+    }
+}
+
+static void kickComponent(decimal* v, const decimal* a, const decimal* m, std::size_t n, decimal h)
+{
+    const simd::Pack hPack = simd::set1(h);
+
+    std::size_t i = 0;
+    for (; i + simd::width <= n; i += simd::width)
+    {
+        const simd::Pack hm = simd::mul(hPack, simd::load(m + i));
+        simd::store(v + i, simd::madd(simd::load(a + i), hm, simd::load(v + i)));
+    }
+    for (; i < n; ++i)
+        v[i] += a[i] * (h * m[i]);
+}
+
+static void axpyComponent(decimal* y, const decimal* x, std::size_t n, decimal a)
+{
+    const simd::Pack aPack = simd::set1(a);
+
+    std::size_t i = 0;
+    for (; i + simd::width <= n; i += simd::width)
+        simd::store(y + i, simd::madd(simd::load(x + i), aPack, simd::load(y + i)));
+    for (; i < n; ++i)
+        y[i] += x[i] * a;
+}
+
+static void offsetComponent(decimal* x, decimal* v, const decimal* x0, const decimal* v0, const decimal* dx,
+                            const decimal* dv, const decimal* m, std::size_t n, decimal h)
+{
+    const simd::Pack hPack = simd::set1(h);
+
+    std::size_t i = 0;
+    for (; i + simd::width <= n; i += simd::width)
+    {
+        const simd::Pack hm     = simd::mul(hPack, simd::load(m + i));
+        const simd::Pack dxPack = simd::load(dx + i);
+        const simd::Pack dvPack = simd::load(dv + i);
+        simd::store(x + i, simd::madd(dxPack, hm, simd::load(x0 + i)));
+        simd::store(v + i, simd::madd(dvPack, hm, simd::load(v0 + i)));
+    }
+    for (; i < n; ++i)
+    {
+        const decimal hm     = h * m[i];
+        const decimal dxSlot = dx[i];
+        const decimal dvSlot = dv[i];
+        x[i]                 = x0[i] + dxSlot * hm;
+        v[i]                 = v0[i] + dvSlot * hm;
+    }
+}
+
+/// Number of slots of `[first, min(last, size))`.
+static std::size_t rangeLength(std::size_t size, std::size_t first, std::size_t last)
+{
+    last = last < size ? last : size;
+    return last > first ? last - first : 0;
+}
+
+// ============================================================================
+//  Kernels
+// ============================================================================
+namespace BatchIntegrators {
+
+void euler(Vector3DArray& pos, Vector3DArray& vel, const Vector3DArray& acc, const std::vector<decimal>& mask,
+           decimal dt, std::size_t first, std::size_t last)
+{
+    kickDrift(pos, vel, acc, mask, dt, dt, first, last);
+}
+void kickDrift(Vector3DArray& pos, Vector3DArray& vel, const Vector3DArray& acc,
+               const std::vector<decimal>& mask, decimal h, decimal dt, std::size_t first, std::size_t last)
+{
+    const std::size_t n = rangeLength(mask.size(), first, last);
+    const decimal*    m = mask.data() + first;
+    kickDriftComponent(pos.x.data() + first, vel.x.data() + first, acc.x.data() + first, m, n, h, dt);
+    kickDriftComponent(pos.y.data() + first, vel.y.data() + first, acc.y.data() + first, m, n, h, dt);
+    kickDriftComponent(pos.z.data() + first, vel.z.data() + first, acc.z.data() + first, m, n, h, dt);
+}
+void kick(Vector3DArray& vel, const Vector3DArray& acc, const std::vector<decimal>& mask, decimal h,
+          std::size_t first, std::size_t last)
+{
+    const std::size_t n = rangeLength(mask.size(), first, last);
+    const decimal*    m = mask.data() + first;
+    kickComponent(vel.x.data() + first, acc.x.data() + first, m, n, h);
+    kickComponent(vel.y.data() + first, acc.y.data() + first, m, n, h);
+    kickComponent(vel.z.data() + first, acc.z.data() + first, m, n, h);
+}
+void axpy(Vector3DArray& y, const Vector3DArray& x, decimal a, std::size_t first, std::size_t last)
+{
+    const std::size_t n = rangeLength(y.size(), first, last);
+    axpyComponent(y.x.data() + first, x.x.data() + first, n, a);
+    axpyComponent(y.y.data() + first, x.y.data() + first, n, a);
+    axpyComponent(y.z.data() + first, x.z.data() + first, n, a);
+}
+void offset(Vector3DArray& pos, Vector3DArray& vel, const Vector3DArray& pos0, const Vector3DArray& vel0,
+            const Vector3DArray& dx, const Vector3DArray& dv, const std::vector<decimal>& mask, decimal h,
+            std::size_t first, std::size_t last)
+{
+    const std::size_t n = rangeLength(mask.size(), first, last);
+    const decimal*    m = mask.data() + first;
+    offsetComponent(pos.x.data() + first, vel.x.data() + first, pos0.x.data() + first, vel0.x.data() + first,
+                    dx.x.data() + first, dv.x.data() + first, m, n, h);
+    offsetComponent(pos.y.data() + first, vel.y.data() + first, pos0.y.data() + first, vel0.y.data() + first,
+                    dx.y.data() + first, dv.y.data() + first, m, n, h);
+    offsetComponent(pos.z.data() + first, vel.z.data() + first, pos0.z.data() + first, vel0.z.data() + first,
+                    dx.z.data() + first, dv.z.data() + first, m, n, h);
+}
+
+} // namespace BatchIntegrators
@@ -19,6 +19,24 @@ decimal     Config::getTimeStep() const { return timeStep; }
 decimal     Config::getSimulationDuration() const { return simulationDuration; }
 std::size_t Config::getMaxIterations() const { return maxIterations; }
 std::string Config::getSolver() const { return solver; }
+decimal     Config::getAbsTolerance() const { return absTolerance; }
+decimal     Config::getRelTolerance() const { return relTolerance; }
+std::size_t Config::getMaxTimeLevel() const { return maxTimeLevel; }
+std::string Config::getBroadPhase() const { return broadPhase; }
+decimal     Config::getGridCellSize() const { return gridCellSize; }
+std::size_t Config::getBroadPhaseSampling() const { return broadPhaseSampling; }
+bool        Config::getPairCaching() const { return pairCaching; }
+std::size_t Config::getThreadCount() const { return threadCount; }
+bool        Config::getDeterministic() const { return deterministic; }
+decimal     Config::getSleepEnergy() const { return sleepEnergy; }
+decimal     Config::getSleepTime() const { return sleepTime; }
+std::string Config::getContactSolver() const { return contactSolver; }
+std::size_t Config::getVelocityIterations() const { return velocityIterations; }
+std::size_t Config::getPositionIterations() const { return positionIterations; }
+bool        Config::getContinuousCollision() const { return continuousCollision; }
+bool        Config::getEventDriven() const { return eventDriven; }
+decimal     Config::getRealTimeFactor() const { return realTimeFactor; }
+decimal     Config::getOutputRate() const { return outputRate; }
 bool        Config::getVerbose() const { return verbose; }
 bool        Config::getSave() const { return save; }
 
@@ -37,6 +55,42 @@ void Config::loadFromFile(const std::string& path)
             setSimulationDuration(node["duration"].as<decimal>());
         if (node["solver"])
             setSolver(node["solver"].as<std::string>());
+        if (node["abstolerance"])
+            setAbsTolerance(node["abstolerance"].as<decimal>());
+        if (node["reltolerance"])
+            setRelTolerance(node["reltolerance"].as<decimal>());
+        if (node["maxtimelevel"])
+            setMaxTimeLevel(node["maxtimelevel"].as<std::size_t>());
+        if (node["broadphase"])
+            setBroadPhase(node["broadphase"].as<std::string>());
+        if (node["gridcellsize"])
+            setGridCellSize(node["gridcellsize"].as<decimal>());
+        if (node["broadphasesampling"])
+            setBroadPhaseSampling(node["broadphasesampling"].as<std::size_t>());
+        if (node["paircaching"])
+            setPairCaching(node["paircaching"].as<bool>());
+        if (node["threads"])
+            setThreadCount(node["threads"].as<std::size_t>());
+        if (node["deterministic"])
+            setDeterministic(node["deterministic"].as<bool>());
+        if (node["sleepenergy"])
+            setSleepEnergy(node["sleepenergy"].as<decimal>());
+        if (node["sleeptime"])
+            setSleepTime(node["sleeptime"].as<decimal>());
+        if (node["contactsolver"])
+            setContactSolver(node["contactsolver"].as<std::string>());
+        if (node["velocityiterations"])
+            setVelocityIterations(node["velocityiterations"].as<std::size_t>());
+        if (node["positioniterations"])
+            setPositionIterations(node["positioniterations"].as<std::size_t>());
+        if (node["continuouscollision"])
+            setContinuousCollision(node["continuouscollision"].as<bool>());
+        if (node["eventdriven"])
+            setEventDriven(node["eventdriven"].as<bool>());
+        if (node["realtimefactor"])
+            setRealTimeFactor(node["realtimefactor"].as<decimal>());
+        if (node["outputrate"])
+            setOutputRate(node["outputrate"].as<decimal>());
         if (node["verbose"])
             setVerbose(node["verbose"].as<bool>());
         if (node["save"])
@@ -64,6 +118,54 @@ void Config::overrideFromCommandLine(int argc, char** argv)
             setMaxIterations(static_cast<std::size_t>(std::stoul(argv[++i])));
         else if (arg == "--solver" && i + 1 < argc)
             setSolver(std::string(argv[++i]));
+        else if (arg == "--abstolerance" && i + 1 < argc)
+            setAbsTolerance(static_cast<decimal>(std::stold(argv[++i])));
+        else if (arg == "--reltolerance" && i + 1 < argc)
+            setRelTolerance(static_cast<decimal>(std::stold(argv[++i])));
+        else if (arg == "--maxtimelevel" && i + 1 < argc)
+            setMaxTimeLevel(static_cast<std::size_t>(std::stoul(argv[++i])));
+        else if (arg == "--broadphase" && i + 1 < argc)
+            setBroadPhase(std::string(argv[++i]));
+        else if (arg == "--gridcellsize" && i + 1 < argc)
+            setGridCellSize(static_cast<decimal>(std::stold(argv[++i])));
+        else if (arg == "--broadphasesampling" && i + 1 < argc)
+            setBroadPhaseSampling(static_cast<std::size_t>(std::stoul(argv[++i])));
+        else if (arg == "--paircaching" && i + 1 < argc)
+        {
+            std::string p = argv[++i];
+            setPairCaching(p == "1" || p == "true" || p == "yes");
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+            setThreadCount(static_cast<std::size_t>(std::stoul(argv[++i])));
+        else if (arg == "--deterministic" && i + 1 < argc)
+        {
+            std::string d = argv[++i];
+            setDeterministic(d == "1" || d == "true" || d == "yes");
+        }
+        else if (arg == "--sleepenergy" && i + 1 < argc)
+            setSleepEnergy(static_cast<decimal>(std::stold(argv[++i])));
+        else if (arg == "--sleeptime" && i + 1 < argc)
+            setSleepTime(static_cast<decimal>(std::stold(argv[++i])));
+        else if (arg == "--contactsolver" && i + 1 < argc)
+            setContactSolver(std::string(argv[++i]));
+        else if (arg == "--velocityiterations" && i + 1 < argc)
+            setVelocityIterations(static_cast<std::size_t>(std::stoul(argv[++i])));
+        else if (arg == "--positioniterations" && i + 1 < argc)
+            setPositionIterations(static_cast<std::size_t>(std::stoul(argv[++i])));
+        else if (arg == "--continuouscollision" && i + 1 < argc)
+        {
+            std::string c = argv[++i];
+            setContinuousCollision(c == "1" || c == "true" || c == "yes");
+        }
+        else if (arg == "--eventdriven" && i + 1 < argc)
+        {
+            std::string e = argv[++i];
+            setEventDriven(e == "1" || e == "true" || e == "yes");
+        }
+        else if (arg == "--realtimefactor" && i + 1 < argc)
+            setRealTimeFactor(static_cast<decimal>(std::stold(argv[++i])));
+        else if (arg == "--outputrate" && i + 1 < argc)
+            setOutputRate(static_cast<decimal>(std::stold(argv[++i])));
         else if (arg == "--verbose" && i + 1 < argc)
         {
             std::string v = argv[++i];
@@ -352,3 +352,85 @@ Vector3D Physics::computeContactForce(const Object& obj1, const Object& obj2, de
     Vector3D friction = computeFrictionForce(obj1, obj2, mu, e, k);
     return normal + friction;
 }
+
+// ============================================================================
+//  Fused contact force
+// ============================================================================
+
+/**
+ * @brief Compute the constants of the contact model of two objects.
+ *
+ * Same constants as `computeSpringForce`, `computeDampingForce` and `computeFrictionForce(obj1, obj2)`.
+ *
+ * @param obj1 First object.
+ * @param obj2 Second object.
+ * @return Contact model of the pair.
+ */
+Physics::ContactModel Physics::computeContactModel(const Object& obj1, const Object& obj2)
+{
+    const MaterialProperties material1 { obj1.getMaterial().getRestitution(), obj1.getStiffnessCst(),
+                                         obj1.getRestitutionCst(), obj1.getFrictionCst() };
+    const MaterialProperties material2 { obj2.getMaterial().getRestitution(), obj2.getStiffnessCst(),
+                                         obj2.getRestitutionCst(), obj2.getFrictionCst() };
+    return computeContactModel(MaterialRegistry::mix(material1, material2), obj1.getMass(), obj2.getMass());
+}
+
+/**
+ * @brief Compute the constants of the contact model of two bodies from the pair table of their materials.
+ *
+ * Only the damping coefficient depends on the masses: the damping ratio is read from the table, so no
+ * transcendental function is evaluated. Without stiffness every term of the model vanishes.
+ *
+ * @param pair Premixed coefficients of the materials of the two bodies.
+ * @param m1 Mass of the first body.
+ * @param m2 Mass of the second body.
+ * @return Contact model of the pair.
+ */
+Physics::ContactModel Physics::computeContactModel(const MaterialPair& pair, decimal m1, decimal m2)
+{
+    ContactModel model;
+    if (pair.stiffness == 0_d)
+        return model;
+    model.stiffness = pair.stiffness;
+    model.friction  = pair.friction;
+
+    const decimal mu = reducedMass(m1, m2);
+    if (!commonMaths::approxEqual(mu, 0_d))
+        model.damping = 2_d * pair.dampingRatio * std::sqrt(pair.stiffness * mu);
+    return model;
+}
+
+/**
+ * @brief Compute the full contact force (spring + damping + friction) acting on obj1, in a single pass.
+ *
+ * The separate functions each normalise `r` again, and `computeFrictionForce` evaluates the normal force a
+ * second time. Here the normal and its magnitude are computed once and shared by the three terms, with the
+ * same operations: the result matches `computeContactForce(obj1, obj2)`.
+ *
+ * @param model Constants of the pair (see `computeContactModel`).
+ * @param r Relative position x2 - x1.
+ * @param v Relative velocity v2 - v1.
+ * @return Contact force vector.
+ */
+Vector3D Physics::computeContactForce(const ContactModel& model, const Vector3D& r, const Vector3D& v)
+{
+    if (model.stiffness == 0_d || r.isNull())
+        return Vector3D(0_d);
+
+    Vector3D n      = r.getNormalised();
+    decimal  vn     = v.dotProduct(n);
+    Vector3D normal = -model.stiffness * r;
+    if (model.damping != 0_d)
+        normal = normal + -model.damping * vn * n;
+    if (model.friction == 0_d)
+        return normal;
+
+    Vector3D v_tan = v - (vn * n);
+    if (v_tan.isNull())
+        return normal;
+    decimal normalMag = normal.getNorm();
+    if (commonMaths::approxEqual(normalMag, 0_d))
+        return normal;
+
+    return normal + -model.friction * normalMag * v_tan.getNormalised();
+}
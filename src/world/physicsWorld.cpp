@@ -1,15 +1,26 @@
 #include "world/physicsWorld.hpp"
 
 #include "collision/collision_response.hpp"
+#include "collision/continuous_collision.hpp"
+#include "collision/pair_cache.hpp"
 #include "mathematics/math_io.hpp"
+#include "mathematics/matrix.hpp"
 #include "objects/object.hpp"
+#include "world/batch_integrators.hpp"
 #include "world/integrateRK4.hpp"
 #include "world/physics.hpp"
+#include "world/realtime_driver.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <numbers>
 #include <vector>
 
 // ============================================================================
@@ -23,30 +34,148 @@ static Solver parseSolver(const std::string& name)
         return Solver::Verlet;
     if (name == "RK4")
         return Solver::RK4;
+    if (name == "BS32")
+        return Solver::BS32;
+    if (name == "Implicit")
+        return Solver::Implicit;
     return Solver::Unknown;
 }
 
 // ============================================================================
 //  Getters
 // ============================================================================
-Config&  PhysicsWorld::getConfig() const { return config; }
-bool     PhysicsWorld::getIsRunning() const { return isRunning; }
-decimal  PhysicsWorld::getTimeStep() const { return timeStep; }
-decimal  PhysicsWorld::getGravityCst() const { return gravityCst; }
-Vector3D PhysicsWorld::getGravityAcc() const { return gravityAcc; }
-Solver   PhysicsWorld::getSolver() const { return solver; }
+Config&        PhysicsWorld::getConfig() const { return config; }
+bool           PhysicsWorld::getIsRunning() const { return isRunning; }
+decimal        PhysicsWorld::getTimeStep() const { return timeStep; }
+decimal        PhysicsWorld::getGravityCst() const { return gravityCst; }
+Vector3D       PhysicsWorld::getGravityAcc() const { return gravityAcc; }
+Solver         PhysicsWorld::getSolver() const { return solver; }
+BroadPhaseType PhysicsWorld::getBroadPhaseType() const { return broadPhaseType; }
+std::size_t    PhysicsWorld::getThreadCount() const { return threadPool->getThreadCount(); }
+bool           PhysicsWorld::getDeterministic() const { return deterministic; }
+decimal        PhysicsWorld::getSleepEnergy() const { return sleepEnergy; }
+decimal        PhysicsWorld::getSleepTime() const { return sleepTime; }
+bool           PhysicsWorld::getContinuousCollision() const { return continuousCollision; }
+bool           PhysicsWorld::getEventDriven() const { return eventDriven; }
+bool           PhysicsWorld::getPairCaching() const { return narrowPhase.getCaching(); }
+decimal        PhysicsWorld::getAbsTolerance() const { return absTolerance; }
+decimal        PhysicsWorld::getRelTolerance() const { return relTolerance; }
+std::size_t    PhysicsWorld::getMaxTimeLevel() const { return maxTimeLevel; }
+std::size_t    PhysicsWorld::getSleepingCount() const { return bodies.getSleepingCount(); }
+std::size_t PhysicsWorld::getAwakeCount() const
+{
+    std::size_t count = 0;
+    for (std::size_t slot = 0; slot < bodies.size(); ++slot)
+    {
+        if (bodies.isDynamic(slot))
+            ++count;
+    }
+    return count;
+}
 
 // ============================================================================
 //  Setters
 // ============================================================================
 void PhysicsWorld::setSolver(const std::string& _solver)
 {
-    solver = parseSolver(_solver);
+    solver         = parseSolver(_solver);
+    verletAccValid = false;
+    adaptiveStep   = timeStep;
+    denseStep      = 0_d;
     config.setSolver(_solver);
 }
+void PhysicsWorld::setTolerances(decimal absolute, decimal relative)
+{
+    config.setAbsTolerance(absolute);
+    config.setRelTolerance(relative);
+    absTolerance = absolute;
+    relTolerance = relative;
+}
+void PhysicsWorld::setMaxTimeLevel(std::size_t level)
+{
+    config.setMaxTimeLevel(level);
+    maxTimeLevel = level;
+}
+void PhysicsWorld::setBroadPhase(const std::string& _broadPhase)
+{
+    broadPhaseType = parseBroadPhase(_broadPhase);
+    broadPhase     = makeBroadPhase(broadPhaseType);
+    broadPhase->setThreadPool(threadPool.get());
+    broadPhase->setBodyFlags(&bodies.getFlags());
+    config.setBroadPhase(_broadPhase);
+    if (broadPhaseType == BroadPhaseType::Unknown)
+    {
+        std::cout << "The following broad phase is not implemented : " << _broadPhase << '\n';
+        std::cout << "Please use one of the following broad phases : BruteForce, SweepAndPrune, UniformGrid, "
+                     "BVH, Auto.\n";
+        std::cout << "Falling back to BruteForce.\n";
+    }
+}
+void PhysicsWorld::setPairCaching(bool caching)
+{
+    config.setPairCaching(caching);
+    narrowPhase.setCaching(caching);
+    setBroadPhase(config.getBroadPhase()); // the broad phase reads it from the config
+}
 void PhysicsWorld::setTimeStep(decimal ind) { timeStep = ind; }
 void PhysicsWorld::setGravityCst(decimal g) { gravityCst = g; }
-void PhysicsWorld::setGravityAcc(const Vector3D& acc) { gravityAcc = acc; }
+void PhysicsWorld::setGravityAcc(const Vector3D& acc)
+{
+    gravityAcc     = acc;
+    verletAccValid = false;
+}
+void PhysicsWorld::setThreadCount(std::size_t count)
+{
+    threadPool.reset(); // join the old workers first
+    threadPool = std::make_unique<ThreadPool>(count);
+    frame.setThreadPool(threadPool.get());
+    broadPhase->setThreadPool(threadPool.get());
+    config.setThreadCount(count);
+}
+void PhysicsWorld::setDeterministic(bool det)
+{
+    deterministic = det;
+    config.setDeterministic(det);
+}
+void PhysicsWorld::setSleepEnergy(decimal energy)
+{
+    config.setSleepEnergy(energy);
+    sleepEnergy = energy;
+}
+void PhysicsWorld::setSleepTime(decimal time)
+{
+    config.setSleepTime(time);
+    sleepTime = time;
+}
+void PhysicsWorld::setContinuousCollision(bool ccd)
+{
+    config.setContinuousCollision(ccd);
+    continuousCollision = ccd;
+}
+void PhysicsWorld::setEventDriven(bool events)
+{
+    config.setEventDriven(events);
+    eventDriven = events;
+}
+void PhysicsWorld::setContactSolver(const std::string& name)
+{
+    contactSolverType = parseContactSolver(name);
+    if (contactSolverType == ContactSolverType::Unknown)
+    {
+        std::cout << "The following contact solver is not implemented : " << name << '\n';
+        std::cout << "Please use one of the following contact solvers : Rebound, SequentialImpulse.\n";
+        std::cout << "Falling back to Rebound.\n";
+        contactSolverType = ContactSolverType::Rebound;
+    }
+    const bool rebound = contactSolverType == ContactSolverType::Rebound;
+    config.setContactSolver(rebound ? "Rebound" : "SequentialImpulse");
+}
+void PhysicsWorld::setSolverIterations(std::size_t velocity, std::size_t position)
+{
+    contactSolver.setIterations(velocity, position);
+    config.setVelocityIterations(velocity);
+    config.setPositionIterations(position);
+}
 
 // ============================================================================
 //  Core simulation methods
@@ -54,12 +183,36 @@ void PhysicsWorld::setGravityAcc(const Vector3D& acc) { gravityAcc = acc; }
 void PhysicsWorld::initialise()
 {
     isRunning = false;
-    objects.clear();
+    clearObjects();
 
     solver     = parseSolver(config.getSolver());
     timeStep   = config.getTimeStep();
     gravityCst = config.getGravity();
     gravityAcc = Physics::computeGravityAcc(gravityCst);
+    if (threadPool->getThreadCount() != config.getThreadCount())
+        setThreadCount(config.getThreadCount());
+    deterministic = config.getDeterministic();
+    sleepEnergy   = config.getSleepEnergy();
+    sleepTime     = config.getSleepTime();
+    absTolerance  = config.getAbsTolerance();
+    relTolerance  = config.getRelTolerance();
+    maxTimeLevel  = config.getMaxTimeLevel();
+    narrowPhase.setCaching(config.getPairCaching());
+    setBroadPhase(config.getBroadPhase());
+    setContactSolver(config.getContactSolver());
+    contactSolver.setIterations(config.getVelocityIterations(), config.getPositionIterations());
+
+    adaptiveStep   = timeStep;
+    lastStep       = timeStep;
+    denseStep      = 0_d;
+    simulationTime = 0.0;
+}
+void PhysicsWorld::resetAcc()
+{
+    Vector3DArray& acc = bodies.getAccelerations();
+    std::fill(acc.x.begin(), acc.x.end(), 0_d);
+    std::fill(acc.y.begin(), acc.y.end(), 0_d);
+    std::fill(acc.z.begin(), acc.z.end(), 0_d);
 }
 
 // ============================================================================
@@ -72,11 +225,19 @@ void PhysicsWorld::applyGravityForce(Object& obj)
 }
 void PhysicsWorld::applyGravityForces()
 {
-
-    for (auto* obj : objects)
-    {
-        applyGravityForce(*obj);
-    }
+    Vector3DArray& acc = bodies.getAccelerations();
+    forEachSlotChunk(
+        [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                if (!bodies.isDynamic(i))
+                    continue;
+                acc.x[i] += gravityAcc[0];
+                acc.y[i] += gravityAcc[1];
+                acc.z[i] += gravityAcc[2];
+            }
+        });
 }
 void PhysicsWorld::applySpringForces(Object& obj, Object& other)
 {
@@ -107,10 +268,9 @@ void PhysicsWorld::applyContactForces(Object& obj, Object& other)
     if (obj.getIsFixed() && other.getIsFixed())
         return;
 
-    Vector3D springForce   = Physics::computeSpringForce(obj, other);
-    Vector3D dampingForce  = Physics::computeDampingForce(obj, other);
-    Vector3D frictionForce = Physics::computeFrictionForce(obj, other);
-    Vector3D totalForce    = springForce + dampingForce + frictionForce;
+    const Physics::ContactModel model      = Physics::computeContactModel(obj, other);
+    const Vector3D              totalForce = Physics::computeContactForce(
+        model, other.getPosition() - obj.getPosition(), other.getVelocity() - obj.getVelocity());
 
     if (!obj.getIsFixed())
         obj.addAcceleration(totalForce / obj.getMass());
@@ -126,7 +286,7 @@ void PhysicsWorld::computeAcceleration(Object& obj)
     applyGravityForce(obj);
 
     // Contact forces
-    for (auto* other : objects)
+    for (Object* other : bodies.getObjects())
     {
         if (!other || other == &obj)
             continue;
@@ -137,62 +297,791 @@ void PhysicsWorld::computeAcceleration(Object& obj)
         }
     }
 }
+void PhysicsWorld::updateBroadPhase()
+{
+    // Slots were added, removed or emptied since the last update: cached per-index data is stale
+    if (broadPhaseVersion != bodies.getVersion())
+    {
+        broadPhase->reset();
+        broadPhaseVersion = bodies.getVersion();
+    }
+    broadPhase->computePairs(bodies.getObjects(), pairs);
+
+    // The pairs between the bodies woken up were left out as sleeping pairs
+    if (wakeContacts())
+        broadPhase->computePairs(bodies.getObjects(), pairs);
+}
+/**
+ * @brief Gravity, then the contact forces of the broad-phase pairs.
+ *
+ * The force of each pair only reads the state of its two bodies: forces are computed on the pool into a
+ * per-pair buffer, then added to the accelerations in pair order, as the single-thread loop does. Each
+ * force is a single fused evaluation (`Physics::computeContactForce(model, r, v)`) reading the body arrays.
+ * The buffer is frame memory, released on return: the stages of RK4 reuse the same bytes.
+ */
 void PhysicsWorld::applyForces()
 {
+    ++forceEvaluations;
+
     // 1. Gravity (applies to all objects)
     applyGravityForces();
 
-    // 2. Contact forces (between object pairs)
-    const size_t n = objects.size();
-    for (size_t i = 0; i < n; ++i)
+    // 2. Contact forces (between candidate pairs, those of the start of the step during multi-rate sub-steps)
+    if (!subStepping)
+        updateBroadPhase();
+    const std::size_t    pairCount = pairs.size();
+    const Vector3DArray& pos       = bodies.getPositions();
+    const Vector3DArray& vel       = bodies.getVelocities();
+    const auto contactForce = [&](std::size_t a, std::size_t b)
     {
-        Object* obj1 = objects[i];
-        if (!obj1)
-            continue;
+        if (!isStepped(a) && !isStepped(b))
+            return Vector3D(0_d);
+        // Pairs of the start of the step may have come apart since, as the broad phase would find
+        if (subStepping &&
+            !bodies.getObject(a)->getBoundingBox().overlaps(bodies.getObject(b)->getBoundingBox()))
+            return Vector3D(0_d);
+        const Physics::ContactModel model = Physics::computeContactModel(
+            bodies.getMaterialPair(a, b), bodies.getColdData(a).mass, bodies.getColdData(b).mass);
+        return Physics::computeContactForce(model, pos.get(b) - pos.get(a), vel.get(b) - vel.get(a));
+    };
+    const FrameArena::Marker  mark       = frame.mark();
+    const std::span<Vector3D> pairForces = frame.allocate<Vector3D>(pairCount);
+    threadPool->parallelFor(0, pairCount, threadPool->grainFor(pairCount, pairGrain),
+                            [&](std::size_t first, std::size_t last)
+                            {
+                                for (std::size_t k = first; k < last; ++k)
+                                    pairForces[k] = contactForce(pairs[k].first, pairs[k].second);
+                            });
+    Vector3DArray& acc = bodies.getAccelerations();
+    for (std::size_t k = 0; k < pairCount; ++k)
+    {
+        const std::size_t a = pairs[k].first;
+        const std::size_t b = pairs[k].second;
+        if (bodies.isDynamic(a))
+            acc.set(a, acc.get(a) + pairForces[k] / bodies.getColdData(a).mass);
+        if (bodies.isDynamic(b))
+            acc.set(b, acc.get(b) + -pairForces[k] / bodies.getColdData(b).mass);
+    }
+    frame.rewind(mark);
+}
+void PhysicsWorld::computeContacts()
+{
+    const std::size_t pairCount = pairs.size();
+    contacts                    = frame.allocate<Contact>(pairCount);
+    contactFound                = frame.allocate<std::uint8_t>(pairCount);
+    narrowPhase.compute(bodies, pairs, contacts, contactFound, *threadPool, frame, pairGrain);
+}
+/**
+ * @brief Broad phase, narrow phase, then collision response in pair order.
+ *
+ * With several threads, the contacts of all pairs are first computed in parallel from the state at the
+ * start of the pass, and the pairs are split into contact islands solved concurrently. Inside an island,
+ * responses are applied in pair order.
+ *
+ * A response moves its two bodies, so in deterministic mode the contact of a pair involving an already
+ * moved body is computed again before its response, and every candidate pair links its bodies (a response
+ * may bring a pair into contact): each response then sees the state the single-thread loop would see.
+ * Otherwise islands only follow the start-of-pass contacts, which are used as they are: islands are smaller
+ * and the narrow phase stays parallel, at the cost of results that depend on the thread count.
+ *
+ * The sequential-impulse solver instead iterates over the start-of-pass contacts of each island (see
+ * ContactSolver); its results never depend on the thread count.
+ */
+void PhysicsWorld::solveCollisions()
+{
+    // Broad phase
+    updateBroadPhase();
 
-        for (size_t j = i + 1; j < n; ++j)
+    if (contactSolverType == ContactSolverType::SequentialImpulse)
+    {
+        // Gravity alone brings resting bodies in at g * dt per step: slower contacts do not bounce
+        const decimal restingSpeed = 2_d * gravityAcc.getNorm() * lastStep;
+        computeContacts();
+        contactSolver.solve(bodies, pairs, contacts, contactFound, islands, *threadPool, frame,
+                            gravityAcc * lastStep, restingSpeed);
+        return;
+    }
+
+    // Narrow phase
+    if (threadPool->getThreadCount() == 1)
+    {
+        for (const CollisionPair& pair : pairs)
         {
-            Object* obj2 = objects[j];
-            if (!obj2)
+            if (!bodies.isDynamic(pair.first) && !bodies.isDynamic(pair.second))
                 continue;
+            Object* A = bodies.getObject(pair.first);
+            Object* B = bodies.getObject(pair.second);
 
-            // Only apply contact forces if objects are colliding
-            if (obj1->checkCollision(*obj2))
+            Contact contact;
+            bool    isCollidindNarrow = A->computeCollision(*B, contact);
+            if (isCollidindNarrow)
             {
-                applyContactForces(*obj1, *obj2);
+                const decimal restitution = bodies.getMaterialPair(pair.first, pair.second).restitution;
+                reboundCollision(*A, *B, contact, restitution);
             }
         }
+        return;
     }
+
+    computeContacts();
+    islands.build(bodies, pairs, deterministic ? nullptr : contactFound.data());
+
+    // Islands share no dynamic body: `touched` is only written for the bodies of the island being solved
+    touched = frame.allocate<std::uint8_t>(bodies.size(), 0);
+    const std::size_t islandCount = islands.size();
+    threadPool->parallelFor(0, islandCount, threadPool->grainFor(islandCount, 1),
+                            [&](std::size_t first, std::size_t last)
+                            {
+                                for (std::size_t island = first; island < last; ++island)
+                                {
+                                    for (const std::size_t k : islands.getPairs(island))
+                                        solveContact(k);
+                                }
+                            });
 }
-void PhysicsWorld::solveCollisions()
+void PhysicsWorld::solveContact(std::size_t k)
+{
+    const CollisionPair& pair = pairs[k];
+    Object*              A    = bodies.getObject(pair.first);
+    Object*              B    = bodies.getObject(pair.second);
+
+    bool isCollidindNarrow = contactFound[k] != 0;
+    if (deterministic && (touched[pair.first] || touched[pair.second]))
+    {
+        contacts[k]       = Contact();
+        isCollidindNarrow = A->computeCollision(*B, contacts[k]);
+    }
+    if (isCollidindNarrow)
+    {
+        reboundCollision(*A, *B, contacts[k], bodies.getMaterialPair(pair.first, pair.second).restitution);
+        if (bodies.isDynamic(pair.first))
+            touched[pair.first] = 1;
+        if (bodies.isDynamic(pair.second))
+            touched[pair.second] = 1;
+    }
+}
+
+// ============================================================================
+//  Sleeping
+// ============================================================================
+/**
+ * @brief Wake up the sleeping bodies paired with an awake one, together with their sleep group.
+ *
+ * A group is the island a body fell asleep with, so a whole resting pile wakes up at once when something
+ * hits any of its bodies.
+ */
+bool PhysicsWorld::wakeContacts()
 {
-    const size_t n = objects.size();
+    const FrameArena::Marker mark       = frame.mark();
+    std::span<std::uint8_t>  wakeGroups = {};
+    bool                     woken      = false;
+    for (const CollisionPair& pair : pairs)
+    {
+        const bool sleepingFirst  = bodies.isSleeping(pair.first) && bodies.isDynamic(pair.second);
+        const bool sleepingSecond = bodies.isSleeping(pair.second) && bodies.isDynamic(pair.first);
+        if (!sleepingFirst && !sleepingSecond)
+            continue;
+        if (!woken)
+            wakeGroups = frame.allocate<std::uint8_t>(bodies.size(), 0);
+        woken = true;
+        wakeGroups[bodies.getSleepGroup(sleepingFirst ? pair.first : pair.second)] = 1;
+    }
+    if (!woken)
+        return false;
 
-    for (size_t i = 0; i < n; ++i)
+    for (std::size_t slot = 0; slot < bodies.size(); ++slot)
     {
-        Object* A = objects[i];
-        if (!A)
+        if (bodies.isSleeping(slot) && wakeGroups[bodies.getSleepGroup(slot)])
+            bodies.wake(slot);
+    }
+    frame.rewind(mark);
+    return true;
+}
+/**
+ * @brief Sleep timers, then island-wide sleeping.
+ *
+ * A body is still while its kinetic energy stays below its own sleep energy, or the world one if it has
+ * none. Once a body has been still for `sleepTime`, it falls asleep with its island (the bodies linked to
+ * it by candidate pairs), and only if every body of the island is still too: a pile never goes half asleep.
+ * Sleeping bodies keep a null velocity and are skipped by the integrators until woken up.
+ */
+void PhysicsWorld::updateSleeping(decimal dt)
+{
+    const Vector3DArray&        vel      = bodies.getVelocities();
+    const std::vector<decimal>& invMass  = bodies.getInverseMasses();
+    const std::vector<decimal>& energies = bodies.getSleepEnergies();
+    std::vector<decimal>&       still    = bodies.getStillTimes();
+    const std::size_t           n        = bodies.size();
+    bool                        anyReady = false;
+    for (std::size_t slot = 0; slot < n; ++slot)
+    {
+        if (!bodies.isDynamic(slot))
             continue;
 
-        for (size_t j = i + 1; j < n; ++j)
+        // 1/2 m v² < E, written with the inverse mass of the arrays
+        const decimal threshold = energies[slot] >= 0_d ? energies[slot] : sleepEnergy;
+        const decimal speed2 =
+            vel.x[slot] * vel.x[slot] + vel.y[slot] * vel.y[slot] + vel.z[slot] * vel.z[slot];
+        if (0.5_d * speed2 < threshold * invMass[slot])
         {
-            Object* B = objects[j];
-            if (!B)
+            still[slot] += dt;
+            anyReady = anyReady || still[slot] >= sleepTime;
+        }
+        else
+            still[slot] = 0_d;
+    }
+    if (!anyReady)
+        return;
+
+    islands.build(bodies, pairs);
+    // Per island: no body is still moving, and the sleep group given to its bodies
+    const FrameArena::Marker       mark        = frame.mark();
+    const std::span<std::uint8_t>  islandReady = frame.allocate<std::uint8_t>(islands.size(), 1);
+    const std::span<std::uint32_t> islandGroup = frame.allocate(islands.size(), ContactIslands::none);
+    for (std::size_t slot = 0; slot < n; ++slot)
+    {
+        if (!bodies.isDynamic(slot) || still[slot] >= sleepTime)
+            continue;
+        const std::uint32_t island = islands.getBodyIsland(slot);
+        if (island != ContactIslands::none)
+            islandReady[island] = 0;
+    }
+    for (std::size_t slot = 0; slot < n; ++slot)
+    {
+        if (!bodies.isDynamic(slot) || still[slot] < sleepTime)
+            continue;
+
+        const std::uint32_t island = islands.getBodyIsland(slot);
+        if (island == ContactIslands::none)
+            bodies.sleep(slot, static_cast<std::uint32_t>(slot));
+        else if (islandReady[island])
+        {
+            // The group is named after the first slot of the island
+            if (islandGroup[island] == ContactIslands::none)
+                islandGroup[island] = static_cast<std::uint32_t>(slot);
+            bodies.sleep(slot, islandGroup[island]);
+        }
+    }
+    frame.rewind(mark);
+}
+
+// ============================================================================
+//  Continuous collision
+// ============================================================================
+bool PhysicsWorld::isSwept(std::size_t slot) const
+{
+    return bodies.isDynamic(slot) && bodies.getType(slot) == ObjectType::Sphere &&
+           (continuousCollision || bodies.getColdData(slot).continuous);
+}
+void PhysicsWorld::saveSweepStarts()
+{
+    sweepStart = {};
+    bool swept = continuousCollision;
+    for (std::size_t slot = 0; slot < bodies.size() && !swept; ++slot)
+        swept = bodies.getColdData(slot).continuous;
+    if (!swept)
+        return;
+
+    sweepStart                     = frame.allocate<Vector3D>(bodies.size());
+    const Vector3DArray& positions = bodies.getPositions();
+    forEachSlotChunk(
+        [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t slot = first; slot < last; ++slot)
+                sweepStart[slot] = positions.get(slot);
+        });
+}
+/**
+ * @brief Move back every swept sphere to its first impact since `saveSweepStarts`, slightly past it.
+ *
+ * Spheres moving less than their radius over the step cannot pass through anything and are not swept. The
+ * others are swept against every other body along their motion relative to it, all bodies being taken at
+ * their start position; a sphere that hits something is put back at `impactSkin` of its radius past the
+ * earliest impact, so that the narrow phase finds the contact and the collision response handles it. The
+ * velocity is kept: the rest of the step is dropped for that sphere only.
+ *
+ * Every fraction is computed before any position changes, so the result does not depend on the slot order
+ * nor on the threads.
+ */
+void PhysicsWorld::advanceToImpacts()
+{
+    using NarrowCollision::shapeOf;
+
+    if (sweepStart.empty())
+        return;
+
+    const std::size_t  n         = bodies.size();
+    Vector3DArray&     positions = bodies.getPositions();
+    std::span<decimal> fractions = frame.allocate<decimal>(n, 1_d);
+    forEachSlotChunk(
+        [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t slot = first; slot < last; ++slot)
+            {
+                if (!isSwept(slot))
+                    continue;
+                const Sphere&  sphere = static_cast<const Sphere&>(*bodies.getObject(slot));
+                const decimal  radius = sphere.getRadius();
+                const Vector3D motion = positions.get(slot) - sweepStart[slot];
+                if (motion.getNormSquare() <= radius * radius)
+                    continue;
+
+                const NarrowCollision::SphereShape shape { sweepStart[slot], radius };
+                decimal                            earliest = 1_d;
+                for (std::size_t other = 0; other < n; ++other)
+                {
+                    const Object* obj = bodies.getObject(other);
+                    if (other == slot || !obj)
+                        continue;
+                    const Vector3D relative = motion - (positions.get(other) - sweepStart[other]);
+                    decimal        fraction = 1_d;
+                    bool           hit      = false;
+                    switch (bodies.getType(other))
+                    {
+                    case ObjectType::Sphere:
+                    {
+                        const decimal otherRadius = static_cast<const Sphere*>(obj)->getRadius();
+                        hit = ContinuousCollision::timeOfImpact(
+                            shape, relative, NarrowCollision::SphereShape { sweepStart[other], otherRadius },
+                            fraction);
+                        break;
+                    }
+                    case ObjectType::AABB:
+                    {
+                        const Vector3D halfExtents = static_cast<const AABB*>(obj)->getHalfExtents();
+                        hit = ContinuousCollision::timeOfImpact(
+                            shape, relative, NarrowCollision::BoxShape { sweepStart[other], halfExtents },
+                            fraction);
+                        break;
+                    }
+                    case ObjectType::Plane:
+                    {
+                        NarrowCollision::PlaneShape plane = shapeOf(*static_cast<const Plane*>(obj));
+                        plane.center                      = sweepStart[other];
+                        hit = ContinuousCollision::timeOfImpact(shape, relative, plane, fraction);
+                        break;
+                    }
+                    case ObjectType::Generic:
+                        break;
+                    }
+                    if (hit)
+                        earliest = std::min(earliest, fraction);
+                }
+                fractions[slot] = earliest;
+            }
+        });
+
+    forEachSlotChunk(
+        [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t slot = first; slot < last; ++slot)
+            {
+                if (!(fractions[slot] < 1_d))
+                    continue;
+                const Vector3D motion = positions.get(slot) - sweepStart[slot];
+                const decimal  radius = static_cast<const Sphere&>(*bodies.getObject(slot)).getRadius();
+                const decimal  skin   = impactSkin * radius / motion.getNorm();
+                positions.set(slot, sweepStart[slot] + std::min(1_d, fractions[slot] + skin) * motion);
+            }
+        });
+}
+
+// ============================================================================
+//  Event-driven stepping
+// ============================================================================
+/**
+ * @brief Time before the body of `slot` may touch the body of `other`, both moving under gravity alone.
+ *
+ * The gap of the pair is its narrow-phase separation (see PairCache::getNarrowSeparation). Against a plane,
+ * only the motion along its normal closes the gap, and the time is the exact crossing of the parabola;
+ * otherwise the gap is closed at most at the norm of the relative velocity and acceleration, and the time is
+ * a lower bound. Two dynamic bodies share the gravity, so their relative motion is a straight line.
+ */
+decimal PhysicsWorld::pairFlightTime(std::size_t slot, std::size_t other) const
+{
+    using ContinuousCollision::approachTime;
+
+    const Vector3DArray& velocities = bodies.getVelocities();
+    const Object&        body       = *bodies.getObject(slot);
+    const Object&        obj        = *bodies.getObject(other);
+    const ObjectType     bodyType   = bodies.getType(slot);
+    const ObjectType     otherType  = bodies.getType(other);
+
+    Vector3D velocity     = velocities.get(slot);
+    Vector3D acceleration = gravityAcc;
+    if (bodies.isDynamic(other))
+    {
+        velocity     = velocity - velocities.get(other);
+        acceleration = Vector3D(0_d);
+    }
+    const decimal gap = PairCache::getNarrowSeparation(body, obj);
+    if ((bodyType == ObjectType::Sphere && otherType == ObjectType::Plane) ||
+        (bodyType == ObjectType::Plane && otherType == ObjectType::Sphere))
+    {
+        const bool      sphereFirst = bodyType == ObjectType::Sphere;
+        const Object&   sphere      = sphereFirst ? body : obj;
+        const Plane&    plane       = static_cast<const Plane&>(sphereFirst ? obj : body);
+        const Vector3D& normal      = plane.getNormal();
+        const decimal   side        = (sphere.getPosition() - plane.getPosition()).dotProduct(normal);
+        // Closing rates along the normal, towards the plane from the side of the sphere
+        const decimal closing = (side < 0_d) == sphereFirst ? 1_d : -1_d;
+        const decimal speed   = closing * velocity.dotProduct(normal);
+        const decimal accel   = closing * acceleration.dotProduct(normal);
+        return approachTime(gap, speed, accel);
+    }
+    return approachTime(gap, velocity.getNorm(), acceleration.getNorm());
+}
+/**
+ * @brief Box covering the body of `slot` along its parabola over `[0, span]`.
+ *
+ * On each axis the displacement `v·t + g·t²/2` is extreme at the ends of the flight or at its apex. Bodies
+ * that do not move keep their current box.
+ */
+BoundingBox PhysicsWorld::sweptBox(std::size_t slot, decimal span) const
+{
+    BoundingBox box = bodies.getObject(slot)->getBoundingBox();
+    if (!bodies.isDynamic(slot))
+        return box;
+
+    const Vector3D velocity = bodies.getVelocities().get(slot);
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        const decimal v    = velocity[i];
+        const decimal g    = gravityAcc[i];
+        const decimal end  = v * span + 0.5_d * g * span * span;
+        decimal       low  = std::min(0_d, end);
+        decimal       high = std::max(0_d, end);
+        if (g != 0_d && -v / g > 0_d && -v / g < span)
+        {
+            const decimal apex = -0.5_d * v * v / g;
+            low                = std::min(low, apex);
+            high               = std::max(high, apex);
+        }
+        box.min[i] += low;
+        box.max[i] += high;
+    }
+    return box;
+}
+/**
+ * @brief Smallest `pairFlightTime` of the pairs that may touch within `span`, or `span` if there is none.
+ *
+ * Two bodies touching within `span` have overlapping boxes at that time, so their boxes swept over `span`
+ * overlap: each dynamic body queries the tree of the swept boxes, and only the pairs it returns are timed.
+ * Pairs with a dynamic body of a lower slot are left to that body. Planes are kept out of the tree, as the
+ * contact test of a tilted plane is not bounded by its box: every body is timed against every plane.
+ *
+ * The cost is one tree build and one query per body, O(n log n) plus the pairs found. The callers pass the
+ * step they would take as `span`, so that the swept boxes stay about as large as the motion they bound.
+ *
+ * Callers only compare a horizon below `threshold` against it, so its search is cut short: during a contact
+ * phase a candidate pair of the last broad phase is closer than that, found in one pass over the pairs, and
+ * otherwise the queries stop on every thread at the first body found closer than that to a contact. Either
+ * way the result is then some time below `threshold`, the same whatever the thread count.
+ */
+decimal PhysicsWorld::contactHorizon(decimal span, decimal threshold)
+{
+    const std::size_t n = bodies.size();
+    if (n == 0 || !(span > 0_d))
+        return span;
+
+    if (threshold > 0_d && broadPhaseVersion == bodies.getVersion())
+    {
+        for (const CollisionPair& pair : pairs)
+        {
+            const bool firstMoves = bodies.isDynamic(pair.first);
+            if (!firstMoves && !bodies.isDynamic(pair.second))
                 continue;
+            const std::size_t slot  = firstMoves ? pair.first : pair.second;
+            const std::size_t other = firstMoves ? pair.second : pair.first;
+            const decimal     time  = pairFlightTime(slot, other);
+            if (time < threshold)
+                return time;
+        }
+    }
+
+    horizonTree.clear();
+    horizonBoxes.resize(n);
+    horizonPlanes.clear();
+    for (std::size_t slot = 0; slot < n; ++slot)
+    {
+        if (!bodies.getObject(slot))
+            continue;
+        if (bodies.getType(slot) == ObjectType::Plane)
+        {
+            horizonPlanes.push_back(slot);
+            continue;
+        }
+        horizonBoxes[slot] = sweptBox(slot, span);
+        horizonTree.createProxy(horizonBoxes[slot], static_cast<std::uint32_t>(slot));
+    }
+
+    const FrameArena::Marker mark    = frame.mark();
+    const std::span<decimal> flights = frame.allocate<decimal>(n, span);
+    std::atomic<bool>        below { false }; // a flight shorter than `threshold` was found
+    forEachSlotChunk(
+        [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t slot = first; slot < last && !below.load(std::memory_order_relaxed); ++slot)
+            {
+                if (!bodies.isDynamic(slot))
+                    continue;
+                decimal&   earliest = flights[slot];
+                const auto check    = [&](std::size_t other) // false once the search can stop
+                {
+                    const bool shared = bodies.isDynamic(other) && other < slot; // timed by `other`
+                    if (other != slot && bodies.getObject(other) && !shared)
+                        earliest = std::min(earliest, pairFlightTime(slot, other));
+                    return earliest > 0_d && !(earliest < threshold);
+                };
+                if (bodies.getType(slot) == ObjectType::Plane)
+                {
+                    for (std::size_t other = 0; other < n; ++other)
+                    {
+                        if (!check(other))
+                            break;
+                    }
+                }
+                else if (std::all_of(horizonPlanes.begin(), horizonPlanes.end(), check))
+                {
+                    horizonTree.query(horizonBoxes[slot], check);
+                }
+                if (earliest < threshold)
+                    below.store(true, std::memory_order_relaxed);
+            }
+        });
+    const decimal earliest = below.load() ? 0_d : *std::min_element(flights.begin(), flights.end());
+    frame.rewind(mark);
+    return earliest;
+}
+decimal PhysicsWorld::motionTime(std::size_t slot) const
+{
+    const Vector3D& size = bodies.getColdData(slot).size;
+    const decimal   half = 0.5_d * std::min({ size.getX(), size.getY(), size.getZ() });
+    if (!(half > 0_d))
+        return std::numeric_limits<decimal>::infinity();
+    return ContinuousCollision::approachTime(half, bodies.getVelocities().get(slot).getNorm(),
+                                             bodies.getAccelerations().get(slot).getNorm());
+}
+decimal PhysicsWorld::motionLimit()
+{
+    const std::size_t n = bodies.size();
+    if (n == 0)
+        return std::numeric_limits<decimal>::infinity();
+
+    const FrameArena::Marker mark   = frame.mark();
+    const std::span<decimal> limits = frame.allocate<decimal>(n, std::numeric_limits<decimal>::infinity());
+    forEachSlotChunk(
+        [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t slot = first; slot < last; ++slot)
+            {
+                if (bodies.isDynamic(slot))
+                    limits[slot] = motionTime(slot);
+            }
+        });
+    const decimal limit = *std::min_element(limits.begin(), limits.end());
+    frame.rewind(mark);
+    return limit;
+}
+/**
+ * @brief Move every dynamic body along its parabola over whole steps, up to the first possible contact.
+ *
+ * Between contacts the only force is gravity, so the motion over any duration is known in closed form: a
+ * sparse scene of projectiles costs one jump per flight instead of one step per `timeStep`. The jump spans
+ * whole steps, so that `run` stays on its time grid, and stops short of the first time any awake body may
+ * touch another one; the steps around the contacts are then integrated as usual.
+ *
+ * The horizon is searched over a span starting at the last one and doubled while no contact is found within
+ * it, up to `maxSteps`: the swept boxes of contactHorizon stay about as large as the jump. A horizon shorter
+ * than a step allows no jump, so its search stops there.
+ */
+std::size_t PhysicsWorld::fastForward(std::size_t maxSteps)
+{
+    if (maxSteps == 0 || bodies.size() == 0 || !(timeStep > 0_d))
+        return 0;
 
-            // Broad phase
-            bool isCollidingBroad = A->checkCollision(*B);
+    const decimal maxSpan  = static_cast<decimal>(maxSteps) * timeStep;
+    decimal       span     = std::clamp(lastHorizon, timeStep, maxSpan);
+    decimal       earliest = contactHorizon(span, timeStep);
+    while (!(earliest < span) && span < maxSpan)
+    {
+        span     = std::min(2_d * span, maxSpan);
+        earliest = contactHorizon(span, timeStep);
+    }
+    lastHorizon = span;
 
-            // Narrow phase
-            if (isCollidingBroad)
+    const decimal steps = std::floor(earliest / timeStep);
+    if (!(steps >= 1_d))
+        return 0;
+    const std::size_t count =
+        steps < static_cast<decimal>(maxSteps) ? static_cast<std::size_t>(steps) : maxSteps;
+
+    const decimal  duration   = static_cast<decimal>(count) * timeStep;
+    const Vector3D drop       = 0.5_d * duration * duration * gravityAcc;
+    const Vector3D kick       = duration * gravityAcc;
+    Vector3DArray& positions  = bodies.getPositions();
+    Vector3DArray& velocities = bodies.getVelocities();
+    forEachSlotChunk(
+        [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t slot = first; slot < last; ++slot)
+            {
+                if (!bodies.isDynamic(slot))
+                    continue;
+                const Vector3D velocity = velocities.get(slot);
+                positions.set(slot, positions.get(slot) + duration * velocity + drop);
+                velocities.set(slot, velocity + kick);
+            }
+        });
+    simulationTime += static_cast<double>(duration);
+    denseStep = 0_d;
+    ++fastForwards;
+    return count;
+}
+
+// ============================================================================
+//  Multi-rate stepping
+// ============================================================================
+/**
+ * @brief Level of each body: the coarsest step `timeStep / 2^level` it can take, shared by its island.
+ *
+ * A body needs a step no longer than the time it takes to move by half its size (see motionTime), and
+ * `stepsPerContactPeriod` steps over the oscillation period 2π·sqrt(μ/k) of each of its candidate pairs,
+ * μ being the reduced mass of the dynamic bodies of the pair and k the stiffness of their materials. Bodies
+ * linked by candidate pairs take the finest level of their island, so that coupled bodies move together.
+ * Levels are capped by `maxTimeLevel`: a body needing more is stepped at the finest level. The implicit
+ * solver is stable at any step of the contact springs: with it, only the motion of the bodies sets their
+ * level.
+ */
+std::size_t PhysicsWorld::assignTimeLevels()
+{
+    const std::size_t n = bodies.size();
+    timeLevels.assign(n, 0);
+    if (n == 0)
+        return 0;
+
+    const FrameArena::Marker mark  = frame.mark();
+    const std::span<decimal> needs = frame.allocate<decimal>(n, std::numeric_limits<decimal>::infinity());
+    forEachSlotChunk(
+        [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t slot = first; slot < last; ++slot)
             {
-                Contact contact;
-                bool    isCollidindNarrow = A->computeCollision(*B, contact);
-                if (isCollidindNarrow)
-                    reboundCollision(*A, *B, contact);
+                if (bodies.isDynamic(slot))
+                    needs[slot] = motionTime(slot);
             }
+        });
+    for (const CollisionPair& pair : pairs)
+    {
+        const bool    dynamicA  = bodies.isDynamic(pair.first);
+        const bool    dynamicB  = bodies.isDynamic(pair.second);
+        const decimal stiffness = bodies.getMaterialPair(pair.first, pair.second).stiffness;
+        if ((!dynamicA && !dynamicB) || !(stiffness > 0_d) || solver == Solver::Implicit)
+            continue;
+        const decimal massA  = bodies.getColdData(pair.first).mass;
+        const decimal massB  = bodies.getColdData(pair.second).mass;
+        const decimal mass   = !dynamicB ? massA : !dynamicA ? massB : Physics::reducedMass(massA, massB);
+        const decimal period = 2_d * std::numbers::pi_v<decimal> * std::sqrt(mass / stiffness);
+        const decimal step   = period / stepsPerContactPeriod;
+        if (dynamicA)
+            needs[pair.first] = std::min(needs[pair.first], step);
+        if (dynamicB)
+            needs[pair.second] = std::min(needs[pair.second], step);
+    }
+
+    for (std::size_t slot = 0; slot < n; ++slot)
+    {
+        decimal step = timeStep;
+        while (timeLevels[slot] < maxTimeLevel && step > needs[slot])
+        {
+            step *= 0.5_d;
+            ++timeLevels[slot];
         }
     }
+    frame.rewind(mark);
+
+    // Finest level of each island
+    islands.build(bodies, pairs);
+    const std::span<std::uint8_t> islandLevels = frame.allocate<std::uint8_t>(islands.size(), 0);
+    for (std::size_t slot = 0; slot < n; ++slot)
+    {
+        const std::uint32_t island = islands.getBodyIsland(slot);
+        if (island != ContactIslands::none)
+            islandLevels[island] = std::max(islandLevels[island], timeLevels[slot]);
+    }
+    std::uint8_t finest = 0;
+    for (std::size_t slot = 0; slot < n; ++slot)
+    {
+        const std::uint32_t island = islands.getBodyIsland(slot);
+        if (island != ContactIslands::none)
+            timeLevels[slot] = islandLevels[island];
+        finest = std::max(finest, timeLevels[slot]);
+    }
+    return finest;
+}
+/**
+ * @brief Move each body over `timeStep` in steps of its time level, all of them ending at the step boundary.
+ *
+ * With `finest` the finest level, the step is cut into 2^finest sub-steps. A body of level `l` moves every
+ * 2^(finest - l) sub-steps, over that many sub-steps at once, with the world solver: its motion mask is set
+ * to that count, which scales its step in the integration kernels, and to 0 at the sub-steps where it
+ * waits. At each sub-step, forces are only evaluated for the candidate pairs with a moving body, and
+ * bodies that wait are seen at their last state. The last sub-step moves every body, so that the collision
+ * response of `integrate` runs on the synchronised state.
+ *
+ * The candidate pairs are those of the start of the step: a body moves by less than half its size per
+ * sub-step, but contacts it reaches within the step are found at the next one. In between, the contacts of
+ * the moving bodies are resolved pair by pair, as the Rebound solver does.
+ */
+void PhysicsWorld::integrateMultiRate()
+{
+    updateBroadPhase();
+    const std::size_t finest = assignTimeLevels();
+    const std::size_t n      = bodies.size();
+    if (finest == 0)
+    {
+        integrateBodies(timeStep);
+        bodyUpdates += getAwakeCount();
+        return;
+    }
+    if (solver == Solver::Verlet)
+        updateVerletAcc(); // every body starts from its full forces
+
+    const std::size_t subSteps = std::size_t { 1 } << finest;
+    const decimal     subStep  = timeStep / static_cast<decimal>(subSteps);
+    levelMasks.assign(n, 0_d);
+    subStepping = true;
+    for (std::size_t s = 1; s <= subSteps; ++s)
+    {
+        std::size_t moved = 0;
+        for (std::size_t slot = 0; slot < n; ++slot)
+        {
+            const std::size_t stride = std::size_t { 1 } << (finest - timeLevels[slot]);
+            const bool        moving = bodies.isDynamic(slot) && s % stride == 0;
+            levelMasks[slot]         = moving ? static_cast<decimal>(stride) : 0_d;
+            moved                   += moving ? 1 : 0;
+        }
+        bodyUpdates += moved;
+
+        integrateBodies(subStep);
+        if (s < subSteps)
+            solveSubStepCollisions();
+    }
+    subStepping = false;
+}
+void PhysicsWorld::solveSubStepCollisions()
+{
+    for (const CollisionPair& pair : pairs)
+    {
+        if (!isStepped(pair.first) && !isStepped(pair.second))
+            continue;
+        Object* A = bodies.getObject(pair.first);
+        Object* B = bodies.getObject(pair.second);
+
+        Contact contact;
+        if (A->computeCollision(*B, contact))
+            reboundCollision(*A, *B, contact, bodies.getMaterialPair(pair.first, pair.second).restitution);
+    }
 }
 
 // ============================================================================
@@ -260,86 +1149,504 @@ void PhysicsWorld::integrateRK4(Object& obj, decimal dt)
     obj.setPosition(obj.getPosition() + dxdt * dt);
     obj.setVelocity(obj.getVelocity() + dvdt * dt);
 }
-void PhysicsWorld::integrateWithoutCollisions()
+/**
+ * @brief Velocity Verlet (kick-drift-kick) over the state of all bodies.
+ *
+ *  1. half kick and drift of every body with the accelerations at the start of the step;
+ *  2. one evaluation of gravity and of the contact forces over the broad-phase pairs;
+ *  3. second half kick with the new accelerations.
+ *
+ * The accelerations of step 2 are kept for the next step, so a step costs one force evaluation. They are
+ * evaluated again when bodies were added or removed, or after a change of solver or gravity.
+ */
+void PhysicsWorld::integrateVerletBodies(decimal dt)
 {
-    if (!isRunning)
+    Vector3DArray&              pos  = bodies.getPositions();
+    Vector3DArray&              vel  = bodies.getVelocities();
+    Vector3DArray&              acc  = bodies.getAccelerations();
+    const std::vector<decimal>& mask = motionMasks();
+
+    updateVerletAcc();
+
+    const decimal halfStep = 0.5_d * dt;
+    forEachSlotChunk([&](std::size_t first, std::size_t last)
+                     { BatchIntegrators::kickDrift(pos, vel, verletAcc, mask, halfStep, dt, first, last); });
+    resetAcc();
+    applyForces();
+    forEachSlotChunk([&](std::size_t first, std::size_t last)
+                     { BatchIntegrators::kick(vel, acc, mask, halfStep, first, last); });
+
+    // During a multi-rate sub-step, only the bodies moved have all their forces: the others keep theirs
+    if (subStepping)
     {
-        std::cout << "Simulation is not running. Run start() first.\n";
-        return;
+        forEachSlotChunk(
+            [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t slot = first; slot < last; ++slot)
+                {
+                    if (mask[slot] > 0_d)
+                        verletAcc.set(slot, acc.get(slot));
+                }
+            });
     }
+    else
+        verletAcc = acc;
+    verletVersion  = bodies.getVersion();
+    verletAccValid = true;
+}
+void PhysicsWorld::updateVerletAcc()
+{
+    if (verletAccValid && verletVersion == bodies.getVersion())
+        return;
+    resetAcc();
+    applyForces();
+    verletAcc      = bodies.getAccelerations();
+    verletVersion  = bodies.getVersion();
+    verletAccValid = true;
+}
+/**
+ * @brief Runge-Kutta 4 over the state of all bodies.
+ *
+ * Each stage moves every body to its intermediate state, then evaluates gravity and the contact forces of
+ * the broad-phase pairs for the whole system, so coupled bodies see each other at the same stage. The stage
+ * derivatives are accumulated in preallocated buffers: once they have reached the body count, a step does
+ * not allocate.
+ */
+void PhysicsWorld::integrateRK4Bodies(decimal dt)
+{
+    Vector3DArray&              pos  = bodies.getPositions();
+    Vector3DArray&              vel  = bodies.getVelocities();
+    Vector3DArray&              acc  = bodies.getAccelerations();
+    const std::vector<decimal>& mask = motionMasks();
+    const std::size_t           n    = bodies.size();
 
-    setTimeStep(timeStep);
+    rkPos0 = pos;
+    rkVel0 = vel;
+    rkSumX.assign(n, 0_d);
+    rkSumV.assign(n, 0_d);
 
-    // Reset accelerations
-    for (auto* obj : objects)
+    // Stage derivatives (dx/dt, dv/dt) = (vel, acc) at the current state, weights 1, 2, 2, 1
+    constexpr std::array<decimal, 4> weights { 1_d, 2_d, 2_d, 1_d };
+    const std::array<decimal, 3>     steps { 0.5_d * dt, 0.5_d * dt, dt };
+    for (std::size_t stage = 0; stage < weights.size(); ++stage)
     {
-        if (!obj || obj->isFixed())
-            continue;
-        obj->setAcceleration(Vector3D(0_d));
+        resetAcc();
+        applyForces();
+        forEachSlotChunk(
+            [&](std::size_t first, std::size_t last)
+            {
+                BatchIntegrators::axpy(rkSumX, vel, weights[stage], first, last);
+                BatchIntegrators::axpy(rkSumV, acc, weights[stage], first, last);
+                if (stage < steps.size())
+                    BatchIntegrators::offset(pos, vel, rkPos0, rkVel0, vel, acc, mask, steps[stage], first,
+                                             last);
+            });
     }
 
-    // Compute gravity forces
-    applyGravityForces();
+    const decimal sixthStep = dt / 6_d;
+    forEachSlotChunk(
+        [&](std::size_t first, std::size_t last)
+        {
+            BatchIntegrators::offset(pos, vel, rkPos0, rkVel0, rkSumX, rkSumV, mask, sixthStep, first,
+                                     last);
+        });
+}
+/**
+ * @brief Bogacki-Shampine 3(2) over the state of all bodies, with a step sized by the local error.
+ *
+ * The stages run as in RK4, over the whole system at once. The difference between the third-order solution
+ * and the embedded second-order one estimates the local error; it is scaled by `absTolerance +
+ * relTolerance·|y|` for each component of the position and velocity of each dynamic body, and the largest
+ * ratio decides: above 1 the step is taken again, shorter; otherwise it is kept and the next one is sized
+ * from it, within a factor of 5.
+ *
+ * Under gravity alone the method is exact, so the step grows until another bound stops it: the time before
+ * the first contact may start (see contactHorizon). The step then lands at the contact onset. While bodies
+ * touch, it is no longer than `timeStep`, so that contacts are resolved as with the fixed-step solvers, nor
+ * than the time for a body to move by half its size, so that a fast body cannot pass through the other one
+ * (see motionLimit).
+ *
+ * The last stage is evaluated at the new state: its derivatives are those of the start of the next step
+ * unless the contacts change the velocities in between, so they are computed again rather than reused.
+ */
+decimal PhysicsWorld::integrateBS32Bodies(decimal maxStep)
+{
+    Vector3DArray&              pos  = bodies.getPositions();
+    Vector3DArray&              vel  = bodies.getVelocities();
+    Vector3DArray&              acc  = bodies.getAccelerations();
+    const std::vector<decimal>& mask = bodies.getMotionMasks();
+    const std::size_t           n    = bodies.size();
+
+    // Butcher tableau of the stages 2 to 4, and weights of the error estimate
+    constexpr std::array<std::array<decimal, 3>, 3> stageWeights { { { 0.5_d, 0_d, 0_d },
+                                                                     { 0_d, 0.75_d, 0_d },
+                                                                     { 2_d / 9_d, 1_d / 3_d, 4_d / 9_d } } };
+    constexpr std::array<decimal, 4> errorWeights { -5_d / 72_d, 1_d / 12_d, 1_d / 9_d, -1_d / 8_d };
+    const decimal                    minStep = 1e-6_d * timeStep;
 
-    // Integrate motion
-    for (auto* obj : objects)
+    rkPos0 = pos;
+    rkVel0 = vel;
+    resetAcc();
+    applyForces();
+    rkStageX[0] = vel;
+    rkStageV[0] = acc;
+
+    // Contacts are searched within the step to take; a horizon shorter than the contact step is not used
+    const decimal contactStep = std::min(timeStep, motionLimit());
+    const decimal candidate   = std::min(adaptiveStep, maxStep);
+    const decimal horizon     = std::max(contactHorizon(candidate, contactStep), contactStep);
+    decimal       h           = std::min(candidate, horizon);
+    const bool    capped      = h < adaptiveStep;
+    bool          rejected    = false;
+    for (;;)
     {
-        if (!obj || obj->isFixed())
-            continue;
-        switch (solver)
-        {
-        case Solver::Euler:
-            integrateEuler(*obj, timeStep);
-            break;
-        case Solver::Verlet:
-            integrateVerlet(*obj, timeStep);
-            break;
-        case Solver::RK4:
-            integrateRK4(*obj, timeStep);
-            break;
-        case Solver::Unknown:
-            std::cout << "The following solver is not implemented : " << config.getSolver() << '\n';
-            std::cout << "Please use one of the following solver : Euler, Verlet, RK4.\n";
-            break;
+        for (std::size_t stage = 1; stage < rkStageX.size(); ++stage)
+        {
+            rkSumX.assign(n, 0_d);
+            rkSumV.assign(n, 0_d);
+            forEachSlotChunk(
+                [&](std::size_t first, std::size_t last)
+                {
+                    for (std::size_t j = 0; j < stage; ++j)
+                    {
+                        BatchIntegrators::axpy(rkSumX, rkStageX[j], stageWeights[stage - 1][j], first, last);
+                        BatchIntegrators::axpy(rkSumV, rkStageV[j], stageWeights[stage - 1][j], first, last);
+                    }
+                    BatchIntegrators::offset(pos, vel, rkPos0, rkVel0, rkSumX, rkSumV, mask, h, first, last);
+                });
+            resetAcc();
+            applyForces();
+            rkStageX[stage] = vel;
+            rkStageV[stage] = acc;
         }
+
+        // Largest scaled error over the components of the dynamic bodies
+        const FrameArena::Marker mark   = frame.mark();
+        const std::span<decimal> errors = frame.allocate<decimal>(n, 0_d);
+        forEachSlotChunk(
+            [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t slot = first; slot < last; ++slot)
+                {
+                    if (!bodies.isDynamic(slot))
+                        continue;
+                    Vector3D errorX(0_d);
+                    Vector3D errorV(0_d);
+                    for (std::size_t j = 0; j < rkStageX.size(); ++j)
+                    {
+                        errorX = errorX + (h * errorWeights[j]) * rkStageX[j].get(slot);
+                        errorV = errorV + (h * errorWeights[j]) * rkStageV[j].get(slot);
+                    }
+                    const Vector3D x0 = rkPos0.get(slot);
+                    const Vector3D x1 = pos.get(slot);
+                    const Vector3D v0 = rkVel0.get(slot);
+                    const Vector3D v1 = vel.get(slot);
+                    for (std::size_t i = 0; i < 3; ++i)
+                    {
+                        const decimal scaleX = absTolerance + relTolerance * std::max(std::abs(x0[i]),
+                                                                                      std::abs(x1[i]));
+                        const decimal scaleV = absTolerance + relTolerance * std::max(std::abs(v0[i]),
+                                                                                      std::abs(v1[i]));
+                        errors[slot]         = std::max({ errors[slot], std::abs(errorX[i]) / scaleX,
+                                                          std::abs(errorV[i]) / scaleV });
+                    }
+                }
+            });
+        const decimal error = n > 0 ? *std::max_element(errors.begin(), errors.end()) : 0_d;
+        frame.rewind(mark);
+
+        // Third-order method: the error scales as h^3; safety factor of 0.9
+        const decimal factor =
+            error > 0_d ? std::clamp(0.9_d * std::pow(error, -1_d / 3_d), 0.2_d, 5_d) : 5_d;
+        if (error <= 1_d || h <= minStep)
+        {
+            // A step shortened by a bound says nothing against the longer one
+            adaptiveStep = capped && !rejected ? std::max(adaptiveStep, h * factor) : h * factor;
+            denseStep    = h;
+            return h;
+        }
+        pos      = rkPos0;
+        vel      = rkVel0;
+        h        = std::max(h * factor, minStep);
+        rejected = true;
     }
+}
+/**
+ * @brief Inverse of a symmetric positive definite block.
+ *
+ * The block is first scaled to a trace of 3, so that the singularity test of `getInverse`, on the absolute
+ * value of the determinant, does not depend on the masses and stiffnesses of the system.
+ */
+static Matrix3x3 inverseDefinite(const Matrix3x3& block)
+{
+    const decimal scale = 3_d / block.getTrace();
+    return (block * scale).getInverse() * scale;
+}
+/**
+ * @brief Linearly implicit Euler over the state of all bodies: backward Euler with a single Newton step,
+ * solved island by island.
+ *
+ * With M the masses, F the forces of the start state and h the step, the velocity change of the bodies
+ * coupled by contact springs solves
+ *
+ *     (M + h·C + h²·K) Δv = h·(F - h·K·v),   then   v += Δv,   x += h·v,
+ *
+ * K and C being assembled from the 3×3 blocks k·I and c·nnᵀ of each candidate pair with a stiffness, k its
+ * stiffness, c its damping coefficient and n the direction between the centres. These are the blocks of a
+ * spring-damper restoring the distance between the bodies: the spring of the contact model acts along the
+ * vector between the centres, away from the other body, so they are not its exact Jacobian, with which a
+ * long step would pull the bodies into each other. The step is first-order with any such matrix (a
+ * W-method), and with this one the velocity change of a body in contact stays below F / (h·k) at any step,
+ * where an explicit step gives h·F / m. Friction is taken at the start of the step.
+ *
+ * Bodies in no such pair take a semi-implicit Euler step, as with the Euler solver. Islands share no dynamic
+ * body and are solved on the pool: exactly by block Gaussian elimination up to `maxDirectIsland` bodies,
+ * otherwise with the diagonal blocks only, each body being implicit in its own contacts while the other
+ * bodies are seen at the start of the step.
+ */
+void PhysicsWorld::integrateImplicitBodies(decimal dt)
+{
+    const std::vector<decimal>& mask = motionMasks();
+    const std::size_t           n    = bodies.size();
 
-    // If collision : object stops moving
+    resetAcc();
+    applyForces();
 
-    const size_t n = objects.size();
+    // Contact models of the pairs with a moving body, coupled when they have a stiffness
+    const std::size_t                      pairCount = pairs.size();
+    const std::span<Physics::ContactModel> models    = frame.allocate<Physics::ContactModel>(pairCount);
+    const std::span<std::uint8_t>          coupled   = frame.allocate<std::uint8_t>(pairCount, 0);
+    for (std::size_t k = 0; k < pairCount; ++k)
+    {
+        const std::size_t a = pairs[k].first;
+        const std::size_t b = pairs[k].second;
+        if (!isStepped(a) && !isStepped(b))
+            continue;
+        models[k] = Physics::computeContactModel(bodies.getMaterialPair(a, b), bodies.getColdData(a).mass,
+                                                 bodies.getColdData(b).mass);
+        coupled[k] = models[k].stiffness > 0_d ? 1 : 0;
+    }
+    islands.build(bodies, pairs, coupled.data());
 
-    for (size_t i = 0; i < n; ++i)
+    // Moving bodies of each island, in slot order
+    const std::size_t              islandCount = islands.size();
+    const std::span<std::size_t>   bodyStart   = frame.allocate<std::size_t>(islandCount + 1, 0);
+    const std::span<std::uint32_t> members     = frame.allocate<std::uint32_t>(n);
+    const std::span<std::uint32_t> local       = frame.allocate<std::uint32_t>(n, ContactIslands::none);
+    for (std::size_t slot = 0; slot < n; ++slot)
+    {
+        const std::uint32_t island = islands.getBodyIsland(slot);
+        if (island != ContactIslands::none && isStepped(slot))
+            ++bodyStart[island + 1];
+    }
+    for (std::size_t island = 0; island < islandCount; ++island)
+        bodyStart[island + 1] += bodyStart[island];
+    const std::span<std::size_t> cursor = frame.allocate<std::size_t>(islandCount);
+    std::copy(bodyStart.begin(), bodyStart.end() - 1, cursor.begin());
+    for (std::size_t slot = 0; slot < n; ++slot)
     {
-        Object* A = objects[i];
-        if (!A)
+        const std::uint32_t island = islands.getBodyIsland(slot);
+        if (island == ContactIslands::none || !isStepped(slot))
             continue;
+        const std::size_t index = cursor[island]++;
+        members[index]          = static_cast<std::uint32_t>(slot);
+        local[slot]             = static_cast<std::uint32_t>(index - bodyStart[island]);
+    }
+
+    // Velocity changes of the coupled bodies, as accelerations over their step
+    threadPool->parallelFor(0, islandCount, threadPool->grainFor(islandCount, 1),
+                            [&](std::size_t first, std::size_t last)
+                            {
+                                for (std::size_t island = first; island < last; ++island)
+                                {
+                                    const std::span<const std::uint32_t> bodiesOf(
+                                        members.data() + bodyStart[island],
+                                        bodyStart[island + 1] - bodyStart[island]);
+                                    if (!bodiesOf.empty())
+                                        solveImplicitIsland(bodiesOf, islands.getPairs(island), models,
+                                                            local, dt * mask[bodiesOf.front()]);
+                                }
+                            });
 
-        for (size_t j = i + 1; j < n; ++j)
+    forEachSlotChunk(
+        [&](std::size_t first, std::size_t last)
         {
-            Object* B = objects[j];
-            if (!B)
-                continue;
+            BatchIntegrators::euler(bodies.getPositions(), bodies.getVelocities(), bodies.getAccelerations(),
+                                    mask, dt, first, last);
+        });
+}
+/**
+ * @brief Assemble and solve the system of an island (see integrateImplicitBodies).
+ *
+ * Bodies of the pairs that are not moved at this step (fixed, asleep, or waiting for their multi-rate
+ * sub-step) keep their velocity: their blocks only add to the diagonal of the body they touch. The
+ * elimination keeps the inverses of its pivots in the diagonal blocks for the back substitution; blocks
+ * left at zero by the sparsity of the island are skipped.
+ */
+void PhysicsWorld::solveImplicitIsland(std::span<const std::uint32_t> members,
+                                       std::span<const std::size_t> islandPairs,
+                                       std::span<const Physics::ContactModel> models,
+                                       std::span<const std::uint32_t> local, decimal h)
+{
+    const Vector3DArray& pos    = bodies.getPositions();
+    const Vector3DArray& vel    = bodies.getVelocities();
+    Vector3DArray&       acc    = bodies.getAccelerations();
+    const std::size_t    count  = members.size();
+    const bool           direct = count <= maxDirectIsland;
 
-            // Broad phase
-            bool isCollidingBroad = A->checkCollision(*B);
+    // Dense blocks of the island, or its diagonal ones only
+    const FrameArena::Marker   mark   = frame.mark();
+    const std::span<Matrix3x3> blocks = frame.allocate<Matrix3x3>(direct ? count * count : count);
+    const std::span<Vector3D>  rhs    = frame.allocate<Vector3D>(count);
+    const auto                 block  = [&](std::size_t i, std::size_t j) -> Matrix3x3&
+    { return blocks[direct ? i * count + j : i]; };
 
-            // Narrow phase
-            if (isCollidingBroad)
+    // M Δv = h·F
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const decimal mass = bodies.getColdData(members[i]).mass;
+        block(i, i).setDiagonal(Vector3D(mass));
+        rhs[i] = (mass * h) * acc.get(members[i]);
+    }
+    // Pair blocks h·c·nnᵀ + h²·k·I, and the spring term -h²·k·(v_a - v_b) of the right-hand side
+    for (const std::size_t k : islandPairs)
+    {
+        const std::size_t            a     = pairs[k].first;
+        const std::size_t            b     = pairs[k].second;
+        const Physics::ContactModel& model = models[k];
+        const Vector3D               r     = pos.get(b) - pos.get(a);
+        const decimal                hk    = h * h * model.stiffness;
+        Matrix3x3                    coupling;
+        coupling.setDiagonal(Vector3D(hk));
+        if (model.damping != 0_d && !r.isNull())
+        {
+            const Vector3D normal = r.getNormalised();
+            coupling += (h * model.damping) * Matrix3x3(normal[0] * normal, normal[1] * normal,
+                                                         normal[2] * normal);
+        }
+        const Vector3D      spring = hk * (vel.get(a) - vel.get(b));
+        const std::uint32_t i      = local[a];
+        const std::uint32_t j      = local[b];
+        if (i != ContactIslands::none)
+        {
+            block(i, i) += coupling;
+            rhs[i]      -= spring;
+        }
+        if (j != ContactIslands::none)
+        {
+            block(j, j) += coupling;
+            rhs[j]      += spring;
+        }
+        if (direct && i != ContactIslands::none && j != ContactIslands::none)
+        {
+            block(i, j) -= coupling;
+            block(j, i) -= coupling;
+        }
+    }
+
+    if (direct)
+    {
+        // Forward elimination, then back substitution; `rhs` ends up holding Δv
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            block(j, j) = inverseDefinite(block(j, j));
+            for (std::size_t i = j + 1; i < count; ++i)
             {
-                Contact contact;
-                bool    isCollidindNarrow = A->computeCollision(*B, contact);
-                if (isCollidindNarrow)
+                if (block(i, j).isZero())
+                    continue;
+                const Matrix3x3 factor = block(i, j).matrixProduct(block(j, j));
+                for (std::size_t col = j + 1; col < count; ++col)
                 {
-                    A->setVelocity(Vector3D(0_d));
-                    A->setIsFixed(true);
-                    B->setVelocity(Vector3D(0_d));
-                    B->setIsFixed(true);
+                    if (!block(j, col).isZero())
+                        block(i, col) -= factor.matrixProduct(block(j, col));
                 }
+                rhs[i] -= factor.matrixVectorProduct(rhs[j]);
             }
         }
+        for (std::size_t j = count; j-- > 0;)
+        {
+            Vector3D sum = rhs[j];
+            for (std::size_t col = j + 1; col < count; ++col)
+            {
+                if (!block(j, col).isZero())
+                    sum -= block(j, col).matrixVectorProduct(rhs[col]);
+            }
+            rhs[j] = block(j, j).matrixVectorProduct(sum);
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            rhs[i] = inverseDefinite(block(i, i)).matrixVectorProduct(rhs[i]);
     }
+
+    for (std::size_t i = 0; i < count; ++i)
+        acc.set(members[i], rhs[i] / h);
+    frame.rewind(mark);
 }
-void PhysicsWorld::integrate()
+/**
+ * @brief Move every dynamic body over `dt` with the selected solver.
+ *
+ * The solver is chosen once for the whole pass, and every solver runs as SIMD kernels over the body
+ * arrays.
+ */
+void PhysicsWorld::integrateBodies(decimal dt)
+{
+    switch (solver)
+    {
+    case Solver::Euler:
+        forEachSlotChunk(
+            [&](std::size_t first, std::size_t last)
+            {
+                BatchIntegrators::euler(bodies.getPositions(), bodies.getVelocities(),
+                                        bodies.getAccelerations(), motionMasks(), dt, first, last);
+            });
+        break;
+    case Solver::Verlet:
+        integrateVerletBodies(dt);
+        break;
+    case Solver::RK4:
+        integrateRK4Bodies(dt);
+        break;
+    case Solver::Implicit:
+        integrateImplicitBodies(dt);
+        break;
+    case Solver::BS32:
+        for (decimal done = 0_d; dt - done > 1e-6_d * dt;)
+            done += integrateBS32Bodies(dt - done);
+        break;
+    case Solver::Unknown:
+        std::cout << "The following solver is not implemented : " << config.getSolver() << '\n';
+        std::cout << "Please use one of the following solver : Euler, Verlet, RK4, BS32, Implicit.\n";
+        break;
+    }
+}
+/**
+ * @brief One step of `integrate`: `timeStep` with the fixed-step solvers, a single adaptive step with BS32.
+ *
+ * Swept spheres are stopped at their first impact along the step (see advanceToImpacts).
+ */
+decimal PhysicsWorld::advanceBodies()
+{
+    saveSweepStarts();
+    decimal step = timeStep;
+    if (solver == Solver::BS32)
+        step = integrateBS32Bodies(std::numeric_limits<decimal>::infinity());
+    else
+    {
+        if (maxTimeLevel > 0)
+            integrateMultiRate();
+        else
+            integrateBodies(timeStep);
+        denseStep = 0_d;
+    }
+    advanceToImpacts();
+
+    lastStep = step;
+    simulationTime += static_cast<double>(step);
+    return step;
+}
+void PhysicsWorld::integrateWithoutCollisions()
 {
     if (!isRunning)
     {
@@ -348,43 +1655,60 @@ void PhysicsWorld::integrate()
     }
 
     setTimeStep(timeStep);
+    frame.reset();
 
     // Reset accelerations
-    for (auto* obj : objects)
-    {
-        if (!obj || obj->isFixed())
-            continue;
-        obj->setAcceleration(Vector3D(0_d));
-    }
+    resetAcc();
 
     // Compute gravity forces
     applyGravityForces();
 
-    // Integrate motion
-    for (auto* obj : objects)
+    // Integrate motion, stopping the swept spheres at their first impact
+    advanceBodies();
+
+    // If collision : object stops moving (contacts only depend on positions, which are not changed here)
+    updateBroadPhase();
+    computeContacts();
+    for (std::size_t k = 0; k < pairs.size(); ++k)
     {
-        if (!obj || obj->isFixed())
-            continue;
-        switch (solver)
-        {
-        case Solver::Euler:
-            integrateEuler(*obj, timeStep);
-            break;
-        case Solver::Verlet:
-            integrateVerlet(*obj, timeStep);
-            break;
-        case Solver::RK4:
-            integrateRK4(*obj, timeStep);
-            break;
-        case Solver::Unknown:
-            std::cout << "The following solver is not implemented : " << config.getSolver() << '\n';
-            std::cout << "Please use one of the following solver : Euler, Verlet, RK4.\n";
-            break;
+        Object* A = bodies.getObject(pairs[k].first);
+        Object* B = bodies.getObject(pairs[k].second);
+
+        if (contactFound[k])
+        {
+            A->setVelocity(Vector3D(0_d));
+            A->setIsFixed(true);
+            B->setVelocity(Vector3D(0_d));
+            B->setIsFixed(true);
         }
     }
+}
+void PhysicsWorld::integrate()
+{
+    if (!isRunning)
+    {
+        std::cout << "Simulation is not running. Run start() first.\n";
+        return;
+    }
+
+    setTimeStep(timeStep);
+    // Transient data of the previous step
+    frame.reset();
+
+    // Reset accelerations
+    resetAcc();
+
+    // Compute gravity forces
+    applyGravityForces();
+
+    // Integrate motion, stopping the swept spheres at their first impact
+    advanceBodies();
 
     // Collision resolution
     solveCollisions();
+
+    // Resting bodies
+    updateSleeping(lastStep);
 }
 
 void PhysicsWorld::run()
@@ -413,11 +1737,37 @@ void PhysicsWorld::run()
     initCSV("output/CSV");
     saveObjectsCSV();
 
+    // Paced or recorded at its own rate: stepped by the real-time driver
+    if (config.getRealTimeFactor() > 0_d || config.getOutputRate() > 0_d)
+    {
+        RealTimeDriver driver(*this);
+        driver.run(static_cast<decimal>(maxIter) * timeStep);
+        if (config.getVerbose())
+            driver.printReport(std::cout);
+        return;
+    }
+
     while (cpt < maxIter + 1 && getIsRunning())
     {
         const decimal time = static_cast<decimal>(cpt) * timeStep;
 
-        integrate();
+        // Event-driven: free flights are skipped in one jump, the last skipped step being saved
+        const std::size_t skipped = eventDriven ? fastForward(maxIter + 1 - cpt) : 0;
+        if (skipped > 0)
+        {
+            cpt += skipped;
+            saveMotionCSV(static_cast<decimal>(cpt - 1) * timeStep);
+            continue;
+        }
+
+        // Adaptive: as many steps as needed to pass `time`, the state at `time` being interpolated
+        if (solver == Solver::BS32)
+        {
+            while (getTime() < time && getIsRunning())
+                integrate();
+        }
+        else
+            integrate();
         saveMotionCSV(time);
 
         // Printing
@@ -425,9 +1775,9 @@ void PhysicsWorld::run()
         {
             if (cpt % 25 == 0)
             {
-                for (auto* obj : objects)
+                for (const Object* obj : bodies.getObjects())
                 {
-                    if (!obj->isFixed())
+                    if (obj && !obj->isFixed())
                         std::cout << std::left << std::setw(col_obj) << obj->getType() << std::setw(col_time)
                                   << std::fixed << std::setprecision(3) << time << std::setw(col_vec)
                                   << formatVector(obj->getPosition()) << std::setw(col_vec)
@@ -443,6 +1793,67 @@ void PhysicsWorld::run()
 // ============================================================================
 //  Object management
 // ============================================================================
+Object* PhysicsWorld::getObject(ObjectHandle handle) const
+{
+    switch (handle.type)
+    {
+    case ObjectType::Sphere:
+        return getObject<Sphere>(handle);
+    case ObjectType::AABB:
+        return getObject<AABB>(handle);
+    case ObjectType::Plane:
+        return getObject<Plane>(handle);
+    case ObjectType::Generic:
+        break;
+    }
+    return nullptr;
+}
+void PhysicsWorld::destroyOwned(Object* obj)
+{
+    switch (obj->getType())
+    {
+    case ObjectType::Sphere:
+        spheres.destroy(spheres.indexOf(obj));
+        break;
+    case ObjectType::AABB:
+        boxes.destroy(boxes.indexOf(obj));
+        break;
+    case ObjectType::Plane:
+        planes.destroy(planes.indexOf(obj));
+        break;
+    case ObjectType::Generic:
+        break;
+    }
+}
+/**
+ * @brief Swap-and-pop removal: the body of the last index moves to the index of `obj`.
+ *
+ * Its motion file follows it, so that every Object keeps writing to its own file.
+ */
+void PhysicsWorld::removeObject(Object* obj)
+{
+    if (!obj || !bodies.contains(*obj))
+        return;
+
+    const std::size_t last = bodies.size() - 1;
+    const std::size_t slot = bodies.remove(*obj);
+    if (motionFiles.size() == last + 1)
+    {
+        if (slot != last)
+            std::swap(motionFiles[slot], motionFiles[last]);
+        motionFiles.pop_back();
+    }
+    destroyOwned(obj);
+}
+void PhysicsWorld::clearObjects()
+{
+    bodies.clear();
+    pairs.clear();
+    contactSolver.clearCache();
+    spheres.clear();
+    boxes.clear();
+    planes.clear();
+}
 
 // ============================================================================
 //  Print & Save
@@ -454,15 +1865,29 @@ void PhysicsWorld::printState() const
     std::cout << "  TimeStep: " << timeStep << " s\n";
     std::cout << "  Gravity: " << gravityCst << " m/s²\n";
     std::cout << "  Solver: " << solver << "\n";
-    std::cout << "  Objects: " << objects.size() << "\n";
+    std::cout << "  Threads: " << threadPool->getThreadCount() << (deterministic ? " (deterministic)" : "")
+              << "\n";
+    std::cout << "  Contact solver: " << contactSolverType;
+    if (contactSolverType == ContactSolverType::SequentialImpulse)
+        std::cout << " (" << contactSolver.getVelocityIterations() << " velocity / "
+                  << contactSolver.getPositionIterations() << " position iterations, "
+                  << contactSolver.getCachedContactCount() << " cached contacts)";
+    std::cout << "\n";
+    std::cout << "  Broad phase: " << broadPhaseType << " (" << pairs.size() << " candidate pairs)\n";
+    broadPhase->printStats(std::cout);
+    const PairCache& pairCache = narrowPhase.getPairCache();
+    std::cout << "  Narrow phase: " << pairCache.getEntryCount() << " candidate pairs apart, "
+              << pairCache.getSkippedCount() << " tests skipped\n";
+    std::cout << "  Objects: " << bodies.size() << " (" << getAwakeCount() << " awake, " << getSleepingCount()
+              << " sleeping)\n";
 
     // Print each object's state
-    for (size_t i = 0; i < objects.size(); ++i)
+    for (size_t i = 0; i < bodies.size(); ++i)
     {
-        if (objects[i])
+        if (bodies.getObject(i))
         {
-            std::cout << "  Object " << i << ": pos=" << objects[i]->getPosition()
-                      << ", vel=" << objects[i]->getVelocity() << "\n";
+            std::cout << "  Object " << i << ": pos=" << bodies.getPositions().get(i)
+                      << ", vel=" << bodies.getVelocities().get(i) << "\n";
         }
     }
 }
@@ -491,36 +1916,97 @@ void PhysicsWorld::initCSV(const std::string& directory)
 
     // Motion CSV
     motionFiles.clear();
-    for (std::size_t idx = 0; idx < objects.size(); ++idx)
+    for (std::size_t idx = 0; idx < bodies.size(); ++idx)
     {
-        Object* obj = objects[idx];
-
-        // if (obj->getIsFixed())
-        //     continue;
-
         std::string   filepath = directory + "/motion_object_" + std::to_string(idx) + ".csv";
         std::ofstream file(filepath);
 
-        obj->initMotionCSV(file);
-        motionFiles.emplace_back(obj, std::move(file));
+        if (Object* obj = bodies.getObject(idx))
+            obj->initMotionCSV(file);
+        motionFiles.push_back(std::move(file));
     }
 }
 void PhysicsWorld::saveObjectsCSV()
 {
-    for (std::size_t idx = 0; idx < objects.size(); ++idx)
+    const Vector3DArray& pos = bodies.getPositions();
+    for (std::size_t idx = 0; idx < bodies.size(); ++idx)
     {
-        objects[idx]->saveObjectCSV(objectFile);
+        if (!bodies.getObject(idx))
+            continue;
+
+        const ObjectColdData& cold  = bodies.getColdData(idx);
+        const bool            fixed = (bodies.getFlags()[idx] & BodyStorage::flagFixed) != 0;
+        objectFile << cold.id << "," << cold.name << "," << bodies.getType(idx) << "," << cold.mass << ","
+                   << pos.x[idx] << "," << pos.y[idx] << "," << pos.z[idx] << "," << cold.size.getX() << ","
+                   << cold.size.getY() << "," << cold.size.getZ() << "," << cold.rotation.getX() << ","
+                   << cold.rotation.getY() << "," << cold.rotation.getZ() << "," << fixed << "\n";
     }
     objectFile.close();
-    objectFile.close();
+}
+void PhysicsWorld::saveMotionCSV(decimal time, const Vector3DArray& positions,
+                                 const Vector3DArray& velocities)
+{
+    if (!config.getSave())
+        return;
+
+    const Vector3DArray& acc = bodies.getAccelerations();
+    const std::size_t    n   = std::min({ motionFiles.size(), bodies.size(), positions.size() });
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (bodies.getObject(i))
+            writeMotionRow(i, time, positions.get(i), velocities.get(i), acc.get(i));
+    }
+}
+void PhysicsWorld::writeMotionRow(std::size_t slot, decimal time, const Vector3D& position,
+                                  const Vector3D& velocity, const Vector3D& acceleration)
+{
+    motionFiles[slot] << time << "," << position.getX() << "," << position.getY() << "," << position.getZ()
+                      << "," << velocity.getX() << "," << velocity.getY() << "," << velocity.getZ() << ","
+                      << acceleration.getX() << "," << acceleration.getY() << "," << acceleration.getZ()
+                      << "\n";
 }
 void PhysicsWorld::saveMotionCSV(decimal time)
 {
     if (!config.getSave())
         return;
 
-    for (auto& [obj, file] : motionFiles)
+    const Vector3DArray& pos = bodies.getPositions();
+    const Vector3DArray& vel = bodies.getVelocities();
+    const Vector3DArray& acc = bodies.getAccelerations();
+    const std::size_t    n   = std::min(motionFiles.size(), bodies.size());
+
+    // Dense output of the last BS32 step: cubic Hermite interpolation between its ends, written with the
+    // stage derivatives (the end state is the start state plus the weighted stages)
+    const double start = simulationTime - static_cast<double>(denseStep);
+    const bool   dense = denseStep > 0_d && time >= start && time < simulationTime && rkPos0.size() == n;
+    const decimal theta = dense ? static_cast<decimal>((time - start) / static_cast<double>(denseStep)) : 1_d;
+    const decimal h01   = theta * theta * (3_d - 2_d * theta);
+    const decimal h10   = theta * (1_d - theta) * (1_d - theta);
+    const decimal h11   = theta * theta * (theta - 1_d);
+    const std::array<decimal, 4> weights { h10 + 2_d / 9_d * h01, h01 / 3_d, 4_d / 9_d * h01, h11 };
+
+    for (std::size_t i = 0; i < n; ++i)
     {
-        obj->saveMotionCSV(file, time);
+        if (!bodies.getObject(i))
+            continue;
+
+        Vector3D position     = pos.get(i);
+        Vector3D velocity     = vel.get(i);
+        Vector3D acceleration = acc.get(i);
+        if (dense)
+        {
+            Vector3D dx(0_d);
+            Vector3D dv(0_d);
+            for (std::size_t j = 0; j < weights.size(); ++j)
+            {
+                dx = dx + weights[j] * rkStageX[j].get(i);
+                dv = dv + weights[j] * rkStageV[j].get(i);
+            }
+            const decimal scale = bodies.getMotionMasks()[i] * denseStep;
+            position            = rkPos0.get(i) + scale * dx;
+            velocity            = rkVel0.get(i) + scale * dv;
+            acceleration        = (1_d - theta) * rkStageV[0].get(i) + theta * rkStageV[3].get(i);
+        }
+        writeMotionRow(i, time, position, velocity, acceleration);
     }
 }
@@ -0,0 +1,237 @@
+#include "world/realtime_driver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+
+// ============================================================================
+//  Constructors
+// ============================================================================
+RealTimeDriver::RealTimeDriver(PhysicsWorld& _world)
+    : world(_world)
+    , realTimeFactor(_world.getConfig().getRealTimeFactor())
+    , outputRate(_world.getConfig().getOutputRate())
+    , currentTime(static_cast<double>(_world.getTime()))
+{
+    previousTime = currentTime;
+    setOutputRate(outputRate);
+}
+
+// ============================================================================
+//  Getters / Setters
+// ============================================================================
+void RealTimeDriver::setRealTimeFactor(decimal factor)
+{
+    if (factor < 0_d)
+        throw std::invalid_argument("Real-time factor cannot be negative");
+    realTimeFactor = factor;
+}
+void RealTimeDriver::setOutputRate(decimal rate)
+{
+    if (rate < 0_d)
+        throw std::invalid_argument("Output rate cannot be negative");
+    outputRate = rate;
+
+    // First record at or after the current time
+    const double slack = 1e-6 * static_cast<double>(world.getTimeStep());
+    nextRecord         = rate > 0_d ? std::llround(std::ceil((currentTime - slack) * rate)) : 0;
+}
+decimal RealTimeDriver::getAlpha() const
+{
+    return static_cast<decimal>(accumulator / static_cast<double>(world.getTimeStep()));
+}
+
+// ============================================================================
+//  Stepping
+// ============================================================================
+/**
+ * @brief Step `k` starts at `origin + (t_k - t_0) / realTimeFactor` on the wall clock, `t_k` being its
+ * simulated start: the schedule follows the simulated time, so that steps of the adaptive solver are paced
+ * by their length. The thread sleeps until shortly before the start, then spins, since a sleep may overrun
+ * its deadline by the scheduler quantum.
+ */
+void RealTimeDriver::run(decimal duration)
+{
+    const double timeStep = static_cast<double>(world.getTimeStep());
+    const double end      = currentTime + static_cast<double>(duration);
+    const double slack    = 1e-3 * timeStep; // steps of `timeStep` in float do not add up to `end` exactly
+    const bool   paced    = realTimeFactor > 0_d;
+    const double factor   = static_cast<double>(realTimeFactor);
+
+    // Wall-clock time of a simulated time on the schedule
+    Clock::time_point origin     = Clock::now();
+    const double      originTime = currentTime;
+    const auto        wallTime   = [&](double time)
+    {
+        const std::chrono::duration<double> offset((time - originTime) / factor);
+        return origin + std::chrono::duration_cast<Clock::duration>(offset);
+    };
+    // Lag beyond which the schedule is shifted
+    const double lagLimit = paced ? static_cast<double>(maxCatchUpSteps) * timeStep / factor : 0.0;
+    const Clock::duration maxLag =
+        std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(lagLimit));
+
+    // State at the start of the run
+    previousPos  = world.getBodies().getPositions();
+    previousVel  = world.getBodies().getVelocities();
+    previousTime = currentTime;
+    if (outputRate > 0_d)
+        recordDue();
+
+    while (end - currentTime > slack && world.getIsRunning())
+    {
+        if (paced)
+        {
+            Clock::time_point start = wallTime(currentTime);
+            Clock::time_point now   = Clock::now();
+            if (now < start)
+            {
+                waitUntil(start);
+                now = Clock::now();
+            }
+            else if (now - start > maxLag)
+            {
+                // Too far behind to catch up: give up the lag and restart the schedule from now
+                droppedTime += std::chrono::duration<double>(now - start).count() * factor;
+                origin += now - start;
+                start = now;
+            }
+            startJitter.record(std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count());
+        }
+
+        step();
+
+        if (paced && Clock::now() > wallTime(currentTime))
+            ++deadlineMisses;
+    }
+}
+std::size_t RealTimeDriver::advance(double frameTime)
+{
+    if (realTimeFactor <= 0_d)
+    {
+        step();
+        return 1;
+    }
+
+    const double timeStep = static_cast<double>(world.getTimeStep());
+    const double maxLag   = static_cast<double>(maxCatchUpSteps) * timeStep;
+    accumulator += frameTime * static_cast<double>(realTimeFactor);
+    if (accumulator > maxLag)
+    {
+        droppedTime += accumulator - maxLag;
+        accumulator = maxLag;
+    }
+
+    std::size_t steps = 0;
+    while (accumulator >= timeStep && world.getIsRunning())
+    {
+        step();
+        accumulator -= static_cast<double>(world.getLastStep());
+        ++steps;
+    }
+    return steps;
+}
+void RealTimeDriver::step()
+{
+    previousPos  = world.getBodies().getPositions();
+    previousVel  = world.getBodies().getVelocities();
+    previousTime = currentTime;
+
+    Timer timer;
+    world.integrate();
+    stepLatency.record(timer.elapsedNanoseconds());
+
+    currentTime += static_cast<double>(world.getLastStep());
+    ++stepCount;
+    recordDue();
+}
+void RealTimeDriver::waitUntil(Clock::time_point deadline) const
+{
+    if (deadline - Clock::now() > spinMargin)
+        std::this_thread::sleep_until(deadline - spinMargin);
+    while (Clock::now() < deadline)
+        std::this_thread::yield();
+}
+
+// ============================================================================
+//  Recording
+// ============================================================================
+/**
+ * @brief Without an output rate, the end of the step is recorded. Otherwise every record time within the
+ * step is: at its end the state of the world, inside it the dense output of BS32 or the linear interpolation
+ * of the other solvers.
+ */
+void RealTimeDriver::recordDue()
+{
+    if (outputRate <= 0_d)
+    {
+        world.saveMotionCSV(static_cast<decimal>(currentTime));
+        lastRecord = currentTime;
+        ++recordCount;
+        return;
+    }
+
+    const double rate   = static_cast<double>(outputRate);
+    const double slack  = 1e-6 * static_cast<double>(world.getTimeStep());
+    const double length = currentTime - previousTime;
+    const bool   save   = world.getConfig().getSave();
+    while (static_cast<double>(nextRecord) / rate <= currentTime + slack)
+    {
+        const double  time  = static_cast<double>(nextRecord) / rate;
+        const decimal alpha = length > 0.0 ? static_cast<decimal>((time - previousTime) / length) : 1_d;
+        if (save && (alpha >= 1_d || world.getSolver() == Solver::BS32))
+            world.saveMotionCSV(static_cast<decimal>(time));
+        else if (save)
+        {
+            interpolate(alpha, recordPos, recordVel);
+            world.saveMotionCSV(static_cast<decimal>(time), recordPos, recordVel);
+        }
+        lastRecord = time;
+        ++recordCount;
+        ++nextRecord;
+    }
+}
+void RealTimeDriver::interpolate(decimal alpha, Vector3DArray& positions, Vector3DArray& velocities) const
+{
+    const Vector3DArray& pos = world.getBodies().getPositions();
+    const Vector3DArray& vel = world.getBodies().getVelocities();
+    positions                = pos;
+    velocities               = vel;
+
+    // Bodies added since the start of the step have no previous state: they are taken at the end
+    const std::size_t n = std::min(pos.size(), previousPos.size());
+    const decimal     a = std::clamp(alpha, 0_d, 1_d);
+    const decimal     b = 1_d - a;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        positions.x[i]  = b * previousPos.x[i] + a * pos.x[i];
+        positions.y[i]  = b * previousPos.y[i] + a * pos.y[i];
+        positions.z[i]  = b * previousPos.z[i] + a * pos.z[i];
+        velocities.x[i] = b * previousVel.x[i] + a * vel.x[i];
+        velocities.y[i] = b * previousVel.y[i] + a * vel.y[i];
+        velocities.z[i] = b * previousVel.z[i] + a * vel.z[i];
+    }
+}
+
+// ============================================================================
+//  Report
+// ============================================================================
+void RealTimeDriver::printReport(std::ostream& out) const
+{
+    const auto line = [&](const char* name, const LatencyHistogram& histogram)
+    {
+        out << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(1)
+            << "mean " << std::setw(9) << histogram.getMean() / 1e3_d << "  p99 " << std::setw(9)
+            << static_cast<double>(histogram.getPercentile(0.99_d)) / 1e3 << "  max " << std::setw(9)
+            << static_cast<double>(histogram.getMax()) / 1e3 << "  (us)\n";
+    };
+
+    out << "Steps: " << stepCount << ", records: " << recordCount << ", deadline misses: " << deadlineMisses
+        << ", dropped time: " << droppedTime << " s\n";
+    line("Step latency", stepLatency);
+    if (startJitter.getCount() > 0)
+        line("Start jitter", startJitter);
+}
@@ -0,0 +1,24 @@
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Debug hook: the replaceable global operator new counts every allocation, then forwards to malloc. Nothrow
+// forms call it too; over-aligned ones are not counted.
+static std::atomic<std::size_t> allocationCount { 0 };
+
+std::size_t getAllocationCount() { return allocationCount.load(std::memory_order_relaxed); }
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size > 0 ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void  operator delete(void* memory) noexcept { std::free(memory); }
+void  operator delete[](void* memory) noexcept { std::free(memory); }
+void  operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void  operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstddef>
+
+// Number of calls to the global operator new since the start of the test program, all threads together.
+// Only counted in the test executables linking allocation_counter.cpp, which replaces operator new/delete.
+std::size_t getAllocationCount();
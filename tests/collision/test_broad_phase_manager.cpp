@@ -0,0 +1,192 @@
+#include "collision/broad_phase.hpp"
+#include "collision/broad_phase_manager.hpp"
+#include "objects/plane.hpp"
+#include "objects/sphere.hpp"
+#include "test_functions.hpp"
+#include "world/physicsWorld.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+struct Scene
+{
+    std::vector<std::unique_ptr<Object>> storage;
+    std::vector<Object*>                 objects;
+
+    void add(std::unique_ptr<Object> obj)
+    {
+        objects.push_back(obj.get());
+        storage.push_back(std::move(obj));
+    }
+
+    /// `count` spheres of diameter in [minSize, maxSize] in a cube of half-size `extent`.
+    void addSpheres(int count, decimal minSize, decimal maxSize, decimal extent, unsigned seed)
+    {
+        std::mt19937                            rng(seed);
+        std::uniform_real_distribution<decimal> pos(-extent, extent);
+        std::uniform_real_distribution<decimal> size(minSize, maxSize);
+        for (int i = 0; i < count; ++i)
+            add(std::make_unique<Sphere>(Vector3D(pos(rng), pos(rng), pos(rng)), size(rng), 1_d));
+    }
+
+    std::vector<CollisionPair> referencePairs() const
+    {
+        BruteForceBroadPhase       reference;
+        std::vector<CollisionPair> pairs;
+        reference.computePairs(objects, pairs);
+        std::erase_if(pairs,
+                      [&](const CollisionPair& p)
+                      {
+                          return !objects[p.first]->getBoundingBox().getFattened(PRECISION_MACHINE).overlaps(
+                              objects[p.second]->getBoundingBox().getFattened(PRECISION_MACHINE));
+                      });
+        return pairs;
+    }
+};
+
+// ============================================================================
+//  Decision rule
+// ============================================================================
+TEST(BroadPhaseManagerTest, ChooseRules)
+{
+    BroadPhaseStats stats;
+    std::string     reason;
+
+    stats.objectCount = 10;
+    EXPECT_EQ(BroadPhaseManager::choose(stats, &reason), BroadPhaseType::BruteForce);
+    EXPECT_NE(reason.find("BruteForce"), std::string::npos);
+
+    stats.objectCount = 200;
+    EXPECT_EQ(BroadPhaseManager::choose(stats), BroadPhaseType::SweepAndPrune);
+
+    stats.objectCount = 5000;
+    EXPECT_EQ(BroadPhaseManager::choose(stats), BroadPhaseType::UniformGrid);
+
+    stats.sizeVariation = 2_d;
+    EXPECT_EQ(BroadPhaseManager::choose(stats), BroadPhaseType::BVH);
+
+    stats.sizeVariation = 0.1_d;
+    stats.fixedFraction = 0.9_d;
+    EXPECT_EQ(BroadPhaseManager::choose(stats), BroadPhaseType::BVH);
+
+    // Measured pair tests cheap enough to test all pairs
+    stats.objectCount     = 100;
+    stats.fixedFraction   = 0_d;
+    stats.pairTestCost    = 1_d;
+    stats.spatialStepCost = 1e6_d;
+    EXPECT_EQ(BroadPhaseManager::choose(stats), BroadPhaseType::BruteForce);
+}
+
+// ============================================================================
+//  Runtime switching
+// ============================================================================
+TEST(BroadPhaseManagerTest, SwitchesToSuitedAlgorithm)
+{
+    Scene dense;
+    dense.addSpheres(600, 0.9_d, 1.1_d, 8_d, 1);
+    Scene uneven;
+    uneven.addSpheres(100, 0.2_d, 0.3_d, 20_d, 2);
+    uneven.addSpheres(5, 30_d, 40_d, 20_d, 3);
+    Scene tiny;
+    tiny.addSpheres(8, 1_d, 1_d, 2_d, 4);
+
+    struct Case
+    {
+        Scene*         scene;
+        BroadPhaseType expected;
+    };
+    for (const Case& c : { Case { &dense, BroadPhaseType::UniformGrid },
+                           Case { &uneven, BroadPhaseType::BVH },
+                           Case { &tiny, BroadPhaseType::BruteForce } })
+    {
+        BroadPhaseManager          manager(1);
+        std::vector<CollisionPair> pairs;
+        manager.computePairs(c.scene->objects, pairs);
+        EXPECT_EQ(manager.getActiveType(), c.expected) << manager.getDecision();
+        EXPECT_EQ(manager.getSwitchCount(), 1u);
+        EXPECT_EQ(pairs, c.scene->referencePairs());
+    }
+}
+
+TEST(BroadPhaseManagerTest, KeepsPairsAcrossSwitches)
+{
+    // Start as a tiny scene, then grow: the active algorithm changes but pairs stay exact
+    Scene scene;
+    scene.addSpheres(20, 0.9_d, 1.1_d, 3_d, 5);
+
+    BroadPhaseManager          manager(2);
+    std::vector<CollisionPair> pairs;
+    manager.computePairs(scene.objects, pairs);
+    EXPECT_EQ(manager.getActiveType(), BroadPhaseType::BruteForce);
+    EXPECT_EQ(pairs, scene.referencePairs());
+
+    scene.addSpheres(200, 0.9_d, 1.1_d, 6_d, 6);
+    manager.reset();
+    std::uniform_real_distribution<decimal> step(-0.05_d, 0.05_d);
+    std::mt19937                            rng(7);
+    for (int i = 0; i < 6; ++i)
+    {
+        for (Object* obj : scene.objects)
+            obj->setPosition(obj->getPosition() + Vector3D(step(rng), step(rng), step(rng)));
+        manager.computePairs(scene.objects, pairs);
+        ASSERT_EQ(pairs, scene.referencePairs());
+    }
+    EXPECT_NE(manager.getActiveType(), BroadPhaseType::Auto);
+    EXPECT_GT(manager.getTiming(manager.getActiveType()), 0_d);
+    EXPECT_EQ(manager.getStats().objectCount, 220u);
+
+    std::ostringstream os;
+    manager.printStats(os);
+    EXPECT_NE(os.str().find("Active:"), std::string::npos);
+    EXPECT_NE(os.str().find("Decision:"), std::string::npos);
+    EXPECT_NE(os.str().find("Timings:"), std::string::npos);
+}
+
+TEST(BroadPhaseManagerTest, SelectedFromWorld)
+{
+    PhysicsWorld world;
+    world.setBroadPhase("Auto");
+    EXPECT_EQ(world.getBroadPhaseType(), BroadPhaseType::Auto);
+
+    Sphere a(Vector3D(0_d), 1_d);
+    Sphere b(Vector3D(0.5_d, 0_d, 0_d), 1_d);
+    world.addObject(&a);
+    world.addObject(&b);
+    world.updateBroadPhase();
+    EXPECT_EQ(world.getCandidatePairs().size(), 1u);
+    world.clearObjects();
+}
+
+// ============================================================================
+//  Thread pool
+// ============================================================================
+TEST(BroadPhaseManagerTest, PairsDoNotDependOnThreadPool)
+{
+    Scene scene;
+    scene.addSpheres(1500, 0.5_d, 2_d, 12_d, 11);
+    ThreadPool pool(4);
+
+    for (const BroadPhaseType type : { BroadPhaseType::BruteForce, BroadPhaseType::SweepAndPrune,
+                                       BroadPhaseType::UniformGrid, BroadPhaseType::BVH,
+                                       BroadPhaseType::Auto })
+    {
+        std::unique_ptr<BroadPhase> serial   = makeBroadPhase(type);
+        std::unique_ptr<BroadPhase> parallel = makeBroadPhase(type);
+        parallel->setThreadPool(&pool);
+
+        std::vector<CollisionPair> expected;
+        std::vector<CollisionPair> pairs;
+        for (int step = 0; step < 2; ++step)
+        {
+            serial->computePairs(scene.objects, expected);
+            parallel->computePairs(scene.objects, pairs);
+            ASSERT_EQ(pairs, expected) << type;
+        }
+    }
+}
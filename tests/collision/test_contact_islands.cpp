@@ -0,0 +1,102 @@
+#include "collision/contact_islands.hpp"
+#include "objects/plane.hpp"
+#include "objects/sphere.hpp"
+#include "world/physicsWorld.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+static std::vector<std::size_t> pairsOf(const ContactIslands& islands, std::size_t island)
+{
+    const auto span = islands.getPairs(island);
+    return { span.begin(), span.end() };
+}
+
+// ============================================================================
+//  Construction
+// ============================================================================
+TEST(ContactIslandsTest, FixedBodiesDoNotMergeIslands)
+{
+    // Slots: 0 ground, 1-2 first stack, 3-4 second stack
+    BodyStorage storage;
+    Plane       ground(Vector3D(0_d), Vector3D(10_d, 10_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    Sphere      a(Vector3D(0_d, 0_d, 1_d), 1_d, 1_d);
+    Sphere      b(Vector3D(0_d, 0_d, 3_d), 1_d, 1_d);
+    Sphere      c(Vector3D(5_d, 0_d, 1_d), 1_d, 1_d);
+    Sphere      d(Vector3D(5_d, 0_d, 3_d), 1_d, 1_d);
+    for (Object* obj : std::vector<Object*> { &ground, &a, &b, &c, &d })
+        storage.add(*obj);
+
+    const std::vector<CollisionPair> pairs { { 0, 1 }, { 0, 3 }, { 1, 2 }, { 3, 4 } };
+    ContactIslands                   islands;
+    islands.build(storage, pairs);
+
+    ASSERT_EQ(islands.size(), 2u);
+    EXPECT_EQ(pairsOf(islands, 0), (std::vector<std::size_t> { 0, 2 }));
+    EXPECT_EQ(pairsOf(islands, 1), (std::vector<std::size_t> { 1, 3 }));
+}
+
+TEST(ContactIslandsTest, ChainsMergeAndMaskSelectsContacts)
+{
+    BodyStorage                          storage;
+    std::vector<std::unique_ptr<Sphere>> spheres;
+    for (int i = 0; i < 6; ++i)
+    {
+        spheres.push_back(std::make_unique<Sphere>(Vector3D(static_cast<decimal>(i)), 1_d, 1_d));
+        storage.add(*spheres.back());
+    }
+    spheres[5]->setIsFixed(true);
+
+    // 0-1-2-3 chain; 4 with the fixed 5; the last pair has no dynamic body
+    const std::vector<CollisionPair> pairs { { 2, 3 }, { 0, 1 }, { 1, 2 }, { 4, 5 } };
+    ContactIslands                   islands;
+    islands.build(storage, pairs);
+    ASSERT_EQ(islands.size(), 2u);
+    EXPECT_EQ(pairsOf(islands, 0), (std::vector<std::size_t> { 0, 1, 2 }));
+    EXPECT_EQ(pairsOf(islands, 1), (std::vector<std::size_t> { 3 }));
+
+    // Without the middle contact, the chain splits
+    const std::vector<std::uint8_t> contacts { 1, 1, 0, 0 };
+    islands.build(storage, pairs, contacts.data());
+    ASSERT_EQ(islands.size(), 2u);
+    EXPECT_EQ(pairsOf(islands, 0), (std::vector<std::size_t> { 0 }));
+    EXPECT_EQ(pairsOf(islands, 1), (std::vector<std::size_t> { 1 }));
+
+    spheres[4]->setIsFixed(true);
+    islands.build(storage, { { 4, 5 } });
+    EXPECT_EQ(islands.size(), 0u);
+}
+
+// ============================================================================
+//  World
+// ============================================================================
+TEST(ContactIslandsTest, WorldSolvesSeparatePilesAsIslands)
+{
+    PhysicsWorld world;
+    world.setThreadCount(2);
+    world.setGravityAcc(Vector3D(0_d, 0_d, -9.81_d));
+
+    Plane ground(Vector3D(0_d), Vector3D(100_d, 100_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    world.addObject(&ground);
+    std::vector<std::unique_ptr<Sphere>> spheres;
+    for (int pile = 0; pile < 3; ++pile)
+    {
+        for (int level = 0; level < 3; ++level)
+        {
+            const Vector3D position(10_d * pile, 0_d, 0.45_d + 0.9_d * level);
+            spheres.push_back(std::make_unique<Sphere>(position, 1_d, Vector3D(0_d, 0_d, -1_d), 1_d));
+            world.addObject(spheres.back().get());
+        }
+    }
+
+    world.start();
+    world.integrate();
+    EXPECT_EQ(world.getIslands().size(), 3u);
+
+    world.clearObjects();
+    world.setThreadCount(1);
+}
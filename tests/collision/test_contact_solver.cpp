@@ -0,0 +1,180 @@
+#include "collision/contact_solver.hpp"
+#include "objects/aabb.hpp"
+#include "objects/plane.hpp"
+#include "objects/sphere.hpp"
+#include "world/physicsWorld.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+/// Largest drift from the initial positions of a stack of unit spheres or boxes, after `duration` seconds.
+static decimal stackDrift(const std::string& contactSolver, ObjectType type, decimal timeStep,
+                          decimal duration, std::size_t height = 6)
+{
+    PhysicsWorld world;
+    world.setSolver("Euler");
+    world.setContactSolver(contactSolver);
+    world.setTimeStep(timeStep);
+
+    Plane ground(Vector3D(0_d), Vector3D(20_d, 20_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    world.addObject(&ground);
+    std::vector<std::unique_ptr<Object>> stack;
+    std::vector<Vector3D>                start;
+    for (std::size_t i = 0; i < height; ++i)
+    {
+        const Vector3D position(0_d, 0_d, 0.5_d + static_cast<decimal>(i));
+        if (type == ObjectType::Sphere)
+            stack.push_back(std::make_unique<Sphere>(position, 1_d, 1_d));
+        else
+            stack.push_back(std::make_unique<AABB>(position, Vector3D(1_d), 1_d));
+        world.addObject(stack.back().get());
+        start.push_back(position);
+    }
+
+    world.start();
+    const auto steps = static_cast<int>(std::round(duration / timeStep));
+    for (int step = 0; step < steps; ++step)
+        world.integrate();
+
+    decimal drift = 0_d;
+    for (std::size_t i = 0; i < height; ++i)
+        drift = std::max(drift, (stack[i]->getPosition() - start[i]).getNorm());
+    world.clearObjects();
+    world.setContactSolver("Rebound");
+    return drift;
+}
+
+/// Running world with the sequential-impulse solver and a ground plane.
+struct BounceScene
+{
+    PhysicsWorld world;
+    Plane        ground { Vector3D(0_d), Vector3D(20_d, 20_d, 0_d), Vector3D(0_d, 0_d, 1_d) };
+
+    BounceScene()
+    {
+        world.setSolver("Euler");
+        world.setContactSolver("SequentialImpulse");
+        world.setTimeStep(0.01_d);
+        world.addObject(&ground);
+        world.start();
+    }
+    ~BounceScene()
+    {
+        world.clearObjects();
+        world.setContactSolver("Rebound");
+    }
+};
+
+// ============================================================================
+//  Stacks
+// ============================================================================
+TEST(ContactSolverTest, StacksStayAtEightTimesTheTimeStep)
+{
+    // Rebound impulses already let a stack sink at the default step, and blow it up at 4x
+    const decimal reference = stackDrift("Rebound", ObjectType::Sphere, 0.01_d, 5_d);
+    EXPECT_GT(stackDrift("Rebound", ObjectType::Sphere, 0.04_d, 5_d), 1_d);
+
+    for (const ObjectType type : { ObjectType::Sphere, ObjectType::AABB })
+    {
+        const decimal drift = stackDrift("SequentialImpulse", type, 0.08_d, 5_d);
+        EXPECT_LT(drift, 0.1_d) << type;
+        EXPECT_LT(drift, reference) << type;
+    }
+}
+
+TEST(ContactSolverTest, ImpulsesOfPersistentContactsAreCached)
+{
+    BounceScene scene;
+    Sphere      bottom(Vector3D(0_d, 0_d, 0.5_d), 1_d, 1_d);
+    Sphere      top(Vector3D(0_d, 0_d, 1.5_d), 1_d, 1_d);
+    scene.world.addObject(&bottom);
+    scene.world.addObject(&top);
+
+    scene.world.integrate();
+    EXPECT_EQ(scene.world.getContactSolver().getCachedContactCount(), 2u);
+
+    // The contact with the top sphere ends: its impulse is forgotten
+    top.setPosition(Vector3D(5_d, 0_d, 5_d));
+    scene.world.integrate();
+    EXPECT_EQ(scene.world.getContactSolver().getCachedContactCount(), 1u);
+    scene.world.clearObjects();
+    EXPECT_EQ(scene.world.getContactSolver().getCachedContactCount(), 0u);
+}
+
+// ============================================================================
+//  Contact response
+// ============================================================================
+TEST(ContactSolverTest, FastContactsBounceAndSlowOnesRest)
+{
+    BounceScene scene;
+    Sphere      fast(Vector3D(0_d, 0_d, 0.52_d), 1_d, Vector3D(0_d, 0_d, -5_d), 1_d);
+    Sphere      slow(Vector3D(5_d, 0_d, 0.5_d), 1_d, 1_d);
+    scene.world.addObject(&fast);
+    scene.world.addObject(&slow);
+
+    scene.world.integrate();
+    // Restitution 0.5 of the default material
+    EXPECT_NEAR(fast.getVelocity()[2], 2.5_d, 0.2_d);
+    for (int i = 0; i < 20; ++i)
+        scene.world.integrate();
+    EXPECT_NEAR(slow.getVelocity()[2], 0_d, 0.1_d);
+    EXPECT_NEAR(slow.getPosition()[2], 0.5_d, 0.02_d);
+}
+
+TEST(ContactSolverTest, FrictionStopsSliding)
+{
+    BounceScene scene;
+    AABB        rough(Vector3D(0_d, 0_d, 0.5_d), Vector3D(1_d), Vector3D(2_d, 0_d, 0_d), 1_d);
+    AABB        smooth(Vector3D(0_d, 5_d, 0.5_d), Vector3D(1_d), Vector3D(2_d, 0_d, 0_d), 1_d);
+    scene.ground.setFrictionCst(0.5_d);
+    rough.setFrictionCst(0.5_d);
+    scene.world.addObject(&rough);
+    scene.world.addObject(&smooth);
+
+    // mu g = 4.9 m/s²: a 2 m/s slide stops within half a second
+    for (int i = 0; i < 60; ++i)
+        scene.world.integrate();
+    EXPECT_NEAR(rough.getVelocity()[0], 0_d, 1e-3_d);
+    EXPECT_NEAR(smooth.getVelocity()[0], 2_d, 1e-3_d);
+}
+
+TEST(ContactSolverTest, ResultsDoNotDependOnThreadCount)
+{
+    auto run = [](std::size_t threads)
+    {
+        BounceScene scene;
+        scene.world.setThreadCount(threads);
+        std::vector<std::unique_ptr<Sphere>> spheres;
+        for (std::size_t i = 0; i < 300; ++i)
+        {
+            const Vector3D position(static_cast<decimal>(i % 10) * 0.9_d,
+                                    static_cast<decimal>((i / 10) % 10) * 0.9_d,
+                                    static_cast<decimal>(i / 100) * 0.9_d + 0.45_d);
+            spheres.push_back(std::make_unique<Sphere>(position, 1_d, 1_d));
+            scene.world.addObject(spheres.back().get());
+        }
+        for (int step = 0; step < 5; ++step)
+            scene.world.integrate();
+
+        std::vector<Vector3D> state;
+        for (const auto& sphere : spheres)
+        {
+            state.push_back(sphere->getPosition());
+            state.push_back(sphere->getVelocity());
+        }
+        scene.world.setThreadCount(1);
+        return state;
+    };
+    const std::vector<Vector3D> reference = run(1);
+    const std::vector<Vector3D> threaded  = run(4);
+    ASSERT_EQ(threaded.size(), reference.size());
+    for (std::size_t i = 0; i < reference.size(); ++i)
+        ASSERT_EQ(threaded[i], reference[i]) << i;
+}
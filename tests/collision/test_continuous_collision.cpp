@@ -0,0 +1,89 @@
+#include "collision/continuous_collision.hpp"
+#include "collision/narrow_collision.hpp"
+#include "mathematics/vector.hpp"
+#include "test_functions.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+using NarrowCollision::BoxShape;
+using NarrowCollision::PlaneShape;
+using NarrowCollision::SphereShape;
+
+// ——————————————————————— Times of impact ———————————————————————
+
+TEST(ContinuousCollisionTest, SphereHitsSphere)
+{
+    const SphereShape moving { Vector3D(-10_d, 0_d, 0_d), 0.5_d };
+    const SphereShape target { Vector3D(0_d), 1_d };
+    decimal           fraction = -1_d;
+
+    // Head-on: touches when the centers are 1.5 apart, after 8.5 of the 20 units
+    ASSERT_TRUE(ContinuousCollision::timeOfImpact(moving, Vector3D(20_d, 0_d, 0_d), target, fraction));
+    EXPECT_NEAR(fraction, 8.5_d / 20_d, 1e-5_d);
+
+    // Passing beside, stopping short, moving away
+    EXPECT_FALSE(ContinuousCollision::timeOfImpact(moving, Vector3D(20_d, 4_d, 0_d), target, fraction));
+    EXPECT_FALSE(ContinuousCollision::timeOfImpact(moving, Vector3D(8_d, 0_d, 0_d), target, fraction));
+    EXPECT_FALSE(ContinuousCollision::timeOfImpact(moving, Vector3D(-20_d, 0_d, 0_d), target, fraction));
+
+    // Already touching: left to the narrow phase
+    const SphereShape touching { Vector3D(1_d, 0_d, 0_d), 0.5_d };
+    EXPECT_FALSE(ContinuousCollision::timeOfImpact(touching, Vector3D(-20_d, 0_d, 0_d), target, fraction));
+}
+
+TEST(ContinuousCollisionTest, SphereHitsPlane)
+{
+    const Plane       ground(Vector3D(0_d), Vector3D(10_d, 10_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    const PlaneShape  plane = NarrowCollision::shapeOf(ground);
+    const SphereShape ball { Vector3D(0_d, 0_d, 5.5_d), 0.5_d };
+    decimal           fraction = -1_d;
+
+    // Falling through the plane in a single motion, from either side
+    ASSERT_TRUE(ContinuousCollision::timeOfImpact(ball, Vector3D(0_d, 0_d, -10_d), plane, fraction));
+    EXPECT_NEAR(fraction, 0.5_d, 1e-5_d);
+    const SphereShape below { Vector3D(0_d, 0_d, -5.5_d), 0.5_d };
+    ASSERT_TRUE(ContinuousCollision::timeOfImpact(below, Vector3D(0_d, 0_d, 10_d), plane, fraction));
+    EXPECT_NEAR(fraction, 0.5_d, 1e-5_d);
+
+    // Crossing outside the rectangle, not reaching it, moving along it
+    EXPECT_FALSE(ContinuousCollision::timeOfImpact(ball, Vector3D(20_d, 0_d, -10_d), plane, fraction));
+    EXPECT_FALSE(ContinuousCollision::timeOfImpact(ball, Vector3D(0_d, 0_d, -4_d), plane, fraction));
+    EXPECT_FALSE(ContinuousCollision::timeOfImpact(ball, Vector3D(3_d, 0_d, 0_d), plane, fraction));
+}
+
+TEST(ContinuousCollisionTest, SphereHitsBox)
+{
+    const BoxShape    wall { Vector3D(0_d), Vector3D(0.05_d, 2_d, 2_d) };
+    const SphereShape ball { Vector3D(-5_d, 0_d, 0_d), 0.25_d };
+    decimal           fraction = -1_d;
+
+    // Through a thin wall: touches its face after 4.7 of the 10 units
+    ASSERT_TRUE(ContinuousCollision::timeOfImpact(ball, Vector3D(10_d, 0_d, 0_d), wall, fraction));
+    EXPECT_NEAR(fraction, 0.47_d, 1e-5_d);
+
+    // Above the wall, short of it, away from it
+    EXPECT_FALSE(ContinuousCollision::timeOfImpact(ball, Vector3D(10_d, 0_d, 6_d), wall, fraction));
+    EXPECT_FALSE(ContinuousCollision::timeOfImpact(ball, Vector3D(4_d, 0_d, 0_d), wall, fraction));
+    EXPECT_FALSE(ContinuousCollision::timeOfImpact(ball, Vector3D(-10_d, 0_d, 0_d), wall, fraction));
+
+    // The expanded box is conservative at the edges: a sphere passing just beside one is stopped early
+    const SphereShape corner { Vector3D(-5_d, 2.2_d, 2.2_d), 0.25_d };
+    ASSERT_TRUE(ContinuousCollision::timeOfImpact(corner, Vector3D(10_d, 0_d, 0_d), wall, fraction));
+    EXPECT_LE(fraction, 0.47_d + 1e-5_d);
+}
+
+// ——————————————————————— Ballistic approach ———————————————————————
+
+TEST(ContinuousCollisionTest, ApproachTime)
+{
+    // Constant speed, free fall from rest, thrown upwards then falling back
+    EXPECT_NEAR(ContinuousCollision::approachTime(10_d, 5_d, 0_d), 2_d, 1e-5_d);
+    EXPECT_NEAR(ContinuousCollision::approachTime(19.62_d, 0_d, 9.81_d), 2_d, 1e-5_d);
+    EXPECT_NEAR(ContinuousCollision::approachTime(5_d, -10_d, 10_d), 1_d + std::sqrt(2_d), 1e-5_d);
+
+    // Moving away, decelerating before closing the gap, already touching
+    EXPECT_TRUE(std::isinf(ContinuousCollision::approachTime(1_d, -1_d, 0_d)));
+    EXPECT_TRUE(std::isinf(ContinuousCollision::approachTime(10_d, 2_d, -1_d)));
+    EXPECT_EQ(ContinuousCollision::approachTime(-1_d, 1_d, 0_d), 0_d);
+}
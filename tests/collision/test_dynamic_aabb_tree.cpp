@@ -0,0 +1,159 @@
+#include "collision/broad_phase.hpp"
+#include "collision/bvh_broad_phase.hpp"
+#include "collision/dynamic_aabb_tree.hpp"
+#include "objects/plane.hpp"
+#include "objects/sphere.hpp"
+#include "test_functions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+static BoundingBox cube(const Vector3D& center, decimal halfSize)
+{
+    return BoundingBox(center - halfSize, center + halfSize);
+}
+
+/// Brute-force pairs restricted to overlapping boxes.
+static std::vector<CollisionPair> referencePairs(const std::vector<Object*>& objects)
+{
+    BruteForceBroadPhase       reference;
+    std::vector<CollisionPair> pairs;
+    reference.computePairs(objects, pairs);
+    std::erase_if(pairs,
+                  [&](const CollisionPair& p)
+                  {
+                      return !objects[p.first]->getBoundingBox().getFattened(PRECISION_MACHINE).overlaps(
+                          objects[p.second]->getBoundingBox().getFattened(PRECISION_MACHINE));
+                  });
+    return pairs;
+}
+
+// ============================================================================
+//  Tree
+// ============================================================================
+TEST(DynamicAABBTreeTest, InsertQueryRemove)
+{
+    DynamicAABBTree tree;
+    EXPECT_EQ(tree.getHeight(), -1);
+
+    std::mt19937                            rng(3);
+    std::uniform_real_distribution<decimal> pos(-50_d, 50_d);
+    std::vector<BoundingBox>                boxes;
+    std::vector<std::int32_t>               proxies;
+    for (std::uint32_t i = 0; i < 1000; ++i)
+    {
+        boxes.push_back(cube(Vector3D(pos(rng), pos(rng), pos(rng)), 1_d));
+        proxies.push_back(tree.createProxy(boxes.back(), i));
+    }
+    EXPECT_EQ(tree.getProxyCount(), 1000u);
+
+    // Balanced: height in O(log N)
+    EXPECT_LE(tree.getHeight(), static_cast<std::int32_t>(2 * std::log2(1000.0) + 2));
+
+    // Query matches brute force on fat boxes
+    const BoundingBox          region = cube(Vector3D(0_d), 10_d);
+    std::vector<std::uint32_t> found;
+    tree.query(region, found);
+    std::sort(found.begin(), found.end());
+    std::vector<std::uint32_t> expected;
+    for (std::uint32_t i = 0; i < boxes.size(); ++i)
+        if (tree.getFatBox(proxies[i]).overlaps(region))
+            expected.push_back(i);
+    EXPECT_EQ(found, expected);
+    EXPECT_FALSE(found.empty());
+
+    // World bounds enclose everything
+    for (const BoundingBox& box : boxes)
+        EXPECT_TRUE(tree.getWorldBounds().contains(box));
+
+    // Remove half of the proxies
+    for (std::size_t i = 0; i < proxies.size(); i += 2)
+        tree.destroyProxy(proxies[i]);
+    EXPECT_EQ(tree.getProxyCount(), 500u);
+    found.clear();
+    tree.query(region, found);
+    for (std::uint32_t i : found)
+        EXPECT_EQ(i % 2, 1u);
+
+    tree.clear();
+    EXPECT_EQ(tree.getHeight(), -1);
+}
+
+TEST(DynamicAABBTreeTest, MoveOnlyReinsertsOutsideFatBox)
+{
+    DynamicAABBTree tree;
+    tree.setMargin(0.5_d);
+    const std::int32_t a = tree.createProxy(cube(Vector3D(0_d), 1_d), 0);
+    tree.createProxy(cube(Vector3D(5_d), 1_d), 1);
+
+    EXPECT_FALSE(tree.moveProxy(a, cube(Vector3D(0.3_d, 0_d, 0_d), 1_d)));
+    EXPECT_TRUE(tree.moveProxy(a, cube(Vector3D(2_d, 0_d, 0_d), 1_d)));
+    EXPECT_VECTOR_EQ(tree.getFatBox(a).min, Vector3D(0.5_d, -1.5_d, -1.5_d));
+    EXPECT_EQ(tree.getUserData(a), 0u);
+}
+
+TEST(DynamicAABBTreeTest, SortedInsertionStaysBalanced)
+{
+    // Insertion along a line is the worst case of an unbalanced tree
+    DynamicAABBTree tree;
+    for (std::uint32_t i = 0; i < 1024; ++i)
+        tree.createProxy(cube(Vector3D(static_cast<decimal>(i), 0_d, 0_d), 0.4_d), i);
+    EXPECT_LE(tree.getHeight(), 22);
+}
+
+// ============================================================================
+//  Broad phase
+// ============================================================================
+TEST(BVHBroadPhaseTest, UnevenSizes)
+{
+    // Free_Fall-like scene: large ground plane and small spheres
+    std::vector<std::unique_ptr<Object>> storage;
+    std::vector<Object*>                 objects;
+    storage.push_back(
+        std::make_unique<Plane>(Vector3D(0_d), Vector3D(50_d, 50_d, 0_d), Vector3D(0_d, 0_d, 1_d)));
+    objects.push_back(storage.back().get());
+
+    std::mt19937                            rng(11);
+    std::uniform_real_distribution<decimal> xy(-20_d, 20_d);
+    std::uniform_real_distribution<decimal> z(0_d, 4_d);
+    for (int i = 0; i < 500; ++i)
+    {
+        storage.push_back(std::make_unique<Sphere>(Vector3D(xy(rng), xy(rng), z(rng)), 0.4_d));
+        objects.push_back(storage.back().get());
+    }
+    objects.push_back(nullptr);
+
+    BVHBroadPhase              bvh;
+    std::vector<CollisionPair> pairs;
+    bvh.computePairs(objects, pairs);
+    EXPECT_EQ(pairs, referencePairs(objects));
+    EXPECT_EQ(bvh.getTree().getProxyCount(), 501u);
+
+    // Slow motion: nothing leaves its fat box
+    for (std::size_t i = 1; i < 501; ++i)
+        objects[i]->setPosition(objects[i]->getPosition() + Vector3D(0_d, 0_d, -0.01_d));
+    bvh.computePairs(objects, pairs);
+    EXPECT_EQ(bvh.getReinsertCount(), 0u);
+    EXPECT_EQ(pairs, referencePairs(objects));
+
+    // Fast motion: everything is reinserted
+    for (std::size_t i = 1; i < 501; ++i)
+        objects[i]->setPosition(objects[i]->getPosition() + Vector3D(1_d, 0_d, -0.5_d));
+    bvh.computePairs(objects, pairs);
+    EXPECT_EQ(bvh.getReinsertCount(), 500u);
+    EXPECT_EQ(pairs, referencePairs(objects));
+
+    // Region query
+    std::vector<std::size_t> inside;
+    bvh.queryRegion(BoundingBox(Vector3D(-100_d, -100_d, -1_d), Vector3D(100_d, 100_d, 0_d)), inside);
+    EXPECT_NE(std::find(inside.begin(), inside.end(), 0u), inside.end());
+    EXPECT_TRUE(bvh.getWorldBounds().contains(objects[0]->getBoundingBox()));
+    EXPECT_EQ(makeBroadPhase(parseBroadPhase("BVH"))->getType(), BroadPhaseType::BVH);
+}
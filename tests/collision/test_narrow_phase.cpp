@@ -1,11 +1,18 @@
+#include "collision/narrow_collision.hpp"
+#include "collision/narrow_kernels.hpp"
+#include "collision/narrow_phase.hpp"
 #include "mathematics/vector.hpp"
 #include "objects/aabb.hpp"
 #include "objects/plane.hpp"
 #include "objects/sphere.hpp"
 #include "test_functions.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
 
 // ——————————————————————— X vs X Collisions ———————————————————————
 
@@ -290,3 +297,310 @@ TEST(NarrowCollisionTest, NarrowCollisionPlaneDefaultCase)
     EXPECT_FALSE(plane.computeCollision(dummy, contact)); // Default case should return false
     EXPECT_FALSE(dummy.computeCollision(plane, contact));
 }
+
+// ——————————————————————— Batched narrow phase ———————————————————————
+
+TEST(NarrowPhaseTest, BucketsIgnorePairOrder)
+{
+    EXPECT_EQ(NarrowPhase::getBucket(ObjectType::Sphere, ObjectType::Sphere), PairBucket::SphereSphere);
+    EXPECT_EQ(NarrowPhase::getBucket(ObjectType::Plane, ObjectType::Sphere), PairBucket::SpherePlane);
+    EXPECT_EQ(NarrowPhase::getBucket(ObjectType::AABB, ObjectType::Sphere), PairBucket::SphereAABB);
+    EXPECT_EQ(NarrowPhase::getBucket(ObjectType::AABB, ObjectType::AABB), PairBucket::AABBAABB);
+    EXPECT_EQ(NarrowPhase::getBucket(ObjectType::Plane, ObjectType::AABB), PairBucket::AABBPlane);
+    EXPECT_EQ(NarrowPhase::getBucket(ObjectType::Plane, ObjectType::Plane), PairBucket::PlanePlane);
+    EXPECT_EQ(NarrowPhase::getBucket(ObjectType::Sphere, ObjectType::Generic), PairBucket::Other);
+}
+
+TEST(NarrowPhaseTest, BatchedContactsMatchObjectDispatch)
+{
+    // Overlapping spheres, boxes and tilted planes, one unknown object, every pair a candidate
+    BodyStorage                          storage;
+    std::vector<std::unique_ptr<Object>> objects;
+    for (int i = 0; i < 24; ++i)
+    {
+        const decimal  t = static_cast<decimal>(i);
+        const Vector3D position(0.7_d * static_cast<decimal>(i % 5), 0.6_d * static_cast<decimal>(i % 3),
+                                0.15_d * t);
+        if (i % 3 == 0)
+            objects.push_back(std::make_unique<Sphere>(position, 1_d + 0.1_d * static_cast<decimal>(i % 4)));
+        else if (i % 3 == 1)
+            objects.push_back(std::make_unique<AABB>(position, Vector3D(1_d, 0.8_d, 1.2_d)));
+        else
+            objects.push_back(std::make_unique<Plane>(position, Vector3D(3_d, 2_d, 0_d),
+                                                      Vector3D(0.2_d * t, 1_d, 0.5_d)));
+    }
+    objects.push_back(std::make_unique<DummyObject>());
+    for (const auto& obj : objects)
+        storage.add(*obj);
+
+    std::vector<CollisionPair> pairs;
+    for (std::size_t a = 0; a < objects.size(); ++a)
+    {
+        for (std::size_t b = a + 1; b < objects.size(); ++b)
+            pairs.push_back({ a, b });
+    }
+
+    for (const std::size_t threads : { 1u, 4u })
+    {
+        ThreadPool pool(threads);
+        FrameArena frame;
+        frame.setThreadPool(&pool);
+        std::span<Contact>      contacts = frame.allocate<Contact>(pairs.size());
+        std::span<std::uint8_t> found    = frame.allocate<std::uint8_t>(pairs.size());
+        NarrowPhase             narrowPhase;
+        narrowPhase.compute(storage, pairs, contacts, found, pool, frame, 8);
+
+        std::size_t bucketed = 0;
+        for (std::size_t b = 0; b < pairBucketCount; ++b)
+            bucketed += narrowPhase.getBucketSize(static_cast<PairBucket>(b));
+        EXPECT_EQ(bucketed, pairs.size());
+        EXPECT_EQ(narrowPhase.getBucketSize(PairBucket::Other), objects.size() - 1);
+
+        std::size_t touching = 0;
+        for (std::size_t k = 0; k < pairs.size(); ++k)
+        {
+            Contact    expected;
+            const bool hit = objects[pairs[k].first]->computeCollision(*objects[pairs[k].second], expected);
+            ASSERT_EQ(found[k] != 0, hit) << "pair " << k;
+            if (!hit)
+                continue;
+            ++touching;
+            EXPECT_EQ(contacts[k].A, expected.A);
+            EXPECT_EQ(contacts[k].B, expected.B);
+            EXPECT_EQ(contacts[k].penetration, expected.penetration);
+            for (int i = 0; i < 3; ++i)
+            {
+                EXPECT_EQ(contacts[k].position[i], expected.position[i]);
+                EXPECT_EQ(contacts[k].normal[i], expected.normal[i]);
+            }
+        }
+        EXPECT_GT(touching, pairs.size() / 10);
+    }
+}
+
+TEST(NarrowPhaseTest, PairCacheSkipsSeparatedCandidates)
+{
+    // Spheres and boxes falling onto a large plane: every pair is a candidate, few are in contact
+    BodyStorage                          storage;
+    std::vector<std::unique_ptr<Object>> objects;
+    objects.push_back(
+        std::make_unique<Plane>(Vector3D(0_d), Vector3D(40_d, 40_d, 0_d), Vector3D(0_d, 0_d, 1_d)));
+    for (int i = 0; i < 30; ++i)
+    {
+        const Vector3D position(1.5_d * static_cast<decimal>(i % 6), 1.5_d * static_cast<decimal>(i / 6),
+                                2_d + 0.2_d * static_cast<decimal>(i));
+        if (i % 2 == 0)
+            objects.push_back(std::make_unique<Sphere>(position, 1_d));
+        else
+            objects.push_back(std::make_unique<AABB>(position, Vector3D(1_d)));
+    }
+    for (const auto& obj : objects)
+        storage.add(*obj);
+
+    std::vector<CollisionPair> pairs;
+    for (std::size_t a = 0; a < objects.size(); ++a)
+    {
+        for (std::size_t b = a + 1; b < objects.size(); ++b)
+            pairs.push_back({ a, b });
+    }
+
+    for (const std::size_t threads : { 1u, 4u })
+    {
+        ThreadPool pool(threads);
+        FrameArena frame;
+        frame.setThreadPool(&pool);
+        NarrowPhase narrowPhase;
+        std::size_t skipped  = 0;
+        std::size_t touching = 0;
+        for (int step = 0; step < 80; ++step)
+        {
+            // Fall until resting on the plane
+            for (std::size_t i = 1; i < objects.size(); ++i)
+            {
+                const Vector3D position = objects[i]->getPosition();
+                objects[i]->setPosition(Vector3D(position.getX(), position.getY(),
+                                                 std::max(position.getZ() - 0.1_d, 0.45_d)));
+            }
+            frame.reset();
+            std::span<Contact>      contacts = frame.allocate<Contact>(pairs.size());
+            std::span<std::uint8_t> found    = frame.allocate<std::uint8_t>(pairs.size());
+            narrowPhase.compute(storage, pairs, contacts, found, pool, frame, 8);
+            skipped += narrowPhase.getPairCache().getSkippedCount();
+
+            touching = 0;
+            for (std::size_t k = 0; k < pairs.size(); ++k)
+            {
+                Contact    expected;
+                const bool hit =
+                    objects[pairs[k].first]->computeCollision(*objects[pairs[k].second], expected);
+                ASSERT_EQ(found[k] != 0, hit) << "step " << step << ", pair " << k;
+                if (!hit)
+                    continue;
+                ++touching;
+                EXPECT_EQ(contacts[k].penetration, expected.penetration);
+                for (int i = 0; i < 3; ++i)
+                    EXPECT_EQ(contacts[k].normal[i], expected.normal[i]);
+            }
+        }
+        // Everything ends up on the plane, after most of the distant pairs were skipped most of the time
+        EXPECT_GE(touching, objects.size() - 1);
+        EXPECT_GT(skipped, 80u * pairs.size() / 2);
+    }
+}
+
+TEST(NarrowPhaseTest, CachedMatchesUncached)
+{
+    // Spheres and boxes drifting on a plane, some of them teleported: both modes find the same contacts
+    std::mt19937                            rng(3);
+    std::uniform_real_distribution<decimal> pos(-4_d, 4_d);
+    std::uniform_real_distribution<decimal> drift(-0.05_d, 0.05_d);
+    BodyStorage                             storage;
+    std::vector<std::unique_ptr<Object>>    objects;
+    objects.push_back(
+        std::make_unique<Plane>(Vector3D(0_d), Vector3D(20_d, 20_d, 0_d), Vector3D(0_d, 0_d, 1_d)));
+    for (int i = 0; i < 40; ++i)
+    {
+        const Vector3D position(pos(rng), pos(rng), 4_d + pos(rng));
+        if (i % 2 == 0)
+            objects.push_back(std::make_unique<Sphere>(position, 0.7_d));
+        else
+            objects.push_back(std::make_unique<AABB>(position, Vector3D(1_d)));
+    }
+    for (const auto& obj : objects)
+        storage.add(*obj);
+
+    std::vector<CollisionPair> pairs;
+    for (std::size_t a = 0; a < objects.size(); ++a)
+    {
+        for (std::size_t b = a + 1; b < objects.size(); ++b)
+            pairs.push_back({ a, b });
+    }
+
+    ThreadPool pool(4);
+    FrameArena frame;
+    frame.setThreadPool(&pool);
+    NarrowPhase cached;
+    NarrowPhase uncached;
+    uncached.setCaching(false);
+    std::size_t skipped = 0;
+    for (int step = 0; step < 60; ++step)
+    {
+        for (std::size_t i = 1; i < objects.size(); ++i)
+        {
+            const bool     jumps = step % 15 == 7 && i % 6 == 0;
+            const Vector3D move  = jumps ? Vector3D(pos(rng), pos(rng), 0_d)
+                                         : Vector3D(drift(rng), drift(rng), -0.08_d);
+            const Vector3D next  = objects[i]->getPosition() + move;
+            objects[i]->setPosition(Vector3D(next.getX(), next.getY(), std::max(next.getZ(), 0.3_d)));
+        }
+        frame.reset();
+        std::span<Contact>      cachedContacts   = frame.allocate<Contact>(pairs.size());
+        std::span<std::uint8_t> cachedFound      = frame.allocate<std::uint8_t>(pairs.size());
+        std::span<Contact>      uncachedContacts = frame.allocate<Contact>(pairs.size());
+        std::span<std::uint8_t> uncachedFound    = frame.allocate<std::uint8_t>(pairs.size());
+        cached.compute(storage, pairs, cachedContacts, cachedFound, pool, frame, 8);
+        uncached.compute(storage, pairs, uncachedContacts, uncachedFound, pool, frame, 8);
+        skipped += cached.getPairCache().getSkippedCount();
+        EXPECT_EQ(uncached.getPairCache().getEntryCount(), 0u);
+
+        for (std::size_t k = 0; k < pairs.size(); ++k)
+        {
+            ASSERT_EQ(cachedFound[k], uncachedFound[k]) << "step " << step << ", pair " << k;
+            if (!cachedFound[k])
+                continue;
+            EXPECT_EQ(cachedContacts[k].penetration, uncachedContacts[k].penetration);
+            for (int i = 0; i < 3; ++i)
+                EXPECT_EQ(cachedContacts[k].normal[i], uncachedContacts[k].normal[i]);
+        }
+    }
+    EXPECT_GT(skipped, 0u);
+}
+
+TEST(NarrowPhaseTest, SphereKernelsMatchScalarTests)
+{
+    // 101 pairs: full packs for every width, plus a scalar tail
+    constexpr std::size_t                   count = 101;
+    std::mt19937                            rng(3);
+    std::uniform_real_distribution<decimal> coordinate(-2_d, 2_d);
+    std::uniform_real_distribution<decimal> size(0.2_d, 1.5_d);
+    std::vector<Sphere>                     first;
+    std::vector<Sphere>                     second;
+    std::vector<Plane>                      planes;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        first.emplace_back(Vector3D(coordinate(rng), coordinate(rng), coordinate(rng)), size(rng));
+        second.emplace_back(Vector3D(coordinate(rng), coordinate(rng), coordinate(rng)), size(rng));
+        planes.emplace_back(Vector3D(coordinate(rng), coordinate(rng), coordinate(rng)),
+                            Vector3D(size(rng) * 3_d, size(rng) * 3_d, 0_d),
+                            Vector3D(coordinate(rng), coordinate(rng), 1_d));
+    }
+    auto column = [&](auto value)
+    {
+        std::vector<decimal> values(count);
+        for (std::size_t i = 0; i < count; ++i)
+            values[i] = value(i);
+        return values;
+    };
+    const auto ax = column([&](std::size_t i) { return first[i].getCenter()[0]; });
+    const auto ay = column([&](std::size_t i) { return first[i].getCenter()[1]; });
+    const auto az = column([&](std::size_t i) { return first[i].getCenter()[2]; });
+    const auto ar = column([&](std::size_t i) { return first[i].getRadius(); });
+    const auto bx = column([&](std::size_t i) { return second[i].getCenter()[0]; });
+    const auto by = column([&](std::size_t i) { return second[i].getCenter()[1]; });
+    const auto bz = column([&](std::size_t i) { return second[i].getCenter()[2]; });
+    const auto br = column([&](std::size_t i) { return second[i].getRadius(); });
+    std::array<std::vector<decimal>, 14> plane;
+    for (std::size_t c = 0; c < 3; ++c)
+    {
+        plane[c]     = column([&](std::size_t i) { return planes[i].getPosition()[c]; });
+        plane[3 + c] = column([&](std::size_t i) { return planes[i].getNormal()[c]; });
+        plane[6 + c] = column([&](std::size_t i) { return planes[i].getU()[c]; });
+        plane[9 + c] = column([&](std::size_t i) { return planes[i].getV()[c]; });
+    }
+    plane[12] = column([&](std::size_t i) { return planes[i].getHalfWidth(); });
+    plane[13] = column([&](std::size_t i) { return planes[i].getHalfHeight(); });
+
+    // Sphere-sphere: the separation test is the only one, so flags are the contacts
+    std::vector<std::uint8_t> candidates(count);
+    NarrowKernels::sphereSphere({ ax.data(), ay.data(), az.data(), ar.data(), bx.data(), by.data(), bz.data(),
+                                  br.data() },
+                                count, candidates.data());
+    std::size_t touching = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Contact    contact;
+        const bool hit = NarrowCollision::computeContact(first[i], second[i], contact);
+        EXPECT_EQ(candidates[i] != 0, hit) << "pair " << i;
+        touching += hit ? 1 : 0;
+    }
+    EXPECT_GT(touching, 0u);
+
+    // Sphere-plane: pairs from `i` on
+    auto spherePlane = [&](std::size_t i)
+    {
+        NarrowKernels::SpherePlanePairs pairs { ax.data() + i, ay.data() + i, az.data() + i, ar.data() + i };
+        std::array<const decimal**, 14> planeArrays { &pairs.px, &pairs.py, &pairs.pz, &pairs.nx, &pairs.ny,
+                                                      &pairs.nz, &pairs.ux, &pairs.uy, &pairs.uz, &pairs.vx,
+                                                      &pairs.vy, &pairs.vz, &pairs.halfWidth,
+                                                      &pairs.halfHeight };
+        for (std::size_t c = 0; c < planeArrays.size(); ++c)
+            *planeArrays[c] = plane[c].data() + i;
+        return pairs;
+    };
+    NarrowKernels::spherePlane(spherePlane(0), count, candidates.data());
+    std::size_t flagged = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // Packs flag the pairs the scalar loop flags, and never reject a contact
+        std::uint8_t scalar = 0;
+        NarrowKernels::spherePlane(spherePlane(i), 1, &scalar);
+        EXPECT_EQ(candidates[i], scalar) << "pair " << i;
+
+        Contact contact;
+        if (NarrowCollision::computeContact(first[i], planes[i], contact))
+            EXPECT_EQ(candidates[i], 1) << "pair " << i;
+        flagged += candidates[i];
+    }
+    EXPECT_GT(flagged, 0u);
+    EXPECT_LT(flagged, count);
+}
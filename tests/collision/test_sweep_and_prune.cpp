@@ -0,0 +1,321 @@
+#include "collision/broad_phase.hpp"
+#include "collision/sweep_and_prune.hpp"
+#include "objects/aabb.hpp"
+#include "objects/plane.hpp"
+#include "objects/sphere.hpp"
+#include "test_functions.hpp"
+#include "world/physicsWorld.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+/// Reference: pairs of the historical i < j loop.
+static std::vector<CollisionPair> bruteForcePairs(const std::vector<Object*>& objects)
+{
+    BruteForceBroadPhase       reference;
+    std::vector<CollisionPair> pairs;
+    reference.computePairs(objects, pairs);
+    return pairs;
+}
+
+class SweepAndPruneTest : public ::testing::Test
+{
+protected:
+    std::vector<std::unique_ptr<Sphere>> spheres;
+    std::vector<Object*>                 objects;
+    std::mt19937                         rng { 42 };
+
+    void SetUp() override
+    {
+        std::uniform_real_distribution<decimal> pos(-5_d, 5_d);
+        std::uniform_real_distribution<decimal> size(0.2_d, 1.5_d);
+        for (int i = 0; i < 200; ++i)
+        {
+            spheres.push_back(std::make_unique<Sphere>(Vector3D(pos(rng), pos(rng), pos(rng)), size(rng)));
+            objects.push_back(spheres.back().get());
+        }
+    }
+};
+
+// ============================================================================
+//  Tests
+// ============================================================================
+TEST(BroadPhaseTest, ParseNames)
+{
+    EXPECT_EQ(parseBroadPhase("BruteForce"), BroadPhaseType::BruteForce);
+    EXPECT_EQ(parseBroadPhase("SweepAndPrune"), BroadPhaseType::SweepAndPrune);
+    EXPECT_EQ(parseBroadPhase("whatever"), BroadPhaseType::Unknown);
+    EXPECT_EQ(makeBroadPhase(BroadPhaseType::Unknown)->getType(), BroadPhaseType::BruteForce);
+    EXPECT_EQ(makeBroadPhase(BroadPhaseType::SweepAndPrune)->getType(), BroadPhaseType::SweepAndPrune);
+}
+
+TEST(BroadPhaseTest, BoundingBoxes)
+{
+    Sphere s(Vector3D(1_d, 2_d, 3_d), 2_d);
+    EXPECT_VECTOR_EQ(s.getBoundingBox().min, Vector3D(0_d, 1_d, 2_d));
+    EXPECT_VECTOR_EQ(s.getBoundingBox().max, Vector3D(2_d, 3_d, 4_d));
+
+    AABB a(Vector3D(0_d), Vector3D(2_d, 4_d, 6_d));
+    EXPECT_VECTOR_EQ(a.getBoundingBox().min, Vector3D(-1_d, -2_d, -3_d));
+    EXPECT_VECTOR_EQ(a.getBoundingBox().max, Vector3D(1_d, 2_d, 3_d));
+
+    // Horizontal ground: flat box
+    Plane p(Vector3D(0_d), Vector3D(10_d, 10_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    EXPECT_DECIMAL_EQ(p.getBoundingBox().min[2], 0_d);
+    EXPECT_DECIMAL_EQ(p.getBoundingBox().max[2], 0_d);
+    EXPECT_DECIMAL_EQ(p.getBoundingBox().max[0], 5_d);
+    EXPECT_DECIMAL_EQ(p.getBoundingBox().max[1], 5_d);
+}
+
+TEST(BroadPhaseTest, BruteForcePairCacheSkipsDistantPairs)
+{
+    // Spheres, boxes and planes drifting slowly, with a few jumps: pairs found apart are cached
+    std::mt19937                            rng(5);
+    std::uniform_real_distribution<decimal> pos(-8_d, 8_d);
+    std::uniform_real_distribution<decimal> drift(-0.05_d, 0.05_d);
+    std::vector<std::unique_ptr<Object>>    owned;
+    std::vector<Object*>                    objects;
+    for (int i = 0; i < 90; ++i)
+    {
+        const Vector3D position(pos(rng), pos(rng), pos(rng));
+        if (i % 3 == 0)
+            owned.push_back(std::make_unique<Sphere>(position, 1_d));
+        else if (i % 3 == 1)
+            owned.push_back(std::make_unique<AABB>(position, Vector3D(1_d, 0.5_d, 1.5_d)));
+        else
+            owned.push_back(std::make_unique<Plane>(position, Vector3D(2_d, 3_d, 0_d),
+                                                    Vector3D(pos(rng), pos(rng), 1_d)));
+        objects.push_back(owned.back().get());
+    }
+
+    for (const std::size_t threads : { 1u, 4u })
+    {
+        ThreadPool           pool(threads);
+        BruteForceBroadPhase cached;
+        cached.setThreadPool(&pool);
+        std::vector<CollisionPair> pairs;
+        std::size_t                skipped = 0;
+        for (int step = 0; step < 60; ++step)
+        {
+            for (std::size_t i = 0; i < objects.size(); ++i)
+            {
+                const bool     jumps = step % 20 == 10 && i % 7 == 0;
+                const Vector3D move  = Vector3D(drift(rng), drift(rng), drift(rng)) +
+                                      (jumps ? Vector3D(3_d, -2_d, 1_d) : Vector3D(0_d));
+                objects[i]->setPosition(objects[i]->getPosition() + move);
+            }
+            cached.computePairs(objects, pairs);
+
+            std::vector<CollisionPair> expected;
+            for (std::size_t i = 0; i < objects.size(); ++i)
+            {
+                for (std::size_t j = i + 1; j < objects.size(); ++j)
+                {
+                    if (objects[i]->checkCollision(*objects[j]))
+                        expected.push_back({ i, j });
+                }
+            }
+            ASSERT_EQ(pairs, expected) << "step " << step;
+            if (step > 0)
+                skipped += cached.getPairCache().getSkippedCount();
+        }
+        EXPECT_FALSE(pairs.empty());
+        // Most of the pairs are far apart and only tested again once their objects drifted enough
+        EXPECT_GT(skipped, 59u * objects.size() * (objects.size() - 1) / 2 / 2);
+    }
+}
+
+TEST(BroadPhaseTest, BruteForceCachedMatchesUncached)
+{
+    // Spheres and boxes drifting, some of them teleported, on the pool: both modes give the same pairs
+    std::mt19937                            rng(11);
+    std::uniform_real_distribution<decimal> pos(-6_d, 6_d);
+    std::uniform_real_distribution<decimal> drift(-0.1_d, 0.1_d);
+    std::vector<std::unique_ptr<Object>>    owned;
+    std::vector<Object*>                    objects;
+    for (int i = 0; i < 80; ++i)
+    {
+        const Vector3D position(pos(rng), pos(rng), pos(rng));
+        if (i % 2 == 0)
+            owned.push_back(std::make_unique<Sphere>(position, 0.8_d));
+        else
+            owned.push_back(std::make_unique<AABB>(position, Vector3D(1.2_d, 0.6_d, 1_d)));
+        objects.push_back(owned.back().get());
+    }
+
+    ThreadPool           pool(4);
+    BruteForceBroadPhase cached(true);
+    BruteForceBroadPhase uncached(false);
+    cached.setThreadPool(&pool);
+    uncached.setThreadPool(&pool);
+    std::vector<CollisionPair> cachedPairs;
+    std::vector<CollisionPair> uncachedPairs;
+    std::size_t                skipped = 0;
+    for (int step = 0; step < 80; ++step)
+    {
+        for (std::size_t i = 0; i < objects.size(); ++i)
+        {
+            const bool     jumps = step % 16 == 8 && i % 5 == 0;
+            const Vector3D move  = jumps ? Vector3D(pos(rng), pos(rng), pos(rng))
+                                         : Vector3D(drift(rng), drift(rng), drift(rng));
+            objects[i]->setPosition(objects[i]->getPosition() + move);
+        }
+        cached.computePairs(objects, cachedPairs);
+        uncached.computePairs(objects, uncachedPairs);
+        ASSERT_EQ(cachedPairs, uncachedPairs) << "step " << step;
+        skipped += cached.getPairCache().getSkippedCount();
+        EXPECT_EQ(uncached.getPairCache().getEntryCount(), 0u);
+    }
+    EXPECT_GT(skipped, 0u);
+}
+
+TEST_F(SweepAndPruneTest, MatchesBruteForce)
+{
+    SweepAndPrune              sap;
+    std::vector<CollisionPair> pairs;
+
+    sap.computePairs(objects, pairs);
+    EXPECT_EQ(pairs, bruteForcePairs(objects));
+    EXPECT_TRUE(std::is_sorted(pairs.begin(), pairs.end()));
+}
+
+TEST_F(SweepAndPruneTest, IncrementalUpdate)
+{
+    SweepAndPrune              sap;
+    std::vector<CollisionPair> pairs;
+    sap.computePairs(objects, pairs);
+
+    // Move objects by small steps: insertion sort path
+    std::uniform_real_distribution<decimal> step(-0.3_d, 0.3_d);
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        for (auto& s : spheres)
+            s->setPosition(s->getPosition() + Vector3D(step(rng), step(rng), step(rng)));
+
+        sap.computePairs(objects, pairs);
+        ASSERT_EQ(pairs, bruteForcePairs(objects));
+    }
+
+    // Stretch the cloud along Y: sweep axis follows the largest spread
+    for (auto& s : spheres)
+        s->setPosition(s->getPosition() * Vector3D(1_d, 20_d, 1_d));
+    sap.computePairs(objects, pairs);
+    EXPECT_EQ(sap.getSweepAxis(), 1u);
+    EXPECT_EQ(pairs, bruteForcePairs(objects));
+}
+
+TEST_F(SweepAndPruneTest, TouchingAndObjectSetChanges)
+{
+    SweepAndPrune              sap;
+    std::vector<CollisionPair> pairs;
+    sap.setMargin(0_d);
+
+    Sphere               a(Vector3D(0_d), 2_d);
+    Sphere               b(Vector3D(2_d, 0_d, 0_d), 2_d); // touching a
+    Sphere               c(Vector3D(10_d, 0_d, 0_d), 2_d);
+    std::vector<Object*> small = { &a, &b, &c };
+
+    sap.computePairs(small, pairs);
+    ASSERT_EQ(pairs.size(), 1u);
+    EXPECT_EQ(pairs[0], (CollisionPair { 0, 1 }));
+
+    // Object array changes size: rebuild
+    sap.computePairs(objects, pairs);
+    EXPECT_EQ(pairs, bruteForcePairs(objects));
+
+    small.push_back(nullptr);
+    sap.reset();
+    sap.computePairs(small, pairs);
+    EXPECT_EQ(pairs.size(), 1u);
+}
+
+TEST(SweepAndPruneWorldTest, SameResultAsBruteForce)
+{
+    auto simulate = [](const std::string& broadPhase)
+    {
+        PhysicsWorld world;
+        world.setSolver("Euler");
+        world.setBroadPhase(broadPhase);
+        world.setTimeStep(0.01_d);
+
+        Plane ground(Vector3D(0_d), Vector3D(40_d, 40_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+        world.addObject(&ground);
+
+        std::vector<std::unique_ptr<Sphere>> balls;
+        for (int i = 0; i < 5; ++i)
+            for (int j = 0; j < 5; ++j)
+            {
+                balls.push_back(std::make_unique<Sphere>(
+                    Vector3D(static_cast<decimal>(i) * 0.9_d, static_cast<decimal>(j) * 0.9_d,
+                             1_d + static_cast<decimal>((i + j) % 3)),
+                    1_d, Vector3D(0_d), 1_d));
+                world.addObject(balls.back().get());
+            }
+
+        world.start();
+        for (int step = 0; step < 200; ++step)
+            world.integrate();
+
+        std::vector<Vector3D> positions;
+        for (auto& b : balls)
+            positions.push_back(b->getPosition());
+        world.clearObjects();
+        return positions;
+    };
+
+    const auto reference = simulate("BruteForce");
+    const auto sap       = simulate("SweepAndPrune");
+    ASSERT_EQ(reference.size(), sap.size());
+    for (std::size_t i = 0; i < reference.size(); ++i)
+        EXPECT_VECTOR_EQ(reference[i], sap[i]);
+}
+
+TEST(SweepAndPruneWorldTest, PairCachingDoesNotChangeResults)
+{
+    auto simulate = [](bool caching)
+    {
+        PhysicsWorld world;
+        world.setSolver("Euler");
+        world.setBroadPhase("BruteForce");
+        world.setPairCaching(caching);
+        world.setTimeStep(0.01_d);
+
+        Plane ground(Vector3D(0_d), Vector3D(40_d, 40_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+        world.addObject(&ground);
+
+        std::vector<std::unique_ptr<Sphere>> balls;
+        for (int i = 0; i < 6; ++i)
+            for (int j = 0; j < 6; ++j)
+            {
+                balls.push_back(std::make_unique<Sphere>(
+                    Vector3D(static_cast<decimal>(i) * 2.5_d, static_cast<decimal>(j) * 2.5_d,
+                             1.5_d + static_cast<decimal>((i * 7 + j) % 5)),
+                    1_d, Vector3D(static_cast<decimal>(j % 3) - 1_d, static_cast<decimal>(i % 3) - 1_d, 0_d),
+                    1_d));
+                world.addObject(balls.back().get());
+            }
+
+        world.start();
+        for (int step = 0; step < 300; ++step)
+            world.integrate();
+
+        std::vector<Vector3D> positions;
+        for (auto& b : balls)
+            positions.push_back(b->getPosition());
+        world.clearObjects();
+        world.setPairCaching(true);
+        return positions;
+    };
+
+    const auto cached   = simulate(true);
+    const auto uncached = simulate(false);
+    ASSERT_EQ(cached.size(), uncached.size());
+    for (std::size_t i = 0; i < cached.size(); ++i)
+        EXPECT_VECTOR_EQ(cached[i], uncached[i]);
+}
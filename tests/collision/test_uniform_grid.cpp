@@ -0,0 +1,121 @@
+#include "collision/broad_phase.hpp"
+#include "collision/uniform_grid.hpp"
+#include "objects/aabb.hpp"
+#include "objects/plane.hpp"
+#include "objects/sphere.hpp"
+#include "test_functions.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+// ============================================================================
+//  Fixture
+// ============================================================================
+class UniformGridTest : public ::testing::Test
+{
+protected:
+    std::vector<std::unique_ptr<Object>> storage;
+    std::vector<Object*>                 objects;
+    std::mt19937                         rng { 7 };
+
+    void SetUp() override
+    {
+        // Dense cloud of similar spheres, around the origin (negative cell coordinates included)
+        std::uniform_real_distribution<decimal> pos(-6_d, 6_d);
+        std::uniform_real_distribution<decimal> size(0.8_d, 1.2_d);
+        for (int i = 0; i < 400; ++i)
+            add(std::make_unique<Sphere>(Vector3D(pos(rng), pos(rng), pos(rng)), size(rng)));
+    }
+
+    void add(std::unique_ptr<Object> obj)
+    {
+        objects.push_back(obj.get());
+        storage.push_back(std::move(obj));
+    }
+
+    /// Brute-force pairs restricted to overlapping boxes (the loose Sphere/Plane broad check reports
+    /// far-away pairs the narrow phase rejects anyway).
+    std::vector<CollisionPair> bruteForcePairs() const
+    {
+        BruteForceBroadPhase       reference;
+        std::vector<CollisionPair> pairs;
+        reference.computePairs(objects, pairs);
+        std::erase_if(pairs,
+                      [&](const CollisionPair& p)
+                      {
+                          return !objects[p.first]->getBoundingBox().getFattened(PRECISION_MACHINE).overlaps(
+                              objects[p.second]->getBoundingBox().getFattened(PRECISION_MACHINE));
+                      });
+        return pairs;
+    }
+};
+
+// ============================================================================
+//  Tests
+// ============================================================================
+TEST_F(UniformGridTest, InferredCellSize)
+{
+    UniformGrid                grid;
+    std::vector<CollisionPair> pairs;
+    grid.computePairs(objects, pairs);
+
+    // Median sphere diameter
+    EXPECT_GT(grid.getCellSize(), 0.8_d * 0.99_d);
+    EXPECT_LT(grid.getCellSize(), 1.2_d * 1.01_d);
+    EXPECT_EQ(pairs, bruteForcePairs());
+    EXPECT_EQ(makeBroadPhase(parseBroadPhase("UniformGrid"))->getType(), BroadPhaseType::UniformGrid);
+}
+
+TEST_F(UniformGridTest, MatchesBruteForceForAnyCellSize)
+{
+    for (decimal cell : { 0.1_d, 0.5_d, 1_d, 3_d, 50_d })
+    {
+        UniformGrid                grid(cell);
+        std::vector<CollisionPair> pairs;
+        grid.computePairs(objects, pairs);
+        EXPECT_DECIMAL_EQ(grid.getCellSize(), cell);
+        EXPECT_EQ(pairs, bruteForcePairs()) << "cell size " << cell;
+    }
+}
+
+TEST_F(UniformGridTest, LargeObjectsKeptOutOfGrid)
+{
+    add(std::make_unique<Plane>(Vector3D(0_d, 0_d, -5_d), Vector3D(20_d, 20_d, 0_d),
+                                Vector3D(0_d, 0_d, 1_d)));
+    add(std::make_unique<AABB>(Vector3D(3_d, 0_d, 0_d), Vector3D(10_d, 1_d, 1_d)));
+    add(std::make_unique<Plane>(Vector3D(0_d, 0_d, 5_d), Vector3D(20_d, 20_d, 0_d),
+                                Vector3D(0_d, 0_d, -1_d)));
+    objects.push_back(nullptr);
+
+    UniformGrid                grid(1_d);
+    std::vector<CollisionPair> pairs;
+    grid.computePairs(objects, pairs);
+
+    EXPECT_EQ(grid.getLargeObjectCount(), 3u);
+    EXPECT_EQ(pairs, bruteForcePairs());
+}
+
+TEST_F(UniformGridTest, MovingObjects)
+{
+    UniformGrid                grid;
+    std::vector<CollisionPair> pairs;
+
+    std::uniform_real_distribution<decimal> step(-0.5_d, 0.5_d);
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        for (Object* obj : objects)
+            obj->setPosition(obj->getPosition() + Vector3D(step(rng), step(rng), step(rng)));
+        grid.computePairs(objects, pairs);
+        ASSERT_EQ(pairs, bruteForcePairs());
+    }
+
+    // Reset re-infers the cell size from the current objects
+    for (Object* obj : objects)
+        obj->setSize(obj->getSize() * 4_d);
+    grid.reset();
+    grid.computePairs(objects, pairs);
+    EXPECT_GT(grid.getCellSize(), 3_d);
+    EXPECT_EQ(pairs, bruteForcePairs());
+}
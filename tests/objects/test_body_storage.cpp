@@ -0,0 +1,176 @@
+#include "objects/body_storage.hpp"
+#include "objects/sphere.hpp"
+#include "world/physicsWorld.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+
+// ============================================================================
+//  Storage
+// ============================================================================
+TEST(BodyStorageTest, AttachAndDetach)
+{
+    BodyStorage storage;
+    Sphere      sphere(Vector3D(1_d, 2_d, 3_d), 0.5_d, Vector3D(0_d, 0_d, -1_d), 2_d);
+    sphere.setName("ball");
+
+    EXPECT_EQ(storage.add(sphere), 0u);
+    EXPECT_TRUE(sphere.isAttached());
+    EXPECT_TRUE(storage.contains(sphere));
+    EXPECT_EQ(storage.getType(0), ObjectType::Sphere);
+    EXPECT_TRUE(storage.isDynamic(0));
+    EXPECT_EQ(storage.getInverseMasses()[0], 0.5_d);
+
+    // The Object is a view on its slot
+    storage.getPositions().set(0, Vector3D(4_d, 5_d, 6_d));
+    EXPECT_EQ(sphere.getPosition(), Vector3D(4_d, 5_d, 6_d));
+    sphere.setVelocity(Vector3D(1_d, 0_d, 0_d));
+    EXPECT_EQ(storage.getVelocities().x[0], 1_d);
+    EXPECT_EQ(storage.getColdData(0).name, "ball");
+    EXPECT_EQ(sphere.getSize(), Vector3D(0.5_d));
+
+    sphere.setIsFixed(true);
+    EXPECT_FALSE(storage.isDynamic(0));
+    EXPECT_EQ(storage.getInverseMasses()[0], 0_d);
+    sphere.setMass(4_d);
+    EXPECT_TRUE(storage.isDynamic(0));
+    EXPECT_EQ(storage.getInverseMasses()[0], 0.25_d);
+
+    // Removal gives the state back to the Object
+    storage.remove(sphere);
+    EXPECT_FALSE(sphere.isAttached());
+    EXPECT_EQ(storage.size(), 0u);
+    EXPECT_EQ(sphere.getPosition(), Vector3D(4_d, 5_d, 6_d));
+    EXPECT_EQ(sphere.getVelocity(), Vector3D(1_d, 0_d, 0_d));
+    EXPECT_EQ(sphere.getMass(), 4_d);
+    EXPECT_EQ(sphere.getName(), "ball");
+    EXPECT_FALSE(sphere.isFixed());
+}
+
+TEST(BodyStorageTest, CopiesAreDetached)
+{
+    BodyStorage storage;
+    Sphere      sphere(Vector3D(1_d, 0_d, 0_d), 1_d, 1_d);
+    storage.add(sphere);
+
+    Sphere copy = sphere;
+    EXPECT_FALSE(copy.isAttached());
+    copy.setPosition(Vector3D(0_d));
+    EXPECT_EQ(sphere.getPosition(), Vector3D(1_d, 0_d, 0_d));
+    EXPECT_EQ(copy.getMass(), 1_d);
+    EXPECT_EQ(storage.size(), 1u);
+}
+
+TEST(BodyStorageTest, RemoveMovesTheLastSlotAndReleaseEmptiesThem)
+{
+    BodyStorage storage;
+    Sphere      a(Vector3D(0_d), 1_d, 1_d);
+    Sphere      b(Vector3D(1_d), 1_d, 1_d);
+    Sphere      c(Vector3D(2_d), 1_d, 1_d);
+    storage.add(a);
+    storage.add(b);
+    storage.add(c);
+
+    EXPECT_EQ(storage.remove(a), 0u);
+    ASSERT_EQ(storage.size(), 2u);
+    EXPECT_EQ(storage.getObject(0), &c);
+    EXPECT_EQ(storage.getObject(1), &b);
+    EXPECT_EQ(storage.getPositions().get(0), Vector3D(2_d));
+    c.setPosition(Vector3D(5_d));
+    EXPECT_EQ(storage.getPositions().get(0), Vector3D(5_d));
+    EXPECT_EQ(storage.remove(a), storage.size());
+
+    const std::size_t version = storage.getVersion();
+    {
+        auto d = std::make_unique<Sphere>(Vector3D(3_d), 1_d, 1_d);
+        storage.add(*d);
+    }
+    EXPECT_EQ(storage.size(), 3u);
+    EXPECT_EQ(storage.getObject(2), nullptr);
+    EXPECT_FALSE(storage.isDynamic(2));
+    EXPECT_GT(storage.getVersion(), version);
+}
+
+// ============================================================================
+//  World
+// ============================================================================
+TEST(BodyStorageTest, WorldIntegratesStoredBodies)
+{
+    PhysicsWorld world;
+    world.setSolver("Euler");
+    world.setTimeStep(0.01_d);
+    world.setGravityAcc(Vector3D(0_d, 0_d, -10_d));
+
+    Sphere ball(Vector3D(0_d, 0_d, 10_d), 0.2_d, Vector3D(1_d, 0_d, 0_d), 1_d);
+    Sphere ground(Vector3D(0_d, 0_d, -100_d), 1_d);
+    world.addObject(&ball);
+    world.addObject(&ground);
+    EXPECT_TRUE(ball.isAttached());
+
+    // Same update, done on a detached copy
+    Sphere reference = ball;
+    world.start();
+    for (int i = 0; i < 10; ++i)
+    {
+        world.integrateWithoutCollisions();
+        reference.setAcceleration(Vector3D(0_d, 0_d, -10_d));
+        world.integrateEuler(reference, 0.01_d);
+    }
+
+    EXPECT_EQ(ball.getPosition(), reference.getPosition());
+    EXPECT_EQ(ball.getVelocity(), reference.getVelocity());
+    EXPECT_EQ(ground.getPosition(), Vector3D(0_d, 0_d, -100_d));
+
+    world.removeObject(&ball);
+    EXPECT_FALSE(ball.isAttached());
+    EXPECT_EQ(world.getObjectCount(), 1u);
+    EXPECT_EQ(world.getObject(0), &ground);
+    world.clearObjects();
+    EXPECT_FALSE(ground.isAttached());
+}
+
+TEST(BodyStorageTest, SleepingBodiesStopUntilWokenUp)
+{
+    BodyStorage storage;
+    Sphere      ball(Vector3D(0_d, 0_d, 1_d), 1_d, Vector3D(1_d, 0_d, 0_d), 2_d);
+    Sphere      ground(Vector3D(0_d), 1_d);
+    ball.setSleepEnergy(0.5_d);
+    storage.add(ground);
+    storage.add(ball);
+    EXPECT_EQ(storage.getSleepEnergies()[1], 0.5_d);
+
+    // Fixed bodies never sleep
+    storage.sleep(0, 0);
+    EXPECT_FALSE(ground.isSleeping());
+
+    storage.sleep(1, 1);
+    EXPECT_TRUE(ball.isSleeping());
+    EXPECT_FALSE(storage.isDynamic(1));
+    EXPECT_EQ(storage.getMotionMasks()[1], 0_d);
+    EXPECT_EQ(ball.getVelocity(), Vector3D(0_d));
+
+    // Any change of position or velocity wakes it up
+    ball.setPosition(Vector3D(0_d, 0_d, 2_d));
+    EXPECT_FALSE(ball.isSleeping());
+    EXPECT_TRUE(storage.isDynamic(1));
+    EXPECT_EQ(storage.getMotionMasks()[1], 1_d);
+    storage.sleep(1, 1);
+    ball.setVelocity(Vector3D(0_d, 1_d, 0_d));
+    EXPECT_FALSE(ball.isSleeping());
+
+    // Removing a slot keeps the groups: the one named after the moved slot follows it
+    storage.sleep(1, 1);
+    storage.remove(ground);
+    EXPECT_TRUE(ball.isSleeping());
+    EXPECT_EQ(storage.getSleepGroup(0), 0u);
+    EXPECT_EQ(storage.getSleepingCount(), 1u);
+
+    // Removing a sleeping body wakes up the bodies asleep with it
+    Sphere other(Vector3D(0_d, 0_d, 3_d), 1_d, 2_d);
+    storage.add(other);
+    storage.sleep(1, 0);
+    storage.remove(ball);
+    EXPECT_FALSE(other.isSleeping());
+    EXPECT_EQ(storage.getSleepingCount(), 0u);
+    EXPECT_EQ(ball.getSleepEnergy(), 0.5_d);
+}
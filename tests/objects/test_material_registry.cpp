@@ -0,0 +1,143 @@
+#include "objects/body_storage.hpp"
+#include "objects/material_registry.hpp"
+#include "objects/sphere.hpp"
+#include "world/physics.hpp"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+// ============================================================================
+//  Registry
+// ============================================================================
+TEST(MaterialRegistryTest, EqualPropertiesShareAnId)
+{
+    MaterialRegistry registry;
+    ObjectColdData   rubber;
+    rubber.stiffnessCst = 100_d;
+    rubber.frictionCst  = 0.8_d;
+    ObjectColdData steel;
+    steel.stiffnessCst = 1000_d;
+    steel.material.setRestitution(0.9_d);
+
+    EXPECT_EQ(registry.intern(rubber), 0u);
+    EXPECT_EQ(registry.intern(steel), 1u);
+    // Names and other cold data do not matter
+    rubber.name = "ball";
+    rubber.mass = 3_d;
+    EXPECT_EQ(registry.intern(rubber), 0u);
+    EXPECT_EQ(registry.size(), 2u);
+
+    registry.clear();
+    EXPECT_EQ(registry.size(), 0u);
+    EXPECT_EQ(registry.intern(steel), 0u);
+}
+
+TEST(MaterialRegistryTest, PairTableIsSymmetricAndPremixed)
+{
+    MaterialRegistry registry;
+    ObjectColdData   a;
+    a.stiffnessCst   = 2_d;
+    a.restitutionCst = 0.5_d;
+    a.frictionCst    = 0.5_d;
+    ObjectColdData b;
+    b.stiffnessCst   = 3_d;
+    b.restitutionCst = 0.8_d;
+    b.frictionCst    = 0.3_d;
+    b.material.setRestitution(0.2_d);
+    ObjectColdData smooth; // no stiffness, no friction
+
+    const std::uint32_t ia = registry.intern(a);
+    const std::uint32_t ib = registry.intern(b);
+    const std::uint32_t is = registry.intern(smooth);
+
+    const MaterialPair& ab = registry.getPair(ia, ib);
+    EXPECT_EQ(ab.stiffness, Physics::effectiveStiffness(2_d, 3_d));
+    EXPECT_EQ(ab.dampingRatio, Physics::dampingRatioFromRestitution(std::sqrt(0.5_d * 0.8_d)));
+    EXPECT_EQ(ab.friction, std::sqrt(0.5_d * 0.3_d));
+    EXPECT_EQ(ab.restitution, 0.2_d);
+
+    const MaterialPair& ba = registry.getPair(ib, ia);
+    EXPECT_EQ(ba.stiffness, ab.stiffness);
+    EXPECT_EQ(ba.dampingRatio, ab.dampingRatio);
+    EXPECT_EQ(ba.friction, ab.friction);
+    EXPECT_EQ(ba.restitution, ab.restitution);
+
+    // Effective stiffness falls back to the stiff side; friction vanishes
+    const MaterialPair& as = registry.getPair(ia, is);
+    EXPECT_EQ(as.stiffness, 2_d);
+    EXPECT_EQ(as.friction, 0_d);
+    EXPECT_EQ(registry.getPair(is, is).stiffness, 0_d);
+}
+
+TEST(MaterialRegistryTest, ReleasedIdsAreReused)
+{
+    MaterialRegistry registry;
+    ObjectColdData   a;
+    a.stiffnessCst = 2_d;
+    ObjectColdData b;
+    b.stiffnessCst = 3_d;
+
+    const std::uint32_t ia = registry.intern(a);
+    EXPECT_EQ(registry.intern(a), ia);
+    const std::uint32_t ib = registry.intern(b);
+    EXPECT_EQ(registry.getUseCount(ia), 2u);
+
+    registry.release(ia);
+    EXPECT_EQ(registry.intern(a), ia);
+    registry.release(ia);
+    registry.release(ia);
+    EXPECT_EQ(registry.getUseCount(ia), 0u);
+
+    // The released id takes the next new material, its row mixed again
+    ObjectColdData c;
+    c.stiffnessCst = 5_d;
+    EXPECT_EQ(registry.intern(c), ia);
+    EXPECT_EQ(registry.size(), 2u);
+    EXPECT_EQ(registry.getPair(ia, ib).stiffness, Physics::effectiveStiffness(5_d, 3_d));
+    EXPECT_EQ(registry.getPair(ia, ia).stiffness, Physics::effectiveStiffness(5_d, 5_d));
+    EXPECT_EQ(registry.getPair(ib, ib).stiffness, Physics::effectiveStiffness(3_d, 3_d));
+
+    // Growing the table keeps the pairs already mixed
+    for (int i = 0; i < 20; ++i)
+    {
+        ObjectColdData extra;
+        extra.frictionCst = static_cast<decimal>(i + 1) / 100_d;
+        registry.intern(extra);
+    }
+    EXPECT_EQ(registry.getPair(ib, ia).stiffness, Physics::effectiveStiffness(5_d, 3_d));
+}
+
+// ============================================================================
+//  Body storage
+// ============================================================================
+TEST(MaterialRegistryTest, StorageFollowsMaterialChanges)
+{
+    BodyStorage storage;
+    Sphere      first(Vector3D(0_d), 1_d, 1_d);
+    Sphere      second(Vector3D(2_d, 0_d, 0_d), 1_d, 1_d);
+    storage.add(first);
+    storage.add(second);
+    EXPECT_EQ(storage.getMaterialId(0), storage.getMaterialId(1));
+    EXPECT_EQ(storage.getMaterials().size(), 1u);
+
+    second.setFrictionCst(0.4_d);
+    EXPECT_NE(storage.getMaterialId(0), storage.getMaterialId(1));
+    EXPECT_EQ(storage.getMaterialPair(1, 1).friction, 0.4_d);
+
+    Material bouncy;
+    bouncy.setRestitution(0.9_d);
+    first.setMaterial(bouncy);
+    EXPECT_EQ(storage.getMaterialPair(0, 0).restitution, 0.9_d);
+    EXPECT_EQ(storage.getMaterialPair(0, 1).restitution, 0.5_d);
+
+    // Ids follow the slots when one is removed
+    const std::uint32_t secondId = storage.getMaterialId(1);
+    storage.remove(first);
+    EXPECT_EQ(storage.getMaterialId(0), secondId);
+
+    // Materials no slot uses any more are reclaimed
+    for (int i = 1; i <= 50; ++i)
+        second.setFrictionCst(static_cast<decimal>(i) / 100_d);
+    EXPECT_LE(storage.getMaterials().size(), 3u);
+    EXPECT_EQ(storage.getMaterialPair(0, 0).friction, 0.5_d);
+}
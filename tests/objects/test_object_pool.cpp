@@ -0,0 +1,125 @@
+#include "objects/object_pool.hpp"
+#include "objects/sphere.hpp"
+#include "world/physicsWorld.hpp"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+// ============================================================================
+//  Pool
+// ============================================================================
+TEST(ObjectPoolTest, HandlesOfDestroyedObjectsNoLongerResolve)
+{
+    ObjectPool<Sphere>  pool;
+    const std::uint32_t a  = pool.create(Vector3D(0_d), 1_d, 1_d);
+    const std::uint32_t b  = pool.create(Vector3D(1_d), 1_d, 1_d);
+    const std::uint32_t ga = pool.getGeneration(a);
+    EXPECT_EQ(pool.size(), 2u);
+    ASSERT_NE(pool.get(a, ga), nullptr);
+    EXPECT_EQ(pool.get(b, pool.getGeneration(b))->getPosition(), Vector3D(1_d));
+    EXPECT_EQ(pool.indexOf(pool.get(b, pool.getGeneration(b))), b);
+
+    // The entry is reused, with a new generation
+    Sphere* first = pool.get(a, ga);
+    pool.destroy(a);
+    EXPECT_EQ(pool.get(a, ga), nullptr);
+    EXPECT_EQ(pool.indexOf(first), ObjectHandle::invalidIndex);
+    const std::uint32_t c = pool.create(Vector3D(2_d), 1_d, 1_d);
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(pool.get(a, ga), nullptr);
+    EXPECT_EQ(pool.get(c, pool.getGeneration(c)), first);
+
+    Sphere outside;
+    EXPECT_EQ(pool.indexOf(&outside), ObjectHandle::invalidIndex);
+}
+
+TEST(ObjectPoolTest, ObjectsNeverMoveAndClearKeepsTheMemory)
+{
+    ObjectPool<Sphere>         pool;
+    std::vector<Sphere*>       addresses;
+    std::vector<std::uint32_t> indices;
+    for (int i = 0; i < 1000; ++i)
+    {
+        indices.push_back(pool.create(Vector3D(static_cast<decimal>(i)), 1_d, 1_d));
+        addresses.push_back(pool.get(indices.back(), pool.getGeneration(indices.back())));
+    }
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+        EXPECT_EQ(pool.get(indices[i], pool.getGeneration(indices[i])), addresses[i]);
+        EXPECT_EQ(addresses[i]->getPosition(), Vector3D(static_cast<decimal>(i)));
+    }
+
+    const std::size_t capacity = pool.capacity();
+    pool.clear();
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_EQ(pool.capacity(), capacity);
+    // Entries are handed out again from the first one
+    const std::uint32_t index = pool.create(Vector3D(0_d), 1_d, 1_d);
+    EXPECT_EQ(index, 0u);
+    EXPECT_EQ(pool.get(index, pool.getGeneration(index)), addresses[0]);
+}
+
+// ============================================================================
+//  World
+// ============================================================================
+TEST(ObjectPoolTest, WorldOwnsCreatedObjects)
+{
+    PhysicsWorld       world;
+    const ObjectHandle ground = world.createObject<Plane>(Vector3D(0_d), Vector3D(10_d, 10_d, 0_d),
+                                                          Vector3D(0_d, 0_d, 1_d));
+    const ObjectHandle ball   = world.createObject<Sphere>(Vector3D(0_d, 0_d, 2_d), 1_d, 1_d);
+    const ObjectHandle box    = world.createObject<AABB>(Vector3D(3_d, 0_d, 2_d), Vector3D(1_d), 1_d);
+    EXPECT_EQ(world.getObjectCount(), 3u);
+    EXPECT_EQ(ball.type, ObjectType::Sphere);
+    ASSERT_NE(world.getObject<Sphere>(ball), nullptr);
+    EXPECT_EQ(world.getObject<AABB>(ball), nullptr);
+    EXPECT_EQ(world.getObject(box)->getPosition(), Vector3D(3_d, 0_d, 2_d));
+    EXPECT_TRUE(world.getObject(ground)->isAttached());
+
+    // Swap and pop: the last body takes the index of the removed one
+    world.destroyObject(ground);
+    EXPECT_EQ(world.getObject(ground), nullptr);
+    EXPECT_EQ(world.getObjectCount(), 2u);
+    EXPECT_EQ(world.getObject(std::size_t { 0 }), world.getObject(box));
+    EXPECT_EQ(world.getObject(std::size_t { 1 }), world.getObject(ball));
+    world.destroyObject(ground);
+    EXPECT_EQ(world.getObjectCount(), 2u);
+
+    // Removing by pointer destroys an owned Object too
+    world.removeObject(world.getObject(ball));
+    EXPECT_EQ(world.getObject(ball), nullptr);
+    EXPECT_EQ(world.getObjectCount(), 1u);
+
+    // User Objects stay usable
+    Sphere user(Vector3D(5_d), 1_d, 1_d);
+    world.addObject(&user);
+    world.removeObject(&user);
+    EXPECT_FALSE(user.isAttached());
+    EXPECT_EQ(user.getPosition(), Vector3D(5_d));
+
+    world.clearObjects();
+    EXPECT_EQ(world.getObject(box), nullptr);
+}
+
+TEST(ObjectPoolTest, SceneResetsReuseTheArenas)
+{
+    PhysicsWorld world;
+    auto         buildScene = [&world]()
+    {
+        world.createObject<Plane>(Vector3D(0_d), Vector3D(10_d, 10_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+        for (int i = 0; i < 300; ++i)
+            world.createObject<Sphere>(Vector3D(static_cast<decimal>(i), 0_d, 1_d), 1_d, 1_d);
+    };
+
+    buildScene();
+    const Object* first = world.getObject(std::size_t { 1 });
+    for (int reset = 0; reset < 1000; ++reset)
+    {
+        world.initialise();
+        EXPECT_EQ(world.getObjectCount(), 0u);
+        buildScene();
+    }
+    EXPECT_EQ(world.getObjectCount(), 301u);
+    // Same memory for the same scene
+    EXPECT_EQ(world.getObject(std::size_t { 1 }), first);
+}
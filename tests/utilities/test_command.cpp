@@ -276,6 +276,28 @@ TEST_F(CommandUtilitiesTest, HandleSetCommand_SetGravity)
     EXPECT_FALSE(handleSetCommand(_world, _words));
 }
 
+TEST_F(CommandUtilitiesTest, HandleSetCommand_SetThreads)
+{
+    deque<string> words = { "threads", "2" };
+
+    testing::internal::CaptureStdout();
+    bool   result = handleSetCommand(*world, words);
+    string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_TRUE(result);
+    EXPECT_TRUE(output.find("2 thread(s)") != string::npos);
+    EXPECT_EQ(world->getThreadCount(), 2u);
+
+    words = { "deterministic", "false" };
+    testing::internal::CaptureStdout();
+    EXPECT_TRUE(handleSetCommand(*world, words));
+    testing::internal::GetCapturedStdout();
+    EXPECT_FALSE(world->getDeterministic());
+
+    world->setThreadCount(1);
+    world->setDeterministic(true);
+}
+
 TEST_F(CommandUtilitiesTest, HandleSetCommand_SetObjectProperty_InvalidObject)
 {
     // Add an object first
@@ -417,3 +439,37 @@ TEST_F(CommandUtilitiesTest, ParseWords_EdgeCases)
     deque<string> result3     = parseWords(longCommand);
     EXPECT_GE(result3.size(), 6);
 }
+
+TEST_F(CommandUtilitiesTest, HandleSetCommand_SetSleep)
+{
+    deque<string> words = { "sleep", "0.2", "1" };
+
+    testing::internal::CaptureStdout();
+    EXPECT_TRUE(handleSetCommand(*world, words));
+    string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_TRUE(output.find("Sleep energy set to 0.2 J") != string::npos);
+    EXPECT_FLOAT_EQ(static_cast<float>(world->getSleepEnergy()), 0.2f);
+    EXPECT_EQ(world->getSleepTime(), 1_d);
+
+    world->setSleepEnergy(0_d);
+    world->setSleepTime(0.5_d);
+}
+
+TEST_F(CommandUtilitiesTest, HandleSetCommand_SetContactSolver)
+{
+    deque<string> words = { "contactsolver", "SequentialImpulse", "20", "4" };
+
+    testing::internal::CaptureStdout();
+    EXPECT_TRUE(handleSetCommand(*world, words));
+    string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_TRUE(output.find("Contact solver set to SequentialImpulse (20 velocity, 4 position") !=
+                string::npos);
+    EXPECT_EQ(world->getContactSolverType(), ContactSolverType::SequentialImpulse);
+    EXPECT_EQ(world->getContactSolver().getVelocityIterations(), 20u);
+    EXPECT_EQ(world->getContactSolver().getPositionIterations(), 4u);
+
+    world->setContactSolver("Rebound");
+    world->setSolverIterations(10, 3);
+}
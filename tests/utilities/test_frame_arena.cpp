@@ -0,0 +1,92 @@
+#include "utilities/frame_arena.hpp"
+#include "utilities/thread_pool.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+// ============================================================================
+//  Allocation
+// ============================================================================
+TEST(FrameArenaTest, AllocationsAreAlignedAndDisjoint)
+{
+    FrameArena              arena(256);
+    const std::span<char>   bytes   = arena.allocate<char>(3, 'a');
+    const std::span<double> doubles = arena.allocate<double>(5, 1.5);
+    // Does not fit the first slab
+    const std::span<std::size_t> sizes = arena.allocate<std::size_t>(100, 7u);
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(doubles.data()) % alignof(double), 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(sizes.data()) % alignof(std::size_t), 0u);
+    for (const char c : bytes)
+        EXPECT_EQ(c, 'a');
+    for (const double d : doubles)
+        EXPECT_EQ(d, 1.5);
+    for (const std::size_t s : sizes)
+        EXPECT_EQ(s, 7u);
+    EXPECT_EQ(arena.getSlabCount(), 2u);
+}
+
+TEST(FrameArenaTest, ResetMergesTheSlabsOfALargeFrame)
+{
+    FrameArena arena(256);
+    for (int i = 0; i < 8; ++i)
+        arena.allocate<std::uint64_t>(40);
+    EXPECT_GT(arena.getSlabCount(), 1u);
+
+    // The next frame of the same size fits in one slab, and later ones reuse it
+    arena.reset();
+    const std::size_t capacity = arena.getCapacity();
+    EXPECT_EQ(arena.getSlabCount(), 1u);
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        for (int i = 0; i < 8; ++i)
+            arena.allocate<std::uint64_t>(40);
+        arena.reset();
+        EXPECT_EQ(arena.getSlabCount(), 1u);
+        EXPECT_EQ(arena.getCapacity(), capacity);
+    }
+}
+
+TEST(FrameArenaTest, RewindReleasesTheLaterAllocations)
+{
+    FrameArena               arena;
+    const std::span<int>     kept = arena.allocate<int>(4, 1);
+    const FrameArena::Marker mark = arena.mark();
+    const std::span<int>     temp = arena.allocate<int>(16, 2);
+    arena.rewind(mark);
+    const std::span<int> next = arena.allocate<int>(16, 3);
+
+    EXPECT_EQ(next.data(), temp.data());
+    for (const int k : kept)
+        EXPECT_EQ(k, 1);
+}
+
+// ============================================================================
+//  Threads
+// ============================================================================
+TEST(FrameArenaTest, ThreadsAllocateInTheirOwnLane)
+{
+    ThreadPool pool(4);
+    FrameArena arena(1024);
+    arena.setThreadPool(&pool);
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        const std::size_t                   chunks = 64;
+        std::vector<std::span<std::size_t>> spans(chunks);
+        pool.parallelFor(0, chunks, 1,
+                         [&](std::size_t first, std::size_t)
+                         { spans[first] = arena.allocate<std::size_t>(50, first); });
+
+        // No chunk overwrote the memory of another one
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            for (const std::size_t value : spans[chunk])
+                ASSERT_EQ(value, chunk);
+        }
+        arena.reset();
+        EXPECT_LE(arena.getSlabCount(), pool.getThreadCount());
+    }
+}
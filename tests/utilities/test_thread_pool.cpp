@@ -0,0 +1,73 @@
+#include "utilities/thread_pool.hpp"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+//  Execution
+// ============================================================================
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce)
+{
+    ThreadPool pool(8);
+    EXPECT_EQ(pool.getThreadCount(), 8u);
+
+    // Odd sizes: the last chunk is shorter than the grain
+    const std::size_t                     begin = 3;
+    const std::size_t                     end   = 10007;
+    std::vector<std::atomic<int>>         visits(end);
+    std::vector<std::atomic<std::size_t>> chunkSizes(ThreadPool::chunkCount(begin, end, 7));
+    pool.parallelFor(begin, end, 7,
+                     [&](std::size_t first, std::size_t last)
+                     {
+                         chunkSizes[(first - begin) / 7] = last - first;
+                         for (std::size_t i = first; i < last; ++i)
+                             ++visits[i];
+                     });
+
+    for (std::size_t i = 0; i < end; ++i)
+        EXPECT_EQ(visits[i].load(), i < begin ? 0 : 1) << i;
+    for (std::size_t c = 0; c + 1 < chunkSizes.size(); ++c)
+        EXPECT_EQ(chunkSizes[c].load(), 7u);
+    EXPECT_EQ(chunkSizes.back().load(), (end - begin) % 7);
+}
+
+TEST(ThreadPoolTest, SingleThreadRunsInline)
+{
+    ThreadPool      pool(1);
+    std::thread::id id;
+    pool.parallelFor(0, 100, 10, [&](std::size_t, std::size_t) { id = std::this_thread::get_id(); });
+    EXPECT_EQ(id, std::this_thread::get_id());
+    EXPECT_GE(ThreadPool(0).getThreadCount(), 1u);
+}
+
+TEST(ThreadPoolTest, NestedCallsComplete)
+{
+    ThreadPool       pool(4);
+    std::atomic<int> sum { 0 };
+
+    auto count = [&](std::size_t first, std::size_t last) { sum += static_cast<int>(last - first); };
+    pool.run(16, [&](std::size_t) { pool.parallelFor(0, 64, 4, count); });
+    EXPECT_EQ(sum.load(), 16 * 64);
+}
+
+TEST(ThreadPoolTest, RunRethrowsTaskException)
+{
+    ThreadPool       pool(4);
+    std::atomic<int> done { 0 };
+    EXPECT_THROW(pool.run(32,
+                          [&](std::size_t i)
+                          {
+                              if (i == 5)
+                                  throw std::runtime_error("task failed");
+                              ++done;
+                          }),
+                 std::runtime_error);
+    EXPECT_EQ(done.load(), 31);
+
+    // The pool stays usable
+    pool.run(8, [&](std::size_t) { ++done; });
+    EXPECT_EQ(done.load(), 39);
+}
@@ -13,6 +13,7 @@ TEST(TimerTest, MeasuresElapsedTime)
     const auto us  = timer.elapsedMicroseconds();
     const auto ms  = timer.elapsedMilliseconds();
     const auto sec = timer.elapsedSeconds();
+    const auto ns  = timer.elapsedNanoseconds();
 
     // --- Sanity checks ---
     EXPECT_GT(us, 0);
@@ -22,6 +23,7 @@ TEST(TimerTest, MeasuresElapsedTime)
     // --- Consistency checks ---
     EXPECT_NEAR(ms, us / 1000.0, 0.5); // allow rounding tolerance
     EXPECT_NEAR(sec, ms / 1000.0, 0.001);
+    EXPECT_GE(ns, us * 1000);
 
     // --- Reset test ---
     timer.reset();
@@ -30,3 +32,36 @@ TEST(TimerTest, MeasuresElapsedTime)
     EXPECT_GT(usAfterReset, 0);
     EXPECT_LT(usAfterReset, us); // after reset, elapsed should be smaller
 }
+
+TEST(LatencyHistogramTest, BucketsAndPercentiles)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.getCount(), 0u);
+    EXPECT_EQ(histogram.getPercentile(0.5_d), 0);
+
+    // 90 steps of 1 us and 10 of 1 ms: buckets [512, 1024) ns and [2^19, 2^20) ns
+    for (int i = 0; i < 90; ++i)
+        histogram.record(1000);
+    for (int i = 0; i < 10; ++i)
+        histogram.record(1000000);
+    EXPECT_EQ(histogram.getBucket(9), 90u);
+    EXPECT_EQ(histogram.getBucket(19), 10u);
+    EXPECT_EQ(histogram.getMin(), 1000);
+    EXPECT_EQ(histogram.getMax(), 1000000);
+    EXPECT_NEAR(histogram.getMean(), 100900_d, 1e-3_d);
+
+    // Bucket bounds, capped by the maximum
+    EXPECT_EQ(histogram.getPercentile(0.5_d), 1023);
+    EXPECT_EQ(histogram.getPercentile(0.9_d), 1023);
+    EXPECT_EQ(histogram.getPercentile(0.99_d), 1000000);
+
+    // Negative durations count as 0, in the first bucket
+    histogram.record(-5);
+    EXPECT_EQ(histogram.getBucket(0), 1u);
+    EXPECT_EQ(histogram.getMin(), 0);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.getCount(), 0u);
+    EXPECT_EQ(histogram.getBucket(9), 0u);
+    EXPECT_EQ(histogram.getMean(), 0_d);
+}
@@ -0,0 +1,262 @@
+#include "mathematics/simd.hpp"
+#include "objects/sphere.hpp"
+#include "world/batch_integrators.hpp"
+#include "world/physicsWorld.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+/// Random bodies, every third one fixed; the count is not a multiple of the SIMD width, to cover the tail
+/// loop.
+struct BatchScene
+{
+    std::vector<std::unique_ptr<Sphere>> spheres;
+    BodyStorage                          storage;
+
+    explicit BatchScene(std::size_t count)
+    {
+        std::mt19937                            rng(42);
+        std::uniform_real_distribution<decimal> dist(-5_d, 5_d);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto sphere = std::make_unique<Sphere>(Vector3D(dist(rng), dist(rng), dist(rng)), 0.1_d,
+                                                   Vector3D(dist(rng), dist(rng), dist(rng)), 1_d);
+            sphere->setAcceleration(Vector3D(dist(rng), dist(rng), dist(rng)));
+            if (i % 3 == 0)
+                sphere->setIsFixed(true);
+            spheres.push_back(std::move(sphere));
+        }
+    }
+    void attach()
+    {
+        for (auto& sphere : spheres)
+            storage.add(*sphere);
+    }
+};
+
+constexpr std::size_t bodyCount = 4 * 16 + 3;
+
+// ============================================================================
+//  Kernels
+// ============================================================================
+TEST(BatchIntegratorsTest, EulerMatchesPerObject)
+{
+    BatchScene batch(bodyCount);
+    BatchScene reference(bodyCount);
+    batch.attach();
+
+    PhysicsWorld world;
+    const decimal dt = 0.01_d;
+    BatchIntegrators::euler(batch.storage.getPositions(), batch.storage.getVelocities(),
+                            batch.storage.getAccelerations(), batch.storage.getMotionMasks(), dt);
+    for (std::size_t i = 0; i < bodyCount; ++i)
+    {
+        Sphere& expected = *reference.spheres[i];
+        if (!expected.isFixed())
+            world.integrateEuler(expected, dt);
+        EXPECT_EQ(batch.spheres[i]->getPosition(), expected.getPosition()) << i;
+        EXPECT_EQ(batch.spheres[i]->getVelocity(), expected.getVelocity()) << i;
+    }
+}
+
+TEST(BatchIntegratorsTest, KickDriftKickMatchesScalarVerlet)
+{
+    BatchScene batch(bodyCount);
+    BatchScene reference(bodyCount);
+    batch.attach();
+
+    const decimal  dt      = 0.02_d;
+    const Vector3D nextAcc = Vector3D(0.5_d, -1_d, -9.81_d);
+    BodyStorage&   storage = batch.storage;
+
+    BatchIntegrators::kickDrift(storage.getPositions(), storage.getVelocities(), storage.getAccelerations(),
+                                storage.getMotionMasks(), 0.5_d * dt, dt);
+    for (auto& sphere : batch.spheres)
+        sphere->setAcceleration(nextAcc);
+    BatchIntegrators::kick(storage.getVelocities(), storage.getAccelerations(), storage.getMotionMasks(),
+                           0.5_d * dt);
+
+    for (std::size_t i = 0; i < bodyCount; ++i)
+    {
+        Sphere& expected = *reference.spheres[i];
+        if (!expected.isFixed())
+        {
+            expected.setVelocity(expected.getVelocity() + expected.getAcceleration() * (0.5_d * dt));
+            expected.setPosition(expected.getPosition() + expected.getVelocity() * dt);
+            expected.setVelocity(expected.getVelocity() + nextAcc * (0.5_d * dt));
+        }
+        EXPECT_EQ(batch.spheres[i]->getPosition(), expected.getPosition()) << i;
+        EXPECT_EQ(batch.spheres[i]->getVelocity(), expected.getVelocity()) << i;
+    }
+}
+
+TEST(BatchIntegratorsTest, EmptySlotsAreLeftUntouched)
+{
+    BatchScene batch(5);
+    batch.attach();
+    const Vector3D position = batch.spheres[1]->getPosition();
+    batch.spheres[1].reset();
+
+    BatchIntegrators::euler(batch.storage.getPositions(), batch.storage.getVelocities(),
+                            batch.storage.getAccelerations(), batch.storage.getMotionMasks(), 0.1_d);
+    EXPECT_EQ(batch.storage.getPositions().get(1), position);
+    EXPECT_NE(std::string(simd::name()), "");
+}
+
+// ============================================================================
+//  World
+// ============================================================================
+TEST(BatchIntegratorsTest, WorldSolversMatchPerObject)
+{
+    for (const std::string solver : { "Euler", "Verlet", "RK4" })
+    {
+        PhysicsWorld world;
+        world.setSolver(solver);
+        world.setGravityAcc(Vector3D(0_d, 0_d, -9.81_d));
+
+        // Far apart bodies: only gravity acts, so the per-object path gives the same result
+        std::vector<std::unique_ptr<Sphere>> spheres;
+        for (int i = 0; i < 11; ++i)
+        {
+            spheres.push_back(std::make_unique<Sphere>(Vector3D(10_d * i, 0_d, 5_d), 0.1_d,
+                                                       Vector3D(1_d, 0_d, 2_d), 1_d));
+            world.addObject(spheres.back().get());
+        }
+        PhysicsWorld solo; // integrates the reference without any neighbour
+        solo.setGravityAcc(world.getGravityAcc());
+        Sphere reference(Vector3D(0_d, 0_d, 5_d), 0.1_d, Vector3D(1_d, 0_d, 2_d), 1_d);
+
+        world.start();
+        for (int step = 0; step < 20; ++step)
+        {
+            world.integrateWithoutCollisions();
+
+            reference.setAcceleration(Vector3D(0_d, 0_d, -9.81_d));
+            if (solver == "Euler")
+                solo.integrateEuler(reference, world.getTimeStep());
+            else if (solver == "Verlet")
+                solo.integrateVerlet(reference, world.getTimeStep());
+            else
+                solo.integrateRK4(reference, world.getTimeStep());
+        }
+        // World-level RK4 sums the stages in another order: allow for rounding
+        for (int i = 0; i < 3; ++i)
+        {
+            EXPECT_NEAR(spheres[0]->getPosition()[i], reference.getPosition()[i], 1e-5_d) << solver;
+            EXPECT_NEAR(spheres[0]->getVelocity()[i], reference.getVelocity()[i], 1e-5_d) << solver;
+        }
+        world.clearObjects();
+    }
+}
+
+// ============================================================================
+//  World-level RK4
+// ============================================================================
+TEST(BatchIntegratorsTest, RK4IsExactForConstantAcceleration)
+{
+    PhysicsWorld world;
+    world.setSolver("RK4");
+    world.setTimeStep(0.01_d);
+    world.setGravityAcc(Vector3D(0_d, 0_d, -10_d));
+
+    Sphere projectile(Vector3D(0_d, 0_d, 10_d), 0.2_d, Vector3D(2_d, 0_d, 5_d), 1_d);
+    Sphere anchor(Vector3D(100_d), 1_d);
+    world.addObject(&projectile);
+    world.addObject(&anchor);
+
+    world.start();
+    for (int step = 0; step < 50; ++step)
+        world.integrateWithoutCollisions();
+
+    const decimal t = 0.5_d;
+    EXPECT_NEAR(projectile.getPosition()[0], 2_d * t, 1e-4_d);
+    EXPECT_NEAR(projectile.getPosition()[2], 10_d + 5_d * t - 5_d * t * t, 1e-4_d);
+    EXPECT_NEAR(projectile.getVelocity()[2], 5_d - 10_d * t, 1e-4_d);
+    EXPECT_EQ(anchor.getPosition(), Vector3D(100_d));
+    world.clearObjects();
+}
+
+TEST(BatchIntegratorsTest, RK4ConservesMomentumOfCoupledBodies)
+{
+    PhysicsWorld world;
+    world.setSolver("RK4");
+    world.setTimeStep(1e-3_d);
+    world.setGravityAcc(Vector3D(0_d));
+
+    // Overlapping spheres pushed apart by their contact spring
+    Sphere a(Vector3D(0_d), 1_d, Vector3D(1_d, 0_d, 0_d), 1_d);
+    Sphere b(Vector3D(0.8_d, 0.1_d, 0_d), 1_d, Vector3D(-0.5_d, 0_d, 0_d), 3_d);
+    a.setStiffnessCst(100_d);
+    b.setStiffnessCst(100_d);
+    world.addObject(&a);
+    world.addObject(&b);
+
+    const Vector3D momentum = a.getVelocity() * a.getMass() + b.getVelocity() * b.getMass();
+    world.start();
+    for (int step = 0; step < 20; ++step)
+    {
+        world.resetAcc();
+        world.integrateRK4Bodies(world.getTimeStep());
+    }
+
+    const Vector3D after = a.getVelocity() * a.getMass() + b.getVelocity() * b.getMass();
+    EXPECT_NE(a.getVelocity(), Vector3D(1_d, 0_d, 0_d));
+    for (int i = 0; i < 3; ++i)
+        EXPECT_NEAR(after[i], momentum[i], 1e-4_d);
+    world.clearObjects();
+}
+
+// ============================================================================
+//  World-level velocity Verlet
+// ============================================================================
+TEST(BatchIntegratorsTest, VerletEvaluatesForcesOncePerStep)
+{
+    PhysicsWorld world;
+    world.setSolver("Verlet");
+    world.setGravityAcc(Vector3D(0_d, 0_d, -9.81_d));
+
+    std::vector<std::unique_ptr<Sphere>> spheres;
+    for (int i = 0; i < 50; ++i)
+    {
+        spheres.push_back(std::make_unique<Sphere>(Vector3D(3_d * i, 0_d, 5_d), 1_d, 1_d));
+        world.addObject(spheres.back().get());
+    }
+
+    world.start();
+    world.integrateWithoutCollisions(); // first step also evaluates the starting accelerations
+    const std::size_t first = world.getForceEvaluationCount();
+    for (int step = 0; step < 10; ++step)
+        world.integrateWithoutCollisions();
+    EXPECT_EQ(world.getForceEvaluationCount(), first + 10);
+    world.clearObjects();
+}
+
+TEST(BatchIntegratorsTest, VerletConservesMomentumOfCoupledBodies)
+{
+    PhysicsWorld world;
+    world.setSolver("Verlet");
+    world.setTimeStep(1e-3_d);
+    world.setGravityAcc(Vector3D(0_d));
+
+    Sphere a(Vector3D(0_d), 1_d, Vector3D(1_d, 0_d, 0_d), 1_d);
+    Sphere b(Vector3D(0.8_d, 0.1_d, 0_d), 1_d, Vector3D(-0.5_d, 0_d, 0_d), 3_d);
+    a.setStiffnessCst(100_d);
+    b.setStiffnessCst(100_d);
+    world.addObject(&a);
+    world.addObject(&b);
+
+    const Vector3D momentum = a.getVelocity() * a.getMass() + b.getVelocity() * b.getMass();
+    for (int step = 0; step < 20; ++step)
+        world.integrateVerletBodies(world.getTimeStep());
+
+    const Vector3D after = a.getVelocity() * a.getMass() + b.getVelocity() * b.getMass();
+    EXPECT_NE(a.getVelocity(), Vector3D(1_d, 0_d, 0_d));
+    for (int i = 0; i < 3; ++i)
+        EXPECT_NEAR(after[i], momentum[i], 1e-4_d);
+    world.clearObjects();
+}
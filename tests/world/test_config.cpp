@@ -82,6 +82,45 @@ TEST(ConfigTest, OverrideFromCommandLine)
     EXPECT_DECIMAL_EQ(config.getGravity(), 12.5_d);
     EXPECT_DECIMAL_EQ(config.getTimeStep(), 0.002_d);   // unchanged
     EXPECT_DECIMAL_EQ(config.getMaxIterations(), 200u); // unchanged
+
+    const char* ccd[] = { "program", "--continuouscollision", "yes" };
+    config.overrideFromCommandLine(3, const_cast<char**>(ccd));
+    EXPECT_TRUE(config.getContinuousCollision());
+    config.setContinuousCollision(false);
+
+    const char* events[] = { "program", "--eventdriven", "1" };
+    config.overrideFromCommandLine(3, const_cast<char**>(events));
+    EXPECT_TRUE(config.getEventDriven());
+    config.setEventDriven(false);
+
+    const char* caching[] = { "program", "--paircaching", "0" };
+    config.overrideFromCommandLine(3, const_cast<char**>(caching));
+    EXPECT_FALSE(config.getPairCaching());
+    config.setPairCaching(true);
+
+    const char* tolerances[] = { "program", "--abstolerance", "1e-8", "--reltolerance", "0" };
+    config.overrideFromCommandLine(5, const_cast<char**>(tolerances));
+    EXPECT_DECIMAL_EQ(config.getAbsTolerance(), 1e-8_d);
+    EXPECT_DECIMAL_EQ(config.getRelTolerance(), 0_d);
+    EXPECT_THROW(config.setAbsTolerance(0_d), std::invalid_argument);
+    EXPECT_THROW(config.setRelTolerance(-1_d), std::invalid_argument);
+    config.setAbsTolerance(1e-5_d);
+    config.setRelTolerance(1e-5_d);
+
+    const char* levels[] = { "program", "--maxtimelevel", "3" };
+    config.overrideFromCommandLine(3, const_cast<char**>(levels));
+    EXPECT_EQ(config.getMaxTimeLevel(), 3u);
+    EXPECT_THROW(config.setMaxTimeLevel(17), std::invalid_argument);
+    config.setMaxTimeLevel(0);
+
+    const char* pacing[] = { "program", "--realtimefactor", "10", "--outputrate", "60" };
+    config.overrideFromCommandLine(5, const_cast<char**>(pacing));
+    EXPECT_DECIMAL_EQ(config.getRealTimeFactor(), 10_d);
+    EXPECT_DECIMAL_EQ(config.getOutputRate(), 60_d);
+    EXPECT_THROW(config.setRealTimeFactor(-1_d), std::invalid_argument);
+    EXPECT_THROW(config.setOutputRate(-1_d), std::invalid_argument);
+    config.setRealTimeFactor(0_d);
+    config.setOutputRate(0_d);
 }
 
 TEST(ConfigTest, OverrideFromCommandLineInvalid)
@@ -317,3 +317,58 @@ TEST(PhysicsTest, ContactForceWithConstants)
         Physics::computeNormalForce(obj1, obj2, e, k) + Physics::computeFrictionForce(obj1, obj2, mu, e, k);
     EXPECT_VECTOR_EQ(f, f_exp);
 }
+
+// ============================================================================
+// Fused contact force
+// ============================================================================
+TEST(PhysicsTest, FusedContactForceMatchesSeparateTerms)
+{
+    auto reference = [](const Object& obj1, const Object& obj2)
+    {
+        return Physics::computeSpringForce(obj1, obj2) + Physics::computeDampingForce(obj1, obj2) +
+               Physics::computeFrictionForce(obj1, obj2);
+    };
+    auto fused = [](const Object& obj1, const Object& obj2)
+    {
+        const Physics::ContactModel model = Physics::computeContactModel(obj1, obj2);
+        return Physics::computeContactForce(model, obj2.getPosition() - obj1.getPosition(),
+                                            obj2.getVelocity() - obj1.getVelocity());
+    };
+
+    DummyObject obj1(1_d), obj2(2_d);
+    obj1.setPosition(Vector3D(0_d));
+    obj2.setPosition(Vector3D(0.8_d, 0.3_d, -0.1_d));
+    obj1.setVelocity(Vector3D(0.5_d, 1_d, 0_d));
+    obj2.setVelocity(Vector3D(-1_d, 0_d, 0.2_d));
+
+    // No stiffness: no force at all
+    EXPECT_VECTOR_EQ(fused(obj1, obj2), Vector3D(0_d));
+    EXPECT_VECTOR_EQ(fused(obj1, obj2), reference(obj1, obj2));
+
+    // Spring and damping, no friction
+    obj1.setStiffnessCst(2_d);
+    obj2.setStiffnessCst(3_d);
+    obj1.setRestitutionCst(0.5_d);
+    obj2.setRestitutionCst(0.8_d);
+    EXPECT_VECTOR_EQ(fused(obj1, obj2), reference(obj1, obj2));
+
+    // All three terms
+    obj1.setFrictionCst(0.5_d);
+    obj2.setFrictionCst(0.3_d);
+    EXPECT_VECTOR_EQ(fused(obj1, obj2), reference(obj1, obj2));
+    EXPECT_VECTOR_EQ(fused(obj2, obj1), reference(obj2, obj1));
+
+    // Static object: no reduced mass, hence no damping
+    obj2.setMass(0_d);
+    EXPECT_VECTOR_EQ(fused(obj1, obj2), reference(obj1, obj2));
+
+    // Relative velocity along the normal only: no friction
+    obj2.setMass(2_d);
+    obj1.setVelocity(Vector3D(0_d));
+    obj2.setVelocity(Vector3D(0.8_d, 0.3_d, -0.1_d));
+    EXPECT_VECTOR_EQ(fused(obj1, obj2), reference(obj1, obj2));
+
+    // Same position
+    obj2.setPosition(Vector3D(0_d));
+    EXPECT_VECTOR_EQ(fused(obj1, obj2), Vector3D(0_d));
+}
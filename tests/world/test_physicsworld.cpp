@@ -1,8 +1,22 @@
+#include "allocation_counter.hpp"
+#include "objects/aabb.hpp"
 #include "objects/object.hpp"
+#include "objects/plane.hpp"
+#include "objects/sphere.hpp"
 #include "test_functions.hpp"
 #include "world/physicsWorld.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
 
 // Dummy Object implementation for testing
 struct DummyObject : public Object
@@ -47,6 +61,12 @@ TEST_F(PhysicsWorldTest, SetSolverParses)
     world.setSolver("RK4");
     EXPECT_EQ(world.getSolver(), Solver::RK4);
 
+    world.setSolver("BS32");
+    EXPECT_EQ(world.getSolver(), Solver::BS32);
+
+    world.setSolver("Implicit");
+    EXPECT_EQ(world.getSolver(), Solver::Implicit);
+
     world.setSolver("gkjrehogidrjlgmksj");
     EXPECT_EQ(world.getSolver(), Solver::Unknown);
     world.integrate(); // should not throw
@@ -237,3 +257,704 @@ TEST_F(PhysicsWorldTest, Collision)
     EXPECT_VECTOR_EQ(objB.getAcceleration(), Vector3D(0_d));
     EXPECT_VECTOR_EQ(objFixed.getAcceleration(), Vector3D(0_d));
 }
+
+// ============================================================================
+//  Multithreaded step
+// ============================================================================
+/// Final state of a packed block of spheres resting on a plane, stepped on `threads` threads.
+static std::vector<Vector3D> runPackedBlock(const std::string& solver, std::size_t threads,
+                                            bool deterministic)
+{
+    PhysicsWorld world;
+    world.setSolver(solver);
+    world.setBroadPhase("SweepAndPrune");
+    world.setTimeStep(1e-3_d);
+    world.setThreadCount(threads);
+    world.setDeterministic(deterministic);
+
+    // More bodies than one chunk of the array kernels, overlapping so that every pass has work
+    Plane ground(Vector3D(0_d), Vector3D(100_d, 100_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    world.addObject(&ground);
+    std::vector<std::unique_ptr<Sphere>> spheres;
+    for (std::size_t i = 0; i < 4200; ++i)
+    {
+        const Vector3D position(static_cast<decimal>(i % 25) * 0.35_d,
+                                static_cast<decimal>((i / 25) % 20) * 0.35_d,
+                                static_cast<decimal>(i / 500) * 0.35_d + 0.15_d);
+        spheres.push_back(std::make_unique<Sphere>(position, 0.4_d, Vector3D(0.1_d, 0_d, -1_d), 1_d));
+        world.addObject(spheres.back().get());
+    }
+
+    world.start();
+    for (int step = 0; step < 2; ++step)
+        world.integrate();
+
+    std::vector<Vector3D> state;
+    for (const auto& sphere : spheres)
+    {
+        state.push_back(sphere->getPosition());
+        state.push_back(sphere->getVelocity());
+    }
+    world.clearObjects();
+    world.setThreadCount(1);
+    world.setDeterministic(true);
+    return state;
+}
+
+TEST(PhysicsWorldThreadsTest, DeterministicStepIsBitIdentical)
+{
+    for (const std::string solver : { "Euler", "Verlet", "RK4", "BS32", "Implicit" })
+    {
+        const std::vector<Vector3D> reference = runPackedBlock(solver, 1, true);
+        const std::vector<Vector3D> threaded  = runPackedBlock(solver, 4, true);
+        ASSERT_EQ(threaded.size(), reference.size());
+        for (std::size_t i = 0; i < reference.size(); ++i)
+            ASSERT_EQ(threaded[i], reference[i]) << solver << " " << i;
+    }
+}
+
+TEST(PhysicsWorldThreadsTest, ThreadCountComesFromConfig)
+{
+    Config& config = Config::get();
+    config.setThreadCount(3);
+    config.setDeterministic(false);
+    PhysicsWorld world(config);
+    EXPECT_EQ(world.getThreadCount(), 3u);
+    EXPECT_FALSE(world.getDeterministic());
+
+    // Start-of-pass contacts: a valid step, no longer tied to the single-thread result
+    for (const Vector3D& v : runPackedBlock("Euler", 4, false))
+        ASSERT_TRUE(std::isfinite(v[0]) && std::isfinite(v[1]) && std::isfinite(v[2]));
+
+    world.setThreadCount(1);
+    world.setDeterministic(true);
+    EXPECT_EQ(config.getThreadCount(), 1u);
+}
+
+// ============================================================================
+//  Sleeping
+// ============================================================================
+/// World with sleeping enabled, restoring the shared config on destruction.
+struct SleepingWorld
+{
+    PhysicsWorld world;
+    Plane        ground { Vector3D(0_d), Vector3D(20_d, 20_d, 0_d), Vector3D(0_d, 0_d, 1_d) };
+
+    SleepingWorld()
+    {
+        world.setSolver("Euler");
+        world.setTimeStep(0.01_d);
+        world.setSleepEnergy(0.05_d);
+        world.setSleepTime(0.3_d);
+        world.addObject(&ground);
+        world.start();
+    }
+    ~SleepingWorld()
+    {
+        world.clearObjects();
+        world.setSleepEnergy(0_d);
+        world.setSleepTime(0.5_d);
+    }
+    void run(int steps)
+    {
+        for (int i = 0; i < steps; ++i)
+            world.integrate();
+    }
+};
+
+TEST(PhysicsWorldSleepTest, RestingBodiesFallAsleepAndStop)
+{
+    SleepingWorld scene;
+    Sphere        ball(Vector3D(0_d, 0_d, 0.6_d), 1_d, 1_d);
+    Sphere        thrown(Vector3D(5_d, 0_d, 0.5_d), 1_d, Vector3D(20_d, 0_d, 0_d), 1_d);
+    scene.world.addObject(&ball);
+    scene.world.addObject(&thrown);
+
+    scene.run(100);
+    EXPECT_TRUE(ball.isSleeping());
+    EXPECT_FALSE(thrown.isSleeping());
+    EXPECT_EQ(scene.world.getSleepingCount(), 1u);
+    EXPECT_EQ(scene.world.getAwakeCount(), 1u);
+
+    // Left out of the integration and of the broad phase
+    const Vector3D rest = ball.getPosition();
+    scene.run(10);
+    EXPECT_EQ(ball.getPosition(), rest);
+    EXPECT_EQ(ball.getVelocity(), Vector3D(0_d));
+    for (const CollisionPair& pair : scene.world.getCandidatePairs())
+        EXPECT_NE(pair.second, 1u);
+
+    // A setter wakes it up
+    ball.setVelocity(Vector3D(0_d, 0_d, 3_d));
+    EXPECT_FALSE(ball.isSleeping());
+    scene.run(1);
+    EXPECT_GT(ball.getPosition()[2], rest[2]);
+}
+
+TEST(PhysicsWorldSleepTest, PilesSleepAndWakeAsIslands)
+{
+    SleepingWorld scene;
+    Sphere        bottom(Vector3D(0_d, 0_d, 0.5_d), 1_d, 1_d);
+    Sphere        top(Vector3D(0_d, 0_d, 1.5_d), 1_d, 1_d);
+    Sphere        other(Vector3D(5_d, 0_d, 0.5_d), 1_d, 1_d);
+    scene.world.addObject(&bottom);
+    scene.world.addObject(&top);
+    scene.world.addObject(&other);
+
+    scene.run(100);
+    ASSERT_TRUE(bottom.isSleeping());
+    ASSERT_TRUE(top.isSleeping());
+    ASSERT_TRUE(other.isSleeping());
+
+    // Dropped on the top sphere: the whole pile wakes up, the other pile sleeps on
+    Sphere falling(Vector3D(0_d, 0_d, 3_d), 1_d, Vector3D(0_d, 0_d, -5_d), 1_d);
+    scene.world.addObject(&falling);
+    for (int i = 0; i < 50 && top.isSleeping(); ++i)
+        scene.run(1);
+    EXPECT_FALSE(top.isSleeping());
+    EXPECT_FALSE(bottom.isSleeping());
+    EXPECT_TRUE(other.isSleeping());
+}
+
+TEST(PhysicsWorldSleepTest, BodyEnergyOverridesTheWorldOne)
+{
+    SleepingWorld scene;
+    scene.world.setSleepEnergy(0_d);
+    Sphere sleeper(Vector3D(0_d, 0_d, 0.5_d), 1_d, 1_d);
+    Sphere insomniac(Vector3D(5_d, 0_d, 0.5_d), 1_d, 1_d);
+    sleeper.setSleepEnergy(0.05_d);
+    scene.world.addObject(&sleeper);
+    scene.world.addObject(&insomniac);
+
+    scene.run(100);
+    EXPECT_TRUE(sleeper.isSleeping());
+    EXPECT_FALSE(insomniac.isSleeping());
+}
+
+// ============================================================================
+//  Continuous collision
+// ============================================================================
+/// Lowest height reached over `steps` steps of 0.1 s by a ball thrown down at 100 m/s onto the ground.
+static decimal lowestHeight(PhysicsWorld& world, Sphere& ball, int steps)
+{
+    world.setSolver("Euler");
+    world.setTimeStep(0.1_d);
+    world.createObject<Plane>(Vector3D(0_d), Vector3D(20_d, 20_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    world.addObject(&ball);
+    world.start();
+
+    decimal lowest = ball.getPosition()[2];
+    for (int step = 0; step < steps; ++step)
+    {
+        world.integrate();
+        lowest = std::min(lowest, ball.getPosition()[2]);
+    }
+    world.clearObjects();
+    return lowest;
+}
+
+TEST(PhysicsWorldContinuousTest, FastSphereStopsAtTheGround)
+{
+    // Discrete steps: the ball moves 10 m per step and passes through the ground
+    PhysicsWorld discrete;
+    Sphere       lost(Vector3D(0_d, 0_d, 5_d), 1_d, Vector3D(0_d, 0_d, -100_d), 1_d);
+    EXPECT_LT(lowestHeight(discrete, lost, 5), -0.5_d);
+
+    // Swept: stopped at the impact, then bounced back
+    PhysicsWorld swept;
+    swept.setContinuousCollision(true);
+    Sphere bounced(Vector3D(0_d, 0_d, 5_d), 1_d, Vector3D(0_d, 0_d, -100_d), 1_d);
+    EXPECT_GT(lowestHeight(swept, bounced, 5), 0_d);
+    EXPECT_GT(bounced.getVelocity()[2], 0_d);
+    swept.setContinuousCollision(false);
+    EXPECT_FALSE(Config::get().getContinuousCollision());
+}
+
+TEST(PhysicsWorldContinuousTest, ObjectsCanBeSweptAlone)
+{
+    PhysicsWorld world;
+    Sphere       swept(Vector3D(0_d, 0_d, 5_d), 1_d, Vector3D(0_d, 0_d, -100_d), 1_d);
+    Sphere       lost(Vector3D(5_d, 0_d, 5_d), 1_d, Vector3D(0_d, 0_d, -100_d), 1_d);
+    swept.setIsContinuous(true);
+    world.addObject(&lost);
+    EXPECT_TRUE(swept.getIsContinuous());
+    EXPECT_GT(lowestHeight(world, swept, 5), 0_d);
+    EXPECT_LT(lost.getPosition()[2], -0.5_d);
+}
+
+// ============================================================================
+//  Event-driven stepping
+// ============================================================================
+TEST(PhysicsWorldEventTest, FreeFlightIsSkippedInOneJump)
+{
+    PhysicsWorld world;
+    world.setSolver("Euler");
+    world.setTimeStep(1e-3_d);
+    world.createObject<Plane>(Vector3D(0_d), Vector3D(200_d, 200_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    Sphere ball(Vector3D(0_d, 0_d, 20_d), 1_d, Vector3D(5_d, 0_d, 0_d), 1_d);
+    world.addObject(&ball);
+    world.start();
+
+    // Jumps to the last step before the ball can reach the ground, along the exact parabola
+    const decimal     g       = -world.getGravityAcc()[2];
+    const decimal     landing = std::sqrt(2_d * 19.5_d / g);
+    const std::size_t steps   = world.fastForward(100000);
+    const decimal     t       = static_cast<decimal>(steps) * 1e-3_d;
+    EXPECT_LE(t, landing);
+    EXPECT_GT(t, landing - 2e-3_d);
+    EXPECT_NEAR(ball.getPosition()[0], 5_d * t, 1e-4_d);
+    EXPECT_NEAR(ball.getPosition()[2], 20_d - 0.5_d * g * t * t, 1e-3_d);
+    EXPECT_NEAR(ball.getVelocity()[2], -g * t, 1e-3_d);
+    EXPECT_EQ(world.getFastForwardCount(), 1u);
+
+    // Within a step of the contact: stepped as usual
+    EXPECT_EQ(world.fastForward(100000), 0u);
+    world.clearObjects();
+}
+
+TEST(PhysicsWorldEventTest, ContactsAreStepped)
+{
+    PhysicsWorld world;
+    world.setTimeStep(1e-3_d);
+    world.createObject<Plane>(Vector3D(0_d), Vector3D(200_d, 200_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    const ObjectHandle resting = world.createObject<Sphere>(Vector3D(0_d, 0_d, 0.5_d), 1_d, 1_d);
+    world.start();
+    EXPECT_EQ(world.fastForward(100), 0u);
+
+    // Two spheres closing in at 10 m/s, 19 m apart: linear relative motion under the same gravity
+    world.destroyObject(resting);
+    Sphere left(Vector3D(-10_d, 0_d, 50_d), 1_d, Vector3D(5_d, 0_d, 0_d), 1_d);
+    Sphere right(Vector3D(10_d, 0_d, 50_d), 1_d, Vector3D(-5_d, 0_d, 0_d), 1_d);
+    world.addObject(&left);
+    world.addObject(&right);
+    const std::size_t steps = world.fastForward(100000);
+    EXPECT_GT(steps, 1800u);
+    EXPECT_LE(steps, 1900u);
+    EXPECT_GE(right.getPosition()[0] - left.getPosition()[0], 1_d);
+    world.clearObjects();
+}
+
+TEST(PhysicsWorldEventTest, JumpStopsBeforeTheFirstContactOfManyBodies)
+{
+    PhysicsWorld world;
+    world.setSolver("Euler");
+    world.setTimeStep(1e-3_d);
+    world.setThreadCount(4);
+    world.createObject<Plane>(Vector3D(0_d), Vector3D(400_d, 400_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    std::mt19937                            rng(7);
+    std::uniform_real_distribution<decimal> speed(-2_d, 2_d);
+    std::vector<std::unique_ptr<Sphere>>    balls;
+    for (int i = 0; i < 216; ++i)
+    {
+        const Vector3D position(static_cast<decimal>(i % 6) * 7_d, static_cast<decimal>(i / 6 % 6) * 7_d,
+                                30_d + static_cast<decimal>(i / 36) * 7_d);
+        balls.push_back(
+            std::make_unique<Sphere>(position, 2_d, Vector3D(speed(rng), speed(rng), speed(rng)), 1_d));
+        world.addObject(balls.back().get());
+    }
+    world.start();
+
+    // Exact time of the first contact, and the lower bound of every pair checked against every other one
+    const decimal g     = -world.getGravityAcc()[2];
+    decimal       exact = std::numeric_limits<decimal>::infinity();
+    decimal       bound = std::numeric_limits<decimal>::infinity();
+    for (std::size_t i = 0; i < balls.size(); ++i)
+    {
+        const decimal height = balls[i]->getPosition()[2] - 1_d;
+        const decimal rise   = balls[i]->getVelocity()[2];
+        const decimal ground = (rise + std::sqrt(rise * rise + 2_d * g * height)) / g;
+        exact                = std::min(exact, ground);
+        bound                = std::min(bound, ground);
+        for (std::size_t j = i + 1; j < balls.size(); ++j)
+        {
+            const Vector3D d   = balls[j]->getPosition() - balls[i]->getPosition();
+            const Vector3D v   = balls[j]->getVelocity() - balls[i]->getVelocity();
+            const decimal  dv  = d.dotProduct(v);
+            const decimal  vv  = v.dotProduct(v);
+            const decimal  gap = d.getNorm() - 2_d;
+            bound              = std::min(bound, gap / std::sqrt(vv));
+            const decimal disc = dv * dv - vv * (d.dotProduct(d) - 4_d);
+            if (dv < 0_d && disc >= 0_d)
+                exact = std::min(exact, (-dv - std::sqrt(disc)) / vv);
+        }
+    }
+
+    // Not past the first contact, and no shorter than with every pair checked
+    const std::size_t steps = world.fastForward(100000);
+    const decimal     t     = static_cast<decimal>(steps) * 1e-3_d;
+    EXPECT_LE(t, exact);
+    EXPECT_GE(t, bound - 1e-3_d);
+    EXPECT_GT(steps, 0u);
+    for (std::size_t i = 0; i < balls.size(); ++i)
+    {
+        EXPECT_GT(balls[i]->getPosition()[2], 1_d);
+        for (std::size_t j = i + 1; j < balls.size(); ++j)
+            EXPECT_GT((balls[j]->getPosition() - balls[i]->getPosition()).getNorm(), 2_d);
+    }
+    world.clearObjects();
+}
+
+TEST(PhysicsWorldEventTest, ProjectilesStepOnlyAroundContacts)
+{
+    PhysicsWorld world;
+    world.setSolver("Euler");
+    world.setTimeStep(1e-3_d);
+    world.createObject<Plane>(Vector3D(0_d), Vector3D(200_d, 200_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    Sphere ball(Vector3D(0_d, 0_d, 10_d), 1_d, Vector3D(2_d, 0_d, 0_d), 1_d);
+    ball.setRestitutionCst(0.8_d);
+    world.addObject(&ball);
+    world.start();
+
+    // The loop of `run`: 4 s, the ball bouncing once or twice
+    std::size_t steps      = 0;
+    std::size_t integrated = 0;
+    decimal     lowest     = ball.getPosition()[2];
+    while (steps < 4000)
+    {
+        const std::size_t skipped = world.fastForward(4000 - steps);
+        if (skipped == 0)
+        {
+            world.integrate();
+            ++integrated;
+        }
+        steps  += std::max<std::size_t>(skipped, 1);
+        lowest  = std::min(lowest, ball.getPosition()[2]);
+    }
+    EXPECT_GT(lowest, 0_d);
+    EXPECT_LT(integrated, 400u);
+    EXPECT_GE(world.getFastForwardCount(), 2u);
+    world.clearObjects();
+}
+
+// ============================================================================
+//  Adaptive stepping
+// ============================================================================
+TEST(PhysicsWorldAdaptiveTest, StepGrowsInFlightAndShrinksAtContact)
+{
+    PhysicsWorld world;
+    world.setSolver("BS32");
+    world.setTimeStep(1e-3_d);
+    world.createObject<Plane>(Vector3D(0_d), Vector3D(200_d, 200_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    Sphere ball(Vector3D(0_d, 0_d, 20_d), 1_d, Vector3D(5_d, 0_d, 0_d), 1_d);
+    world.addObject(&ball);
+    world.start();
+
+    // Exact under gravity: a few growing steps, the last one landing on the ground
+    const decimal g       = -world.getGravityAcc()[2];
+    const decimal landing = std::sqrt(2_d * 19.5_d / g);
+    std::size_t   steps   = 0;
+    while (world.getTime() < landing - 1e-4_d && steps < 100)
+    {
+        world.integrate();
+        ++steps;
+    }
+    const decimal t = world.getTime();
+    EXPECT_LT(steps, 15u);
+    EXPECT_GT(world.getLastStep(), 0.1_d);
+    EXPECT_NEAR(t, landing, 1e-3_d);
+    EXPECT_NEAR(ball.getPosition()[0], 5_d * t, 1e-3_d);
+    EXPECT_NEAR(ball.getPosition()[2], 20_d - 0.5_d * g * t * t, 1e-2_d);
+
+    // The contact takes a step of `timeStep`, then the bounce is a flight of a single step again
+    world.integrate();
+    EXPECT_LE(world.getLastStep(), 1e-3_d * (1_d + 1e-4_d));
+    EXPECT_GT(ball.getVelocity()[2], 0_d);
+    world.integrate();
+    EXPECT_GT(world.getLastStep(), 0.1_d);
+    EXPECT_GT(ball.getPosition()[2], 0_d);
+    world.setSolver("Euler");
+    world.clearObjects();
+}
+
+TEST(PhysicsWorldAdaptiveTest, StepStopsAtTheFirstContactOfManyBodies)
+{
+    PhysicsWorld world;
+    world.setSolver("BS32");
+    world.setTimeStep(1e-3_d);
+    world.setThreadCount(4);
+    std::mt19937                            rng(9);
+    std::uniform_real_distribution<decimal> speed(-2_d, 2_d);
+    std::vector<std::unique_ptr<Sphere>>    balls;
+    for (int i = 0; i < 216; ++i)
+    {
+        const Vector3D position(static_cast<decimal>(i % 6) * 7_d, static_cast<decimal>(i / 6 % 6) * 7_d,
+                                static_cast<decimal>(i / 36) * 7_d);
+        balls.push_back(
+            std::make_unique<Sphere>(position, 2_d, Vector3D(speed(rng), speed(rng), speed(rng)), 1_d));
+        world.addObject(balls.back().get());
+    }
+    world.start();
+
+    // Same gravity for all: the spheres meet in straight lines, the steps growing until then. Only the
+    // contact step, at most 4 m/s closing speed, can overlap them
+    decimal longest = 0_d;
+    for (int step = 0; step < 20; ++step)
+    {
+        world.integrate();
+        longest = std::max(longest, world.getLastStep());
+        for (std::size_t i = 0; i < balls.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < balls.size(); ++j)
+                ASSERT_GT((balls[j]->getPosition() - balls[i]->getPosition()).getNorm(), 2_d - 4e-3_d);
+        }
+    }
+    EXPECT_GT(longest, 1e-2_d);
+    world.clearObjects();
+}
+
+TEST(PhysicsWorldAdaptiveTest, DenseOutputLandsOnTheTimeGrid)
+{
+    Config&                     config    = Config::get();
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "3dpe_dense_output";
+    config.setSave(true);
+    {
+        PhysicsWorld world;
+        world.setSolver("BS32");
+        world.setTimeStep(1e-3_d);
+        Sphere ball(Vector3D(0_d, 0_d, 100_d), 1_d, Vector3D(0_d), 1_d);
+        world.addObject(&ball);
+        world.start();
+        world.initCSV(directory.string());
+
+        // Long steps in free fall, the state being written every 0.1 s in between
+        std::size_t steps = 0;
+        for (int k = 1; k <= 10; ++k)
+        {
+            const decimal time = 0.1_d * static_cast<decimal>(k);
+            for (; world.getTime() < time; ++steps)
+                world.integrate();
+            world.saveMotionCSV(time);
+        }
+        EXPECT_LT(steps, 10u);
+        world.setSolver("Euler");
+        world.clearObjects();
+    }
+    config.setSave(false);
+
+    std::ifstream file(directory / "motion_object_0.csv");
+    std::string   line;
+    std::getline(file, line); // header
+    const decimal g    = config.getGravity();
+    int           rows = 0;
+    while (std::getline(file, line))
+    {
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream row(line);
+        decimal            t, x, y, z, vx, vy, vz;
+        row >> t >> x >> y >> z >> vx >> vy >> vz;
+        EXPECT_NEAR(t, 0.1_d * static_cast<decimal>(++rows), 1e-5_d);
+        EXPECT_NEAR(z, 100_d - 0.5_d * g * t * t, 1e-3_d) << t;
+        EXPECT_NEAR(vz, -g * t, 1e-3_d) << t;
+    }
+    EXPECT_EQ(rows, 10);
+    std::filesystem::remove_all(directory);
+}
+
+// ============================================================================
+//  Multi-rate stepping
+// ============================================================================
+TEST(PhysicsWorldMultiRateTest, StiffPairIsSubSteppedAlone)
+{
+    PhysicsWorld world;
+    world.setSolver("Verlet");
+    world.setTimeStep(1e-2_d);
+    world.setMaxTimeLevel(4);
+
+    // A stiff pair in contact, and idle bodies falling from rest far from it
+    Sphere left(Vector3D(0_d), 1_d, 1_d);
+    Sphere right(Vector3D(0.9_d, 0_d, 0_d), 1_d, 1_d);
+    left.setStiffnessCst(1e4_d);
+    right.setStiffnessCst(1e4_d);
+    world.addObject(&left);
+    world.addObject(&right);
+    std::vector<std::unique_ptr<Sphere>> idle;
+    for (int i = 0; i < 10; ++i)
+    {
+        idle.push_back(std::make_unique<Sphere>(Vector3D(10_d + 2_d * i, 0_d, 0_d), 1_d, 1_d));
+        world.addObject(idle.back().get());
+    }
+    world.start();
+    world.integrate();
+
+    // The pair shares a fine level; the idle bodies take the whole step at once
+    const std::vector<std::uint8_t>& levels = world.getTimeLevels();
+    ASSERT_EQ(levels.size(), 12u);
+    EXPECT_GT(levels[0], 0u);
+    EXPECT_LE(levels[0], 4u);
+    EXPECT_EQ(levels[1], levels[0]);
+    for (std::size_t slot = 2; slot < levels.size(); ++slot)
+        EXPECT_EQ(levels[slot], 0u);
+    EXPECT_EQ(world.getBodyUpdateCount(), 10u + 2u * (1u << levels[0]));
+
+    // Pushed apart, and the idle bodies end the step where a single-rate step leaves them
+    EXPECT_LT(left.getVelocity()[0], 0_d);
+    EXPECT_GT(right.getVelocity()[0], 0_d);
+    const decimal g = -world.getGravityAcc()[2];
+    EXPECT_NEAR(idle[0]->getPosition()[2], -0.5_d * g * 1e-4_d, 1e-6_d);
+    EXPECT_NEAR(idle[0]->getVelocity()[2], -g * 1e-2_d, 1e-5_d);
+
+    world.setMaxTimeLevel(0);
+    world.setSolver("Euler");
+    world.clearObjects();
+}
+
+TEST(PhysicsWorldMultiRateTest, SubStepsMatchTheFineSingleRateStep)
+{
+    // The same stiff pair stepped at the fine level alone, or with single-rate steps of that size
+    const auto separation = [](std::size_t maxLevel, decimal timeStep, int steps)
+    {
+        PhysicsWorld world;
+        world.setSolver("RK4");
+        world.setTimeStep(timeStep);
+        world.setMaxTimeLevel(maxLevel);
+        Sphere left(Vector3D(0_d), 1_d, 1_d);
+        Sphere right(Vector3D(0.9_d, 0_d, 0_d), 1_d, 1_d);
+        left.setStiffnessCst(1e4_d);
+        right.setStiffnessCst(1e4_d);
+        world.addObject(&left);
+        world.addObject(&right);
+        world.start();
+        for (int i = 0; i < steps; ++i)
+            world.integrate();
+        const decimal gap = right.getPosition()[0] - left.getPosition()[0];
+        world.setMaxTimeLevel(0);
+        world.setSolver("Euler");
+        world.clearObjects();
+        return gap;
+    };
+    const decimal multiRate = separation(2, 1e-2_d, 1);
+    const decimal fine      = separation(0, 2.5e-3_d, 4);
+    EXPECT_GT(multiRate, 0.9_d);
+    EXPECT_NEAR(multiRate, fine, 1e-4_d);
+}
+
+// ============================================================================
+//  Implicit contacts
+// ============================================================================
+/// A pair of unit spheres overlapping by a tenth, of stiffness `stiffness` each, and a sphere drifting far
+/// away, after `steps` steps of `timeStep` without gravity. Returns the kinetic energy of the pair.
+static decimal stiffPairEnergy(const std::string& solver, decimal stiffness, decimal timeStep, int steps,
+                               decimal* gap = nullptr, Vector3D* freePosition = nullptr)
+{
+    PhysicsWorld world;
+    world.setSolver(solver);
+    world.setTimeStep(timeStep);
+    world.setGravityAcc(Vector3D(0_d));
+    Sphere left(Vector3D(0_d), 1_d, 1_d);
+    Sphere right(Vector3D(0.9_d, 0_d, 0_d), 1_d, 1_d);
+    Sphere drifting(Vector3D(0_d, 20_d, 0_d), 1_d, Vector3D(1_d, 0_d, 0_d), 1_d);
+    left.setStiffnessCst(stiffness);
+    right.setStiffnessCst(stiffness);
+    world.addObject(&left);
+    world.addObject(&right);
+    world.addObject(&drifting);
+    world.start();
+    for (int i = 0; i < steps; ++i)
+        world.integrate();
+
+    const decimal energy = 0.5_d * (left.getVelocity().getNormSquare() + right.getVelocity().getNormSquare());
+    if (gap)
+        *gap = right.getPosition()[0] - left.getPosition()[0];
+    if (freePosition)
+        *freePosition = drifting.getPosition();
+    world.setSolver("Euler");
+    world.clearObjects();
+    return energy;
+}
+
+TEST(PhysicsWorldImplicitTest, StiffContactStaysBoundedAtLongSteps)
+{
+    // Effective stiffness 1e6 and reduced mass 0.5: a period of 4.4e-3 s, far below the step
+    const decimal stiffness = 2e6_d;
+    const decimal timeStep  = 1e-2_d;
+
+    // Work of the contact spring, -k·r, while the centres move from 0.9 to 1 apart and the boxes overlap
+    const decimal springWork = 0.5_d * 1e6_d * (1_d - 0.81_d);
+
+    Vector3D      freePosition;
+    const decimal implicitEnergy =
+        stiffPairEnergy("Implicit", stiffness, timeStep, 5, nullptr, &freePosition);
+    EXPECT_GT(implicitEnergy, 0_d);
+    EXPECT_LT(implicitEnergy, springWork);
+    EXPECT_GT(stiffPairEnergy("Verlet", stiffness, timeStep, 5), 10_d * springWork);
+
+    // Bodies in no contact take the semi-implicit Euler step
+    EXPECT_NEAR(freePosition[0], 5_d * timeStep, 1e-6_d);
+    EXPECT_NEAR(freePosition[1], 20_d, 1e-6_d);
+}
+
+TEST(PhysicsWorldImplicitTest, SoftContactMatchesRK4AtShortSteps)
+{
+    decimal       implicitGap    = 0_d;
+    decimal       rk4Gap         = 0_d;
+    const decimal implicitEnergy = stiffPairEnergy("Implicit", 2_d, 1e-3_d, 50, &implicitGap);
+    const decimal rk4Energy      = stiffPairEnergy("RK4", 2_d, 1e-3_d, 50, &rk4Gap);
+    EXPECT_GT(implicitGap, 0.9_d);
+    EXPECT_NEAR(implicitGap, rk4Gap, 1e-4_d);
+    EXPECT_NEAR(implicitEnergy, rk4Energy, 1e-2_d * rk4Energy);
+}
+
+// ============================================================================
+//  Frame memory
+// ============================================================================
+/// Allocations made by 30 steps of a resting scene: spheres and boxes on the ground, some boxes stacked, and
+/// a ball rolling away.
+static std::size_t steadyStateAllocations(const std::string& solver, const std::string& contactSolver,
+                                          const std::string& broadPhase, std::size_t threads)
+{
+    PhysicsWorld world;
+    world.setSolver(solver);
+    world.setContactSolver(contactSolver);
+    world.setBroadPhase(broadPhase);
+    world.setThreadCount(threads);
+    world.setTimeStep(0.01_d);
+
+    world.createObject<Plane>(Vector3D(0_d), Vector3D(40_d, 40_d, 0_d), Vector3D(0_d, 0_d, 1_d));
+    for (std::size_t i = 0; i < 24; ++i)
+    {
+        const Vector3D position(static_cast<decimal>(i % 6) * 1.5_d, static_cast<decimal>(i / 6) * 1.5_d,
+                                0.5_d);
+        if (i % 2 == 0)
+            world.createObject<Sphere>(position, 1_d, 1_d);
+        else
+            world.createObject<AABB>(position, Vector3D(1_d), 1_d);
+        if (i % 4 == 1)
+            world.createObject<AABB>(position + Vector3D(0_d, 0_d, 1_d), Vector3D(1_d), 1_d);
+    }
+    const ObjectHandle ball =
+        world.createObject<Sphere>(Vector3D(15_d, 15_d, 0.5_d), 1_d, Vector3D(2_d, 0_d, 0_d), 1_d);
+    world.getObject(ball)->setIsContinuous(true);
+
+    // Containers reach their size over the first steps
+    world.start();
+    for (int step = 0; step < 20; ++step)
+        world.integrate();
+    const std::size_t before = getAllocationCount();
+    for (int step = 0; step < 30; ++step)
+        world.integrate();
+    const std::size_t allocations = getAllocationCount() - before;
+
+    world.clearObjects();
+    world.setThreadCount(1);
+    world.setContactSolver("Rebound");
+    return allocations;
+}
+
+TEST(PhysicsWorldFrameTest, SteadyStateStepDoesNotAllocate)
+{
+    // The Auto broad phase is left out: its periodic sampling reports its decision as a string
+    const std::string broadPhase = Config::get().getBroadPhase();
+    for (const std::string solver : { "Euler", "Verlet", "RK4", "BS32", "Implicit" })
+    {
+        for (const std::string contactSolver : { "Rebound", "SequentialImpulse" })
+        {
+            for (const std::string algorithm : { "BruteForce", "SweepAndPrune", "UniformGrid", "BVH" })
+            {
+                for (const std::size_t threads : { 1u, 4u })
+                    EXPECT_EQ(steadyStateAllocations(solver, contactSolver, algorithm, threads), 0u)
+                        << solver << " " << contactSolver << " " << algorithm << " " << threads;
+            }
+        }
+    }
+    Config::get().setBroadPhase(broadPhase);
+}
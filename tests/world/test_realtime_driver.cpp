@@ -0,0 +1,151 @@
+#include "objects/sphere.hpp"
+#include "test_functions.hpp"
+#include "utilities/timer.hpp"
+#include "world/physicsWorld.hpp"
+#include "world/realtime_driver.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// ============================================================================
+//  Helpers
+// ============================================================================
+/// A sphere drifting at constant velocity without gravity: every state between two steps is on its line.
+struct DriftingWorld
+{
+    PhysicsWorld world;
+    Sphere       ball { Vector3D(0_d), 1_d, Vector3D(2_d, 0_d, -1_d), 1_d };
+
+    DriftingWorld()
+    {
+        world.setSolver("Euler");
+        world.setTimeStep(1e-3_d);
+        world.setGravityAcc(Vector3D(0_d));
+        world.addObject(&ball);
+        world.start();
+    }
+    ~DriftingWorld() { world.clearObjects(); }
+};
+
+// ============================================================================
+//  Stepping
+// ============================================================================
+TEST(RealTimeDriverTest, MaxModeStepsTheDuration)
+{
+    DriftingWorld  scene;
+    RealTimeDriver driver(scene.world);
+    EXPECT_EQ(driver.getRealTimeFactor(), 0_d);
+    EXPECT_EQ(driver.getOutputRate(), 0_d);
+
+    // As fast as possible, every step recorded
+    driver.run(0.1_d);
+    EXPECT_EQ(driver.getStepCount(), 100u);
+    EXPECT_EQ(driver.getRecordCount(), 100u);
+    EXPECT_EQ(driver.getStepLatency().getCount(), 100u);
+    EXPECT_EQ(driver.getStartJitter().getCount(), 0u);
+    EXPECT_NEAR(scene.world.getTime(), 0.1_d, 1e-5_d);
+    EXPECT_NEAR(scene.ball.getPosition()[0], 0.2_d, 1e-4_d);
+
+    // Negative factors and rates are refused
+    EXPECT_THROW(driver.setRealTimeFactor(-1_d), std::invalid_argument);
+    EXPECT_THROW(driver.setOutputRate(-1_d), std::invalid_argument);
+}
+
+TEST(RealTimeDriverTest, PacedRunFollowsTheWallClock)
+{
+    DriftingWorld  scene;
+    RealTimeDriver driver(scene.world);
+
+    // Real time: the 50th step cannot start before 49 ms
+    driver.setRealTimeFactor(1_d);
+    Timer timer;
+    driver.run(0.05_d);
+    EXPECT_GE(timer.elapsedMicroseconds(), 49000);
+    EXPECT_EQ(driver.getStepCount(), 50u);
+    EXPECT_EQ(driver.getStartJitter().getCount(), 50u);
+    EXPECT_LE(driver.getDeadlineMisses(), driver.getStepCount());
+
+    // Ten times faster, spinning through the waits: 100 ms simulated in about 10 ms
+    driver.setRealTimeFactor(10_d);
+    driver.setSpinMargin(std::chrono::milliseconds(1));
+    timer.reset();
+    driver.run(0.1_d);
+    EXPECT_GE(timer.elapsedMicroseconds(), 9900);
+    EXPECT_EQ(driver.getStepCount(), 150u);
+}
+
+TEST(RealTimeDriverTest, AdvanceKeepsTheRemainder)
+{
+    DriftingWorld  scene;
+    RealTimeDriver driver(scene.world);
+    driver.setRealTimeFactor(1_d);
+
+    // 2.5 steps of wall time: two steps, half of one left for the rendering
+    EXPECT_EQ(driver.advance(2.5e-3), 2u);
+    EXPECT_NEAR(driver.getAlpha(), 0.5_d, 1e-3_d);
+    EXPECT_EQ(driver.advance(1e-3), 1u);
+    EXPECT_NEAR(driver.getAlpha(), 0.5_d, 1e-3_d);
+
+    // The rendered state lies between the two ends of the last step
+    Vector3DArray positions;
+    Vector3DArray velocities;
+    driver.interpolate(driver.getAlpha(), positions, velocities);
+    EXPECT_NEAR(positions.get(0)[0], 2_d * 2.5e-3_d, 1e-5_d);
+    EXPECT_NEAR(velocities.get(0)[0], 2_d, 1e-5_d);
+
+    // A long stall is not caught up: at most `maxCatchUpSteps` steps, the rest dropped
+    EXPECT_EQ(driver.advance(1.0), 8u);
+    EXPECT_NEAR(driver.getDroppedTime(), 1_d - 7.5e-3_d, 1e-4_d);
+
+    // Without a factor, one step per call
+    driver.setRealTimeFactor(0_d);
+    EXPECT_EQ(driver.advance(1.0), 1u);
+    EXPECT_EQ(driver.getStepCount(), 12u);
+}
+
+// ============================================================================
+//  Recording
+// ============================================================================
+TEST(RealTimeDriverTest, OutputRateInterpolatesBetweenSteps)
+{
+    Config&                     config    = Config::get();
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "3dpe_output_rate";
+    config.setSave(true);
+    {
+        DriftingWorld scene;
+        scene.world.initCSV(directory.string());
+
+        // 30 records per second over 1 ms steps: most of them fall inside a step
+        RealTimeDriver driver(scene.world);
+        driver.setOutputRate(30_d);
+        driver.run(0.5_d);
+        EXPECT_EQ(driver.getStepCount(), 500u);
+        EXPECT_EQ(driver.getRecordCount(), 16u); // from 0 to 15/30 s
+        EXPECT_NEAR(driver.getLastRecordTime(), 0.5_d, 1e-5_d);
+    }
+    config.setSave(false);
+
+    std::ifstream file(directory / "motion_object_0.csv");
+    std::string   line;
+    std::getline(file, line); // header
+    int rows = 0;
+    while (std::getline(file, line))
+    {
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream row(line);
+        decimal            t, x, y, z, vx;
+        row >> t >> x >> y >> z >> vx;
+        EXPECT_NEAR(t, static_cast<decimal>(rows++) / 30_d, 1e-5_d);
+        EXPECT_NEAR(x, 2_d * t, 1e-4_d) << t;
+        EXPECT_NEAR(z, -t, 1e-4_d) << t;
+        EXPECT_NEAR(vx, 2_d, 1e-5_d) << t;
+    }
+    EXPECT_EQ(rows, 16);
+    std::filesystem::remove_all(directory);
+}